@@ -24,6 +24,7 @@ SIMULATION() {
     constexpr uint64_t TestTick = 1000000UL; // 1M ticks
 
     uint64_t input_cnt = 0;
+    sim_register_counter("aes1.inputs", &input_cnt);
 
     for (uint64_t tick = 0; tick < TestTick; ++tick) {
         if (input(data, key)) {
@@ -16,6 +16,12 @@ REGISTER_ARRAY1(array_reg, uint16_t, REG_ARRAY_SIZE, 2) {
     }
 }
 
+REGISTER_ARRAY1(bulk_reg, uint16_t, REG_ARRAY_SIZE, 3) {
+    for (int i = 0; i < REG_ARRAY_SIZE; ++i) {
+        bulk_reg[i] = 0;
+    }
+}
+
 REGISTER(payload_reg, Payload) {
     payload_reg.data = 0;
     payload_reg.meta.tag = 3;
@@ -73,4 +79,16 @@ TICK_IMPL() {
     array_payload_next.data = multi_reg.get() + array_reg[idx];
     array_payload_next.meta.valid = true;
     payload_array.setnext<1>(idx, array_payload_next);
+
+    uint16_t bulk_next[REG_ARRAY_SIZE];
+    Payload payload_fill[2];
+    for (int i = 0; i < REG_ARRAY_SIZE; ++i) {
+        bulk_next[i] = static_cast<uint16_t>(bulk_reg[i] + array_reg[i]);
+    }
+    payload_fill[0] = payload_reg;
+    payload_fill[1] = payload_reg;
+    bulk_reg.setnext_all(bulk_next);
+    bulk_reg.setnext_all<1>(bulk_next);
+    bulk_reg.setnext_range<2>(idx, REG_ARRAY_SIZE, bulk_next);
+    payload_array.setnext_range(0, 2, payload_fill);
 }
@@ -0,0 +1,23 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include <defhelper.hpp>
+#include <run.hpp>
+
+#include "header.hpp"
+
+TOP("./Top.hpp");
+PROJECT(".");
+
+QUERY(status, TLBStatus);
+
+SIMULATION() {
+    sim_run(1000);
+    TLBStatus st = status();
+    // 冷启动缺失 12 次，第 300 个周期失效后缺失 1 次，第 500 个周期冲刷后再缺失 12 次
+    if (st.errors != 0 || st.misses != 25 || st.hits != 975) {
+        std::printf("cam failed: hits=%u misses=%u errors=%u\n", st.hits, st.misses, st.errors);
+        std::exit(1);
+    }
+    std::printf("cam passed: hits=%u misses=%u\n", st.hits, st.misses);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <defhelper.hpp>
+
+#include "header.hpp"
+
+PARAMETER(ENTRIES, 16);
+PARAMETER(PAGES, 12);
+
+// 全相联 TLB：端口 0 在缺失的下个周期填入，端口 1 用于单独失效一个表项
+CAM(tlb, uint32_t, TLBEntry, ENTRIES, 2);
+
+REGISTER(cycle, uint32_t) {
+    cycle = 0;
+}
+REGISTER(hits, uint32_t) {
+    hits = 0;
+}
+REGISTER(misses, uint32_t) {
+    misses = 0;
+}
+REGISTER(errors, uint32_t) {
+    errors = 0;
+}
+
+QUERY(status, TLBStatus) {
+    TLBStatus value;
+    value.hits = hits;
+    value.misses = misses;
+    value.errors = errors;
+    return value;
+}
+
+TICK_IMPL() {
+    uint32_t error_count = 0;
+    const uint32_t vpn = 0x1000 + cycle % PAGES;
+    const uint32_t idx = tlb.find(vpn);
+    if (idx != ENTRIES) {
+        const TLBEntry entry = tlb.value(idx);
+        if (entry.ppn != vpn * 3 + 1 || entry.writable != (vpn % 2 == 0) || tlb.key(idx) != vpn) {
+            error_count++;
+        }
+        hits.setnext(hits + 1);
+        // 第 300 个周期失效命中的表项，下次访问同一页时重新缺失
+        if (cycle == 300) {
+            tlb.invalidatenext<1>(idx);
+        }
+    } else {
+        const uint32_t slot = tlb.findfree();
+        if (slot == ENTRIES) {
+            error_count++;
+        } else {
+            TLBEntry entry;
+            entry.ppn = vpn * 3 + 1;
+            entry.writable = (vpn % 2 == 0);
+            tlb.writenext<0>(slot, vpn, entry);
+        }
+        misses.setnext(misses + 1);
+    }
+    // 第 500 个周期整体冲刷
+    if (cycle == 500) {
+        tlb.clrnext();
+    }
+    cycle.setnext(cycle + 1);
+    errors.setnext(errors + error_count);
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <defhelper.hpp>
+
+STRUCT(TLBEntry) {
+    uint32_t ppn;
+    bool writable;
+};
+
+STRUCT(TLBStatus) {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t errors;
+};
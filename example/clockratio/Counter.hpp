@@ -0,0 +1,17 @@
+#pragma once
+
+#include <defhelper.hpp>
+
+#include "header.hpp"
+
+REGISTER(count, uint32_t) {
+    count = 0;
+}
+
+QUERY(value, uint32_t) {
+    return count;
+}
+
+TICK_IMPL() {
+    count.setnext(count + 1);
+}
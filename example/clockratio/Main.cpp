@@ -0,0 +1,38 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include <defhelper.hpp>
+#include <run.hpp>
+
+#include "header.hpp"
+
+TOP("./Top.hpp");
+PROJECT(".");
+
+GLOBAL() {
+    uint32_t outputs = 0;
+    bool misaligned = false;
+}
+
+QUERY(status, SinkStatus);
+QUERY(stalls, uint32_t);
+
+// 分频实例只在有效沿执行 tick，输出出现在第 0、4、8…个周期
+SERVICE(output, ARG(uint32_t) sum) {
+    if (sim_cycles() % 4 != 0) {
+        misaligned = true;
+    }
+    outputs++;
+}
+
+SIMULATION() {
+    sim_run(40);
+    SinkStatus st = status();
+    // 40 个快周期中慢实例有 10 个有效沿，每个有效沿接收一个数据，其余 30 次发送被拒绝并重试
+    if (st.ticks != 10 || st.child_ticks != 10 || st.received != 10 || st.sum != 55 || stalls() != 30 || outputs != 10 || misaligned) {
+        std::printf("clockratio failed: ticks=%u child_ticks=%u received=%u sum=%u stalls=%u outputs=%u misaligned=%d\n",
+                    st.ticks, st.child_ticks, st.received, st.sum, stalls(), outputs, misaligned ? 1 : 0);
+        std::exit(1);
+    }
+    std::printf("clockratio passed: ticks=%u received=%u sum=%u stalls=%u\n", st.ticks, st.received, st.sum, stalls());
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <defhelper.hpp>
+
+#include "header.hpp"
+
+REGISTER(next, uint32_t) {
+    next = 1;
+}
+REGISTER(stalls, uint32_t) {
+    stalls = 0;
+}
+
+REQUEST_READY(send, ARG(uint32_t) value);
+
+QUERY(stall_count, uint32_t) {
+    return stalls;
+}
+
+TICK_IMPL() {
+    if (send(next)) {
+        next.setnext(next + 1);
+    } else {
+        stalls.setnext(stalls + 1);
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <defhelper.hpp>
+
+#include "header.hpp"
+
+PARAMETER(DIV, 4);
+
+// 父模块每 DIV 个周期本实例及子实例 counter 执行一个周期
+CLOCK_RATIO(DIV);
+
+REGISTER(ticks, uint32_t) {
+    ticks = 0;
+}
+REGISTER(received, uint32_t) {
+    received = 0;
+}
+REGISTER(sum, uint32_t) {
+    sum = 0;
+}
+
+CHILD_INSTANCE(Counter, counter);
+USE_CHILD_QUERY(counter, value, counter_value, uint32_t);
+
+REQUEST(output, ARG(uint32_t) sum);
+
+SERVICE_READY(recv, true, ARG(uint32_t) value) {
+    received.setnext(received + 1);
+    sum.setnext(sum + value);
+}
+
+QUERY(status, SinkStatus) {
+    SinkStatus value;
+    value.ticks = ticks;
+    value.received = received;
+    value.sum = sum;
+    value.child_ticks = counter_value();
+    return value;
+}
+
+TICK_IMPL() {
+    ticks.setnext(ticks + 1);
+    output(sum);
+}
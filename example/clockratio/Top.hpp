@@ -0,0 +1,24 @@
+#pragma once
+
+#include <defhelper.hpp>
+
+#include "header.hpp"
+
+REQUEST(output, ARG(uint32_t) sum);
+
+CHILD_INSTANCE(Producer, prod);
+CHILD_INSTANCE(SlowSink, sink, DIV=4);
+
+CONNECT_CR_CS(prod, send, sink, recv);
+CONNECT_CR_R(sink, output, output);
+
+USE_CHILD_QUERY(sink, status, sink_status, SinkStatus);
+USE_CHILD_QUERY(prod, stall_count, prod_stalls, uint32_t);
+
+QUERY(status, SinkStatus) {
+    return sink_status();
+}
+
+QUERY(stalls, uint32_t) {
+    return prod_stalls();
+}
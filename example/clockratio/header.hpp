@@ -0,0 +1,10 @@
+#pragma once
+
+#include <defhelper.hpp>
+
+STRUCT(SinkStatus) {
+    uint32_t ticks;
+    uint32_t received;
+    uint32_t sum;
+    uint32_t child_ticks;
+};
@@ -0,0 +1,23 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include <defhelper.hpp>
+#include <run.hpp>
+
+#include "header.hpp"
+
+TOP("./Top.hpp");
+PROJECT(".");
+
+QUERY(status, PipeStatus);
+
+SIMULATION() {
+    sim_run(1000);
+    PipeStatus st = status();
+    // 前 100 个周期没有输出，之后单端口每个周期输出一个，多端口每两个周期输出两个
+    if (st.errors != 0 || st.received != 900 || st.received_mp != 900) {
+        std::printf("delayline failed: received=%u received_mp=%u errors=%u\n", st.received, st.received_mp, st.errors);
+        std::exit(1);
+    }
+    std::printf("delayline passed: received=%u received_mp=%u\n", st.received, st.received_mp);
+}
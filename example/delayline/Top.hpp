@@ -0,0 +1,62 @@
+#pragma once
+
+#include <defhelper.hpp>
+
+#include "header.hpp"
+
+PARAMETER(LATENCY, 100);
+
+// 模拟固定延迟的访存通路：第 t 个周期发出的请求在第 t + LATENCY 个周期返回
+DELAY_LINE(pipe, uint32_t, LATENCY);
+DELAY_LINE_MP(pipe_mp, uint32_t, LATENCY, 2);
+
+REGISTER(cycle, uint32_t) {
+    cycle = 0;
+}
+REGISTER(received, uint32_t) {
+    received = 0;
+}
+REGISTER(received_mp, uint32_t) {
+    received_mp = 0;
+}
+REGISTER(errors, uint32_t) {
+    errors = 0;
+}
+
+QUERY(status, PipeStatus) {
+    PipeStatus value;
+    value.received = received;
+    value.received_mp = received_mp;
+    value.errors = errors;
+    return value;
+}
+
+TICK_IMPL() {
+    uint32_t error_count = 0;
+    // 单端口每个周期压入周期号，多端口在奇数周期压入两个值
+    pipe.pushnext(cycle);
+    if (cycle % 2 == 1) {
+        pipe_mp.pushnext({cycle, cycle + 1}, 2);
+    }
+
+    if (pipe.outvalid()) {
+        if (pipe.out() + LATENCY != cycle) {
+            error_count++;
+        }
+        received.setnext(received + 1);
+    } else if (cycle >= LATENCY) {
+        error_count++;
+    }
+
+    const uint32_t num = pipe_mp.outvalid();
+    if (num > 0) {
+        const auto &values = pipe_mp.out();
+        if (num != 2 || values[0] + LATENCY != cycle || values[1] != values[0] + 1) {
+            error_count++;
+        }
+        received_mp.setnext(received_mp + num);
+    }
+
+    cycle.setnext(cycle + 1);
+    errors.setnext(errors + error_count);
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <defhelper.hpp>
+
+STRUCT(PipeStatus) {
+    uint32_t received;
+    uint32_t received_mp;
+    uint32_t errors;
+};
@@ -1,6 +1,6 @@
+#include <array>
 #include <cstdio>
 #include <cstdlib>
-#include <deque>
 
 #include <defhelper.hpp>
 #include <run.hpp>
@@ -19,16 +19,20 @@ GLOBAL() {
         uint64_t y;
         uint64_t tick;
     };
-    std::deque<ExpectedOutput> expected_outputs;
+    // At most 3 results are in flight; a fixed ring keeps the harness allocation-free
+    std::array<ExpectedOutput, 4> expected_outputs;
+    uint32_t expected_head = 0;
+    uint32_t expected_count = 0;
 };
 
 SERVICE(s3output, ARG(uint64_t) y) {
-    if (expected_outputs.empty()) {
+    if (expected_count == 0) {
         std::printf("mulu32 failed: unexpected output y=%lu at tick %lu\n", y, current_tick);
         std::exit(1);
     }
-    ExpectedOutput expected = expected_outputs.front();
-    expected_outputs.pop_front();
+    ExpectedOutput expected = expected_outputs[expected_head];
+    expected_head = (expected_head + 1) % expected_outputs.size();
+    expected_count--;
     if (y != expected.y) {
         std::printf("mulu32 failed: incorrect output y=%lu at tick %lu, expected %lu\n", y, current_tick, expected.y);
         std::exit(1);
@@ -61,7 +65,8 @@ SIMULATION() {
             s0input(a, b);
             // Calculate expected output
             uint64_t expected_y = static_cast<uint64_t>(a) * static_cast<uint64_t>(b);
-            expected_outputs.push_back({expected_y, current_tick + 3}); // Output will be available after 3 ticks
+            expected_outputs[(expected_head + expected_count) % expected_outputs.size()] = {expected_y, current_tick + 3}; // Output will be available after 3 ticks
+            expected_count++;
         }
         sim_nextcycle();
     }
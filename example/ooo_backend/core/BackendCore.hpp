@@ -554,23 +554,13 @@ TICK_IMPL() {
     issue_to_lane(best_lsu0, false, false, true, false);
     issue_to_lane(best_lsu1, false, false, false, true);
 
-    for (int i = 0; i < ARCH_REGS; ++i) {
-        map_table.setnext<0>(i, next_map[i]);
-    }
-    for (int i = 0; i < PHYS_REGS; ++i) {
-        phys_ready.setnext<0>(i, next_phys_ready[i]);
-        phys_value.setnext<0>(i, next_phys_value[i]);
-        free_tags.setnext<0>(i, next_free_tags[i]);
-    }
-    for (int i = 0; i < ROB_SIZE; ++i) {
-        rob.setnext<0>(i, next_rob[i]);
-    }
-    for (int i = 0; i < IQ_SIZE; ++i) {
-        iq.setnext<0>(i, next_iq[i]);
-    }
-    for (int i = 0; i < FRONTEND_QUEUE_DEPTH; ++i) {
-        ingress_buf.setnext<0>(i, next_ingress_buf[i]);
-    }
+    map_table.setnext_all<0>(next_map);
+    phys_ready.setnext_all<0>(next_phys_ready);
+    phys_value.setnext_all<0>(next_phys_value);
+    free_tags.setnext_all<0>(next_free_tags);
+    rob.setnext_all<0>(next_rob);
+    iq.setnext_all<0>(next_iq);
+    ingress_buf.setnext_all<0>(next_ingress_buf);
 
     dispatched.setnext(next_dispatched);
     issued.setnext(next_issued);
@@ -0,0 +1,146 @@
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+#include <defhelper.hpp>
+#include <run.hpp>
+
+#include "../header.hpp"
+
+TOP("../core/BackendCore.hpp");
+PROJECT("..");
+
+PARAMETER(ALU_LANES, 2);
+PARAMETER(LSU_LANES, 2);
+
+// 与 MainWide 运行同一段程序，取指、两路访存响应与结果检查分别写成协程进程，由生成的调度器逐周期恢复
+GLOBAL() {
+    std::vector<BackendInstr> program;
+    uint64_t mem[64]{};
+    std::deque<MemRequest> pending0;
+    std::deque<MemRequest> pending1;
+    bool resp0_valid = false;
+    bool resp1_valid = false;
+    MemResponse resp0{};
+    MemResponse resp1{};
+    bool passed = false;
+
+    static constexpr uint64_t MEM_LATENCY = 3;
+
+    VulProcess feeder() {
+        std::size_t pc = 0;
+        while (pc < program.size()) {
+            if (push_inst<0>(program[pc])) {
+                pc++;
+            }
+            if (pc < program.size() && push_inst<1>(program[pc])) {
+                pc++;
+            }
+            co_await vul_next_cycle();
+        }
+    }
+
+    // 请求在服务中入队，进程等待固定延迟后访问存储并置起响应，响应被取走后再处理下一个请求
+    VulProcess memory(std::deque<MemRequest> &pending, bool &valid, MemResponse &resp) {
+        for (;;) {
+            co_await vul_until([&] { return !pending.empty(); });
+            co_await vul_wait_cycles(MEM_LATENCY);
+            const MemRequest req = pending.front();
+            pending.pop_front();
+            uint64_t idx = (req.addr >> 3) & 63ULL;
+            if (req.is_store) {
+                mem[idx] = req.data;
+                resp.data = 0;
+            } else {
+                resp.data = mem[idx];
+            }
+            resp.valid = true;
+            resp.rob_idx = req.rob_idx;
+            resp.dst_phys = req.dst_phys;
+            resp.seq = req.seq;
+            valid = true;
+            co_await vul_until([&] { return !valid; });
+        }
+    }
+
+    VulProcess checker() {
+        co_await vul_until([this] { return status().halted; });
+        BackendStatus st = status();
+        ArchRegSnapshot snap = regs();
+        if (snap.x1 != 34ULL || mem[16] != 34ULL) {
+            std::printf("agents integration failed: x1=%llu mem[16]=%llu expected=34\n",
+                        static_cast<unsigned long long>(snap.x1), static_cast<unsigned long long>(mem[16]));
+            std::exit(1);
+        }
+        std::printf("ooo agents passed: cycles=%llu committed=%llu x1=%llu mem16=%llu\n",
+                    static_cast<unsigned long long>(st.cycle),
+                    static_cast<unsigned long long>(st.committed),
+                    static_cast<unsigned long long>(snap.x1),
+                    static_cast<unsigned long long>(mem[16]));
+        passed = true;
+    }
+}
+
+REQUEST_READY(push_inst, ARRAY(INGRESS_WIDTH), ARG(BackendInstr) inst);
+QUERY(status, BackendStatus);
+QUERY(regs, ArchRegSnapshot);
+
+SERVICE(mem_req0, ARG(MemRequest) req) {
+    pending0.push_back(req);
+}
+
+SERVICE_READY(mem_resp0, resp0_valid, RESP(MemResponse) resp) {
+    resp = resp0;
+    resp0_valid = false;
+}
+
+SERVICE(mem_req1, ARG(MemRequest) req) {
+    pending1.push_back(req);
+}
+
+SERVICE_READY(mem_resp1, resp1_valid, RESP(MemResponse) resp) {
+    resp = resp1;
+    resp1_valid = false;
+}
+
+SIMULATION() {
+    auto emit = [&](uint8_t op, uint8_t rd, uint8_t rs1, uint8_t rs2, int64_t imm) {
+        BackendInstr inst{};
+        inst.valid = true;
+        inst.opcode = op;
+        inst.rd = rd;
+        inst.rs1 = rs1;
+        inst.rs2 = rs2;
+        inst.imm = imm;
+        program.push_back(inst);
+    };
+
+    for (uint64_t i = 0; i < 64; ++i) {
+        mem[i] = i * 3ULL;
+    }
+
+    emit(OP_ADDI, 1, 0, 0, 10);
+    emit(OP_ADDI, 2, 0, 0, 3);
+    emit(OP_ADDI, 3, 0, 0, 4);
+    for (int rep = 0; rep < 24; ++rep) {
+        emit(OP_MUL, 4, 1, 2, 0);
+        emit(OP_ADD, 5, 4, 3, 0);
+        emit(OP_LOAD, 6, 0, 0, (rep & 7) * 8);
+        emit(OP_ADD, 7, 6, 5, 0);
+        emit(OP_STORE, 0, 0, 7, (16 + rep) * 8);
+        emit(OP_ADDI, 1, 1, 0, 1);
+    }
+    emit(OP_HALT, 0, 0, 0, 0);
+
+    sim_spawn(feeder());
+    sim_spawn(memory(pending0, resp0_valid, resp0));
+    sim_spawn(memory(pending1, resp1_valid, resp1));
+    sim_spawn(checker());
+
+    sim_run(8000, [&] { return passed; });
+    if (!passed) {
+        std::printf("agents integration failed: timeout\n");
+        std::exit(1);
+    }
+}
@@ -17,7 +17,7 @@ SERVICE(push, ARG(uint32_t) data) {
     sum.setnext(sum + data);
 }
 
-QUERY(snapshot, ChildSnapshot) {
+QUERY_CACHED(snapshot, ChildSnapshot) {
     ChildSnapshot value;
     value.sum = sum;
     value.can_pop = history.deqvalid();
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <defhelper.hpp>
+
+#include "header.hpp"
+
+PARAMETER(JOBS, 8);
+PARAMETER(LATENCY, 1000);
+
+// 每个任务发出后等待 LATENCY 个周期，等待期间只有 wait 在倒计数
+REGISTER(wait, uint32_t) {
+    wait = 0;
+}
+QUIESCENT_TIMER(wait);
+
+REGISTER(done, uint32_t) {
+    done = 0;
+}
+REGISTER(busy_ticks, uint32_t) {
+    busy_ticks = 0;
+}
+
+QUERY(status, EngineStatus) {
+    EngineStatus value;
+    value.done = done;
+    value.busy_ticks = busy_ticks;
+    return value;
+}
+
+TICK_IMPL() {
+    if (wait != 0) {
+        wait.setnext(wait - 1);
+    } else if (done < JOBS) {
+        done.setnext(done + 1);
+        busy_ticks.setnext(busy_ticks + 1);
+        wait.setnext(LATENCY);
+    }
+}
@@ -0,0 +1,26 @@
+#include <cstdio>
+#include <cstdlib>
+
+#include <defhelper.hpp>
+#include <run.hpp>
+
+#include "header.hpp"
+
+TOP("./Top.hpp");
+PROJECT(".");
+
+QUERY(status, EngineStatus);
+
+SIMULATION() {
+    sim_skip_idle(true);
+    VulRunResult result = sim_run(100000, [&] { return status().done == 8; });
+    EngineStatus st = status();
+    // 第 k 个任务在第 1001*(k-1) 个周期发出，第 8 个任务发出后停止；
+    // 每次等待的 1000 个周期中第一个周期逐个执行，其余 999 个周期被跳过
+    if (result.reason != VulRunStopped || result.cycles != 7008 || result.skipped != 7 * 999 || st.done != 8 || st.busy_ticks != 8) {
+        std::printf("quiescent failed: cycles=%lu skipped=%lu done=%u busy_ticks=%u\n",
+                    (unsigned long)result.cycles, (unsigned long)result.skipped, st.done, st.busy_ticks);
+        std::exit(1);
+    }
+    std::printf("quiescent passed: cycles=%lu skipped=%lu\n", (unsigned long)result.cycles, (unsigned long)result.skipped);
+}
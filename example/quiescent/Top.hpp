@@ -0,0 +1,12 @@
+#pragma once
+
+#include <defhelper.hpp>
+
+#include "header.hpp"
+
+CHILD_INSTANCE(Engine, engine);
+USE_CHILD_QUERY(engine, status, engine_status, EngineStatus);
+
+QUERY(status, EngineStatus) {
+    return engine_status();
+}
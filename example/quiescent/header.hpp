@@ -0,0 +1,8 @@
+#pragma once
+
+#include <defhelper.hpp>
+
+STRUCT(EngineStatus) {
+    uint32_t done;
+    uint32_t busy_ticks;
+};
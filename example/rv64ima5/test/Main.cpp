@@ -5,6 +5,7 @@
 
 #include <defhelper.hpp>
 #include <run.hpp>
+#include <sparsemem.hpp>
 
 #include "../header.hpp"
 
@@ -13,7 +14,7 @@ PROJECT("..");
 
 GLOBAL() {
 static constexpr uint64_t kMemSize = 4096;
-std::array<uint8_t, 4096> memory{};
+VulSparseMemory memory;
 std::array<uint64_t, 32> arch_regs{};
 bool halted_seen = false;
 uint64_t halt_pc = 0;
@@ -29,17 +30,11 @@ uint64_t reservation_addr = 0;
 uint8_t reservation_width = 0;
 
 uint64_t load_le(uint64_t addr, uint8_t width) {
-    uint64_t value = 0;
-    for (uint8_t i = 0; i < width; ++i) {
-        value |= static_cast<uint64_t>(memory[addr + i]) << (8U * i);
-    }
-    return value;
+    return memory.load_le(addr, width);
 }
 
 void store_le(uint64_t addr, uint64_t value, uint8_t width) {
-    for (uint8_t i = 0; i < width; ++i) {
-        memory[addr + i] = static_cast<uint8_t>((value >> (8U * i)) & 0xffU);
-    }
+    memory.store_le(addr, value, width);
 }
 
 uint32_t load32(uint64_t addr) {
@@ -246,7 +241,7 @@ SERVICE(trace_halt, ARG(uint64_t) pc) {
 }
 
 SIMULATION() {
-    std::memset(memory.data(), 0, memory.size());
+    memory.clear();
     for (auto &x : arch_regs) {
         x = 0;
     }
@@ -309,13 +304,11 @@ SIMULATION() {
     dcache_pending_req.wdata = 0;
 
     const uint64_t max_cycles = 512;
-    for (uint64_t tick = 0; tick < max_cycles; ++tick) {
-        sim_cycle = tick;
-        sim_nextcycle();
-        if (halted_seen) {
-            break;
-        }
-    }
+    sim_cycle = 0;
+    sim_run(max_cycles, [&] {
+        sim_cycle = sim_cycles();
+        return halted_seen;
+    });
 
     if (!halted_seen) {
         std::printf("core integration timed out\n");
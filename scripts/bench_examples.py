@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+"""端到端仿真吞吐基准：对 example/ 下带仿真入口的设计逐个执行
+vulsimgen 生成 -> release.sh 构建 -> 固定周期数运行，记录生成耗时、编译耗时、
+仿真速度（cycles/sec）和峰值内存，结果追加到 JSON 历史文件中。
+
+用法：
+    scripts/bench_examples.py                       # 跑全部用例
+    scripts/bench_examples.py --only rv64ima5 aes1  # 只跑名字包含给定子串的用例
+    scripts/bench_examples.py --cycles 500000 --history build/bench/examples.json
+
+vulsimgen 默认取 build/vulsimgen，可用 --vulsimgen 指定。
+生成的仿真程序在环境变量 VULSIM_MAX_CYCLES 设置时运行到该周期数即退出，
+并向 stderr 输出 "[vulsim] cycles=N seconds=S"；提前结束的设计按实际周期数统计。
+"""
+
+import argparse
+import datetime
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+import time
+from dataclasses import dataclass
+from typing import List, Optional
+
+ROOT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+
+@dataclass
+class Case:
+    name: str
+    main: str
+    top: Optional[str] = None  # 仿真入口未声明 TOP() 时需要显式给出
+
+
+CASES: List[Case] = [
+    Case("rv64ima5", "example/rv64ima5/test/Main.cpp"),
+    Case("ooo_backend_wide", "example/ooo_backend/test/MainWide.cpp"),
+    Case("ooo_backend_narrow", "example/ooo_backend/test/MainNarrow.cpp"),
+    Case("cachetest", "example/cachetest/TestMain.cpp", "example/cachetest/SimpleCache.hpp"),
+    Case("systolic2d", "example/systolic2d/Main.cpp", "example/systolic2d/Top.hpp"),
+    Case("aes1", "example/aes1/AES1Main.cpp", "example/aes1/AES1.hpp"),
+    Case("array1d", "example/array1d/Main.cpp", "example/array1d/Top.hpp"),
+    Case("querydemo", "example/querydemo/Main.cpp", "example/querydemo/Top.hpp"),
+    Case("prodcon", "example/prodcon/Main.cpp"),
+    Case("mulu32", "example/mulu32/Main.cpp"),
+    Case("queue_mp_demo", "example/queue_mp_demo/test/Main.cpp"),
+]
+
+REPORT_RE = re.compile(r"\[vulsim\] cycles=(\d+) seconds=([0-9.eE+-]+)")
+
+
+def run_timed(cmd: List[str], cwd: str, env=None, input_text: Optional[str] = None):
+    """运行命令，返回 (耗时秒, stdout, stderr)，失败时抛出 RuntimeError。"""
+    start = time.perf_counter()
+    proc = subprocess.run(cmd, cwd=cwd, env=env, input=input_text,
+                          stdout=subprocess.PIPE, stderr=subprocess.PIPE, text=True)
+    elapsed = time.perf_counter() - start
+    if proc.returncode != 0:
+        raise RuntimeError("command failed ({}): {}\n{}{}".format(
+            proc.returncode, " ".join(cmd), proc.stdout[-2000:], proc.stderr[-2000:]))
+    return elapsed, proc.stdout, proc.stderr
+
+
+def run_with_rusage(cmd: List[str], cwd: str, env):
+    """运行仿真程序，返回 (墙钟秒, stderr, 峰值 RSS KiB)。"""
+    start = time.perf_counter()
+    proc = subprocess.Popen(cmd, cwd=cwd, env=env, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+    stderr = proc.stderr.read()
+    proc.stderr.close()
+    # 直接 wait4 该子进程，只取它自己的资源占用
+    _, status, usage = os.wait4(proc.pid, 0)
+    proc.returncode = os.waitstatus_to_exitcode(status)
+    elapsed = time.perf_counter() - start
+    if proc.returncode != 0:
+        raise RuntimeError("simulation exited with {}: {}".format(proc.returncode, stderr[-2000:]))
+    return elapsed, stderr, usage.ru_maxrss
+
+
+def bench_case(case: Case, vulsimgen: str, work_dir: str, cycles: int):
+    out_dir = os.path.join(work_dir, case.name)
+    if os.path.exists(out_dir):
+        shutil.rmtree(out_dir)
+
+    cmd = [vulsimgen, "-m", os.path.join(ROOT_DIR, case.main), "-l", os.path.join(ROOT_DIR, "vullib"), "-o", out_dir]
+    if case.top:
+        cmd += ["-t", os.path.join(ROOT_DIR, case.top)]
+    gen_seconds, _, _ = run_timed(cmd, cwd=ROOT_DIR)
+
+    compile_seconds, _, _ = run_timed(["bash", "release.sh"], cwd=out_dir)
+
+    binary = os.path.join(out_dir, os.path.splitext(os.path.basename(case.main))[0] + "_O3")
+    env = dict(os.environ)
+    env["VULSIM_MAX_CYCLES"] = str(cycles)
+    wall_seconds, stderr, max_rss_kib = run_with_rusage([binary], cwd=out_dir, env=env)
+
+    match = REPORT_RE.search(stderr)
+    if match is None:
+        raise RuntimeError("no cycle report in simulation output")
+    sim_cycles = int(match.group(1))
+    sim_seconds = float(match.group(2))
+    return {
+        "gen_seconds": round(gen_seconds, 4),
+        "compile_seconds": round(compile_seconds, 4),
+        "cycles": sim_cycles,
+        "sim_seconds": round(sim_seconds, 6),
+        "wall_seconds": round(wall_seconds, 4),
+        "cycles_per_sec": round(sim_cycles / sim_seconds, 1) if sim_seconds > 0 else None,
+        "peak_rss_kib": max_rss_kib,
+    }
+
+
+def git_info():
+    def git(*args):
+        try:
+            return subprocess.run(["git", *args], cwd=ROOT_DIR, stdout=subprocess.PIPE,
+                                  stderr=subprocess.DEVNULL, text=True).stdout.strip()
+        except OSError:
+            return ""
+    return {
+        "commit": git("rev-parse", "HEAD"),
+        "subject": git("log", "-1", "--format=%s"),
+        "dirty": bool(git("status", "--porcelain", "--untracked-files=no")),
+    }
+
+
+def load_history(path: str):
+    if not os.path.exists(path):
+        return []
+    with open(path, "r", encoding="utf-8") as f:
+        return json.load(f)
+
+
+def previous_result(history, name: str):
+    for record in reversed(history):
+        result = record.get("results", {}).get(name)
+        if result and result.get("cycles_per_sec"):
+            return result
+    return None
+
+
+def main():
+    parser = argparse.ArgumentParser(description="end-to-end simulation throughput benchmark over example designs")
+    parser.add_argument("--vulsimgen", default=os.path.join(ROOT_DIR, "build", "vulsimgen"))
+    parser.add_argument("--cycles", type=int, default=200000, help="cycle cap per design (VULSIM_MAX_CYCLES)")
+    parser.add_argument("--work-dir", default=os.path.join(ROOT_DIR, "build", "bench", "examples"))
+    parser.add_argument("--history", default=os.path.join(ROOT_DIR, "build", "bench", "examples_history.json"))
+    parser.add_argument("--only", nargs="*", default=[], help="run only cases whose name contains one of these")
+    parser.add_argument("--no-record", action="store_true", help="do not append to the history file")
+    parser.add_argument("--list", action="store_true")
+    args = parser.parse_args()
+
+    cases = [c for c in CASES if not args.only or any(s in c.name for s in args.only)]
+    if args.list:
+        for case in cases:
+            print(case.name)
+        return 0
+    if not os.path.isfile(args.vulsimgen):
+        print("vulsimgen not found: {} (build it first or pass --vulsimgen)".format(args.vulsimgen), file=sys.stderr)
+        return 2
+
+    os.makedirs(args.work_dir, exist_ok=True)
+    history = load_history(args.history)
+
+    results = {}
+    failures = 0
+    print("{:<20} {:>8} {:>9} {:>10} {:>14} {:>10} {:>8}".format(
+        "design", "gen(s)", "build(s)", "cycles", "cycles/sec", "rss(MiB)", "delta"))
+    for case in cases:
+        try:
+            result = bench_case(case, args.vulsimgen, args.work_dir, args.cycles)
+        except RuntimeError as err:
+            failures += 1
+            results[case.name] = {"error": str(err).splitlines()[0]}
+            print("{:<20} FAILED: {}".format(case.name, err), file=sys.stderr)
+            continue
+        results[case.name] = result
+        prev = previous_result(history, case.name)
+        delta = "-"
+        if prev and result["cycles_per_sec"]:
+            delta = "{:+.1f}%".format((result["cycles_per_sec"] / prev["cycles_per_sec"] - 1.0) * 100.0)
+        print("{:<20} {:>8.2f} {:>9.2f} {:>10} {:>14.0f} {:>10.1f} {:>8}".format(
+            case.name, result["gen_seconds"], result["compile_seconds"], result["cycles"],
+            result["cycles_per_sec"] or 0, result["peak_rss_kib"] / 1024.0, delta))
+
+    if not args.no_record:
+        record = {
+            "timestamp": datetime.datetime.now(datetime.timezone.utc).isoformat(timespec="seconds"),
+            "host": os.uname().nodename,
+            "cycles": args.cycles,
+            **git_info(),
+            "results": results,
+        }
+        history.append(record)
+        os.makedirs(os.path.dirname(os.path.abspath(args.history)), exist_ok=True)
+        with open(args.history, "w", encoding="utf-8") as f:
+            json.dump(history, f, indent=2)
+            f.write("\n")
+        print("history appended to {}".format(args.history))
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""VUL 仿真与 Verilator 吞吐对比：对同一个仿真入口分别执行
+vulsimgen -> release.sh 与 vulrtlgen -m -> make（Verilator -O3，可选多线程），
+以相同的 VULSIM_MAX_CYCLES 运行两个程序，比较 cycles/sec。
+
+用法：
+    scripts/bench_verilator.py --only prodcon mulu32
+    scripts/bench_verilator.py --threads 1 4 --cycles 1000000 --json build/bench/verilator.json
+
+用例列表与 scripts/bench_examples.py 共用。两个程序都在结束时向 stderr 输出
+"[vulsim] cycles=N seconds=S"，只统计 simulation() 的执行时间，不含复位与构造。
+"""
+
+import argparse
+import json
+import os
+import re
+import shutil
+import sys
+
+from bench_examples import CASES, REPORT_RE, ROOT_DIR, bench_case, run_timed, run_with_rusage
+
+TOP_RE = re.compile(r"^TOP \?= (\S+)$", re.MULTILINE)
+
+
+def bench_verilator(case, vulrtlgen: str, work_dir: str, cycles: int, threads: int, hier_blocks: str, rtllib: str):
+    out_dir = os.path.join(work_dir, case.name)
+    if os.path.exists(out_dir):
+        shutil.rmtree(out_dir)
+
+    cmd = [vulrtlgen, "-m", os.path.join(ROOT_DIR, case.main), "-l", os.path.join(ROOT_DIR, "vullib"), "-o", out_dir,
+           "--rtllib", rtllib]
+    if case.top:
+        cmd += ["-t", os.path.join(ROOT_DIR, case.top)]
+    gen_seconds, _, _ = run_timed(cmd, cwd=ROOT_DIR)
+
+    make_cmd = ["make", "THREADS={}".format(threads)]
+    if hier_blocks:
+        make_cmd.append("HIER_BLOCKS={}".format(hier_blocks))
+    compile_seconds, _, _ = run_timed(make_cmd, cwd=out_dir)
+
+    with open(os.path.join(out_dir, "Makefile"), "r", encoding="utf-8") as f:
+        match = TOP_RE.search(f.read())
+    if match is None:
+        raise RuntimeError("no TOP in generated Makefile")
+    binary = os.path.join(out_dir, "obj_dir", "V" + match.group(1))
+
+    env = dict(os.environ)
+    env["VULSIM_MAX_CYCLES"] = str(cycles)
+    wall_seconds, stderr, max_rss_kib = run_with_rusage([binary], cwd=out_dir, env=env)
+
+    match = REPORT_RE.search(stderr)
+    if match is None:
+        raise RuntimeError("no cycle report in Verilator output")
+    sim_cycles = int(match.group(1))
+    sim_seconds = float(match.group(2))
+    return {
+        "gen_seconds": round(gen_seconds, 4),
+        "compile_seconds": round(compile_seconds, 4),
+        "cycles": sim_cycles,
+        "sim_seconds": round(sim_seconds, 6),
+        "wall_seconds": round(wall_seconds, 4),
+        "cycles_per_sec": round(sim_cycles / sim_seconds, 1) if sim_seconds > 0 else None,
+        "peak_rss_kib": max_rss_kib,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="compare VUL simulation and Verilator throughput on the same TestMain")
+    parser.add_argument("--vulsimgen", default=os.path.join(ROOT_DIR, "build", "vulsimgen"))
+    parser.add_argument("--vulrtlgen", default=os.path.join(ROOT_DIR, "build", "vulrtlgen"))
+    parser.add_argument("--cycles", type=int, default=200000, help="cycle cap per design (VULSIM_MAX_CYCLES)")
+    parser.add_argument("--threads", type=int, nargs="+", default=[1], help="Verilator --threads values to measure")
+    parser.add_argument("--hier-blocks", default="", help="module names passed to HIER_BLOCKS for hierarchical verilation")
+    parser.add_argument("--rtllib", default="generic", choices=["generic", "verilator"],
+                        help="vullib queue/RAM implementation passed to vulrtlgen --rtllib")
+    parser.add_argument("--work-dir", default=os.path.join(ROOT_DIR, "build", "bench", "verilator"))
+    parser.add_argument("--json", default="", help="write results to this JSON file")
+    parser.add_argument("--only", nargs="*", default=[], help="run only cases whose name contains one of these")
+    args = parser.parse_args()
+
+    for tool in (args.vulsimgen, args.vulrtlgen):
+        if not os.path.isfile(tool):
+            print("tool not found: {} (build it first or pass --vulsimgen/--vulrtlgen)".format(tool), file=sys.stderr)
+            return 2
+    if shutil.which("verilator") is None and not os.environ.get("VERILATOR"):
+        print("verilator not found in PATH", file=sys.stderr)
+        return 2
+
+    cases = [c for c in CASES if not args.only or any(s in c.name for s in args.only)]
+    os.makedirs(args.work_dir, exist_ok=True)
+
+    results = {}
+    failures = 0
+    header = "{:<20} {:>10} {:>14}".format("design", "cycles", "vul c/s")
+    for threads in args.threads:
+        header += " {:>14} {:>7}".format("vl-t{} c/s".format(threads), "ratio")
+    print(header)
+    for case in cases:
+        entry = {}
+        try:
+            entry["vul"] = bench_case(case, args.vulsimgen, os.path.join(args.work_dir, "vul"), args.cycles)
+            for threads in args.threads:
+                entry["verilator_t{}".format(threads)] = bench_verilator(
+                    case, args.vulrtlgen, os.path.join(args.work_dir, "vl_t{}".format(threads)),
+                    args.cycles, threads, args.hier_blocks, args.rtllib)
+        except RuntimeError as err:
+            failures += 1
+            entry["error"] = str(err).splitlines()[0]
+            results[case.name] = entry
+            print("{:<20} FAILED: {}".format(case.name, err), file=sys.stderr)
+            continue
+        results[case.name] = entry
+        vul_rate = entry["vul"]["cycles_per_sec"] or 0
+        line = "{:<20} {:>10} {:>14.0f}".format(case.name, entry["vul"]["cycles"], vul_rate)
+        for threads in args.threads:
+            vl_rate = entry["verilator_t{}".format(threads)]["cycles_per_sec"] or 0
+            ratio = "{:.2f}x".format(vul_rate / vl_rate) if vl_rate else "-"
+            line += " {:>14.0f} {:>7}".format(vl_rate, ratio)
+        print(line)
+
+    if args.json:
+        os.makedirs(os.path.dirname(os.path.abspath(args.json)), exist_ok=True)
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump({"cycles": args.cycles, "threads": args.threads, "results": results}, f, indent=2)
+            f.write("\n")
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
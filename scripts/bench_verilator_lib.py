@@ -0,0 +1,287 @@
+#!/usr/bin/env python3
+"""vullib RTL 库的 Verilator 吞吐基准：对 VulQueue / VulQueueMP / VulBRAM 的每个深度与位宽组合，
+分别用 vullib/queue.sv、ram_generic.sv（generic）与 queue_verilator.sv、ram_verilator.sv（verilator）
+构建同一个由 LFSR 驱动的测试顶层，以 Verilator -O3 编译后运行固定周期数，比较 cycles/sec。
+
+用法：
+    scripts/bench_verilator_lib.py
+    scripts/bench_verilator_lib.py --kinds queue --depths 16 1024 --widths 32 256 --cycles 2000000
+    scripts/bench_verilator_lib.py --json build/bench/verilator_lib.json
+
+两种实现的测试顶层每周期把出队/读出的数据折叠进同一个校验和，校验和不一致说明两者周期行为不同，
+此时脚本返回非零。VERILATOR 环境变量可以指定 verilator 可执行文件。
+"""
+
+import argparse
+import json
+import os
+import re
+import shutil
+import sys
+
+from bench_examples import ROOT_DIR, run_timed
+
+IMPLS = {
+    "generic": ["vullib/ram_generic.sv", "vullib/queue.sv"],
+    "verilator": ["vullib/ram_verilator.sv", "vullib/queue_verilator.sv"],
+}
+
+RESULT_RE = re.compile(r"cycles=(\d+) seconds=([0-9.eE+-]+) checksum=([0-9a-f]+)")
+
+# 公共部分：xorshift64 激励与按 64 位分段折叠的校验和
+TOP_HEAD = """
+module bench_top #(
+    parameter int unsigned Width = 32,
+    parameter int unsigned Depth = 16
+) (
+    input  logic        clk,
+    input  logic        rstn,
+    output logic [63:0] checksum
+);
+
+logic [63:0] rnd;
+logic [63:0] cycle;
+wire  [Width-1:0] rnd_data = Width'({((Width + 63) / 64){rnd}});
+
+function automatic logic [63:0] fold(input logic [Width-1:0] d);
+    logic [63:0] f;
+    f = '0;
+    for (int i = 0; i < Width; i = i + 64) begin
+        f = f ^ 64'(d >> i);
+    end
+    return f;
+endfunction
+
+always_ff @(posedge clk or negedge rstn) begin
+    if (!rstn) begin
+        rnd <= 64'h9e3779b97f4a7c15;
+        cycle <= '0;
+    end else begin
+        logic [63:0] x;
+        x = rnd ^ (rnd << 13);
+        x = x ^ (x >> 7);
+        x = x ^ (x << 17);
+        rnd <= x;
+        cycle <= cycle + 1;
+    end
+end
+
+// 每 4096 个周期在偏入队与偏出队之间切换，让队列在空与满之间往复
+wire fill_phase = cycle[12];
+"""
+
+TOP_BODY = {
+    "queue": """
+logic             enqready;
+logic             deqready;
+logic [Width-1:0] deqnext_data;
+wire              enq_vld = enqready && (fill_phase ? (rnd[0] | rnd[1]) : (rnd[0] & rnd[1]));
+wire              deq_vld = deqready && (fill_phase ? (rnd[2] & rnd[3]) : (rnd[2] | rnd[3]));
+
+VulQueue #(.Width(Width), .Depth(Depth)) u_dut (
+    .clk(clk), .rstn(rstn),
+    .enqready(enqready), .deqready(deqready),
+    .enqnext_vld(enq_vld), .enqnext_data(rnd_data),
+    .deqnext_vld(deq_vld), .deqnext_data(deqnext_data),
+    .clrnext(rnd[63:52] == '0)
+);
+
+always_ff @(posedge clk or negedge rstn) begin
+    if (!rstn) begin
+        checksum <= '0;
+    end else if (deq_vld) begin
+        checksum <= {checksum[62:0], checksum[63]} ^ fold(deqnext_data);
+    end
+end
+""",
+    "queuemp": """
+localparam int unsigned Ports = 4;
+localparam int unsigned CntW = $clog2(Ports + 1);
+
+logic [CntW-1:0]  enqready;
+logic [CntW-1:0]  deqready;
+logic [Width-1:0] enqnext_data [0:Ports-1];
+logic [Width-1:0] deqnext_data [0:Ports-1];
+wire  [CntW-1:0]  enq_num = fill_phase ? CntW'(rnd[1:0]) + CntW'(rnd[2]) : CntW'(rnd[1:0] & rnd[3:2]);
+wire  [CntW-1:0]  deq_num = fill_phase ? CntW'(rnd[5:4] & rnd[7:6]) : CntW'(rnd[5:4]) + CntW'(rnd[6]);
+
+for (genvar i = 0; i < Ports; i = i + 1) begin : g_data
+    assign enqnext_data[i] = rnd_data ^ Width'(i);
+end
+
+VulQueueMP #(.Width(Width), .Depth(Depth), .EnqWidth(Ports), .DeqWidth(Ports)) u_dut (
+    .clk(clk), .rstn(rstn),
+    .enqready(enqready), .deqready(deqready),
+    .enqnext_vld(enq_num), .enqnext_data(enqnext_data),
+    .deqnext_vld(deq_num), .deqnext_data(deqnext_data),
+    .clrnext(rnd[63:52] == '0)
+);
+
+always_ff @(posedge clk or negedge rstn) begin
+    if (!rstn) begin
+        checksum <= '0;
+    end else begin
+        logic [63:0] c;
+        c = {checksum[62:0], checksum[63]} ^ 64'(deqready) ^ (64'(enqready) << 8);
+        for (int i = 0; i < Ports; i = i + 1) begin
+            c = c ^ (fold(deqnext_data[i]) << i);
+        end
+        checksum <= c;
+    end
+end
+""",
+    "ram": """
+localparam int unsigned AddrWidth = (Depth <= 2) ? 1 : $clog2(Depth);
+
+logic                 readreq [1];
+logic [AddrWidth-1:0] readaddr [1];
+logic [Width-1:0]     readdata [1];
+logic                 write [1];
+logic [AddrWidth-1:0] writeaddr [1];
+logic [Width-1:0]     writedata [1];
+
+assign readreq[0] = rnd[0];
+assign readaddr[0] = AddrWidth'(rnd[63:32]);
+assign write[0] = rnd[1];
+assign writeaddr[0] = AddrWidth'(rnd[47:16]);
+assign writedata[0] = rnd_data;
+
+VulBRAM #(.DataWidth(Width), .AddrWidth(AddrWidth), .ReadPorts(1), .WritePorts(1)) u_dut (
+    .clk(clk), .rstn(rstn),
+    .s1_readreq(readreq), .s1_readaddr(readaddr), .s2_readdata(readdata),
+    .s1_write(write), .s1_writeaddr(writeaddr), .s1_writedata(writedata)
+);
+
+always_ff @(posedge clk or negedge rstn) begin
+    if (!rstn) begin
+        checksum <= '0;
+    end else begin
+        checksum <= {checksum[62:0], checksum[63]} ^ fold(readdata[0]);
+    end
+end
+""",
+}
+
+MAIN_CPP = r"""
+#include "Vbench_top.h"
+#include "verilated.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char **argv) {
+    const unsigned long long cycles = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000ULL;
+    VerilatedContext ctx;
+    Vbench_top top{&ctx};
+
+    top.clk = 0;
+    top.rstn = 0;
+    top.eval();
+    top.clk = 1;
+    top.eval();
+    top.clk = 0;
+    top.eval();
+    top.rstn = 1;
+    top.eval();
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long long i = 0; i < cycles; i++) {
+        top.clk = 1;
+        top.eval();
+        top.clk = 0;
+        top.eval();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("cycles=%llu seconds=%.6f checksum=%016llx\n", cycles, seconds, (unsigned long long)top.checksum);
+    top.final();
+    return 0;
+}
+"""
+
+
+def bench_one(verilator: str, work_dir: str, kind: str, impl: str, depth: int, width: int, cycles: int):
+    out_dir = os.path.join(work_dir, "{}_d{}_w{}_{}".format(kind, depth, width, impl))
+    if os.path.exists(out_dir):
+        shutil.rmtree(out_dir)
+    os.makedirs(out_dir)
+    with open(os.path.join(out_dir, "bench_top.sv"), "w", encoding="utf-8") as f:
+        f.write(TOP_HEAD + TOP_BODY[kind] + "\nendmodule\n")
+    with open(os.path.join(out_dir, "main.cpp"), "w", encoding="utf-8") as f:
+        f.write(MAIN_CPP)
+
+    srcs = [os.path.join(ROOT_DIR, p) for p in IMPLS[impl]]
+    cmd = [verilator, "--cc", "--exe", "--build", "-j", str(os.cpu_count() or 1),
+           "--top-module", "bench_top", "-Mdir", "obj_dir", "-o", "Vbench",
+           "-GWidth={}".format(width), "-GDepth={}".format(depth),
+           "-O3", "--x-assign", "fast", "--x-initial", "fast", "--noassert", "-Wno-fatal",
+           "-CFLAGS", "-std=c++20 -O3 -march=native"] + srcs + ["bench_top.sv", "main.cpp"]
+    compile_seconds, _, _ = run_timed(cmd, cwd=out_dir)
+
+    _, stdout, _ = run_timed([os.path.join(out_dir, "obj_dir", "Vbench"), str(cycles)], cwd=out_dir)
+    match = RESULT_RE.search(stdout)
+    if match is None:
+        raise RuntimeError("no result line in benchmark output: " + stdout[-200:])
+    sim_seconds = float(match.group(2))
+    return {
+        "compile_seconds": round(compile_seconds, 4),
+        "sim_seconds": round(sim_seconds, 6),
+        "cycles_per_sec": round(int(match.group(1)) / sim_seconds, 1) if sim_seconds > 0 else None,
+        "checksum": match.group(3),
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="compare generic and Verilator-oriented vullib RTL throughput")
+    parser.add_argument("--kinds", nargs="+", default=["queue", "queuemp", "ram"], choices=sorted(TOP_BODY.keys()))
+    parser.add_argument("--depths", type=int, nargs="+", default=[4, 64, 1024])
+    parser.add_argument("--widths", type=int, nargs="+", default=[32, 256])
+    parser.add_argument("--cycles", type=int, default=1000000)
+    parser.add_argument("--work-dir", default=os.path.join(ROOT_DIR, "build", "bench", "verilator_lib"))
+    parser.add_argument("--json", default="", help="write results to this JSON file")
+    args = parser.parse_args()
+
+    verilator = os.environ.get("VERILATOR") or shutil.which("verilator")
+    if not verilator:
+        print("verilator not found in PATH", file=sys.stderr)
+        return 2
+    os.makedirs(args.work_dir, exist_ok=True)
+
+    results = []
+    failures = 0
+    print("{:<8} {:>6} {:>6} {:>14} {:>14} {:>8}".format("kind", "depth", "width", "generic c/s", "verilator c/s", "speedup"))
+    for kind in args.kinds:
+        for depth in args.depths:
+            for width in args.widths:
+                entry = {"kind": kind, "depth": depth, "width": width}
+                try:
+                    for impl in IMPLS:
+                        entry[impl] = bench_one(verilator, args.work_dir, kind, impl, depth, width, args.cycles)
+                except RuntimeError as err:
+                    failures += 1
+                    entry["error"] = str(err).splitlines()[0]
+                    results.append(entry)
+                    print("{:<8} {:>6} {:>6} FAILED: {}".format(kind, depth, width, err), file=sys.stderr)
+                    continue
+                results.append(entry)
+                generic_rate = entry["generic"]["cycles_per_sec"] or 0
+                verilator_rate = entry["verilator"]["cycles_per_sec"] or 0
+                speedup = "{:.2f}x".format(verilator_rate / generic_rate) if generic_rate else "-"
+                line = "{:<8} {:>6} {:>6} {:>14.0f} {:>14.0f} {:>8}".format(
+                    kind, depth, width, generic_rate, verilator_rate, speedup)
+                if entry["generic"]["checksum"] != entry["verilator"]["checksum"]:
+                    failures += 1
+                    line += "  CHECKSUM MISMATCH"
+                print(line)
+
+    if args.json:
+        os.makedirs(os.path.dirname(os.path.abspath(args.json)), exist_ok=True)
+        with open(args.json, "w", encoding="utf-8") as f:
+            json.dump({"cycles": args.cycles, "results": results}, f, indent=2)
+            f.write("\n")
+
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,37 @@
+#!/usr/bin/env bash
+
+# 构建并运行 vullib 微基准测试。
+#
+# 用法：
+#   scripts/bench_vullib.sh --save-baseline      # 在本机记录基线
+#   scripts/bench_vullib.sh                      # 与基线比较，回退超过容差时返回非零
+#   scripts/bench_vullib.sh --filter regarray    # 其余参数原样传给 vullib_bench
+#
+# 环境变量：
+#   BENCH_BUILD_DIR  构建目录，默认 build/bench
+#   BENCH_BASELINE   基线文件，默认 $BENCH_BUILD_DIR/vullib_bench.baseline
+#   CXX              编译器，默认 g++
+#   BENCH_CXXFLAGS   追加的编译选项，例如 -mbmi2
+
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="${BENCH_BUILD_DIR:-$ROOT_DIR/build/bench}"
+BASELINE="${BENCH_BASELINE:-$BUILD_DIR/vullib_bench.baseline}"
+CXX="${CXX:-g++}"
+
+mkdir -p "$BUILD_DIR"
+"$CXX" -std=c++20 -O2 -DNDEBUG ${BENCH_CXXFLAGS:-} -I"$ROOT_DIR/vullib" \
+    "$ROOT_DIR/vullib/bench/vullib_bench.cpp" -o "$BUILD_DIR/vullib_bench"
+
+if [[ "${1:-}" == "--save-baseline" ]]; then
+    shift
+    exec "$BUILD_DIR/vullib_bench" --save "$BASELINE" "$@"
+fi
+
+if [[ -f "$BASELINE" ]]; then
+    exec "$BUILD_DIR/vullib_bench" --baseline "$BASELINE" "$@"
+fi
+
+echo "no baseline at $BASELINE, run with --save-baseline first to record one" >&2
+exec "$BUILD_DIR/vullib_bench" "$@"
@@ -0,0 +1,72 @@
+#!/usr/bin/env bash
+
+# 以堆分配统计模式（alloctrack.sh）构建各示例，断言预热后仿真热路径中没有任何堆分配。
+#
+# 用法：scripts/test_alloc_steady.sh [输出目录]
+# 环境变量：
+#   VULSIMGEN            vulsimgen 路径，默认使用 build/vulsimgen（不存在时先用 cmake 构建）
+#   VULSIM_ALLOC_WARMUP  预热周期数，默认 10
+#   VULSIM_MAX_CYCLES    每个示例的周期上限，默认 20000
+
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+OUT_DIR="${1:-/tmp/vulsim_alloc_steady_test_$$}"
+
+if [[ -e "$OUT_DIR" ]]; then
+    echo "output directory already exists: $OUT_DIR" >&2
+    echo "choose another path or remove it before running this test" >&2
+    exit 1
+fi
+
+cd "$ROOT_DIR"
+
+VULSIMGEN="${VULSIMGEN:-$ROOT_DIR/build/vulsimgen}"
+if [[ ! -x "$VULSIMGEN" ]]; then
+    cmake -S . -B build >/dev/null
+    cmake --build build --target vulsimgen >/dev/null
+fi
+
+export VULSIM_ALLOC_WARMUP="${VULSIM_ALLOC_WARMUP:-10}"
+export VULSIM_MAX_CYCLES="${VULSIM_MAX_CYCLES:-20000}"
+export VULSIM_ALLOC_STRICT=1
+
+# 名称 仿真入口 [顶层模块]
+CASES=(
+    "rv64ima5 example/rv64ima5/test/Main.cpp"
+    "ooo_backend_wide example/ooo_backend/test/MainWide.cpp"
+    "ooo_backend_narrow example/ooo_backend/test/MainNarrow.cpp"
+    "cachetest example/cachetest/TestMain.cpp example/cachetest/SimpleCache.hpp"
+    "systolic2d example/systolic2d/Main.cpp example/systolic2d/Top.hpp"
+    "aes1 example/aes1/AES1Main.cpp example/aes1/AES1.hpp"
+    "querydemo example/querydemo/Main.cpp example/querydemo/Top.hpp"
+    "prodcon example/prodcon/Main.cpp"
+    "mulu32 example/mulu32/Main.cpp"
+    "queue_mp_demo example/queue_mp_demo/test/Main.cpp"
+)
+
+failed=0
+for entry in "${CASES[@]}"; do
+    read -r name main top <<<"$entry"
+    gen_args=(-m "$ROOT_DIR/$main" -l "$ROOT_DIR/vullib" -o "$OUT_DIR/$name")
+    if [[ -n "${top:-}" ]]; then
+        gen_args+=(-t "$ROOT_DIR/$top")
+    fi
+    "$VULSIMGEN" "${gen_args[@]}" >/dev/null
+    bash "$OUT_DIR/$name/alloctrack.sh" >/dev/null
+
+    binary="$OUT_DIR/$name/$(basename "${main%.*}")_alloc"
+    if (cd "$OUT_DIR/$name" && "$binary" >/dev/null 2>"$OUT_DIR/$name/alloc.log"); then
+        echo "ok    $name"
+    else
+        echo "FAIL  $name" >&2
+        grep '^\[vulsim-alloc\]' "$OUT_DIR/$name/alloc.log" >&2 || true
+        failed=1
+    fi
+done
+
+if [[ "$failed" -ne 0 ]]; then
+    echo "steady-state heap allocations detected" >&2
+    exit 1
+fi
+echo "no steady-state heap allocations"
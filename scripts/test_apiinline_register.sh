@@ -46,7 +46,8 @@ cmake --build build >/dev/null
 HLS="$OUT_DIR/top.logic.cpp"
 
 reject_regex "\\.(setnext|get)\\(" "$HLS"
-reject_regex "\\b(scalar_reg|multi_reg|array_reg|payload_reg|payload_array)\\b" "$HLS"
+reject_regex "\\.(setnext_all|setnext_range)\\(" "$HLS"
+reject_regex "\\b(scalar_reg|multi_reg|array_reg|bulk_reg|payload_reg|payload_array)\\b" "$HLS"
 reject_regex "__vul_reg_wdata\\.at<[^>]+>\\(\\) = value\\." "$HLS"
 
 require_fixed "value = rdata_scalar_reg__.at<31, 0>();" "$HLS"
@@ -75,4 +76,14 @@ require_fixed "value.meta.valid = rdata_payload_array__[2].at<40, 40>();" "$HLS"
 require_fixed "wdata_payload_array__[idx][1] = __vul_reg_wdata;" "$HLS"
 require_fixed "wen_payload_array__[idx][1] = true;" "$HLS"
 
+require_fixed "void __vul_reg_setnext_all_bulk_reg(const uint16_t *src) {" "$HLS"
+require_fixed "    __vul_reg_setnext_bulk_reg<P>(__vul_i, src[__vul_i]);" "$HLS"
+require_fixed "void __vul_reg_setnext_range_bulk_reg(uint32_t lo, uint32_t hi, const uint16_t *src) {" "$HLS"
+require_fixed "    __vul_reg_setnext_bulk_reg<P>(__vul_i, src[__vul_i - lo]);" "$HLS"
+require_fixed "void __vul_reg_setnext_range_payload_array(uint32_t lo, uint32_t hi, const Payload *src) {" "$HLS"
+require_fixed "__vul_reg_setnext_all_bulk_reg<0>(bulk_next);" "$HLS"
+require_fixed "__vul_reg_setnext_all_bulk_reg<1>(bulk_next);" "$HLS"
+require_fixed "__vul_reg_setnext_range_bulk_reg<2>(idx, REG_ARRAY_SIZE, bulk_next);" "$HLS"
+require_fixed "__vul_reg_setnext_range_payload_array<0>(0, 2, payload_fill);" "$HLS"
+
 echo "apiinline register test passed: $HLS"
@@ -0,0 +1,94 @@
+#!/usr/bin/env bash
+
+# 先以两种档位编译运行 vullib/test/storage_profile.cpp，检查 unchecked 档位去掉了寄存器数组的写端口位图；
+# 再以 checked（默认）与 unchecked（vulsimgen --profile unchecked）两种构建档位生成并构建各示例，
+# 断言两者的仿真输出逐行一致，并打印两者的仿真耗时。
+#
+# 用法：scripts/test_unchecked_profile.sh [输出目录]
+# 环境变量：
+#   VULSIMGEN            vulsimgen 路径，默认使用 build/vulsimgen（不存在时先用 cmake 构建）
+#   VULSIM_MAX_CYCLES    每个示例的周期上限，默认 20000
+#   CXX                  编译 storage_profile 测试所用的编译器，默认 g++
+
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+OUT_DIR="${1:-/tmp/vulsim_unchecked_profile_test_$$}"
+
+if [[ -e "$OUT_DIR" ]]; then
+    echo "output directory already exists: $OUT_DIR" >&2
+    echo "choose another path or remove it before running this test" >&2
+    exit 1
+fi
+
+cd "$ROOT_DIR"
+
+VULSIMGEN="${VULSIMGEN:-$ROOT_DIR/build/vulsimgen}"
+if [[ ! -x "$VULSIMGEN" ]]; then
+    cmake -S . -B build >/dev/null
+    cmake --build build --target vulsimgen >/dev/null
+fi
+
+export VULSIM_MAX_CYCLES="${VULSIM_MAX_CYCLES:-20000}"
+
+mkdir -p "$OUT_DIR/storage_profile"
+for profile in checked unchecked; do
+    profile_flags=()
+    if [[ "$profile" == "unchecked" ]]; then
+        profile_flags=(-DVULSIM_UNCHECKED)
+    fi
+    "${CXX:-g++}" -std=c++20 -O1 -I"$ROOT_DIR/vullib" "${profile_flags[@]}" \
+        "$ROOT_DIR/vullib/test/storage_profile.cpp" -o "$OUT_DIR/storage_profile/$profile"
+    "$OUT_DIR/storage_profile/$profile" >/dev/null
+    echo "ok    storage_profile ($profile)"
+done
+
+# 名称 仿真入口 [顶层模块]
+CASES=(
+    "rv64ima5 example/rv64ima5/test/Main.cpp"
+    "ooo_backend_wide example/ooo_backend/test/MainWide.cpp"
+    "ooo_backend_narrow example/ooo_backend/test/MainNarrow.cpp"
+    "cachetest example/cachetest/TestMain.cpp example/cachetest/SimpleCache.hpp"
+    "querydemo example/querydemo/Main.cpp example/querydemo/Top.hpp"
+    "prodcon example/prodcon/Main.cpp"
+    "queue_mp_demo example/queue_mp_demo/test/Main.cpp"
+    "delayline example/delayline/Main.cpp"
+    "cam example/cam/Main.cpp"
+)
+
+# 去掉 [vulsim] 统计行中的耗时，只比较仿真结果
+strip_timing() {
+    sed -E 's/seconds=[0-9.e+-]+//'
+}
+
+failed=0
+for entry in "${CASES[@]}"; do
+    read -r name main top <<<"$entry"
+    binary="$(basename "${main%.*}")_O3"
+    for profile in checked unchecked; do
+        gen_args=(-m "$ROOT_DIR/$main" -l "$ROOT_DIR/vullib" -o "$OUT_DIR/$name/$profile" --profile "$profile")
+        if [[ -n "${top:-}" ]]; then
+            gen_args+=(-t "$ROOT_DIR/$top")
+        fi
+        "$VULSIMGEN" "${gen_args[@]}" >/dev/null
+        bash "$OUT_DIR/$name/$profile/release.sh" >/dev/null
+        (cd "$OUT_DIR/$name/$profile" && "./$binary" >run.log 2>&1) || {
+            echo "FAIL  $name ($profile run)" >&2
+            failed=1
+        }
+    done
+    checked_time="$(grep -o 'seconds=[0-9.e+-]*' "$OUT_DIR/$name/checked/run.log" | tail -1 || true)"
+    unchecked_time="$(grep -o 'seconds=[0-9.e+-]*' "$OUT_DIR/$name/unchecked/run.log" | tail -1 || true)"
+    if diff <(strip_timing <"$OUT_DIR/$name/checked/run.log") <(strip_timing <"$OUT_DIR/$name/unchecked/run.log") >/dev/null; then
+        echo "ok    $name  checked ${checked_time#seconds=}s  unchecked ${unchecked_time#seconds=}s"
+    else
+        echo "FAIL  $name (outputs differ)" >&2
+        failed=1
+    fi
+done
+
+if [[ "$failed" -ne 0 ]]; then
+    echo "checked and unchecked profiles disagree" >&2
+    exit 1
+fi
+echo "checked and unchecked profiles agree"
@@ -5,6 +5,8 @@
 #include "apiinline/apiinline.hpp"
 
 #include "apiinline/bram.hpp"
+#include "apiinline/cam.hpp"
+#include "apiinline/delayline.hpp"
 #include "apiinline/queue.hpp"
 #include "apiinline/register.hpp"
 #include "apiinline/request.hpp"
@@ -27,6 +29,8 @@ InlineCode inlineAPIs(
 ) {
     InlineCode codes = inlineRegisterAPIs(module, bundlelib, logic_hls_codes, logic_hls_debug);
     codes = inlineQueueAPIs(module, bundlelib, codes.lines, codes.debug);
+    codes = inlineDelayLineAPIs(module, bundlelib, codes.lines, codes.debug);
+    codes = inlineCAMAPIs(module, bundlelib, codes.lines, codes.debug);
     codes = inlineMemoryAPIs(module, bundlelib, codes.lines, codes.debug);
     codes = inlineRequestAPIs(module, bundlelib, codes.lines, codes.debug);
     codes = normalizeTemplateLambdaCalls(codes.lines, codes.debug);
@@ -0,0 +1,251 @@
+// MIT License
+
+// Copyright (c) 2026 Meng Chengzhen, in Shandong University
+
+#include "apiinline/cam.hpp"
+
+#include "apiinline/utils.hpp"
+
+#include <sstream>
+#include <unordered_map>
+
+namespace apiinline {
+
+namespace {
+
+struct CAMInfo {
+    const VulStaticCAM *cam = nullptr;
+    uint32_t entries = 1;
+    uint32_t key_width = 0;
+    uint32_t value_width = 0;
+    vector<FlatField> key_fields;
+    vector<FlatField> value_fields;
+    string key_type_str;
+    string value_type_str;
+    string key_default_expr;
+    string value_default_expr;
+    string valid;
+    string keys;
+    string values;
+    string wen;
+    string wvalid;
+    string widx;
+    string wkey;
+    string wvalue;
+    string clrnext;
+};
+
+void emitUnpack(std::ostringstream &os, const string &type_str, const string &default_expr,
+    const vector<FlatField> &fields, const string &packed) {
+    os << "  " << type_str << " value = " << default_expr << ";\n";
+    for (const auto &field : fields) {
+        const string extracted = uintExtractExpr(packed, field.offset + field.width - 1, field.offset);
+        os << "  " << field.name << " = " << unpackFlatFieldValueExpr(field.name, extracted, field) << ";\n";
+    }
+    os << "  return value;\n";
+}
+
+void emitPack(std::ostringstream &os, const vector<FlatField> &fields, const string &target, const string &value_name) {
+    for (const auto &field : fields) {
+        const string value = packFlatFieldValueExpr(flatFieldValueExpr(value_name, field.name), field);
+        os << "  " << uintExtractExpr(target, field.offset + field.width - 1, field.offset) << " = " << value << ";\n";
+    }
+}
+
+string camPortHelpers(const CAMInfo &info) {
+    const string &name = info.cam->name;
+    const string entries = std::to_string(info.entries);
+    std::ostringstream os;
+    os << "bool __vul_cam_valid_" << name << "(uint32_t idx) {\n";
+    os << "  return " << info.valid << "[idx];\n}\n";
+    os << info.key_type_str << " __vul_cam_key_" << name << "(uint32_t idx) {\n";
+    emitUnpack(os, info.key_type_str, info.key_default_expr, info.key_fields, info.keys + "[idx]");
+    os << "}\n";
+    os << info.value_type_str << " __vul_cam_value_" << name << "(uint32_t idx) {\n";
+    emitUnpack(os, info.value_type_str, info.value_default_expr, info.value_fields, info.values + "[idx]");
+    os << "}\n";
+    // 比较器阵列加优先编码器：返回 key 匹配的最小有效下标
+    os << "uint32_t __vul_cam_find_" << name << "(" << info.key_type_str << " key) {\n";
+    os << "  Int<" << info.key_width << "> __vul_cam_packed = 0;\n";
+    emitPack(os, info.key_fields, "__vul_cam_packed", "key");
+    os << "  for (uint32_t i = 0; i < " << entries << "; ++i) {\n";
+    os << "    if (" << info.valid << "[i] && " << info.keys << "[i] == __vul_cam_packed) {\n";
+    os << "      return i;\n";
+    os << "    }\n";
+    os << "  }\n";
+    os << "  return " << entries << ";\n}\n";
+    os << "bool __vul_cam_contains_" << name << "(" << info.key_type_str << " key) {\n";
+    os << "  return __vul_cam_find_" << name << "(key) != " << entries << ";\n}\n";
+    os << "uint32_t __vul_cam_findfree_" << name << "() {\n";
+    os << "  for (uint32_t i = 0; i < " << entries << "; ++i) {\n";
+    os << "    if (!" << info.valid << "[i]) {\n";
+    os << "      return i;\n";
+    os << "    }\n";
+    os << "  }\n";
+    os << "  return " << entries << ";\n}\n";
+    os << "uint32_t __vul_cam_size_" << name << "() {\n";
+    os << "  uint32_t __vul_cam_cnt = 0;\n";
+    os << "  for (uint32_t i = 0; i < " << entries << "; ++i) {\n";
+    os << "    __vul_cam_cnt += " << info.valid << "[i] ? 1 : 0;\n";
+    os << "  }\n";
+    os << "  return __vul_cam_cnt;\n}\n";
+    os << "template <uint32_t P = 0>\n";
+    os << "void __vul_cam_writenext_" << name << "(uint32_t idx, " << info.key_type_str << " key, "
+       << info.value_type_str << " value) {\n";
+    os << "  " << info.wen << "[P] = true;\n";
+    os << "  " << info.wvalid << "[P] = true;\n";
+    os << "  " << info.widx << "[P] = idx;\n";
+    emitPack(os, info.key_fields, info.wkey + "[P]", "key");
+    emitPack(os, info.value_fields, info.wvalue + "[P]", "value");
+    os << "}\n";
+    os << "template <uint32_t P = 0>\n";
+    os << "void __vul_cam_invalidatenext_" << name << "(uint32_t idx) {\n";
+    os << "  " << info.wen << "[P] = true;\n";
+    os << "  " << info.wvalid << "[P] = false;\n";
+    os << "  " << info.widx << "[P] = idx;\n}\n";
+    os << "void __vul_cam_clrnext_" << name << "() {\n";
+    os << "  " << info.clrnext << " = true;\n}\n";
+    return os.str();
+}
+
+bool parseTemplateMethodCall(
+    const string &code,
+    const vector<TokenInfo> &tokens,
+    int object_idx,
+    string &method,
+    string &port_expr,
+    vector<string> &args,
+    int &close_idx
+) {
+    if (object_idx + 2 >= static_cast<int>(tokens.size()) || tokens[object_idx + 1].spelling != ".") {
+        return false;
+    }
+    int cursor = object_idx + 2;
+    if (tokens[cursor].spelling == "template") {
+        ++cursor;
+    }
+    if (cursor >= static_cast<int>(tokens.size())) {
+        return false;
+    }
+    method = tokens[cursor].spelling;
+    ++cursor;
+    port_expr.clear();
+    if (cursor < static_cast<int>(tokens.size()) && tokens[cursor].spelling == "<") {
+        int close_angle = findMatching(tokens, cursor, "<", ">");
+        if (close_angle < 0) {
+            return false;
+        }
+        if (cursor + 1 <= close_angle - 1) {
+            port_expr = sourceBetween(code, tokens[cursor + 1], tokens[close_angle - 1]);
+        }
+        cursor = close_angle + 1;
+    }
+    if (cursor >= static_cast<int>(tokens.size()) || tokens[cursor].spelling != "(") {
+        return false;
+    }
+    close_idx = findMatching(tokens, cursor, "(", ")");
+    if (close_idx < 0) {
+        return false;
+    }
+    args = splitTopLevelArgs(code, tokens, cursor + 1, close_idx - 1);
+    return true;
+}
+
+} // namespace
+
+InlineCode inlineCAMAPIs(
+    const VulStaticModuleInstance &module,
+    const VulStaticBundleLib &bundlelib,
+    const vector<string> &logic_hls_codes,
+    const VulDebugLocs &logic_hls_debug
+) {
+    unordered_map<string, CAMInfo> cams;
+    for (const auto &cam : module.cams) {
+        CAMInfo info;
+        info.cam = &cam;
+        info.entries = static_cast<uint32_t>(cam.entries);
+        info.key_type_str = cam.key_type.toString();
+        info.value_type_str = cam.value_type.toString();
+        flatten_type_signature(cam.key_type, bundlelib, "value", info.key_width, info.key_fields);
+        flatten_type_signature(cam.value_type, bundlelib, "value", info.value_width, info.value_fields);
+        info.key_default_expr = defaultValueExprForType(cam.key_type, bundlelib);
+        info.value_default_expr = defaultValueExprForType(cam.value_type, bundlelib);
+        info.valid = cam.name + "__valid__";
+        info.keys = cam.name + "__key__";
+        info.values = cam.name + "__value__";
+        info.wen = cam.name + "__wen__";
+        info.wvalid = cam.name + "__wvalid__";
+        info.widx = cam.name + "__widx__";
+        info.wkey = cam.name + "__wkey__";
+        info.wvalue = cam.name + "__wvalue__";
+        info.clrnext = cam.name + "__clrnext__";
+        cams[cam.name] = std::move(info);
+    }
+    if (cams.empty()) {
+        return {logic_hls_codes, logic_hls_debug};
+    }
+
+    string code = joinLines(logic_hls_codes);
+    vector<TokenInfo> tokens = tokenizeWithLibclang(code);
+    vector<Replacement> repls;
+    string helper_defs;
+    for (const auto &[name, info] : cams) {
+        helper_defs += camPortHelpers(info);
+        helper_defs += "\n";
+    }
+    size_t logic_func_pos = findLogicSubmoduleFunctionStart(code);
+    if (logic_func_pos != string::npos) {
+        repls.push_back(Replacement{
+            static_cast<uint32_t>(logic_func_pos),
+            static_cast<uint32_t>(logic_func_pos),
+            helper_defs
+        });
+    }
+    for (int i = 0; i < static_cast<int>(tokens.size()); ++i) {
+        if (logic_func_pos != string::npos && tokens[i].start < logic_func_pos) {
+            continue;
+        }
+        auto it = cams.find(tokens[i].spelling);
+        if (it == cams.end() || tokens[i].kind != CXToken_Identifier) {
+            continue;
+        }
+        const CAMInfo &info = it->second;
+        string method;
+        string port_expr;
+        vector<string> args;
+        int close_idx = -1;
+        if (!parseTemplateMethodCall(code, tokens, i, method, port_expr, args, close_idx)) {
+            continue;
+        }
+        if (method != "valid" && method != "key" && method != "value" && method != "find" &&
+            method != "contains" && method != "findfree" && method != "size" &&
+            method != "writenext" && method != "invalidatenext" && method != "clrnext") {
+            continue;
+        }
+        string text = "__vul_cam_" + method + "_" + info.cam->name;
+        if (!port_expr.empty()) {
+            text += "<" + port_expr + ">";
+        }
+        text += "(";
+        for (size_t arg = 0; arg < args.size(); ++arg) {
+            if (arg != 0) text += ", ";
+            text += args[arg];
+        }
+        text += ")";
+        if (!overlapsExisting(repls, tokens[i].start, tokens[close_idx].end)) {
+            repls.push_back(Replacement{tokens[i].start, tokens[close_idx].end, text});
+        }
+    }
+
+    return applyReplacementsWithDebug(logic_hls_codes, logic_hls_debug, std::move(repls));
+}
+
+vector<string> inlineCAMAPIs(
+    const VulStaticModuleInstance &module,
+    const VulStaticBundleLib &bundlelib,
+    const vector<string> &logic_hls_codes
+) {
+    return inlineCAMAPIs(module, bundlelib, logic_hls_codes, {}).lines;
+}
+
+} // namespace apiinline
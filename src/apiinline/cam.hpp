@@ -0,0 +1,26 @@
+// MIT License
+
+// Copyright (c) 2026 Meng Chengzhen, in Shandong University
+
+#pragma once
+
+#include "bundlelib.h"
+#include "module.h"
+#include "apiinline/utils.hpp"
+
+namespace apiinline {
+
+vector<string> inlineCAMAPIs(
+    const VulStaticModuleInstance &module,
+    const VulStaticBundleLib &bundlelib,
+    const vector<string> &logic_hls_codes
+);
+
+InlineCode inlineCAMAPIs(
+    const VulStaticModuleInstance &module,
+    const VulStaticBundleLib &bundlelib,
+    const vector<string> &logic_hls_codes,
+    const VulDebugLocs &logic_hls_debug
+);
+
+} // namespace apiinline
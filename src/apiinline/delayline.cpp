@@ -0,0 +1,212 @@
+// MIT License
+
+// Copyright (c) 2026 Meng Chengzhen, in Shandong University
+
+#include "apiinline/delayline.hpp"
+
+#include "apiinline/utils.hpp"
+
+#include <sstream>
+#include <unordered_map>
+
+namespace apiinline {
+
+namespace {
+
+struct DelayLineInfo {
+    const VulStaticDelayLine *line = nullptr;
+    bool is_mp = false;
+    uint32_t width = 1;
+    uint32_t data_width = 0;
+    vector<FlatField> fields;
+    string type_str;
+    string helper_name;
+    string pushvld;
+    string pushdata;
+    string outvld;
+    string outdata;
+    string clrnext;
+    string default_expr;
+};
+
+string unpackValueHelper(const DelayLineInfo &info) {
+    std::ostringstream os;
+    os << info.type_str << " " << info.helper_name
+       << "(const Int<" << info.data_width << "> &__vul_delayline_packed) {\n";
+    os << "  " << info.type_str << " value = " << info.default_expr << ";\n";
+    for (const auto &field : info.fields) {
+        const string extracted = uintExtractExpr("__vul_delayline_packed", field.offset + field.width - 1, field.offset);
+        os << "  " << field.name << " = "
+           << unpackFlatFieldValueExpr(field.name, extracted, field) << ";\n";
+    }
+    os << "  return value;\n";
+    os << "}\n";
+    return os.str();
+}
+
+void emitPackValue(std::ostringstream &os, const DelayLineInfo &info, const string &indent, const string &target, const string &value_name) {
+    os << indent << "Int<" << info.data_width << "> __vul_delayline_packed = 0;\n";
+    for (const auto &field : info.fields) {
+        const string value = packFlatFieldValueExpr(flatFieldValueExpr(value_name, field.name), field);
+        os << indent << uintExtractExpr("__vul_delayline_packed", field.offset + field.width - 1, field.offset)
+           << " = " << value << ";\n";
+    }
+    os << indent << target << " = __vul_delayline_packed;\n";
+}
+
+string delayLinePortHelpers(const DelayLineInfo &info) {
+    const string &name = info.line->name;
+    std::ostringstream os;
+    if (!info.is_mp) {
+        os << "bool __vul_delayline_outvalid_" << name << "() {\n";
+        os << "  return " << info.outvld << ";\n}\n";
+        os << info.type_str << " __vul_delayline_out_" << name << "() {\n";
+        os << "  return " << info.helper_name << "(" << info.outdata << ");\n}\n";
+        os << "void __vul_delayline_pushnext_" << name << "(" << info.type_str << " value) {\n";
+        emitPackValue(os, info, "  ", info.pushdata, "value");
+        os << "  " << info.pushvld << " = true;\n}\n";
+    } else {
+        os << "uint32_t __vul_delayline_outvalid_" << name << "() {\n";
+        os << "  return " << info.outvld << ";\n}\n";
+        os << "std::array<" << info.type_str << ", " << info.width << "> __vul_delayline_out_" << name << "() {\n";
+        os << "  std::array<" << info.type_str << ", " << info.width << "> __vul_delayline_values = {};\n";
+        for (uint32_t i = 0; i < info.width; ++i) {
+            os << "  if (" << info.outvld << " > " << i << ") {\n";
+            os << "    __vul_delayline_values[" << i << "] = "
+               << info.helper_name << "(" << info.outdata << "[" << i << "]);\n";
+            os << "  }\n";
+        }
+        os << "  return __vul_delayline_values;\n}\n";
+        os << "void __vul_delayline_pushnext_" << name
+           << "(std::array<" << info.type_str << ", " << info.width
+           << "> values, uint32_t num = " << info.width << ") {\n";
+        os << "  uint32_t __vul_delayline_req = num < " << info.width << " ? num : " << info.width << ";\n";
+        for (uint32_t i = 0; i < info.width; ++i) {
+            os << "  if (__vul_delayline_req > " << i << ") {\n";
+            os << "    " << info.type_str << " __vul_delayline_value = values[" << i << "];\n";
+            emitPackValue(os, info, "    ", info.pushdata + "[" + std::to_string(i) + "]", "__vul_delayline_value");
+            os << "  }\n";
+        }
+        os << "  " << info.pushvld << " = __vul_delayline_req;\n}\n";
+    }
+    os << "void __vul_delayline_clrnext_" << name << "() {\n";
+    os << "  " << info.clrnext << " = true;\n}\n";
+    return os.str();
+}
+
+bool parseMethodCall(
+    const string &code,
+    const vector<TokenInfo> &tokens,
+    int object_idx,
+    string &method,
+    vector<string> &args,
+    int &close_idx
+) {
+    if (object_idx + 2 >= static_cast<int>(tokens.size()) || tokens[object_idx + 1].spelling != ".") {
+        return false;
+    }
+    int method_idx = object_idx + 2;
+    method = tokens[method_idx].spelling;
+    int open_idx = method_idx + 1;
+    if (open_idx >= static_cast<int>(tokens.size()) || tokens[open_idx].spelling != "(") {
+        return false;
+    }
+    close_idx = findMatching(tokens, open_idx, "(", ")");
+    if (close_idx < 0) {
+        return false;
+    }
+    args = splitTopLevelArgs(code, tokens, open_idx + 1, close_idx - 1);
+    return true;
+}
+
+} // namespace
+
+InlineCode inlineDelayLineAPIs(
+    const VulStaticModuleInstance &module,
+    const VulStaticBundleLib &bundlelib,
+    const vector<string> &logic_hls_codes,
+    const VulDebugLocs &logic_hls_debug
+) {
+    unordered_map<string, DelayLineInfo> lines;
+    for (const auto &line : module.delay_lines) {
+        DelayLineInfo info;
+        info.line = &line;
+        info.is_mp = line.width > 1;
+        info.width = static_cast<uint32_t>(line.width);
+        info.type_str = line.type.toString();
+        flatten_type_signature(line.type, bundlelib, "value", info.data_width, info.fields);
+        info.default_expr = defaultValueExprForType(line.type, bundlelib);
+        info.helper_name = "__vul_delayline_unpack_" + line.name;
+        info.pushvld = line.name + "__pushvld__";
+        info.pushdata = line.name + "__pushdata__";
+        info.outvld = line.name + "__outvld__";
+        info.outdata = line.name + "__outdata__";
+        info.clrnext = line.name + "__clrnext__";
+        lines[line.name] = std::move(info);
+    }
+    if (lines.empty()) {
+        return {logic_hls_codes, logic_hls_debug};
+    }
+
+    string code = joinLines(logic_hls_codes);
+    vector<TokenInfo> tokens = tokenizeWithLibclang(code);
+    vector<Replacement> repls;
+    string helper_defs;
+    for (const auto &[name, info] : lines) {
+        helper_defs += unpackValueHelper(info);
+        helper_defs += "\n";
+        helper_defs += delayLinePortHelpers(info);
+        helper_defs += "\n";
+    }
+    size_t logic_func_pos = findLogicSubmoduleFunctionStart(code);
+    if (logic_func_pos != string::npos) {
+        repls.push_back(Replacement{
+            static_cast<uint32_t>(logic_func_pos),
+            static_cast<uint32_t>(logic_func_pos),
+            helper_defs
+        });
+    }
+    for (int i = 0; i < static_cast<int>(tokens.size()); ++i) {
+        if (logic_func_pos != string::npos && tokens[i].start < logic_func_pos) {
+            continue;
+        }
+        auto it = lines.find(tokens[i].spelling);
+        if (it == lines.end() || tokens[i].kind != CXToken_Identifier) {
+            continue;
+        }
+        const DelayLineInfo &info = it->second;
+        string method;
+        vector<string> args;
+        int close_idx = -1;
+        if (!parseMethodCall(code, tokens, i, method, args, close_idx)) {
+            continue;
+        }
+        if (method != "outvalid" && method != "out" && method != "pushnext" && method != "clrnext") {
+            continue;
+        }
+        // out(num) 的参数只用于接口对齐，展开时丢弃
+        string text = "__vul_delayline_" + method + "_" + info.line->name + "(";
+        if (method == "pushnext") {
+            for (size_t arg = 0; arg < args.size(); ++arg) {
+                if (arg != 0) text += ", ";
+                text += args[arg];
+            }
+        }
+        text += ")";
+        if (!overlapsExisting(repls, tokens[i].start, tokens[close_idx].end)) {
+            repls.push_back(Replacement{tokens[i].start, tokens[close_idx].end, text});
+        }
+    }
+
+    return applyReplacementsWithDebug(logic_hls_codes, logic_hls_debug, std::move(repls));
+}
+
+vector<string> inlineDelayLineAPIs(
+    const VulStaticModuleInstance &module,
+    const VulStaticBundleLib &bundlelib,
+    const vector<string> &logic_hls_codes
+) {
+    return inlineDelayLineAPIs(module, bundlelib, logic_hls_codes, {}).lines;
+}
+
+} // namespace apiinline
@@ -89,6 +89,24 @@ string registerWriteHelper(const RegisterInfo &info) {
     os << "  " << info.wdata_port << idx << port << " = __vul_reg_wdata;\n";
     os << "  " << info.wen_port << idx << port << " = true;\n";
     os << "}\n";
+    if (is_array) {
+        // bulk writes lower to per-index writes of the same port
+        const string setnext = "__vul_reg_setnext_" + info.reg->name + "<P>";
+        os << "template <uint32_t P = 0>\n";
+        os << "void __vul_reg_setnext_all_" << info.reg->name << "(const "
+           << info.type_str << " *src) {\n";
+        os << "  for (uint32_t __vul_i = 0; __vul_i < " << info.reg->dims[0] << "; ++__vul_i) {\n";
+        os << "    " << setnext << "(__vul_i, src[__vul_i]);\n";
+        os << "  }\n";
+        os << "}\n";
+        os << "template <uint32_t P = 0>\n";
+        os << "void __vul_reg_setnext_range_" << info.reg->name
+           << "(uint32_t lo, uint32_t hi, const " << info.type_str << " *src) {\n";
+        os << "  for (uint32_t __vul_i = lo; __vul_i < hi; ++__vul_i) {\n";
+        os << "    " << setnext << "(__vul_i, src[__vul_i - lo]);\n";
+        os << "  }\n";
+        os << "}\n";
+    }
     return os.str();
 }
 
@@ -317,6 +335,8 @@ InlineCode inlineRegisterAPIs(
             }
             if (cursor < static_cast<int>(tokens.size()) &&
                 (tokens[cursor].spelling == "setnext" ||
+                 tokens[cursor].spelling == "setnext_all" ||
+                 tokens[cursor].spelling == "setnext_range" ||
                  tokens[cursor].spelling == "holdnext" ||
                  tokens[cursor].spelling == "resetnext")) {
                 method_idx = cursor;
@@ -326,7 +346,8 @@ InlineCode inlineRegisterAPIs(
             const string method_name = tokens[method_idx].spelling;
             string port_expr = "0";
             int open_idx = method_idx + 1;
-            if (method_name == "setnext" && open_idx < static_cast<int>(tokens.size()) && tokens[open_idx].spelling == "<") {
+            const bool is_setnext = (method_name.rfind("setnext", 0) == 0);
+            if (is_setnext && open_idx < static_cast<int>(tokens.size()) && tokens[open_idx].spelling == "<") {
                 int close_angle = findMatching(tokens, open_idx, "<", ">");
                 if (close_angle >= 0) {
                     if (open_idx + 1 <= close_angle - 1) {
@@ -361,6 +382,26 @@ InlineCode inlineRegisterAPIs(
                         }
                         continue;
                     }
+                    if (method_name == "setnext_all" || method_name == "setnext_range") {
+                        const size_t argc = (method_name == "setnext_all") ? 1 : 3;
+                        if (!is_array || args.size() != argc) {
+                            continue;
+                        }
+                        if (!overlapsExisting(repls, tokens[i].start, tokens[close_idx].end)) {
+                            string call = "__vul_reg_" + method_name + "_" + info.reg->name;
+                            call += "<" + port_expr + ">(";
+                            for (size_t a = 0; a < args.size(); ++a) {
+                                call += (a ? ", " : "") + inlineRegisterReadsInExpr(args[a], registers);
+                            }
+                            call += ")";
+                            repls.push_back(Replacement{
+                                tokens[i].start,
+                                tokens[close_idx].end,
+                                call
+                            });
+                        }
+                        continue;
+                    }
                     string idx_expr;
                     string value_expr;
                     if (is_array && args.size() >= 2) {
@@ -338,6 +338,7 @@ static VulStaticQuery staticalizeQuery(const VulTempQuery &item, const VulStatic
     VulStaticQuery query;
     query.name = item.name;
     query.ret_type = parseTypeSignature(item.ret_type, config_lib);
+    query.cached = item.cached;
     return query;
 }
 
@@ -513,6 +514,48 @@ void instantiateModule(
         instance.queues.push_back(std::move(static_queue));
     }
 
+    // delay lines
+    for (const auto &line : temp.delay_lines) {
+        VulErrorContextGuard _err{"Processing delay line '" + line.name + "'"};
+        VulStaticDelayLine static_line;
+        static_line.name = line.name;
+        static_line.type = parseTypeSignature(line.type, local_config_lib);
+        static_line.latency = calculateConstexprValue(line.latency, local_config_lib);
+        if (static_line.latency < 1) {
+            throw VulException("Delay line latency must be at least 1");
+        }
+        static_line.width = line.width.empty() ? 1 : calculateConstexprValue(line.width, local_config_lib);
+        if (static_line.width < 1) {
+            throw VulException("Delay line width must be at least 1");
+        }
+        instance.delay_lines.push_back(std::move(static_line));
+    }
+
+    // CAMs
+    for (const auto &cam : temp.cams) {
+        VulErrorContextGuard _err{"Processing CAM '" + cam.name + "'"};
+        VulStaticCAM static_cam;
+        static_cam.name = cam.name;
+        static_cam.key_type = parseTypeSignature(cam.key_type, local_config_lib);
+        static_cam.value_type = parseTypeSignature(cam.value_type, local_config_lib);
+        const auto &key_sig = static_cam.key_type;
+        const bool key_is_uint = key_sig.uint_length > 0;
+        const bool key_is_basic = key_sig.uint_length <= 0 && isBasicVulType(key_sig.type) && key_sig.type.find("128") == string::npos;
+        if (!key_is_uint && !key_is_basic) {
+            throw VulException("CAM key must be an integer type or UInt<N>, got '" + key_sig.toString() + "'");
+        }
+        static_cam.entries = calculateConstexprValue(cam.entries, local_config_lib);
+        if (static_cam.entries < 1) {
+            throw VulException("CAM entries must be at least 1");
+        }
+        static_cam.index_width = static_cast<ConfigRealValue>(std::max<uint64_t>(1, log2ceil(static_cast<uint64_t>(static_cam.entries) + 1)));
+        static_cam.write_ports = calculateConstexprValue(cam.write_ports, local_config_lib);
+        if (static_cam.write_ports < 1) {
+            throw VulException("CAM write ports must be at least 1");
+        }
+        instance.cams.push_back(std::move(static_cam));
+    }
+
     // instances
     for (const auto &inst : temp.instances) {
         VulErrorContextGuard _err{"Processing instance '" + inst.name + "'"};
@@ -819,6 +862,44 @@ void instantiateModule(
     // helper codes
     instance.helper_codes = temp.helper_codes;
     instance.helper_codes_debug = temp.helper_codes_debug;
+
+    // clock ratio: services are only accepted on active edges, so callers in the faster domain need a handshake to retry
+    if (!temp.clock_ratio.empty()) {
+        VulErrorContextGuard _err{"Processing CLOCK_RATIO"};
+        instance.clock_ratio = calculateConstexprValue(temp.clock_ratio, local_config_lib);
+        if (instance.clock_ratio < 1) {
+            throw VulException("CLOCK_RATIO must be at least 1, got " + std::to_string(instance.clock_ratio));
+        }
+        if (instance.clock_ratio > 1) {
+            for (const auto &serv_entry : instance.services) {
+                if (!serv_entry.second.has_handshake) {
+                    throw VulException("Service '" + serv_entry.first + "' of a module with CLOCK_RATIO(" + std::to_string(instance.clock_ratio) +
+                        ") must be declared with SERVICE_READY or SERVICE_PRIO_READY, callers in the faster clock domain retry until an active edge");
+                }
+            }
+        }
+    }
+
+    // quiescent timers: skipping idle cycles rewrites the pending countdown value, so only scalar integer registers qualify
+    for (const auto &timer_name : temp.quiescent_timers) {
+        VulErrorContextGuard _err{"Processing QUIESCENT_TIMER '" + timer_name + "'"};
+        auto reg_it = std::find_if(instance.registers.begin(), instance.registers.end(), [&](const VulStaticRegister &reg) {
+            return reg.name == timer_name;
+        });
+        if (reg_it == instance.registers.end()) {
+            throw VulException("QUIESCENT_TIMER '" + timer_name + "' does not name a REGISTER of module '" + temp.name + "'");
+        }
+        if (!reg_it->dims.empty()) {
+            throw VulException("QUIESCENT_TIMER '" + timer_name + "' must be a scalar register, register arrays are not supported");
+        }
+        const auto &sig = reg_it->signature;
+        const bool is_uint = sig.uint_length > 0 && sig.uint_length <= 64;
+        const bool is_basic = sig.uint_length <= 0 && isBasicVulType(sig.type) && sig.type != "bool" && sig.type.find("128") == string::npos;
+        if (!is_uint && !is_basic) {
+            throw VulException("QUIESCENT_TIMER '" + timer_name + "' must have an integer type of at most 64 bits, got '" + sig.toString() + "'");
+        }
+        instance.quiescent_timers.insert(timer_name);
+    }
 }
 
 void detectRequestCallInLogicBlocks(VulStaticModuleInstance &module_instance) {
@@ -221,6 +221,7 @@ struct VulTempServ : public VulTempReqServBase {
 struct VulTempQuery {
     string name;
     string ret_type;
+    bool cached = false; // QUERY_CACHED: result memoized within one cycle
     vector<string> codelines;
     VulDebugLocs codelines_debug;
 };
@@ -272,6 +273,21 @@ struct VulTempQueue {
     string deq_width;
 };
 
+struct VulTempDelayLine {
+    string name;
+    string type;
+    string latency;
+    string width; // DELAY_LINE 为空
+};
+
+struct VulTempCAM {
+    string name;
+    string key_type;
+    string value_type;
+    string entries;
+    string write_ports;
+};
+
 struct VulTempModule {
     string name;
     string filepath;
@@ -286,6 +302,8 @@ struct VulTempModule {
     vector<VulTempBRAM> brams;
     vector<VulTempDigitalROM> roms;
     vector<VulTempQueue> queues;
+    vector<VulTempDelayLine> delay_lines;
+    vector<VulTempCAM> cams;
     vector<VulTempInstance> instances;
     vector<VulTempTickBlock> tick_blocks;
     vector<VulTempTickBlockDebug> tick_blocks_debug;
@@ -294,6 +312,8 @@ struct VulTempModule {
     vector<VulTempChildQueryUse> child_query_uses;
     vector<string> helper_codes;
     VulDebugLocs helper_codes_debug;
+    string clock_ratio; // CLOCK_RATIO 表达式，未声明时为空
+    vector<string> quiescent_timers; // QUIESCENT_TIMER 声明的寄存器名
 };
 
 using VulTempModuleCache = std::unordered_map<string, VulTempModule>; // map from module name to its parsed temp module
@@ -439,6 +459,7 @@ VulStaticReqServ staticalizeReqServ(const VulTempReqServBase &item, const VulSta
 struct VulStaticQuery {
     ReqServName name;
     VulStaticTypeSignature ret_type;
+    bool cached = false;
 };
 
 struct VulStaticRegister {
@@ -483,6 +504,22 @@ struct VulStaticQueue {
     ConfigRealValue deq_width;
 };
 
+struct VulStaticDelayLine {
+    InstanceName name;
+    VulStaticTypeSignature type;
+    ConfigRealValue latency;
+    ConfigRealValue width; // 大于 1 时使用多端口接口
+};
+
+struct VulStaticCAM {
+    InstanceName name;
+    VulStaticTypeSignature key_type;
+    VulStaticTypeSignature value_type;
+    ConfigRealValue entries;
+    ConfigRealValue index_width;
+    ConfigRealValue write_ports;
+};
+
 struct VulStaticModuleInstance {
 
     inline vector<string> normalizedInstancePath() const {
@@ -572,6 +609,8 @@ struct VulStaticModuleInstance {
     vector<VulStaticBRAM> brams;
     vector<VulStaticDigitalROM> roms;
     vector<VulStaticQueue> queues;
+    vector<VulStaticDelayLine> delay_lines;
+    vector<VulStaticCAM> cams;
 
     unordered_map<ReqServName, VulLogicBlock> serv_logic_blocks;
     unordered_map<ReqServName, VulLogicBlock> query_logic_blocks;
@@ -590,6 +629,12 @@ struct VulStaticModuleInstance {
 
     InstanceName instance_decl_name; // empty for top / synthetic instances
     vector<ConfigRealValue> instance_array_indices; // empty for scalar instance or top
+
+    // 父模块每 clock_ratio 个周期本实例及其子树执行一个周期，1 表示与父模块同频
+    ConfigRealValue clock_ratio = 1;
+
+    // 静默跳过时只允许倒计数的寄存器，模块逻辑只依赖其是否为 0
+    unordered_set<BMemberName> quiescent_timers;
 };
 
 void instantiateModule(
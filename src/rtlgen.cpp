@@ -83,6 +83,8 @@ struct RTLGenContext {
     vector<string> rtl_inst;  // RTL框架模块的实例化代码，主要是子模块的实例化和连接
     vector<string> rtl_logicports;  // RTL框架中实例化逻辑子模块时连接的端口代码，每个一行，没有逗号或换行
 
+    string clk_name = "clk";  // 本模块寄存器、存储与子实例使用的时钟，CLOCK_RATIO 分频时为门控后的时钟
+
     vector<string> resource_files;
 };
 
@@ -547,6 +549,50 @@ void _procConstAndBundle(RTLGenContext &ctx){
     }
 };
 
+constexpr const char *ClockEnablePort = "clk_en__";
+
+void _procClockRatio(RTLGenContext &ctx) {
+    const ConfigRealValue ratio = ctx.module.clock_ratio;
+    if (ratio <= 1) {
+        return;
+    }
+    VulErrorContextGuard guard("processing clock ratio");
+
+    uint32_t width = 1;
+    while ((ConfigRealValue(1) << width) < ratio) {
+        ++width;
+    }
+    const string w = std::to_string(width);
+    const string phase = "clk_phase__";
+    const string latch = "clk_en_latch__";
+    ctx.clk_name = "clk_div__";
+
+    // 相位计数器在父时钟上计数，相位为 0 的周期是有效沿；寄存器、存储与子实例使用门控后的时钟
+    ctx.rtl_decl.push_back("reg [" + std::to_string(width - 1) + ":0] " + phase + ";\n");
+    ctx.rtl_decl.push_back("reg " + latch + ";\n");
+    ctx.rtl_decl.push_back("wire " + string(ClockEnablePort) + ";\n");
+    ctx.rtl_decl.push_back("wire " + ctx.clk_name + ";\n");
+    ctx.rtl_logic.push_back("assign " + string(ClockEnablePort) + " = (" + phase + " == " + w + "'d0);\n");
+    ctx.rtl_logic.push_back("always @(posedge clk) begin\n");
+    ctx.rtl_logic.push_back("  if (rstn == 0) begin\n");
+    ctx.rtl_logic.push_back("    " + phase + " <= " + w + "'d0;\n");
+    ctx.rtl_logic.push_back("  end else begin\n");
+    ctx.rtl_logic.push_back("    " + phase + " <= (" + phase + " == " + w + "'d" + std::to_string(ratio - 1) + ") ? " + w + "'d0 : " + phase + " + " + w + "'d1;\n");
+    ctx.rtl_logic.push_back("  end\n");
+    ctx.rtl_logic.push_back("end\n");
+    // 时钟低电平时锁存使能，门控时钟不产生毛刺
+    ctx.rtl_logic.push_back("always_latch begin\n");
+    ctx.rtl_logic.push_back("  if (!clk) " + latch + " = " + string(ClockEnablePort) + ";\n");
+    ctx.rtl_logic.push_back("end\n");
+    ctx.rtl_logic.push_back("assign " + ctx.clk_name + " = clk & " + latch + ";\n");
+
+    // 逻辑子模块据此屏蔽非有效沿上的服务握手与 tick
+    if (!ctx.module.tick_blocks.empty() || !ctx.module.services.empty()) {
+        ctx.hls_arguments.push_back("const bool " + string(ClockEnablePort));
+        ctx.rtl_logicports.push_back("." + string(ClockEnablePort) + "(" + string(ClockEnablePort) + ")");
+    }
+}
+
 void _procWires(RTLGenContext &ctx) {
     VulErrorContextGuard guard("processing wires");
 
@@ -816,7 +862,7 @@ void _procRegisters(RTLGenContext &ctx) {
             }
 
             // generate always block for register update
-            ctx.rtl_logic.push_back("always @(posedge clk) begin\n");
+            ctx.rtl_logic.push_back("always @(posedge " + ctx.clk_name + ") begin\n");
             ctx.rtl_logic.push_back("  if (rstn == 0) begin\n");
             ctx.rtl_logic.push_back("    " + reg_decl_name + " <= " + resetvalue_wire_name + ";\n");
             ctx.rtl_logic.push_back("  end else begin\n");
@@ -853,7 +899,7 @@ void _procRegisters(RTLGenContext &ctx) {
             }
 
             // generate always block for register update
-            ctx.rtl_logic.push_back("always @(posedge clk) begin\n");
+            ctx.rtl_logic.push_back("always @(posedge " + ctx.clk_name + ") begin\n");
             ctx.rtl_logic.push_back("  if (rstn == 0) begin\n");
             ctx.rtl_logic.push_back("    for (int i = 0; i < " + size_str + "; i++) begin\n");
             ctx.rtl_logic.push_back("      " + reg_decl_name + "[i] <= " + resetvalue_wire_name + "[i];\n");
@@ -1340,6 +1386,10 @@ void _procServicesAndTicks(RTLGenContext &ctx) {
     }
     // generate cycle logic
     VulErrorContextGuard cycle_guard("generating cycle logic for services and ticks");
+    // CLOCK_RATIO 分频时，非有效沿不接受服务、不执行 tick，避免在门控时钟之外产生请求
+    const bool clock_divided = ctx.module.clock_ratio > 1;
+    const string clk_en_prefix = clock_divided ? string(ClockEnablePort) + " && " : "";
+    const string clk_en_guard = clock_divided ? "if (" + string(ClockEnablePort) + ") " : "";
     for (auto it = service_cache.rbegin(); it != service_cache.rend(); ++it) {
         int32_t key = it->first;
         const std::vector<ServiceCache>& vec = it->second;
@@ -1357,7 +1407,7 @@ void _procServicesAndTicks(RTLGenContext &ctx) {
                         for (const auto &ret : cache.ret_ports) {
                             emit_construct_ret(ret, call_names);
                         }
-                        ctx.hls_body.push_back("  bool rdy = " + condFuncName(cache.name) + ".template operator()<" + std::to_string(idx) + ">(" + call_names + ");\n");
+                        ctx.hls_body.push_back("  bool rdy = " + clk_en_prefix + condFuncName(cache.name) + ".template operator()<" + std::to_string(idx) + ">(" + call_names + ");\n");
                         ctx.hls_body.push_back("  if (rdy && " + reqservVldPort(cache.name) + "[" + std::to_string(idx) + "]) {\n");
                         ctx.hls_body.push_back("    " + implFuncName(cache.name) + ".template operator()<" + std::to_string(idx) + ">(" + call_names + ");\n");
                         for (const auto &ret : cache.ret_ports) {
@@ -1379,7 +1429,7 @@ void _procServicesAndTicks(RTLGenContext &ctx) {
                     for (const auto &ret : cache.ret_ports) {
                         emit_construct_ret(ret, call_names);
                     }
-                    ctx.hls_body.push_back("  bool rdy = " + condFuncName(cache.name) + "(" + call_names + ");\n");
+                    ctx.hls_body.push_back("  bool rdy = " + clk_en_prefix + condFuncName(cache.name) + "(" + call_names + ");\n");
                     ctx.hls_body.push_back("  if (rdy && " + reqservVldPort(cache.name) + ") {\n");
                     ctx.hls_body.push_back("    " + implFuncName(cache.name) + "(" + call_names + ");\n");
                     for (const auto &ret : cache.ret_ports) {
@@ -1433,7 +1483,7 @@ void _procServicesAndTicks(RTLGenContext &ctx) {
                     ctx.hls_body.push_back("}\n");
                 }
             } else {
-                ctx.hls_body.push_back(cache.name + "();\n");
+                ctx.hls_body.push_back(clk_en_guard + cache.name + "();\n");
             }
         }
     }
@@ -1500,7 +1550,7 @@ void _procChildrenAndConnection(RTLGenContext &ctx) {
 
         auto emit_child_instance = [&](const string &child_instance_name) {
             vector<string> child_port_lines;
-            child_port_lines.push_back(".clk(clk)");
+            child_port_lines.push_back(".clk(" + ctx.clk_name + ")");
             child_port_lines.push_back(".rstn(rstn)");
 
             for (const auto &req_entry : child.requests) {
@@ -2100,7 +2150,7 @@ void _procQueues(RTLGenContext &ctx) {
             ctx.rtl_inst.push_back("  .Width(" + data_width_str + "),\n");
             ctx.rtl_inst.push_back("  .Depth(" + depth_str + ")\n");
             ctx.rtl_inst.push_back(") " + que_name + "__inst (\n");
-            ctx.rtl_inst.push_back("  .clk(clk),\n");
+            ctx.rtl_inst.push_back("  .clk(" + ctx.clk_name + "),\n");
             ctx.rtl_inst.push_back("  .rstn(rstn),\n");
             ctx.rtl_inst.push_back("  .enqready(" + port_enqready + "),\n");
             ctx.rtl_inst.push_back("  .deqready(" + port_deqvalid + "),\n");
@@ -2244,7 +2294,7 @@ void _procQueues(RTLGenContext &ctx) {
             ctx.rtl_inst.push_back("  .EnqWidth(" + enq_width_str + "),\n");
             ctx.rtl_inst.push_back("  .DeqWidth(" + deq_width_str + ")\n");
             ctx.rtl_inst.push_back(") " + que_name + "__inst (\n");
-            ctx.rtl_inst.push_back("  .clk(clk),\n");
+            ctx.rtl_inst.push_back("  .clk(" + ctx.clk_name + "),\n");
             ctx.rtl_inst.push_back("  .rstn(rstn),\n");
             ctx.rtl_inst.push_back("  .enqready(" + port_enqready + "),\n");
             ctx.rtl_inst.push_back("  .deqready(" + port_deqvalid + "),\n");
@@ -2258,6 +2308,428 @@ void _procQueues(RTLGenContext &ctx) {
     }
 }
 
+void _procDelayLines(RTLGenContext &ctx) {
+
+    auto clog2 = [](uint32_t x) -> uint32_t {
+        uint32_t res = 0;
+        while ((1U << res) < x) {
+            res++;
+        }
+        return res;
+    };
+
+    for (const auto &line : ctx.module.delay_lines) {
+
+        VulErrorContextGuard line_guard("processing delay line " + line.name);
+
+        const string line_name = line.name;
+        const bool is_mp = line.width > 1;
+
+        const string port_pushvld = line_name + "__pushvld__";
+        const string port_pushdata = line_name + "__pushdata__";
+        const string port_outvld = line_name + "__outvld__";
+        const string port_outdata = line_name + "__outdata__";
+        const string port_clrnext = line_name + "__clrnext__";
+
+        uint32_t data_width = 0;
+        vector<FlatField> data_fields;
+        flatten_type_signature(line.type, ctx.local_bundlelib, "value", data_width, data_fields);
+
+        if (line.latency < 1) {
+            throw VulException("Delay line latency must be at least 1");
+        }
+
+        const string proxy_class_name = "DelayLineProxy_" + line_name + "__";
+        const string data_width_str = std::to_string(data_width);
+        const string data_width_m1_str = std::to_string(data_width - 1);
+        const string latency_str = std::to_string(line.latency);
+        const string width_str = std::to_string(line.width);
+        const string cnt_width_str = std::to_string(clog2(static_cast<uint32_t>(line.width) + 1));
+        const string data_type_str = line.type.toString();
+
+        const string vld_type_str = is_mp ? "Int<" + cnt_width_str + ">" : "bool";
+        const string pushdata_type_str = is_mp ? "std::array<Int<" + data_width_str + ">, " + width_str + ">" : "Int<" + data_width_str + ">";
+        const string outdata_arg_str = is_mp ? "const " + pushdata_type_str + " &" : "const " + pushdata_type_str + " ";
+
+        if (ctx.emit_hls_api_helpers) {
+            ctx.hls_header.push_back("struct " + proxy_class_name + " {\n");
+            ctx.hls_header.push_back("  " + vld_type_str + " &" + port_pushvld + ";\n");
+            ctx.hls_header.push_back("  " + pushdata_type_str + " &" + port_pushdata + ";\n");
+            ctx.hls_header.push_back("  const " + vld_type_str + " " + port_outvld + ";\n");
+            ctx.hls_header.push_back("  " + outdata_arg_str + port_outdata + ";\n");
+            ctx.hls_header.push_back("  bool &" + port_clrnext + ";\n");
+            ctx.hls_header.push_back("\n");
+            ctx.hls_header.push_back("  " + proxy_class_name +
+                "(" + vld_type_str + " &" + port_pushvld +
+                ", " + pushdata_type_str + " &" + port_pushdata +
+                ", const " + vld_type_str + " " + port_outvld +
+                ", " + outdata_arg_str + port_outdata +
+                ", bool &" + port_clrnext +
+                ") : " +
+                port_pushvld + "(" + port_pushvld + "), " +
+                port_pushdata + "(" + port_pushdata + "), " +
+                port_outvld + "(" + port_outvld + "), " +
+                port_outdata + "(" + port_outdata + "), " +
+                port_clrnext + "(" + port_clrnext + ") {}\n");
+            ctx.hls_header.push_back("\n");
+
+            if (!is_mp) {
+                ctx.hls_header.push_back("  bool outvalid() const {\n");
+                ctx.hls_header.push_back("    return " + port_outvld + ";\n");
+                ctx.hls_header.push_back("  }\n");
+                ctx.hls_header.push_back("\n");
+
+                ctx.hls_header.push_back("  " + data_type_str + " out() const {\n");
+                ctx.hls_header.push_back("    " + data_type_str + " value;\n");
+                for (const auto &field : data_fields) {
+                    ctx.hls_header.push_back("    " + field.name + " = " + typedExtractExpr(field, port_outdata) + ";\n");
+                }
+                ctx.hls_header.push_back("    return value;\n");
+                ctx.hls_header.push_back("  }\n");
+                ctx.hls_header.push_back("\n");
+
+                ctx.hls_header.push_back("  void pushnext(const " + data_type_str + " &value) {\n");
+                for (const auto &field : data_fields) {
+                    ctx.hls_header.push_back("    " + uintExtractExpr(port_pushdata, field.offset + field.width - 1, field.offset) + " = " + packFlatFieldExpr(field, field.name) + ";\n");
+                }
+                ctx.hls_header.push_back("    " + port_pushvld + " = true;\n");
+                ctx.hls_header.push_back("  }\n");
+                ctx.hls_header.push_back("\n");
+            } else {
+                const string arr_type_str = "std::array<" + data_type_str + ", " + width_str + ">";
+                ctx.hls_header.push_back("  uint32_t outvalid() const {\n");
+                ctx.hls_header.push_back("    return " + port_outvld + ".template to<uint32_t>();\n");
+                ctx.hls_header.push_back("  }\n");
+                ctx.hls_header.push_back("\n");
+
+                ctx.hls_header.push_back("  " + arr_type_str + " out(const uint32_t num = " + width_str + ") const {\n");
+                ctx.hls_header.push_back("    (void)num;\n");
+                ctx.hls_header.push_back("    " + arr_type_str + " out_buf;\n");
+                for (uint32_t i = 0; i < static_cast<uint32_t>(line.width); ++i) {
+                    ctx.hls_header.push_back("    if (outvalid() > " + std::to_string(i) + ") {\n");
+                    ctx.hls_header.push_back("      auto &value = out_buf[" + std::to_string(i) + "];\n");
+                    for (const auto &field : data_fields) {
+                        ctx.hls_header.push_back("      " + field.name + " = " + typedExtractExpr(field, port_outdata + "[" + std::to_string(i) + "]") + ";\n");
+                    }
+                    ctx.hls_header.push_back("    }\n");
+                }
+                ctx.hls_header.push_back("    return out_buf;\n");
+                ctx.hls_header.push_back("  }\n");
+                ctx.hls_header.push_back("\n");
+
+                ctx.hls_header.push_back("  void pushnext(const " + arr_type_str + " &values, const uint32_t num = " + width_str + ") {\n");
+                ctx.hls_header.push_back("    const uint32_t req = (num < " + width_str + ") ? num : " + width_str + ";\n");
+                for (uint32_t i = 0; i < static_cast<uint32_t>(line.width); ++i) {
+                    ctx.hls_header.push_back("    if (req > " + std::to_string(i) + ") {\n");
+                    ctx.hls_header.push_back("      const " + data_type_str + " &value = values[" + std::to_string(i) + "];\n");
+                    for (const auto &field : data_fields) {
+                        ctx.hls_header.push_back("      " + uintExtractExpr(port_pushdata + "[" + std::to_string(i) + "]", field.offset + field.width - 1, field.offset) + " = " + packFlatFieldExpr(field, field.name) + ";\n");
+                    }
+                    ctx.hls_header.push_back("    }\n");
+                }
+                ctx.hls_header.push_back("    " + port_pushvld + " = req;\n");
+                ctx.hls_header.push_back("  }\n");
+                ctx.hls_header.push_back("\n");
+            }
+
+            ctx.hls_header.push_back("  void clrnext() {\n");
+            ctx.hls_header.push_back("    " + port_clrnext + " = true;\n");
+            ctx.hls_header.push_back("  }\n");
+            ctx.hls_header.push_back("};\n");
+            ctx.hls_header.push_back("\n");
+        }
+
+        ctx.hls_arguments.push_back(vld_type_str + " &" + port_pushvld);
+        ctx.hls_arguments.push_back(pushdata_type_str + " &" + port_pushdata);
+        ctx.hls_arguments.push_back("const " + vld_type_str + " " + port_outvld);
+        ctx.hls_arguments.push_back(outdata_arg_str + port_outdata);
+        ctx.hls_arguments.push_back("bool &" + port_clrnext);
+
+        if (is_mp) {
+            ctx.hls_init.push_back(port_pushvld + " = 0;\n");
+            for (uint32_t i = 0; i < static_cast<uint32_t>(line.width); ++i) {
+                ctx.hls_init.push_back(port_pushdata + "[" + std::to_string(i) + "] = 0;\n");
+            }
+        } else {
+            ctx.hls_init.push_back(port_pushvld + " = false;\n");
+            ctx.hls_init.push_back(port_pushdata + " = 0;\n");
+        }
+        ctx.hls_init.push_back(port_clrnext + " = false;\n");
+        if (ctx.emit_hls_api_helpers) {
+            ctx.hls_init.push_back(proxy_class_name + " " + line_name + "(" + port_pushvld + ", " + port_pushdata + ", " + port_outvld + ", " + port_outdata + ", " + port_clrnext + ");\n");
+        }
+
+        if (is_mp) {
+            ctx.rtl_decl.push_back("wire [" + cnt_width_str + "-1:0] " + port_pushvld + ";\n");
+            ctx.rtl_decl.push_back("wire [" + data_width_m1_str + ":0] " + port_pushdata + "[" + width_str + "];\n");
+            ctx.rtl_decl.push_back("wire [" + cnt_width_str + "-1:0] " + port_outvld + ";\n");
+            ctx.rtl_decl.push_back("wire [" + data_width_m1_str + ":0] " + port_outdata + "[" + width_str + "];\n");
+        } else {
+            ctx.rtl_decl.push_back("wire " + port_pushvld + ";\n");
+            ctx.rtl_decl.push_back("wire [" + data_width_m1_str + ":0] " + port_pushdata + ";\n");
+            ctx.rtl_decl.push_back("wire " + port_outvld + ";\n");
+            ctx.rtl_decl.push_back("wire [" + data_width_m1_str + ":0] " + port_outdata + ";\n");
+        }
+        ctx.rtl_decl.push_back("wire " + port_clrnext + ";\n");
+
+        ctx.rtl_logicports.push_back("." + port_pushvld + "(" + port_pushvld + ")");
+        ctx.rtl_logicports.push_back("." + port_pushdata + "(" + port_pushdata + ")");
+        ctx.rtl_logicports.push_back("." + port_outvld + "(" + port_outvld + ")");
+        ctx.rtl_logicports.push_back("." + port_outdata + "(" + port_outdata + ")");
+        ctx.rtl_logicports.push_back("." + port_clrnext + "(" + port_clrnext + ")");
+
+        ctx.rtl_inst.push_back(string(is_mp ? "VulDelayLineMP" : "VulDelayLine") + " #(\n");
+        ctx.rtl_inst.push_back("  .Width(" + data_width_str + "),\n");
+        if (is_mp) {
+            ctx.rtl_inst.push_back("  .Latency(" + latency_str + "),\n");
+            ctx.rtl_inst.push_back("  .PushWidth(" + width_str + ")\n");
+        } else {
+            ctx.rtl_inst.push_back("  .Latency(" + latency_str + ")\n");
+        }
+        ctx.rtl_inst.push_back(") " + line_name + "__inst (\n");
+        ctx.rtl_inst.push_back("  .clk(" + ctx.clk_name + "),\n");
+        ctx.rtl_inst.push_back("  .rstn(rstn),\n");
+        ctx.rtl_inst.push_back("  .pushnext_vld(" + port_pushvld + "),\n");
+        ctx.rtl_inst.push_back("  .pushnext_data(" + port_pushdata + "),\n");
+        ctx.rtl_inst.push_back("  .out_vld(" + port_outvld + "),\n");
+        ctx.rtl_inst.push_back("  .out_data(" + port_outdata + "),\n");
+        ctx.rtl_inst.push_back("  .clrnext(" + port_clrnext + ")\n");
+        ctx.rtl_inst.push_back(");\n");
+    }
+}
+
+void _procCAMs(RTLGenContext &ctx) {
+
+    for (const auto &cam : ctx.module.cams) {
+
+        VulErrorContextGuard cam_guard("processing cam " + cam.name);
+
+        const string cam_name = cam.name;
+
+        const string port_valid = cam_name + "__valid__";
+        const string port_key = cam_name + "__key__";
+        const string port_value = cam_name + "__value__";
+        const string port_wen = cam_name + "__wen__";
+        const string port_wvalid = cam_name + "__wvalid__";
+        const string port_widx = cam_name + "__widx__";
+        const string port_wkey = cam_name + "__wkey__";
+        const string port_wvalue = cam_name + "__wvalue__";
+        const string port_clrnext = cam_name + "__clrnext__";
+
+        uint32_t key_width = 0;
+        vector<FlatField> key_fields;
+        flatten_type_signature(cam.key_type, ctx.local_bundlelib, "value", key_width, key_fields);
+        uint32_t value_width = 0;
+        vector<FlatField> value_fields;
+        flatten_type_signature(cam.value_type, ctx.local_bundlelib, "value", value_width, value_fields);
+        if (key_width == 0 || value_width == 0) {
+            throw VulException("CAM key and value widths must be positive");
+        }
+
+        const uint32_t entries = static_cast<uint32_t>(cam.entries);
+        const uint32_t write_ports = static_cast<uint32_t>(cam.write_ports);
+        const string proxy_class_name = "CAMProxy_" + cam_name + "__";
+        const string entries_str = std::to_string(entries);
+        const string write_ports_str = std::to_string(write_ports);
+        const string key_width_str = std::to_string(key_width);
+        const string value_width_str = std::to_string(value_width);
+        const string idx_width_str = std::to_string(static_cast<uint32_t>(cam.index_width));
+        const string key_type_str = cam.key_type.toString();
+        const string value_type_str = cam.value_type.toString();
+
+        const string valid_type_str = "std::array<bool, " + entries_str + ">";
+        const string keys_type_str = "std::array<Int<" + key_width_str + ">, " + entries_str + ">";
+        const string values_type_str = "std::array<Int<" + value_width_str + ">, " + entries_str + ">";
+        const string wen_type_str = "std::array<bool, " + write_ports_str + ">";
+        const string widx_type_str = "std::array<Int<" + idx_width_str + ">, " + write_ports_str + ">";
+        const string wkey_type_str = "std::array<Int<" + key_width_str + ">, " + write_ports_str + ">";
+        const string wvalue_type_str = "std::array<Int<" + value_width_str + ">, " + write_ports_str + ">";
+
+        if (ctx.emit_hls_api_helpers) {
+            ctx.hls_header.push_back("struct " + proxy_class_name + " {\n");
+            ctx.hls_header.push_back("  const " + valid_type_str + " &" + port_valid + ";\n");
+            ctx.hls_header.push_back("  const " + keys_type_str + " &" + port_key + ";\n");
+            ctx.hls_header.push_back("  const " + values_type_str + " &" + port_value + ";\n");
+            ctx.hls_header.push_back("  " + wen_type_str + " &" + port_wen + ";\n");
+            ctx.hls_header.push_back("  " + wen_type_str + " &" + port_wvalid + ";\n");
+            ctx.hls_header.push_back("  " + widx_type_str + " &" + port_widx + ";\n");
+            ctx.hls_header.push_back("  " + wkey_type_str + " &" + port_wkey + ";\n");
+            ctx.hls_header.push_back("  " + wvalue_type_str + " &" + port_wvalue + ";\n");
+            ctx.hls_header.push_back("  bool &" + port_clrnext + ";\n");
+            ctx.hls_header.push_back("\n");
+            ctx.hls_header.push_back("  " + proxy_class_name +
+                "(const " + valid_type_str + " &" + port_valid +
+                ", const " + keys_type_str + " &" + port_key +
+                ", const " + values_type_str + " &" + port_value +
+                ", " + wen_type_str + " &" + port_wen +
+                ", " + wen_type_str + " &" + port_wvalid +
+                ", " + widx_type_str + " &" + port_widx +
+                ", " + wkey_type_str + " &" + port_wkey +
+                ", " + wvalue_type_str + " &" + port_wvalue +
+                ", bool &" + port_clrnext +
+                ") : " +
+                port_valid + "(" + port_valid + "), " +
+                port_key + "(" + port_key + "), " +
+                port_value + "(" + port_value + "), " +
+                port_wen + "(" + port_wen + "), " +
+                port_wvalid + "(" + port_wvalid + "), " +
+                port_widx + "(" + port_widx + "), " +
+                port_wkey + "(" + port_wkey + "), " +
+                port_wvalue + "(" + port_wvalue + "), " +
+                port_clrnext + "(" + port_clrnext + ") {}\n");
+            ctx.hls_header.push_back("\n");
+
+            ctx.hls_header.push_back("  bool valid(const uint32_t idx) const {\n");
+            ctx.hls_header.push_back("    return " + port_valid + "[idx];\n");
+            ctx.hls_header.push_back("  }\n");
+            ctx.hls_header.push_back("\n");
+
+            ctx.hls_header.push_back("  " + key_type_str + " key(const uint32_t idx) const {\n");
+            ctx.hls_header.push_back("    " + key_type_str + " value;\n");
+            for (const auto &field : key_fields) {
+                ctx.hls_header.push_back("    " + field.name + " = " + typedExtractExpr(field, port_key + "[idx]") + ";\n");
+            }
+            ctx.hls_header.push_back("    return value;\n");
+            ctx.hls_header.push_back("  }\n");
+            ctx.hls_header.push_back("\n");
+
+            ctx.hls_header.push_back("  " + value_type_str + " value(const uint32_t idx) const {\n");
+            ctx.hls_header.push_back("    " + value_type_str + " value;\n");
+            for (const auto &field : value_fields) {
+                ctx.hls_header.push_back("    " + field.name + " = " + typedExtractExpr(field, port_value + "[idx]") + ";\n");
+            }
+            ctx.hls_header.push_back("    return value;\n");
+            ctx.hls_header.push_back("  }\n");
+            ctx.hls_header.push_back("\n");
+
+            // 比较器阵列加优先编码器：返回 key 匹配的最小有效下标
+            ctx.hls_header.push_back("  uint32_t find(const " + key_type_str + " &key) const {\n");
+            ctx.hls_header.push_back("    Int<" + key_width_str + "> packed = 0;\n");
+            for (const auto &field : key_fields) {
+                ctx.hls_header.push_back("    " + uintExtractExpr("packed", field.offset + field.width - 1, field.offset) + " = " + packFlatFieldExpr(field, flatFieldValueExpr("key", field.name)) + ";\n");
+            }
+            ctx.hls_header.push_back("    for (uint32_t i = 0; i < " + entries_str + "; ++i) {\n");
+            ctx.hls_header.push_back("      if (" + port_valid + "[i] && " + port_key + "[i] == packed) {\n");
+            ctx.hls_header.push_back("        return i;\n");
+            ctx.hls_header.push_back("      }\n");
+            ctx.hls_header.push_back("    }\n");
+            ctx.hls_header.push_back("    return " + entries_str + ";\n");
+            ctx.hls_header.push_back("  }\n");
+            ctx.hls_header.push_back("\n");
+
+            ctx.hls_header.push_back("  bool contains(const " + key_type_str + " &key) const {\n");
+            ctx.hls_header.push_back("    return find(key) != " + entries_str + ";\n");
+            ctx.hls_header.push_back("  }\n");
+            ctx.hls_header.push_back("\n");
+
+            ctx.hls_header.push_back("  uint32_t findfree() const {\n");
+            ctx.hls_header.push_back("    for (uint32_t i = 0; i < " + entries_str + "; ++i) {\n");
+            ctx.hls_header.push_back("      if (!" + port_valid + "[i]) {\n");
+            ctx.hls_header.push_back("        return i;\n");
+            ctx.hls_header.push_back("      }\n");
+            ctx.hls_header.push_back("    }\n");
+            ctx.hls_header.push_back("    return " + entries_str + ";\n");
+            ctx.hls_header.push_back("  }\n");
+            ctx.hls_header.push_back("\n");
+
+            ctx.hls_header.push_back("  uint32_t size() const {\n");
+            ctx.hls_header.push_back("    uint32_t cnt = 0;\n");
+            ctx.hls_header.push_back("    for (uint32_t i = 0; i < " + entries_str + "; ++i) {\n");
+            ctx.hls_header.push_back("      cnt += " + port_valid + "[i] ? 1 : 0;\n");
+            ctx.hls_header.push_back("    }\n");
+            ctx.hls_header.push_back("    return cnt;\n");
+            ctx.hls_header.push_back("  }\n");
+            ctx.hls_header.push_back("\n");
+
+            ctx.hls_header.push_back("  template<uint32_t P = 0>\n");
+            ctx.hls_header.push_back("  void writenext(const uint32_t idx, const " + key_type_str + " &key, const " + value_type_str + " &value) {\n");
+            ctx.hls_header.push_back("    " + port_wen + "[P] = true;\n");
+            ctx.hls_header.push_back("    " + port_wvalid + "[P] = true;\n");
+            ctx.hls_header.push_back("    " + port_widx + "[P] = idx;\n");
+            for (const auto &field : key_fields) {
+                ctx.hls_header.push_back("    " + uintExtractExpr(port_wkey + "[P]", field.offset + field.width - 1, field.offset) + " = " + packFlatFieldExpr(field, flatFieldValueExpr("key", field.name)) + ";\n");
+            }
+            for (const auto &field : value_fields) {
+                ctx.hls_header.push_back("    " + uintExtractExpr(port_wvalue + "[P]", field.offset + field.width - 1, field.offset) + " = " + packFlatFieldExpr(field, flatFieldValueExpr("value", field.name)) + ";\n");
+            }
+            ctx.hls_header.push_back("  }\n");
+            ctx.hls_header.push_back("\n");
+
+            ctx.hls_header.push_back("  template<uint32_t P = 0>\n");
+            ctx.hls_header.push_back("  void invalidatenext(const uint32_t idx) {\n");
+            ctx.hls_header.push_back("    " + port_wen + "[P] = true;\n");
+            ctx.hls_header.push_back("    " + port_wvalid + "[P] = false;\n");
+            ctx.hls_header.push_back("    " + port_widx + "[P] = idx;\n");
+            ctx.hls_header.push_back("  }\n");
+            ctx.hls_header.push_back("\n");
+
+            ctx.hls_header.push_back("  void clrnext() {\n");
+            ctx.hls_header.push_back("    " + port_clrnext + " = true;\n");
+            ctx.hls_header.push_back("  }\n");
+            ctx.hls_header.push_back("};\n");
+            ctx.hls_header.push_back("\n");
+        }
+
+        ctx.hls_arguments.push_back("const " + valid_type_str + " &" + port_valid);
+        ctx.hls_arguments.push_back("const " + keys_type_str + " &" + port_key);
+        ctx.hls_arguments.push_back("const " + values_type_str + " &" + port_value);
+        ctx.hls_arguments.push_back(wen_type_str + " &" + port_wen);
+        ctx.hls_arguments.push_back(wen_type_str + " &" + port_wvalid);
+        ctx.hls_arguments.push_back(widx_type_str + " &" + port_widx);
+        ctx.hls_arguments.push_back(wkey_type_str + " &" + port_wkey);
+        ctx.hls_arguments.push_back(wvalue_type_str + " &" + port_wvalue);
+        ctx.hls_arguments.push_back("bool &" + port_clrnext);
+
+        for (uint32_t p = 0; p < write_ports; ++p) {
+            const string p_str = std::to_string(p);
+            ctx.hls_init.push_back(port_wen + "[" + p_str + "] = false;\n");
+            ctx.hls_init.push_back(port_wvalid + "[" + p_str + "] = false;\n");
+            ctx.hls_init.push_back(port_widx + "[" + p_str + "] = 0;\n");
+            ctx.hls_init.push_back(port_wkey + "[" + p_str + "] = 0;\n");
+            ctx.hls_init.push_back(port_wvalue + "[" + p_str + "] = 0;\n");
+        }
+        ctx.hls_init.push_back(port_clrnext + " = false;\n");
+        if (ctx.emit_hls_api_helpers) {
+            ctx.hls_init.push_back(proxy_class_name + " " + cam_name + "(" + port_valid + ", " + port_key + ", " + port_value + ", " +
+                port_wen + ", " + port_wvalid + ", " + port_widx + ", " + port_wkey + ", " + port_wvalue + ", " + port_clrnext + ");\n");
+        }
+
+        ctx.rtl_decl.push_back("wire " + port_valid + "[" + entries_str + "];\n");
+        ctx.rtl_decl.push_back("wire [" + key_width_str + "-1:0] " + port_key + "[" + entries_str + "];\n");
+        ctx.rtl_decl.push_back("wire [" + value_width_str + "-1:0] " + port_value + "[" + entries_str + "];\n");
+        ctx.rtl_decl.push_back("wire " + port_wen + "[" + write_ports_str + "];\n");
+        ctx.rtl_decl.push_back("wire " + port_wvalid + "[" + write_ports_str + "];\n");
+        ctx.rtl_decl.push_back("wire [" + idx_width_str + "-1:0] " + port_widx + "[" + write_ports_str + "];\n");
+        ctx.rtl_decl.push_back("wire [" + key_width_str + "-1:0] " + port_wkey + "[" + write_ports_str + "];\n");
+        ctx.rtl_decl.push_back("wire [" + value_width_str + "-1:0] " + port_wvalue + "[" + write_ports_str + "];\n");
+        ctx.rtl_decl.push_back("wire " + port_clrnext + ";\n");
+
+        for (const string &port : {port_valid, port_key, port_value, port_wen, port_wvalid, port_widx, port_wkey, port_wvalue, port_clrnext}) {
+            ctx.rtl_logicports.push_back("." + port + "(" + port + ")");
+        }
+
+        ctx.rtl_inst.push_back("VulCAM #(\n");
+        ctx.rtl_inst.push_back("  .KeyWidth(" + key_width_str + "),\n");
+        ctx.rtl_inst.push_back("  .ValueWidth(" + value_width_str + "),\n");
+        ctx.rtl_inst.push_back("  .Entries(" + entries_str + "),\n");
+        ctx.rtl_inst.push_back("  .WritePorts(" + write_ports_str + "),\n");
+        ctx.rtl_inst.push_back("  .IdxWidth(" + idx_width_str + ")\n");
+        ctx.rtl_inst.push_back(") " + cam_name + "__inst (\n");
+        ctx.rtl_inst.push_back("  .clk(" + ctx.clk_name + "),\n");
+        ctx.rtl_inst.push_back("  .rstn(rstn),\n");
+        ctx.rtl_inst.push_back("  .valid(" + port_valid + "),\n");
+        ctx.rtl_inst.push_back("  .keys(" + port_key + "),\n");
+        ctx.rtl_inst.push_back("  .values(" + port_value + "),\n");
+        ctx.rtl_inst.push_back("  .wen(" + port_wen + "),\n");
+        ctx.rtl_inst.push_back("  .wvalid(" + port_wvalid + "),\n");
+        ctx.rtl_inst.push_back("  .widx(" + port_widx + "),\n");
+        ctx.rtl_inst.push_back("  .wkey(" + port_wkey + "),\n");
+        ctx.rtl_inst.push_back("  .wvalue(" + port_wvalue + "),\n");
+        ctx.rtl_inst.push_back("  .clrnext(" + port_clrnext + ")\n");
+        ctx.rtl_inst.push_back(");\n");
+    }
+}
+
 void _procBRAMAndROM(RTLGenContext &ctx) {
     auto escape_verilog_string = [](const string &s) -> string {
         string out;
@@ -2392,7 +2864,7 @@ void _procBRAMAndROM(RTLGenContext &ctx) {
             ctx.rtl_inst.push_back("  .DataWidth(" + data_width_str + "),\n");
             ctx.rtl_inst.push_back("  .AddrWidth(" + addr_width_str + ")\n");
             ctx.rtl_inst.push_back(") " + bram_name + "__inst (\n");
-            ctx.rtl_inst.push_back("  .clk(clk),\n");
+            ctx.rtl_inst.push_back("  .clk(" + ctx.clk_name + "),\n");
             ctx.rtl_inst.push_back("  .rstn(rstn),\n");
             ctx.rtl_inst.push_back("  .s1_en(" + port_s1_en + "),\n");
             ctx.rtl_inst.push_back("  .s1_we(" + port_s1_we + "),\n");
@@ -2534,7 +3006,7 @@ void _procBRAMAndROM(RTLGenContext &ctx) {
             ctx.rtl_inst.push_back("  .ReadPorts(" + read_ports_str + "),\n");
             ctx.rtl_inst.push_back("  .WritePorts(" + write_ports_str + ")\n");
             ctx.rtl_inst.push_back(") " + bram_name + "__inst (\n");
-            ctx.rtl_inst.push_back("  .clk(clk),\n");
+            ctx.rtl_inst.push_back("  .clk(" + ctx.clk_name + "),\n");
             ctx.rtl_inst.push_back("  .rstn(rstn),\n");
             ctx.rtl_inst.push_back("  .s1_readreq(" + port_s1_readreq + "),\n");
             ctx.rtl_inst.push_back("  .s1_readaddr(" + port_s1_readaddr + "),\n");
@@ -2648,7 +3120,7 @@ void _procBRAMAndROM(RTLGenContext &ctx) {
         ctx.rtl_inst.push_back("  .ReadPorts(" + read_ports_str + "),\n");
         ctx.rtl_inst.push_back("  .ReadMemHPath(\"" + init_path_escaped + "\")\n");
         ctx.rtl_inst.push_back(") " + rom_name + "__inst (\n");
-        ctx.rtl_inst.push_back("  .clk(clk),\n");
+        ctx.rtl_inst.push_back("  .clk(" + ctx.clk_name + "),\n");
         ctx.rtl_inst.push_back("  .rstn(rstn),\n");
         ctx.rtl_inst.push_back("  .s1_readreq(" + port_s1_readreq + "),\n");
         ctx.rtl_inst.push_back("  .s1_readaddr(" + port_s1_readaddr + "),\n");
@@ -2691,6 +3163,7 @@ RTLGenResult genModuleRTLImpl(
     RTLGenContext ctx(module, local_configlib, local_bundlelib, global_helper_codes, emit_hls_api_helpers);
 
     _procConstAndBundle(ctx);
+    _procClockRatio(ctx);
     _procWires(ctx);
     _procRegisters(ctx);
     _procRequests(ctx);
@@ -2698,6 +3171,8 @@ RTLGenResult genModuleRTLImpl(
     _procServicesAndTicks(ctx);
     _procChildrenAndConnection(ctx);
     _procQueues(ctx);
+    _procDelayLines(ctx);
+    _procCAMs(ctx);
     _procBRAMAndROM(ctx);
 
     RTLGenResult result;
@@ -2720,6 +3195,9 @@ RTLGenResult genModuleRTLImpl(
     auto &hls = result.logic_hls_codes;
     auto &hls_debug = result.logic_hls_debug;
     if (result.has_logic_submodule) {
+        // fixint.hpp 中的位扫描等运算在此宏下使用可综合的逐位实现
+        hls.push_back("#define VULFIXINT_HLS 1\n");
+        hls.push_back("\n");
         hls.push_back("#include <array>\n");
         hls.push_back("#include <cstdint>\n");
         hls.push_back("#include <type_traits>\n");
@@ -2876,6 +3354,72 @@ static string verilatorIndexedTopExpr(const string &port_name, bool is_arrayed,
     return verilatorTopExpr(port_name);
 }
 
+// Verilator 端口：位宽不超过 64 时为 CData/SData/IData/QData 标量，否则为 32 位字数组 VlWide
+static string verilatorScalarType(uint32_t width) {
+    if (width <= 8) return "uint8_t";
+    if (width <= 16) return "uint16_t";
+    if (width <= 32) return "uint32_t";
+    return "uint64_t";
+}
+
+static string verilatorMaskLiteral(uint32_t width) {
+    std::ostringstream oss;
+    oss << "0x" << std::hex << (width >= 64 ? ~0ULL : ((1ULL << width) - 1ULL)) << "ULL";
+    return oss.str();
+}
+
+// 端口中 [offset, offset + width) 位的 uint64_t 表达式，按端口位宽与字边界展开，不经过逐位循环
+static string verilatorFieldReadExpr(const string &src_expr, uint32_t port_width, uint32_t offset, uint32_t width) {
+    string expr;
+    if (port_width <= 64) {
+        expr = "static_cast<uint64_t>(" + src_expr + ")";
+        if (offset != 0) {
+            expr = "(" + expr + " >> " + std::to_string(offset) + ")";
+        }
+        if (width == port_width) {
+            return expr;
+        }
+    } else {
+        const uint32_t lo = offset / 32;
+        const uint32_t hi = (offset + width - 1) / 32;
+        const uint32_t shift = offset % 32;
+        const string word_type = hi - lo >= 2 ? "__uint128_t" : "uint64_t";
+        expr = "static_cast<" + word_type + ">(" + src_expr + "[" + std::to_string(lo) + "])";
+        for (uint32_t w = lo + 1; w <= hi; ++w) {
+            expr += " | (static_cast<" + word_type + ">(" + src_expr + "[" + std::to_string(w) + "]) << " + std::to_string(32 * (w - lo)) + ")";
+        }
+        if (hi != lo) {
+            expr = "(" + expr + ")";
+        }
+        if (shift != 0) {
+            expr = "(" + expr + " >> " + std::to_string(shift) + ")";
+        }
+        if (word_type != "uint64_t") {
+            expr = "static_cast<uint64_t>(" + expr + ")";
+        }
+    }
+    if (width >= 64) {
+        return expr;
+    }
+    return "(" + expr + " & " + verilatorMaskLiteral(width) + ")";
+}
+
+// 字段取值转换为截断到字段位宽的 uint64_t 表达式
+static string verilatorFieldValueExpr(const FlatField &field, const string &value_expr) {
+    string expr = field.is_fixint ? ("(" + value_expr + ").to<uint64_t>()") : ("static_cast<uint64_t>(" + value_expr + ")");
+    if (field.width >= 64) {
+        return expr;
+    }
+    return "(" + expr + " & " + verilatorMaskLiteral(field.width) + ")";
+}
+
+static bool verilatorPortHasWideField(const ArgPort &port) {
+    for (const auto &field : port.flat_fields) {
+        if (field.width > 64) return true;
+    }
+    return false;
+}
+
 static void emitVerilatorUnpack(
     vector<string> &out,
     const ArgPort &port,
@@ -2887,9 +3431,17 @@ static void emitVerilatorUnpack(
         out.push_back(indent + port.type.toString() + " " + port.name + " = {};\n");
     }
     for (const auto &field : port.flat_fields) {
+        if (field.width > 64) {
+            // 超过 64 位的字段仍按位拼接
+            out.push_back(
+                indent + field.name + " = static_cast<decltype(" + field.name + ")>(__vul_get_bits(" +
+                src_expr + ", " + std::to_string(field.offset) + ", " + std::to_string(field.width) + "));\n"
+            );
+            continue;
+        }
         out.push_back(
-            indent + field.name + " = static_cast<decltype(" + field.name + ")>(__vul_get_bits(" +
-            src_expr + ", " + std::to_string(field.offset) + ", " + std::to_string(field.width) + "));\n"
+            indent + field.name + " = static_cast<decltype(" + field.name + ")>(" +
+            verilatorFieldReadExpr(src_expr, port.width, field.offset, field.width) + ");\n"
         );
     }
 }
@@ -2901,12 +3453,49 @@ static void emitVerilatorPack(
     const string &value_root,
     const string &indent
 ) {
-    for (const auto &field : port.flat_fields) {
-        out.push_back(
-            indent + "__vul_set_bits(" + dst_expr + ", " + std::to_string(field.offset) + ", " +
-            std::to_string(field.width) + ", static_cast<__uint128_t>(" +
-            flatFieldValueExpr(value_root, field.name) + "));\n"
-        );
+    if (port.flat_fields.empty()) {
+        return;
+    }
+    if (verilatorPortHasWideField(port)) {
+        for (const auto &field : port.flat_fields) {
+            out.push_back(
+                indent + "__vul_set_bits(" + dst_expr + ", " + std::to_string(field.offset) + ", " +
+                std::to_string(field.width) + ", static_cast<__uint128_t>(" +
+                flatFieldValueExpr(value_root, field.name) + "));\n"
+            );
+        }
+        return;
+    }
+    if (port.width <= 64) {
+        // 整个端口一次赋值，不做读-改-写
+        string expr;
+        for (const auto &field : port.flat_fields) {
+            string term = verilatorFieldValueExpr(field, flatFieldValueExpr(value_root, field.name));
+            if (field.offset != 0) {
+                term = "(" + term + " << " + std::to_string(field.offset) + ")";
+            }
+            expr += (expr.empty() ? "" : " | ") + term;
+        }
+        out.push_back(indent + dst_expr + " = static_cast<" + verilatorScalarType(port.width) + ">(" + expr + ");\n");
+        return;
+    }
+    const uint32_t words = (port.width + 31) / 32;
+    for (uint32_t w = 0; w < words; ++w) {
+        const uint32_t word_lo = 32 * w;
+        string expr;
+        for (const auto &field : port.flat_fields) {
+            if (field.offset >= word_lo + 32 || field.offset + field.width <= word_lo) {
+                continue;
+            }
+            string term = verilatorFieldValueExpr(field, flatFieldValueExpr(value_root, field.name));
+            if (field.offset > word_lo) {
+                term = "(" + term + " << " + std::to_string(field.offset - word_lo) + ")";
+            } else if (field.offset < word_lo) {
+                term = "(" + term + " >> " + std::to_string(word_lo - field.offset) + ")";
+            }
+            expr += (expr.empty() ? "" : " | ") + term;
+        }
+        out.push_back(indent + dst_expr + "[" + std::to_string(w) + "] = static_cast<uint32_t>(" + (expr.empty() ? string("0") : expr) + ");\n");
     }
 }
 
@@ -2946,19 +3535,10 @@ static void validateTestMainBindings(
     }
 }
 
-vector<string> genVerilatorTestMainCpp(
-    const VulStaticProject &project,
-    const string &top_verilator_class_name
-) {
-    if (!project.top_module_instance) {
-        throw VulException("Cannot generate Verilator TestMain without a top module");
-    }
-    const auto &top_module = *project.top_module_instance;
-    const auto &test = project.test_harness;
-    validateTestMainBindings(test, top_module, project.global_configlib);
-
+// 顶层模块的局部 bundle 覆盖同名全局 bundle
+static VulStaticBundleLib verilatorBundleLib(const VulStaticProject &project) {
     VulStaticBundleLib bundlelib = project.global_bundlelib;
-    for (const auto &local_bundle : top_module.local_bundles) {
+    for (const auto &local_bundle : project.top_module_instance->local_bundles) {
         bool replaced = false;
         for (auto &bundle : bundlelib) {
             if (bundle.name == local_bundle.name) {
@@ -2971,18 +3551,50 @@ vector<string> genVerilatorTestMainCpp(
             bundlelib.push_back(local_bundle);
         }
     }
+    return bundlelib;
+}
+
+vector<string> genVerilatorTestMainCpp(
+    const VulStaticProject &project,
+    const string &top_verilator_class_name
+) {
+    if (!project.top_module_instance) {
+        throw VulException("Cannot generate Verilator TestMain without a top module");
+    }
+    const auto &top_module = *project.top_module_instance;
+    const auto &test = project.test_harness;
+    validateTestMainBindings(test, top_module, project.global_configlib);
+
+    const VulStaticBundleLib bundlelib = verilatorBundleLib(project);
 
     const string top_class_name = top_verilator_class_name.empty() ? ("V" + top_module.simClassName()) : top_verilator_class_name;
     vector<string> out;
 
     out.push_back("#include <array>\n");
     out.push_back("#include <cassert>\n");
+    out.push_back("#include <chrono>\n");
     out.push_back("#include <cstdint>\n");
+    out.push_back("#include <cstdio>\n");
     out.push_back("#include <cstdlib>\n");
+    out.push_back("#include <string>\n");
     out.push_back("#include <type_traits>\n");
     out.push_back("\n");
     out.push_back("#include \"verilated.h\"\n");
     out.push_back("#include \"" + top_class_name + ".h\"\n");
+    out.push_back("#include \"sparsemem.hpp\"\n");
+    out.push_back("#include \"process.hpp\"\n");
+    out.push_back("#include \"runresult.hpp\"\n");
+    out.push_back("\n");
+    out.push_back("// VULSIM_MAX_CYCLES 与 VUL 仿真程序含义相同，结束时输出同样的统计行，便于对比吞吐\n");
+    out.push_back("static uint64_t sim_max_cycles = 0;\n");
+    out.push_back("static bool sim_report_enabled = false;\n");
+    out.push_back("static std::chrono::steady_clock::time_point sim_start_time;\n");
+    out.push_back("\n");
+    out.push_back("static void sim_report(uint64_t cycles) {\n");
+    out.push_back("  if (!sim_report_enabled) return;\n");
+    out.push_back("  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - sim_start_time).count();\n");
+    out.push_back("  std::fprintf(stderr, \"[vulsim] cycles=%llu seconds=%.6f\\n\", static_cast<unsigned long long>(cycles), seconds);\n");
+    out.push_back("}\n");
     out.push_back("\n");
     out.push_back("using std::array;\n");
     out.push_back("using int8 = int8_t;\n");
@@ -3031,7 +3643,11 @@ vector<string> genVerilatorTestMainCpp(
     out.push_back("template <typename T>\n");
     out.push_back("static inline typename std::enable_if<!(std::is_integral<T>::value || std::is_enum<T>::value), uint64_t>::type\n");
     out.push_back("__vul_port_word(const T &value, uint32_t word) {\n");
-    out.push_back("  return static_cast<uint64_t>(value[word]);\n");
+    out.push_back("  // VlWide 由 32 位字组成\n");
+    out.push_back("  constexpr uint32_t n = sizeof(T) / sizeof(value[0]);\n");
+    out.push_back("  uint64_t lo = 2 * word < n ? static_cast<uint64_t>(value[2 * word]) : 0;\n");
+    out.push_back("  uint64_t hi = 2 * word + 1 < n ? static_cast<uint64_t>(value[2 * word + 1]) : 0;\n");
+    out.push_back("  return lo | (hi << 32);\n");
     out.push_back("}\n");
     out.push_back("\n");
     out.push_back("template <typename T>\n");
@@ -3043,7 +3659,9 @@ vector<string> genVerilatorTestMainCpp(
     out.push_back("template <typename T>\n");
     out.push_back("static inline typename std::enable_if<!(std::is_integral<T>::value || std::is_enum<T>::value), void>::type\n");
     out.push_back("__vul_port_set_word(T &value, uint32_t word, uint64_t data) {\n");
-    out.push_back("  value[word] = data;\n");
+    out.push_back("  constexpr uint32_t n = sizeof(T) / sizeof(value[0]);\n");
+    out.push_back("  if (2 * word < n) value[2 * word] = static_cast<uint32_t>(data);\n");
+    out.push_back("  if (2 * word + 1 < n) value[2 * word + 1] = static_cast<uint32_t>(data >> 32);\n");
     out.push_back("}\n");
     out.push_back("\n");
     out.push_back("template <typename T>\n");
@@ -3103,6 +3721,10 @@ vector<string> genVerilatorTestMainCpp(
     }
     out.push_back("  }\n");
     out.push_back("\n");
+    out.push_back("  uint64_t sim_cycles() const {\n");
+    out.push_back("    return __sim_cycles;\n");
+    out.push_back("  }\n");
+    out.push_back("\n");
 
     for (const auto &[name, top_serv] : top_module.services) {
         auto req_iter = test.requests.find(name);
@@ -3142,20 +3764,16 @@ vector<string> genVerilatorTestMainCpp(
     }
 
     for (const auto &[name, query] : test.queries) {
-        uint32_t width = 0;
-        vector<FlatField> flat_fields;
-        flatten_type_signature(query.ret_type, bundlelib, "value", width, flat_fields);
+        ArgPort value_port;
+        value_port.name = "value";
+        value_port.type = query.ret_type;
+        value_port.width = 0;
+        flatten_type_signature(query.ret_type, bundlelib, "value", value_port.width, value_port.flat_fields);
         out.push_back("  " + query.ret_type.toString() + " " + name + "() {\n");
         out.push_back("    eval_and_process_services();\n");
         out.push_back("    " + query.ret_type.toString() + " value = " +
                       apiinline::defaultValueExprForType(query.ret_type, bundlelib) + ";\n");
-        for (const auto &field : flat_fields) {
-            out.push_back(
-                "    " + field.name + " = static_cast<decltype(" + field.name + ")>(__vul_get_bits(" +
-                verilatorTopExpr(queryPort(name)) + ", " + std::to_string(field.offset) + ", " +
-                std::to_string(field.width) + "));\n"
-            );
-        }
+        emitVerilatorUnpack(out, value_port, verilatorTopExpr(queryPort(name)), "    ", false);
         out.push_back("    return value;\n");
         out.push_back("  }\n");
         out.push_back("\n");
@@ -3173,6 +3791,8 @@ vector<string> genVerilatorTestMainCpp(
     }
     out.push_back("  " + top_class_name + " *top = nullptr;\n");
     out.push_back("  bool __processing_services = false;\n");
+    out.push_back("  uint64_t __sim_cycles = 0;\n");
+    out.push_back("  VulProcessScheduler __sim_processes;\n");
     for (const auto &[name, top_serv] : top_module.services) {
         if (test.requests.find(name) != test.requests.end()) {
             if (top_serv.is_arrayed) {
@@ -3199,10 +3819,48 @@ vector<string> genVerilatorTestMainCpp(
     out.push_back("  }\n");
     out.push_back("\n");
     out.push_back("  void sim_nextcycle() {\n");
+    out.push_back("    __sim_processes.resume_all();\n");
     out.push_back("    sim_execute();\n");
     out.push_back("    sim_commit();\n");
     out.push_back("  }\n");
     out.push_back("\n");
+    out.push_back("  template <typename StopPredicate>\n");
+    out.push_back("  VulRunResult sim_run(uint64_t max_cycles, StopPredicate &&stop) {\n");
+    out.push_back("    for (uint64_t i = 0; i < max_cycles; ++i) {\n");
+    out.push_back("      __sim_processes.resume_all();\n");
+    out.push_back("      sim_execute();\n");
+    out.push_back("      sim_commit();\n");
+    out.push_back("      if (stop()) [[unlikely]] return {VulRunStopped, i + 1};\n");
+    out.push_back("    }\n");
+    out.push_back("    return {VulRunMaxCycles, max_cycles};\n");
+    out.push_back("  }\n");
+    out.push_back("\n");
+    out.push_back("  VulRunResult sim_run(uint64_t max_cycles) {\n");
+    out.push_back("    return sim_run(max_cycles, [] { return false; });\n");
+    out.push_back("  }\n");
+    out.push_back("\n");
+    out.push_back("  void sim_spawn(VulProcess &&process) {\n");
+    out.push_back("    __sim_processes.spawn(std::move(process));\n");
+    out.push_back("  }\n");
+    out.push_back("\n");
+    out.push_back("  VulRunResult sim_run_processes(uint64_t max_cycles) {\n");
+    out.push_back("    if (__sim_processes.empty()) return {VulRunStopped, 0};\n");
+    out.push_back("    return sim_run(max_cycles, [this] { return __sim_processes.empty(); });\n");
+    out.push_back("  }\n");
+    out.push_back("\n");
+    out.push_back("  // 遥测与采样只在 VUL 仿真程序中提供，这里保留同名接口以便同一份 TestMain 可以直接编译\n");
+    out.push_back("  void sim_register_counter(const std::string &, const uint64_t *) {}\n");
+    out.push_back("  bool sim_sample_measuring() const { return true; }\n");
+    out.push_back("  bool sim_sample_detailed() const { return true; }\n");
+    out.push_back("  // Verilator 模型没有静默检测，始终逐周期执行\n");
+    out.push_back("  void sim_skip_idle(bool) {}\n");
+    out.push_back("  uint64_t sim_skipped_cycles() const { return 0; }\n");
+    out.push_back("\n");
+    out.push_back("  void sim_exit() {\n");
+    out.push_back("    sim_report(__sim_cycles);\n");
+    out.push_back("    std::exit(1);\n");
+    out.push_back("  }\n");
+    out.push_back("\n");
     out.push_back("  void sim_commit() {\n");
     out.push_back("    top->clk = !top->clk;\n");
     out.push_back("    top->eval();\n");
@@ -3229,6 +3887,11 @@ vector<string> genVerilatorTestMainCpp(
             out.push_back("    __handled_" + name + " = false;\n");
         }
     }
+    out.push_back("    ++__sim_cycles;\n");
+    out.push_back("    if (__sim_cycles == sim_max_cycles) [[unlikely]] {\n");
+    out.push_back("      sim_report(__sim_cycles);\n");
+    out.push_back("      std::exit(0);\n");
+    out.push_back("    }\n");
     out.push_back("  }\n");
     out.push_back("\n");
     out.push_back("  void sim_commit_raw() {\n");
@@ -3320,12 +3983,369 @@ vector<string> genVerilatorTestMainCpp(
     out.push_back("\n");
     out.push_back("int main(int argc, char **argv) {\n");
     out.push_back("  Verilated::commandArgs(argc, argv);\n");
+    out.push_back("  if (const char *env = std::getenv(\"VULSIM_MAX_CYCLES\")) {\n");
+    out.push_back("    sim_max_cycles = std::strtoull(env, nullptr, 10);\n");
+    out.push_back("    sim_report_enabled = true;\n");
+    out.push_back("  }\n");
     out.push_back("  VulTestMain test_main;\n");
+    out.push_back("  sim_start_time = std::chrono::steady_clock::now();\n");
     out.push_back("  test_main.simulation();\n");
+    out.push_back("  sim_report(test_main.sim_cycles());\n");
     out.push_back("  return 0;\n");
     out.push_back("}\n");
 
     return out;
 }
 
+
+// 把一个值的各平铺字段以 64 位字送入联合仿真检查器，两侧对同一类型的值得到相同的字序列
+static void emitCosimWords(
+    vector<string> &out,
+    const ArgPort &port,
+    const string &root,
+    const string &side,
+    const string &indent
+) {
+    for (const auto &field : port.flat_fields) {
+        const string value = flatFieldValueExpr(root, field.name);
+        if (field.width <= 64) {
+            out.push_back(indent + "checker.word(" + side + ", " + verilatorFieldValueExpr(field, value) + ");\n");
+        } else if (field.is_fixint) {
+            out.push_back(indent + "for (uint64_t __w : (" + value + ").get_data()) checker.word(" + side + ", __w);\n");
+        } else {
+            out.push_back(indent + "checker.word(" + side + ", static_cast<uint64_t>(static_cast<__uint128_t>(" + value + ")));\n");
+            out.push_back(indent + "checker.word(" + side + ", static_cast<uint64_t>(static_cast<__uint128_t>(" + value + ") >> 64));\n");
+        }
+    }
+}
+
+vector<string> genVerilatorCosimHpp(
+    const VulStaticProject &project,
+    const string &top_verilator_class_name
+) {
+    if (!project.top_module_instance) {
+        throw VulException("Cannot generate Verilator co-simulation shadow without a top module");
+    }
+    const auto &top_module = *project.top_module_instance;
+    const auto &test = project.test_harness;
+    validateTestMainBindings(test, top_module, project.global_configlib);
+    const VulStaticBundleLib bundlelib = verilatorBundleLib(project);
+    const string top_class_name = top_verilator_class_name.empty() ? ("V" + top_module.simClassName()) : top_verilator_class_name;
+
+    // 检查器中的端口编号：TestMain 的请求、TestMain 的服务、顶层 QUERY 依次排列
+    vector<string> port_names;
+    std::map<string, uint32_t> request_ids;
+    std::map<string, uint32_t> service_ids;
+    std::map<string, uint32_t> query_ids;
+    for (const auto &[name, top_serv] : top_module.services) {
+        if (test.requests.find(name) != test.requests.end()) {
+            request_ids[name] = static_cast<uint32_t>(port_names.size());
+            port_names.push_back("request:" + name);
+        }
+    }
+    for (const auto &[name, temp_serv] : test.services) {
+        service_ids[name] = static_cast<uint32_t>(port_names.size());
+        port_names.push_back("service:" + name);
+    }
+    for (const auto &[name, query] : top_module.queries) {
+        query_ids[name] = static_cast<uint32_t>(port_names.size());
+        port_names.push_back("query:" + name);
+    }
+
+    vector<string> out;
+    out.push_back("// Verilator shadow model for VUL/RTL lockstep co-simulation, generated by VulSim RTLGen tool.\n");
+    out.push_back("// Included by the VUL simulator when built with -DVULSIM_COSIM.\n");
+    out.push_back("#pragma once\n");
+    out.push_back("\n");
+    out.push_back("#include <array>\n");
+    out.push_back("#include <cstdint>\n");
+    out.push_back("\n");
+    out.push_back("#include \"verilated.h\"\n");
+    out.push_back("#include \"" + top_class_name + ".h\"\n");
+    out.push_back("\n");
+    out.push_back("#include \"cosim.hpp\"\n");
+    out.push_back("\n");
+    out.push_back("// VUL 仿真每发起一次请求、响应一次服务都同步转发到这里；Verilator 侧的服务直接使用 VUL 侧记录的响应，\n");
+    out.push_back("// 周期提交时两侧分别记录边界事件与顶层 QUERY 的取值，交给 VulCosimChecker 比较\n");
+    out.push_back("class VulCosimShadow {\n");
+    out.push_back("public:\n");
+    out.push_back("  ~VulCosimShadow() {\n");
+    out.push_back("    delete top;\n");
+    out.push_back("  }\n");
+    out.push_back("\n");
+    out.push_back("  void open(uint64_t interval) {\n");
+    string names_init;
+    for (const auto &name : port_names) {
+        names_init += (names_init.empty() ? "" : ", ") + string("\"") + name + "\"";
+    }
+    out.push_back("    checker.configure(interval, {" + names_init + "});\n");
+    out.push_back("    top = new " + top_class_name + ";\n");
+    out.push_back("    top->clk = 0;\n");
+    out.push_back("    top->rstn = 0;\n");
+    for (const auto &[name, id] : request_ids) {
+        const auto &top_serv = top_module.services.at(name);
+        const uint32_t count = top_serv.is_arrayed ? static_cast<uint32_t>(top_serv.array_size) : 1;
+        for (uint32_t idx = 0; idx < count; ++idx) {
+            out.push_back("    " + verilatorIndexedTopExpr(reqservVldPort(name), top_serv.is_arrayed, idx) + " = false;\n");
+        }
+    }
+    out.push_back("    for (int i = 0; i < 4; ++i) commit_raw();\n");
+    out.push_back("    top->rstn = 1;\n");
+    out.push_back("    top->eval();\n");
+    out.push_back("  }\n");
+    out.push_back("\n");
+    out.push_back("  void reset() {\n");
+    out.push_back("    top->rstn = 0;\n");
+    out.push_back("    commit_raw();\n");
+    out.push_back("    top->rstn = 1;\n");
+    out.push_back("    top->eval();\n");
+    out.push_back("  }\n");
+    out.push_back("\n");
+    out.push_back("  bool finish(uint64_t cycles) {\n");
+    out.push_back("    return checker.finish(cycles);\n");
+    out.push_back("  }\n");
+    out.push_back("\n");
+
+    // TestMain 发起的请求：记录 VUL 侧事件，参数驱动到 Verilator 端口，响应在周期提交时读取
+    for (const auto &[name, id] : request_ids) {
+        const auto &top_serv = top_module.services.at(name);
+        vector<ArgPort> arg_ports;
+        vector<ArgPort> ret_ports;
+        for (const auto &arg : top_serv.args) arg_ports.push_back(procArg(arg, bundlelib));
+        for (const auto &ret : top_serv.rets) ret_ports.push_back(procArg(ret, bundlelib));
+        const string sig = top_serv.signatureArgOnly();
+        const string idx = top_serv.is_arrayed ? "IDX" : "0";
+        auto port_expr = [&](const string &port) {
+            return top_serv.is_arrayed ? (verilatorTopExpr(port) + "[IDX]") : verilatorTopExpr(port);
+        };
+        if (top_serv.is_arrayed) {
+            out.push_back("  template <uint32_t IDX = 0>\n");
+        }
+        out.push_back("  void request_" + name + "(" + sig + (top_serv.has_handshake ? (string(sig.empty() ? "" : ", ") + "bool __ret") : "") + ") {\n");
+        out.push_back("    checker.begin_event(VulCosimRef, " + std::to_string(id) + ", " + idx + ");\n");
+        for (const auto &arg : arg_ports) emitCosimWords(out, arg, arg.name, "VulCosimRef", "    ");
+        for (const auto &ret : ret_ports) emitCosimWords(out, ret, ret.name, "VulCosimRef", "    ");
+        if (top_serv.has_handshake) {
+            out.push_back("    checker.word(VulCosimRef, __ret);\n");
+        }
+        out.push_back("    checker.end_event(VulCosimRef);\n");
+        out.push_back("    " + port_expr(reqservVldPort(name)) + " = true;\n");
+        out.push_back("    __issued_" + name + (top_serv.is_arrayed ? "[IDX]" : "") + " = true;\n");
+        for (const auto &arg : arg_ports) {
+            emitVerilatorPack(out, arg, port_expr(reqservArgPort(name, arg.name)), arg.name, "    ");
+        }
+        out.push_back("  }\n");
+        out.push_back("\n");
+    }
+
+    // TestMain 提供的服务：记录 VUL 侧事件与响应，供 Verilator 侧在周期提交时重放
+    for (const auto &[name, id] : service_ids) {
+        const auto &top_req = top_module.requests.at(name);
+        const string sig = top_req.signatureArgOnly();
+        const string idx = top_req.is_arrayed ? "IDX" : "0";
+        vector<ArgPort> arg_ports;
+        for (const auto &arg : top_req.args) arg_ports.push_back(procArg(arg, bundlelib));
+        if (top_req.is_arrayed) {
+            out.push_back("  template <uint32_t IDX = 0>\n");
+        }
+        out.push_back("  void service_" + name + "(" + sig + (top_req.has_handshake ? (string(sig.empty() ? "" : ", ") + "bool __cond") : "") + ") {\n");
+        out.push_back("    checker.begin_event(VulCosimRef, " + std::to_string(id) + ", " + idx + ");\n");
+        for (const auto &arg : arg_ports) emitCosimWords(out, arg, arg.name, "VulCosimRef", "    ");
+        if (top_req.has_handshake) {
+            out.push_back("    checker.word(VulCosimRef, __cond);\n");
+        }
+        out.push_back("    checker.end_event(VulCosimRef);\n");
+        out.push_back("    auto &__resp = __resp_" + name + (top_req.is_arrayed ? "[IDX]" : "") + ";\n");
+        out.push_back("    __resp.called = true;\n");
+        out.push_back("    __resp.fire = " + string(top_req.has_handshake ? "__cond" : "true") + ";\n");
+        for (const auto &ret : top_req.rets) {
+            out.push_back("    __resp." + ret.name + " = " + ret.name + ";\n");
+        }
+        out.push_back("  }\n");
+        out.push_back("\n");
+    }
+
+    out.push_back("  template <typename RefTop>\n");
+    out.push_back("  void commit(uint64_t cycles, RefTop &ref) {\n");
+    for (const auto &[name, id] : service_ids) {
+        const auto &top_req = top_module.requests.at(name);
+        if (!top_req.has_handshake) continue;
+        const uint32_t count = top_req.is_arrayed ? static_cast<uint32_t>(top_req.array_size) : 1;
+        for (uint32_t i = 0; i < count; ++i) {
+            const string resp = "__resp_" + name + (top_req.is_arrayed ? ("[" + std::to_string(i) + "]") : "");
+            out.push_back("    " + verilatorIndexedTopExpr(reqservRdyPort(name), top_req.is_arrayed, i) + " = " + resp + ".called && " + resp + ".fire;\n");
+        }
+    }
+    out.push_back("    top->eval();\n");
+    out.push_back("    process_services();\n");
+    // 请求的响应在本周期所有服务完成后读取
+    for (const auto &[name, id] : request_ids) {
+        const auto &top_serv = top_module.services.at(name);
+        vector<ArgPort> arg_ports;
+        vector<ArgPort> ret_ports;
+        for (const auto &arg : top_serv.args) arg_ports.push_back(procArg(arg, bundlelib));
+        for (const auto &ret : top_serv.rets) ret_ports.push_back(procArg(ret, bundlelib));
+        const uint32_t count = top_serv.is_arrayed ? static_cast<uint32_t>(top_serv.array_size) : 1;
+        for (uint32_t i = 0; i < count; ++i) {
+            const string issued = "__issued_" + name + (top_serv.is_arrayed ? ("[" + std::to_string(i) + "]") : "");
+            out.push_back("    if (" + issued + ") {\n");
+            for (const auto &arg : arg_ports) {
+                emitVerilatorUnpack(out, arg, verilatorIndexedTopExpr(reqservArgPort(name, arg.name), top_serv.is_arrayed, i), "      ");
+            }
+            for (const auto &ret : ret_ports) {
+                emitVerilatorUnpack(out, ret, verilatorIndexedTopExpr(reqservArgPort(name, ret.name), top_serv.is_arrayed, i), "      ");
+            }
+            out.push_back("      checker.begin_event(VulCosimDut, " + std::to_string(id) + ", " + std::to_string(i) + ");\n");
+            for (const auto &arg : arg_ports) emitCosimWords(out, arg, arg.name, "VulCosimDut", "      ");
+            for (const auto &ret : ret_ports) emitCosimWords(out, ret, ret.name, "VulCosimDut", "      ");
+            if (top_serv.has_handshake) {
+                out.push_back("      checker.word(VulCosimDut, static_cast<bool>(" + verilatorIndexedTopExpr(reqservRdyPort(name), top_serv.is_arrayed, i) + "));\n");
+            }
+            out.push_back("      checker.end_event(VulCosimDut);\n");
+            out.push_back("    }\n");
+        }
+    }
+    out.push_back("    top->clk = !top->clk;\n");
+    out.push_back("    top->eval();\n");
+    for (const auto &[name, id] : request_ids) {
+        const auto &top_serv = top_module.services.at(name);
+        const uint32_t count = top_serv.is_arrayed ? static_cast<uint32_t>(top_serv.array_size) : 1;
+        for (uint32_t i = 0; i < count; ++i) {
+            out.push_back("    " + verilatorIndexedTopExpr(reqservVldPort(name), top_serv.is_arrayed, i) + " = false;\n");
+        }
+        if (top_serv.is_arrayed) {
+            out.push_back("    __issued_" + name + ".fill(false);\n");
+        } else {
+            out.push_back("    __issued_" + name + " = false;\n");
+        }
+    }
+    out.push_back("    top->clk = !top->clk;\n");
+    out.push_back("    top->eval();\n");
+    for (const auto &[name, id] : service_ids) {
+        const auto &top_req = top_module.requests.at(name);
+        if (top_req.is_arrayed) {
+            out.push_back("    __handled_" + name + ".fill(false);\n");
+            out.push_back("    __resp_" + name + ".fill({});\n");
+        } else {
+            out.push_back("    __handled_" + name + " = false;\n");
+            out.push_back("    __resp_" + name + " = {};\n");
+        }
+    }
+    // 顶层 QUERY 反映提交后的寄存器状态，两侧都在时钟沿之后读取
+    for (const auto &[name, id] : query_ids) {
+        const auto &query = top_module.queries.at(name);
+        ArgPort value_port;
+        value_port.name = "value";
+        value_port.type = query.ret_type;
+        value_port.width = 0;
+        flatten_type_signature(query.ret_type, bundlelib, "value", value_port.width, value_port.flat_fields);
+        out.push_back("    {\n");
+        out.push_back("      const " + query.ret_type.toString() + " value = ref." + name + "();\n");
+        out.push_back("      checker.begin_event(VulCosimRef, " + std::to_string(id) + ", 0);\n");
+        emitCosimWords(out, value_port, "value", "VulCosimRef", "      ");
+        out.push_back("      checker.end_event(VulCosimRef);\n");
+        out.push_back("    }\n");
+        out.push_back("    {\n");
+        emitVerilatorUnpack(out, value_port, verilatorTopExpr(queryPort(name)), "      ");
+        out.push_back("      checker.begin_event(VulCosimDut, " + std::to_string(id) + ", 0);\n");
+        emitCosimWords(out, value_port, "value", "VulCosimDut", "      ");
+        out.push_back("      checker.end_event(VulCosimDut);\n");
+        out.push_back("    }\n");
+    }
+    out.push_back("    if (!checker.end_cycle(cycles)) [[unlikely]] {\n");
+    out.push_back("      sim_cosim_failed(cycles);\n");
+    out.push_back("    }\n");
+    out.push_back("  }\n");
+    out.push_back("\n");
+
+    out.push_back("protected:\n");
+    out.push_back("  " + top_class_name + " *top = nullptr;\n");
+    out.push_back("  VulCosimChecker checker;\n");
+    out.push_back("  bool __processing_services = false;\n");
+    for (const auto &[name, id] : request_ids) {
+        const auto &top_serv = top_module.services.at(name);
+        if (top_serv.is_arrayed) {
+            out.push_back("  std::array<bool, " + std::to_string(top_serv.array_size) + "> __issued_" + name + " = {};\n");
+        } else {
+            out.push_back("  bool __issued_" + name + " = false;\n");
+        }
+    }
+    for (const auto &[name, id] : service_ids) {
+        const auto &top_req = top_module.requests.at(name);
+        out.push_back("  struct __resp_t_" + name + " {\n");
+        out.push_back("    bool called = false;\n");
+        out.push_back("    bool fire = false;\n");
+        for (const auto &ret : top_req.rets) {
+            out.push_back("    " + ret.type.toString() + " " + ret.name + " = {};\n");
+        }
+        out.push_back("  };\n");
+        if (top_req.is_arrayed) {
+            out.push_back("  std::array<bool, " + std::to_string(top_req.array_size) + "> __handled_" + name + " = {};\n");
+            out.push_back("  std::array<__resp_t_" + name + ", " + std::to_string(top_req.array_size) + "> __resp_" + name + " = {};\n");
+        } else {
+            out.push_back("  bool __handled_" + name + " = false;\n");
+            out.push_back("  __resp_t_" + name + " __resp_" + name + " = {};\n");
+        }
+    }
+    out.push_back("\n");
+    out.push_back("  void commit_raw() {\n");
+    out.push_back("    top->clk = !top->clk;\n");
+    out.push_back("    top->eval();\n");
+    out.push_back("    top->clk = !top->clk;\n");
+    out.push_back("    top->eval();\n");
+    out.push_back("  }\n");
+    out.push_back("\n");
+    out.push_back("  void process_services() {\n");
+    out.push_back("    if (__processing_services) return;\n");
+    out.push_back("    __processing_services = true;\n");
+    out.push_back("    bool again = true;\n");
+    out.push_back("    while (again) {\n");
+    out.push_back("      again = false;\n");
+    for (const auto &[name, id] : service_ids) {
+        const auto &top_req = top_module.requests.at(name);
+        vector<ArgPort> arg_ports;
+        vector<ArgPort> ret_ports;
+        for (const auto &arg : top_req.args) arg_ports.push_back(procArg(arg, bundlelib));
+        for (const auto &ret : top_req.rets) ret_ports.push_back(procArg(ret, bundlelib));
+        const uint32_t count = top_req.is_arrayed ? static_cast<uint32_t>(top_req.array_size) : 1;
+        for (uint32_t i = 0; i < count; ++i) {
+            const string suffix = top_req.is_arrayed ? ("[" + std::to_string(i) + "]") : "";
+            const string handled = "__handled_" + name + suffix;
+            out.push_back("      if (" + verilatorIndexedTopExpr(reqservVldPort(name), top_req.is_arrayed, i) + " && !" + handled + ") {\n");
+            for (const auto &arg : arg_ports) {
+                emitVerilatorUnpack(out, arg, verilatorIndexedTopExpr(reqservArgPort(name, arg.name), top_req.is_arrayed, i), "        ");
+            }
+            if (top_req.has_handshake || !ret_ports.empty()) {
+                out.push_back("        const auto &__resp = __resp_" + name + suffix + ";\n");
+                out.push_back("        const bool __fire = __resp.called && __resp.fire;\n");
+            }
+            out.push_back("        checker.begin_event(VulCosimDut, " + std::to_string(id) + ", " + std::to_string(i) + ");\n");
+            for (const auto &arg : arg_ports) emitCosimWords(out, arg, arg.name, "VulCosimDut", "        ");
+            if (top_req.has_handshake) {
+                out.push_back("        checker.word(VulCosimDut, __fire);\n");
+            }
+            out.push_back("        checker.end_event(VulCosimDut);\n");
+            if (!ret_ports.empty()) {
+                out.push_back("        if (__fire) {\n");
+                for (const auto &ret : ret_ports) {
+                    out.push_back("          const auto &" + ret.name + " = __resp." + ret.name + ";\n");
+                    emitVerilatorPack(out, ret, verilatorIndexedTopExpr(reqservArgPort(name, ret.name), top_req.is_arrayed, i), ret.name, "          ");
+                }
+                out.push_back("        }\n");
+            }
+            out.push_back("        " + handled + " = true;\n");
+            out.push_back("        top->eval();\n");
+            out.push_back("        again = true;\n");
+            out.push_back("      }\n");
+        }
+    }
+    out.push_back("    }\n");
+    out.push_back("    __processing_services = false;\n");
+    out.push_back("  }\n");
+    out.push_back("};\n");
+    out.push_back("\n");
+    out.push_back("inline VulCosimShadow vul_cosim;\n");
+    return out;
+}
+
 }
@@ -74,5 +74,11 @@ vector<string> genVerilatorTestMainCpp(
     const string &top_verilator_class_name = ""
 );
 
+// 联合仿真用的 Verilator 影子模型（VulCosim.hpp），由 -DVULSIM_COSIM 构建的 VUL 仿真程序包含
+vector<string> genVerilatorCosimHpp(
+    const VulStaticProject &project,
+    const string &top_verilator_class_name = ""
+);
+
 
 } // namespace rtlgen
@@ -36,6 +36,7 @@ std::string generateLogicRTLWithRTLzz(
     options.top_function = top_function;
     options.unroll_limit = unroll_limit;
     options.clang_args.push_back("-std=c++20");
+    options.clang_args.push_back("-DVULFIXINT_HLS=1");
 
     const auto source_parent = source_path.parent_path();
     if (!source_parent.empty()) {
@@ -64,6 +64,9 @@ const string BlockRAM1RWClassName = "VulBRAM1RW";
 const string ROMClassName = "VulROM";
 const string QueueClassName = "VulQueue";
 const string QueueMPClassName = "VulQueueMP";
+const string DelayLineClassName = "VulDelayLine";
+const string DelayLineMPClassName = "VulDelayLineMP";
+const string CAMClassName = "VulCAM";
 
 string genCurrentTimeString() {
     std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
@@ -881,7 +884,165 @@ vector<string> genStaticProjectHeaderCode(
     return out_lines;
 }
 
-StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, const vector<VulTracedSignal> &traced_signals) {
+// 第一个端口的标记，与 vullib/stimulus.hpp 中的 VulStimulusStream::TagPortBase 相同，生成代码中以 static_assert 检查
+static constexpr uint64_t StimulusTagPortBase = 4;
+
+// 激励录制与回放中的一个端口：Main 发出的请求、Main 提供的服务或 QUERY。
+// 端口按种类与名字排序后依次编号，标记为 StimulusTagPortBase + 序号
+struct StimulusPort {
+    enum Kind { Request, Service, Query };
+    Kind kind;
+    string name;
+    uint64_t tag = 0;
+    bool is_arrayed = false;
+    uint32_t array_size = 1;
+    bool has_handshake = false;
+    vector<pair<string, string>> arg_decls; // 参数名与类型，参数名取 Main 中的声明
+    vector<pair<string, string>> ret_decls;
+    vector<FlatField> arg_fields;            // 以参数名为根展平的字段
+    vector<FlatField> ret_fields;
+
+    string label() const {
+        static const char *kind_names[] = {"request", "service", "query"};
+        return string(kind_names[kind]) + " " + name;
+    }
+};
+
+static void stimulusFlatten(
+    const string &root,
+    const VulStaticTypeSignature &type,
+    const VulStaticBundleLib &bundlelib,
+    vector<pair<string, string>> &decls,
+    vector<FlatField> &fields
+) {
+    uint32_t offset = 0;
+    decls.push_back({root, type.toString()});
+    flatten_type_signature(type, bundlelib, root, offset, fields);
+}
+
+// Main 的请求与服务的参数名取自 Main，类型取自顶层模块中对应的服务与请求
+static StimulusPort stimulusReqServPort(
+    StimulusPort::Kind kind,
+    const string &name,
+    const VulTempReqServBase &decl,
+    const VulStaticReqServ &top,
+    const VulStaticBundleLib &bundlelib
+) {
+    if (decl.args.size() != top.args.size() || decl.rets.size() != top.rets.size()) {
+        throw VulException("TestMain '" + name + "' signature mismatch with top module");
+    }
+    StimulusPort port;
+    port.kind = kind;
+    port.name = name;
+    port.is_arrayed = top.is_arrayed;
+    port.array_size = top.is_arrayed ? static_cast<uint32_t>(top.array_size) : 1;
+    port.has_handshake = decl.has_handshake;
+    for (size_t i = 0; i < decl.args.size(); ++i) {
+        stimulusFlatten(decl.args[i].second, top.args[i].type, bundlelib, port.arg_decls, port.arg_fields);
+    }
+    for (size_t i = 0; i < decl.rets.size(); ++i) {
+        stimulusFlatten(decl.rets[i].second, top.rets[i].type, bundlelib, port.ret_decls, port.ret_fields);
+    }
+    return port;
+}
+
+// 接口签名：端口种类、名字、数组大小与各字段的名字和位宽的 FNV-1a 哈希，回放时拒绝不同接口录制的流
+static uint64_t stimulusSignature(const vector<StimulusPort> &ports) {
+    string desc;
+    for (const auto &port : ports) {
+        desc += port.label() + "[" + std::to_string(port.is_arrayed ? port.array_size : 0) + "]" + (port.has_handshake ? "?" : "") + "(";
+        for (const auto &field : port.arg_fields) {
+            desc += field.name + ":" + std::to_string(field.width) + ",";
+        }
+        desc += ")->(";
+        for (const auto &field : port.ret_fields) {
+            desc += field.name + ":" + std::to_string(field.width) + ",";
+        }
+        desc += ");";
+    }
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : desc) {
+        hash ^= c;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// stream 为写入的流对象：Main 的录制写 vul_stimulus，实例边界捕获写 vul_capture
+static string stimulusEventCall(const StimulusPort &port, const string &index, const string &stream = "vul_stimulus") {
+    return stream + ".event(" + std::to_string(port.tag) + (port.is_arrayed ? ", " + index : "") + ");\n";
+}
+
+static void stimulusPutFields(vector<string> &out, const vector<FlatField> &fields, const string &indent, const string &stream = "vul_stimulus") {
+    for (const auto &field : fields) {
+        out.push_back(indent + stream + ".put(" + field.name + ");\n");
+    }
+}
+
+static void stimulusGetFields(vector<string> &out, const vector<FlatField> &fields, const string &indent) {
+    for (const auto &field : fields) {
+        out.push_back(indent + "vul_stimulus.get(" + field.name + ");\n");
+    }
+}
+
+static void stimulusCheckFields(vector<string> &out, const vector<FlatField> &fields, const string &indent) {
+    for (const auto &field : fields) {
+        out.push_back(indent + "vul_stimulus.check(" + cppStringLiteral(field.name) + ", " + field.name + ");\n");
+    }
+}
+
+// 实例边界的端口表，即以该实例为顶层时 TestMain 看到的端口：请求对应实例的服务，服务对应实例的请求，参数名取自模块声明。
+// vulsimgen --capture 生成的捕获代码与 --isolate 合成的回放 TestMain 由同一张表编号，签名一致
+static vector<StimulusPort> stimulusInstancePorts(const VulStaticModuleInstance &inst, const VulStaticBundleLib &global_bundlelib) {
+    VulStaticBundleLib bundlelib = inst.local_bundles;
+    bundlelib.insert(bundlelib.end(), global_bundlelib.begin(), global_bundlelib.end());
+    auto decl_of = [](const VulStaticReqServ &port) {
+        VulTempReqServBase decl;
+        decl.name = port.name;
+        decl.has_handshake = port.has_handshake;
+        for (const auto &arg : port.args) {
+            decl.args.push_back({arg.type.toString(), arg.name});
+        }
+        for (const auto &ret : port.rets) {
+            decl.rets.push_back({ret.type.toString(), ret.name});
+        }
+        return decl;
+    };
+    vector<StimulusPort> ports;
+    auto add_port = [&](StimulusPort port) {
+        port.tag = StimulusTagPortBase + ports.size();
+        ports.push_back(std::move(port));
+    };
+    for (const auto &[name, serv] : std::map<string, VulStaticReqServ>(inst.services.begin(), inst.services.end())) {
+        add_port(stimulusReqServPort(StimulusPort::Request, name, decl_of(serv), serv, bundlelib));
+    }
+    for (const auto &[name, req] : std::map<string, VulStaticReqServ>(inst.requests.begin(), inst.requests.end())) {
+        add_port(stimulusReqServPort(StimulusPort::Service, name, decl_of(req), req, bundlelib));
+    }
+    for (const auto &[name, query] : std::map<string, VulStaticQuery>(inst.queries.begin(), inst.queries.end())) {
+        StimulusPort port;
+        port.kind = StimulusPort::Query;
+        port.name = name;
+        stimulusFlatten("__ret", query.ret_type, bundlelib, port.ret_decls, port.ret_fields);
+        add_port(std::move(port));
+    }
+    return ports;
+}
+
+static const StimulusPort &stimulusFindPort(const vector<StimulusPort> &ports, StimulusPort::Kind kind, const string &name) {
+    for (const auto &port : ports) {
+        if (port.kind == kind && port.name == name) {
+            return port;
+        }
+    }
+    throw VulException("Stimulus port '" + name + "' not found");
+}
+
+StaticModuleCodeHpp genStaticModuleCodeHpp(
+    const VulStaticModuleInstance &mod,
+    const vector<VulTracedSignal> &traced_signals,
+    const VulStaticBundleLib *capture_global_bundlelib
+) {
 
     vector<string> decl_include_field;
     vector<string> decl_public_field;
@@ -894,12 +1055,50 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
     vector<string> impl_commit_field;
     VulDebugLocs impl_commit_field_debug;
     vector<string> impl_sys_reset_field;
+    // 静默检测：提交前判断本周期是否只有计时寄存器在倒计数，以及可以整体跳过的周期数
+    vector<string> impl_quiescent_span_field;
+    vector<string> impl_quiescent_skip_field;
     vector<string> impl_reg_reset_value_field;
     VulDebugLocs impl_reg_reset_value_field_debug;
     vector<string> impl_reg_reset_field;
     VulDebugLocs impl_reg_reset_field_debug;
 
     string mod_class_name = mod.simClassName();
+    // VULSIM_ALLOC_TRACK 构建下把堆分配记到该函数名下，其余构建展开为空
+    auto alloc_scope_line = [&](const string &func_name) {
+        return CodeTab + "VUL_ALLOC_SCOPE(\"" + mod_class_name + "::" + func_name + "\");\n";
+    };
+
+    // vulsimgen --capture 选中的实例：把穿过实例边界的服务调用、请求与 QUERY 写入 vul_capture，
+    // 端口的编号与以该实例为顶层的回放 TestMain 一致
+    const bool capture = capture_global_bundlelib != nullptr;
+    vector<StimulusPort> capture_ports;
+    if (capture) {
+        if (childIsArrayTemplate(mod)) {
+            throw VulException("Boundary capture of an instance array element is not supported: " + mod_class_name);
+        }
+        capture_ports = stimulusInstancePorts(mod, *capture_global_bundlelib);
+    }
+
+    // CLOCK_RATIO：父模块每 clock_ratio 个周期本实例执行一个周期，相位为 0 的周期是有效沿，复位后从有效沿开始
+    if (mod.clock_ratio > 1) {
+        decl_private_field.push_back("uint32_t __clk_phase = 0;\n");
+        decl_private_field.push_back("\n");
+        impl_sys_reset_field.push_back("__clk_phase = 0;\n");
+    }
+    // 握手端口写入 cond 与握手成功时的响应，无握手端口只写入响应
+    auto capture_result_lines = [&](vector<string> &out, const StimulusPort &stim, const string &indent) {
+        if (stim.has_handshake) {
+            out.push_back(indent + "vul_capture.put(cond);\n");
+            if (!stim.ret_fields.empty()) {
+                out.push_back(indent + "if (cond) {\n");
+                stimulusPutFields(out, stim.ret_fields, indent + CodeTab, "vul_capture");
+                out.push_back(indent + "}\n");
+            }
+        } else {
+            stimulusPutFields(out, stim.ret_fields, indent, "vul_capture");
+        }
+    };
 
     // local params and consts
     for (const auto &param : mod.local_parameters) {
@@ -947,10 +1146,22 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
         wrapper_prefix_args += argnames;
         if (is_arrayed) {
             impl_field.push_back("template <uint32_t IDX>\n");
-            impl_field.push_back(rettype + " " + mod_class_name + "::" + req_entry.first + "(" + arglists + ") {\n");
-            impl_field.push_back(CodeTab + call_prefix + wrapper_name + "<IDX>(" + wrapper_prefix_args + ");\n");
+            wrapper_name += "<IDX>";
+        }
+        impl_field.push_back(rettype + " " + mod_class_name + "::" + req_entry.first + "(" + arglists + ") {\n");
+        if (capture) {
+            // 实例发出的请求在回放中由 TestMain 的服务响应，返回后记录参数与结果
+            const StimulusPort &stim = stimulusFindPort(capture_ports, StimulusPort::Service, req_entry.first);
+            impl_field.push_back(CodeTab + (rettype == "void" ? "" : "bool cond = ") + wrapper_name + "(" + wrapper_prefix_args + ");\n");
+            impl_field.push_back(CodeTab + "if (vul_capture.recording()) [[unlikely]] {\n");
+            impl_field.push_back(CodeTab + CodeTab + stimulusEventCall(stim, "IDX", "vul_capture"));
+            stimulusPutFields(impl_field, stim.arg_fields, CodeTab + CodeTab, "vul_capture");
+            capture_result_lines(impl_field, stim, CodeTab + CodeTab);
+            impl_field.push_back(CodeTab + "}\n");
+            if (rettype != "void") {
+                impl_field.push_back(CodeTab + "return cond;\n");
+            }
         } else {
-            impl_field.push_back(rettype + " " + mod_class_name + "::" + req_entry.first + "(" + arglists + ") {\n");
             impl_field.push_back(CodeTab + call_prefix + wrapper_name + "(" + wrapper_prefix_args + ");\n");
         }
         impl_field.push_back("}\n");
@@ -969,15 +1180,33 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
         string arglists = serv.signatureArgOnly();
         const bool is_arrayed = serv.is_arrayed;
 
+        // 每周期至多调用一次的检查标志；VULSIM_UNCHECKED（vulsimgen --profile unchecked）下连同提交时的复位一起移除
+        decl_private_field.push_back("#ifndef VULSIM_UNCHECKED\n");
+        impl_sys_reset_field.push_back("#ifndef VULSIM_UNCHECKED\n");
+        impl_commit_field.push_back("#ifndef VULSIM_UNCHECKED\n");
         if (is_arrayed) {
-            decl_private_field.push_back("std::array<bool, " + std::to_string(serv.array_size) + "> " + call_guard_name + ";\n");
+            decl_private_field.push_back("std::array<bool, " + std::to_string(serv.array_size) + "> " + call_guard_name + "{};\n");
             impl_sys_reset_field.push_back("for (auto &__flag : " + call_guard_name + ") __flag = false;\n");
             impl_commit_field.push_back("for (auto &__flag : " + call_guard_name + ") __flag = false;\n");
         } else {
-            decl_private_field.push_back("bool " + call_guard_name + ";\n");
+            decl_private_field.push_back("bool " + call_guard_name + " = false;\n");
             impl_sys_reset_field.push_back(call_guard_name + " = false;\n");
             impl_commit_field.push_back(call_guard_name + " = false;\n");
         }
+        decl_private_field.push_back("#endif\n");
+        impl_sys_reset_field.push_back("#endif\n");
+        impl_commit_field.push_back("#endif\n");
+        auto call_guard_lines = [&]() {
+            impl_field.push_back("#ifndef VULSIM_UNCHECKED\n");
+            if (is_arrayed) {
+                impl_field.push_back(CodeTab + "assert(!" + call_guard_name + "[IDX] && \"" + service_assert_msg + " (for each array index)\");\n");
+                impl_field.push_back(CodeTab + call_guard_name + "[IDX] = true;\n");
+            } else {
+                impl_field.push_back(CodeTab + "assert(!" + call_guard_name + " && \"" + service_assert_msg + "\");\n");
+                impl_field.push_back(CodeTab + call_guard_name + " = true;\n");
+            }
+            impl_field.push_back("#endif\n");
+        };
 
         if (is_arrayed) {
             decl_public_field.push_back("template <uint32_t IDX = 0>\n");
@@ -988,20 +1217,41 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
 
         // implemented by logic block, or connented to child module's service
         auto lb_iter = mod.serv_logic_blocks.find(serv_entry.first);
+        if (capture && lb_iter == mod.serv_logic_blocks.end()) {
+            throw VulException("Boundary capture does not support service '" + serv_entry.first + "' forwarded to a child instance of " + mod_class_name);
+        }
+        // 对实例服务的调用在回放中由 TestMain 的请求发出：调用前记录参数，返回前记录结果
+        const StimulusPort *capture_stim = capture ? &stimulusFindPort(capture_ports, StimulusPort::Request, serv_entry.first) : nullptr;
+        auto capture_call_lines = [&]() {
+            impl_field.push_back(CodeTab + "if (vul_capture.recording()) [[unlikely]] {\n");
+            impl_field.push_back(CodeTab + CodeTab + stimulusEventCall(*capture_stim, "IDX", "vul_capture"));
+            stimulusPutFields(impl_field, capture_stim->arg_fields, CodeTab + CodeTab, "vul_capture");
+            impl_field.push_back(CodeTab + "}\n");
+        };
+        auto capture_return_lines = [&]() {
+            impl_field.push_back(CodeTab + "if (vul_capture.recording()) [[unlikely]] {\n");
+            impl_field.push_back(CodeTab + CodeTab + "vul_capture.event(VulStimulusStream::TagResult);\n");
+            capture_result_lines(impl_field, *capture_stim, CodeTab + CodeTab);
+            impl_field.push_back(CodeTab + "}\n");
+        };
         if (lb_iter != mod.serv_logic_blocks.end()) {
             if (rettype == "void") {
                 if (is_arrayed) {
                     impl_field.push_back("template <uint32_t IDX>\n");
                 }
                 impl_field.push_back("void " + mod_class_name + "::" + serv_entry.first + "(" + arglists + ") {\n");
-                if (is_arrayed) {
-                    impl_field.push_back(CodeTab + "assert(!" + call_guard_name + "[IDX] && \"" + service_assert_msg + " (for each array index)\");\n");
-                    impl_field.push_back(CodeTab + call_guard_name + "[IDX] = true;\n");
-                } else {
-                    impl_field.push_back(CodeTab + "assert(!" + call_guard_name + " && \"" + service_assert_msg + "\");\n");
-                    impl_field.push_back(CodeTab + call_guard_name + " = true;\n");
+                call_guard_lines();
+                if (capture) {
+                    // 服务体中的 return 只能结束 lambda，保证结果总会被记录
+                    capture_call_lines();
+                    impl_field.push_back(CodeTab + "[&]() {\n");
                 }
+                impl_field.push_back(alloc_scope_line(serv_entry.first));
                 vulDebugAppendLines(impl_field, impl_field_debug, lb_iter->second.codelines, lb_iter->second.codelines_debug);
+                if (capture) {
+                    impl_field.push_back(CodeTab + "}();\n");
+                    capture_return_lines();
+                }
                 impl_field.push_back("}\n");
             } else {
                 if (is_arrayed) {
@@ -1018,12 +1268,13 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
                     impl_field.push_back("template <uint32_t IDX>\n");
                 }
                 impl_field.push_back("bool " + mod_class_name + "::" + serv_entry.first + "(" + arglists + ") {\n");
-                if (is_arrayed) {
-                    impl_field.push_back(CodeTab + "assert(!" + call_guard_name + "[IDX] && \"" + service_assert_msg + " (for each array index)\");\n");
-                    impl_field.push_back(CodeTab + call_guard_name + "[IDX] = true;\n");
-                } else {
-                    impl_field.push_back(CodeTab + "assert(!" + call_guard_name + " && \"" + service_assert_msg + "\");\n");
-                    impl_field.push_back(CodeTab + call_guard_name + " = true;\n");
+                if (mod.clock_ratio > 1) {
+                    // 分频实例只在有效沿接受服务调用，其余周期返回未就绪，由调用方重试
+                    impl_field.push_back(CodeTab + "if (__clk_phase != 0) return false;\n");
+                }
+                call_guard_lines();
+                if (capture) {
+                    capture_call_lines();
                 }
                 if (is_arrayed) {
                     impl_field.push_back(CodeTab + "bool cond = __cond_" + serv_entry.first + "<IDX>(" + argnames + ");\n");
@@ -1032,6 +1283,9 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
                     impl_field.push_back(CodeTab + "bool cond = __cond_" + serv_entry.first + "(" + argnames + ");\n");
                     impl_field.push_back(CodeTab + "if (cond) __impl_" + serv_entry.first + "(" + argnames + ");\n");
                 }
+                if (capture) {
+                    capture_return_lines();
+                }
                 impl_field.push_back(CodeTab + "return cond;\n");
                 impl_field.push_back("}\n");
 
@@ -1039,6 +1293,7 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
                     impl_field.push_back("template <uint32_t IDX>\n");
                 }
                 impl_field.push_back("bool " + mod_class_name + "::__cond_" + serv_entry.first + "(" + arglists + ") {\n");
+                impl_field.push_back(alloc_scope_line("__cond_" + serv_entry.first));
                 vulDebugAppendLines(impl_field, impl_field_debug, lb_iter->second.cond_codelines, lb_iter->second.cond_codelines_debug);
                 impl_field.push_back("}\n");
 
@@ -1046,6 +1301,7 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
                     impl_field.push_back("template <uint32_t IDX>\n");
                 }
                 impl_field.push_back("void " + mod_class_name + "::__impl_" + serv_entry.first + "(" + arglists + ") {\n");
+                impl_field.push_back(alloc_scope_line(serv_entry.first));
                 vulDebugAppendLines(impl_field, impl_field_debug, lb_iter->second.codelines, lb_iter->second.codelines_debug);
                 impl_field.push_back("}\n");
             }
@@ -1064,8 +1320,42 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
             throw VulException("Missing logic block for query " + query_name);
         }
 
-        decl_public_field.push_back(query.ret_type.toString() + " " + query_name + "() const;\n");
-        impl_field.push_back(query.ret_type.toString() + " " + mod_class_name + "::" + query_name + "() const {\n");
+        const string rettype = query.ret_type.toString();
+        decl_public_field.push_back(rettype + " " + query_name + "() const;\n");
+        // 捕获时公开的 QUERY 只转发到原实现并记录返回值
+        string query_func = query_name;
+        if (capture) {
+            const StimulusPort &stim = stimulusFindPort(capture_ports, StimulusPort::Query, query_name);
+            query_func = "__capture_" + query_name;
+            decl_private_field.push_back(rettype + " " + query_func + "() const;\n");
+            impl_field.push_back(rettype + " " + mod_class_name + "::" + query_name + "() const {\n");
+            impl_field.push_back(CodeTab + "const " + rettype + " __ret = " + query_func + "();\n");
+            impl_field.push_back(CodeTab + "if (vul_capture.recording()) [[unlikely]] {\n");
+            impl_field.push_back(CodeTab + CodeTab + stimulusEventCall(stim, "", "vul_capture"));
+            stimulusPutFields(impl_field, stim.ret_fields, CodeTab + CodeTab, "vul_capture");
+            impl_field.push_back(CodeTab + "}\n");
+            impl_field.push_back(CodeTab + "return __ret;\n");
+            impl_field.push_back("}\n");
+        }
+        if (query.cached) {
+            // memoized within one cycle: state observed by a query only changes in apply_next_tick
+            // std::optional keeps the return type free of a default-constructible requirement
+            const string cache_name = "__query_cache_" + query_name;
+            decl_private_field.push_back("mutable std::optional<" + rettype + "> " + cache_name + ";\n");
+            decl_private_field.push_back(rettype + " __query_impl_" + query_name + "() const;\n");
+            impl_sys_reset_field.push_back(cache_name + ".reset();\n");
+            impl_commit_field.push_back(cache_name + ".reset();\n");
+            impl_field.push_back(rettype + " " + mod_class_name + "::" + query_func + "() const {\n");
+            impl_field.push_back(CodeTab + "if (!" + cache_name + ") {\n");
+            impl_field.push_back(CodeTab + CodeTab + cache_name + ".emplace(__query_impl_" + query_name + "());\n");
+            impl_field.push_back(CodeTab + "}\n");
+            impl_field.push_back(CodeTab + "return *" + cache_name + ";\n");
+            impl_field.push_back("}\n");
+            impl_field.push_back(rettype + " " + mod_class_name + "::__query_impl_" + query_name + "() const {\n");
+        } else {
+            impl_field.push_back(rettype + " " + mod_class_name + "::" + query_func + "() const {\n");
+        }
+        impl_field.push_back(alloc_scope_line(query_name));
         vulDebugAppendLines(impl_field, impl_field_debug, lb_iter->second.codelines, lb_iter->second.codelines_debug);
         impl_field.push_back("}\n");
         impl_field.push_back("\n");
@@ -1125,6 +1415,19 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
         impl_reg_reset_field.push_back("this->" + reg.name + "._reset();\n");
 
         impl_commit_field.push_back(reg.name + "." + ApplyTickFunctionName + "();\n");
+
+        if (mod.quiescent_timers.count(reg.name)) {
+            // 计时寄存器减到 0 的那个周期正常执行，唤醒设计
+            impl_quiescent_span_field.push_back(CodeTab + "if (" + reg.name + "._timer_counting()) {\n");
+            impl_quiescent_span_field.push_back(CodeTab + CodeTab + "limit = std::min(limit, " + reg.name + "._timer_span());\n");
+            impl_quiescent_span_field.push_back(CodeTab + CodeTab + "if (limit == 0) return 0;\n");
+            impl_quiescent_span_field.push_back(CodeTab + "} else if (!" + reg.name + "._quiescent()) {\n");
+            impl_quiescent_span_field.push_back(CodeTab + CodeTab + "return 0;\n");
+            impl_quiescent_span_field.push_back(CodeTab + "}\n");
+            impl_quiescent_skip_field.push_back(CodeTab + "if (" + reg.name + "._timer_counting()) " + reg.name + "._timer_skip(cycles);\n");
+        } else {
+            impl_quiescent_span_field.push_back(CodeTab + "if (!" + reg.name + "._quiescent()) return 0;\n");
+        }
     }
 
     // generate wire
@@ -1162,6 +1465,7 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
 
         decl_private_field.push_back(bram_class + " " + bram.name + ";\n");
         impl_commit_field.push_back(CodeTab + bram.name + "." + ApplyTickFunctionName + "();\n");
+        impl_quiescent_span_field.push_back(CodeTab + "if (!" + bram.name + "._quiescent()) return 0;\n");
     }
     // generate rom
     for (const auto &rom : mod.roms) {
@@ -1173,6 +1477,7 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
 
         decl_private_field.push_back(rom_class + " " + rom.name + "{\"" + rom.init_path + "\"};\n");
         impl_commit_field.push_back(CodeTab + rom.name + "." + ApplyTickFunctionName + "();\n");
+        impl_quiescent_span_field.push_back(CodeTab + "if (!" + rom.name + "._quiescent()) return 0;\n");
     }
 
     // generate queues
@@ -1192,6 +1497,31 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
         string queue_class = (is_multi_queue ? QueueMPClassName : QueueClassName) + "<" + queue_param + ">";
         decl_private_field.push_back(queue_class + " " + queue.name + ";\n");
         impl_commit_field.push_back(CodeTab + queue.name + "." + ApplyTickFunctionName + "();\n");
+        impl_quiescent_span_field.push_back(CodeTab + "if (!" + queue.name + "._quiescent()) return 0;\n");
+    }
+
+    // generate delay lines
+    for (const auto &line : mod.delay_lines) {
+        VulErrorContextGuard context_guard("processing delay line " + line.name);
+        string line_class;
+        if (line.width > 1) {
+            line_class = DelayLineMPClassName + "<" + line.type.toString() + ", " + std::to_string(line.latency) + ", " + std::to_string(line.width) + ">";
+        } else {
+            line_class = DelayLineClassName + "<" + line.type.toString() + ", " + std::to_string(line.latency) + ">";
+        }
+        decl_private_field.push_back(line_class + " " + line.name + ";\n");
+        impl_commit_field.push_back(CodeTab + line.name + "." + ApplyTickFunctionName + "();\n");
+        impl_quiescent_span_field.push_back(CodeTab + "if (!" + line.name + "._quiescent()) return 0;\n");
+    }
+
+    // generate CAMs
+    for (const auto &cam : mod.cams) {
+        VulErrorContextGuard context_guard("processing cam " + cam.name);
+        string cam_class = CAMClassName + "<" + cam.key_type.toString() + ", " + cam.value_type.toString() + ", " +
+            std::to_string(cam.entries) + ", " + std::to_string(cam.write_ports) + ">";
+        decl_private_field.push_back(cam_class + " " + cam.name + ";\n");
+        impl_commit_field.push_back(CodeTab + cam.name + "." + ApplyTickFunctionName + "();\n");
+        impl_quiescent_span_field.push_back(CodeTab + "if (!" + cam.name + "._quiescent()) return 0;\n");
     }
 
     // generate instances
@@ -1222,12 +1552,18 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
                 impl_init_field.push_back(init_call);
                 impl_commit_field.push_back(childPtrFieldName(inst_name, indices) + "->" + ApplyTickFunctionName + "();\n");
                 impl_sys_reset_field.push_back(childPtrFieldName(inst_name, indices) + "->reset();\n");
+                impl_quiescent_span_field.push_back(CodeTab + "limit = " + childPtrFieldName(inst_name, indices) + "->__quiescent_span(limit);\n");
+                impl_quiescent_span_field.push_back(CodeTab + "if (limit == 0) return 0;\n");
+                impl_quiescent_skip_field.push_back(CodeTab + childPtrFieldName(inst_name, indices) + "->__quiescent_skip(cycles);\n");
             });
         } else {
             decl_private_field.push_back("std::unique_ptr<" + child_class_name + "> " + child_instance_ptr_name + ";\n");
             impl_init_field.push_back(child_instance_ptr_name + " = std::make_unique<" + child_class_name + ">(this);\n");
             impl_commit_field.push_back(child_instance_ptr_name + "->" + ApplyTickFunctionName + "();\n");
             impl_sys_reset_field.push_back(child_instance_ptr_name + "->reset();\n");
+            impl_quiescent_span_field.push_back(CodeTab + "limit = " + child_instance_ptr_name + "->__quiescent_span(limit);\n");
+            impl_quiescent_span_field.push_back(CodeTab + "if (limit == 0) return 0;\n");
+            impl_quiescent_skip_field.push_back(CodeTab + child_instance_ptr_name + "->__quiescent_skip(cycles);\n");
         }
 
         // connected requests
@@ -1386,6 +1722,7 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
         decl_private_field.push_back("void " + tick_func_name + "();\n");
 
         impl_field.push_back("void " + mod_class_name + "::" + tick_func_name + "() {\n");
+        impl_field.push_back(alloc_scope_line(tick_func_name));
         vulDebugAppendLines(impl_field, impl_field_debug, tick.codelines, tick.codelines_debug);
         impl_field.push_back("}\n");
         impl_field.push_back("\n");
@@ -1525,6 +1862,8 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
     decl.push_back("void __reg_reset();\n");
     decl.push_back("void reset() { __sys_reset(); __reg_reset(); }\n");
     decl.push_back("void init();\n");
+    decl.push_back("uint64_t __quiescent_span(uint64_t limit) const;\n");
+    decl.push_back("void __quiescent_skip(uint64_t cycles);\n");
     decl.push_back("\n");
 
     // constructor declaration
@@ -1569,6 +1908,9 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
 
     // tick function implementations
     impl.push_back("void " + mod_class_name + "::" + TickFunctionName + "() {\n");
+    if (mod.clock_ratio > 1) {
+        impl.push_back(CodeTab + "if (__clk_phase != 0) return;\n");
+    }
     for (const auto &id : mod.update_seq) {
         if (id == mod.instance_id) {
             // tick functions here
@@ -1596,9 +1938,36 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
 
     // apply tick function implementations
     impl.push_back("void " + mod_class_name + "::" + ApplyTickFunctionName + "() {\n");
+    impl.push_back(alloc_scope_line(ApplyTickFunctionName));
+    if (mod.clock_ratio > 1) {
+        // 非有效沿跳过整个子树的提交，状态保持不变
+        impl.push_back(CodeTab + "const bool __clk_active = __clk_phase == 0;\n");
+        impl.push_back(CodeTab + "__clk_phase = (__clk_phase + 1 == " + std::to_string(mod.clock_ratio) + ") ? 0 : __clk_phase + 1;\n");
+        impl.push_back(CodeTab + "if (!__clk_active) return;\n");
+    }
     vulDebugAppendLines(impl, impl_debug, impl_commit_field, impl_commit_field_debug);
     impl.push_back("}\n");
 
+    // quiescence: called after on_current_tick() and before apply_next_tick(), returns 0 unless only timers count down
+    impl.push_back("uint64_t " + mod_class_name + "::__quiescent_span(uint64_t limit) const {\n");
+    if (mod.clock_ratio > 1) {
+        // 分频子树在不同相位上的行为不同，一个周期的静默不能推出之后的周期也静默
+        impl.push_back(CodeTab + "(void)limit;\n");
+        impl.push_back(CodeTab + "return 0;\n");
+    } else {
+        impl.insert(impl.end(), impl_quiescent_span_field.begin(), impl_quiescent_span_field.end());
+        impl.push_back(CodeTab + "return limit;\n");
+    }
+    impl.push_back("}\n");
+    impl.push_back("\n");
+    impl.push_back("void " + mod_class_name + "::__quiescent_skip(uint64_t cycles) {\n");
+    if (mod.clock_ratio <= 1) {
+        impl.insert(impl.end(), impl_quiescent_skip_field.begin(), impl_quiescent_skip_field.end());
+    }
+    impl.push_back(CodeTab + "(void)cycles;\n");
+    impl.push_back("}\n");
+    impl.push_back("\n");
+
     // sys reset function implementations
     impl.push_back("void " + mod_class_name + "::__sys_reset() {\n");
     impl.insert(impl.end(), impl_sys_reset_field.begin(), impl_sys_reset_field.end());
@@ -1635,9 +2004,11 @@ StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &mod, c
 StaticTestHarnessCodeHpp genStaticTestHarnessCodeHpp(
     const VulStaticTestHarnessModule &test_module,
     const VulStaticModuleInstance &top_module,
+    const VulStaticBundleLib &global_bundlelib,
     bool enable_tracing,
     const vector<VulBreakPointSpec> &break_specs,
-    uint64_t break_cycles
+    uint64_t break_cycles,
+    const VulStaticModuleInstance *capture_instance
 ) {
     
     vector<string> init_field;
@@ -1649,11 +2020,48 @@ StaticTestHarnessCodeHpp genStaticTestHarnessCodeHpp(
     vector<string> const_field;
 
     string child_instptr_name = "__instptr_top";
+    string class_name = top_module.parent->simClassName();
     string child_class_name = top_module.simClassName();
 
     member_field.push_back("std::unique_ptr<" + child_class_name + "> " + child_instptr_name + ";\n");
     init_field.push_back(CodeTab + child_instptr_name + " = std::make_unique<" + child_class_name + ">(this);\n");
 
+    VulStaticBundleLib bundlelib = top_module.local_bundles;
+    bundlelib.insert(bundlelib.end(), global_bundlelib.begin(), global_bundlelib.end());
+
+    // 激励录制与回放的端口表：请求、服务、QUERY 各自按名字排序
+    vector<StimulusPort> stim_ports;
+    std::map<std::pair<int, string>, size_t> stim_index;
+    auto add_stim_port = [&](StimulusPort port) {
+        port.tag = StimulusTagPortBase + stim_ports.size();
+        stim_index[{port.kind, port.name}] = stim_ports.size();
+        stim_ports.push_back(std::move(port));
+    };
+    for (const auto &[name, req] : std::map<string, VulTempReq>(test_module.requests.begin(), test_module.requests.end())) {
+        auto top_it = top_module.services.find(name);
+        if (top_it == top_module.services.end()) {
+            throw VulException("TestMain REQUEST '" + name + "' not found in top module '" + top_module.module_name + "'");
+        }
+        add_stim_port(stimulusReqServPort(StimulusPort::Request, name, req, top_it->second, bundlelib));
+    }
+    for (const auto &[name, serv] : std::map<string, VulTempServ>(test_module.services.begin(), test_module.services.end())) {
+        auto top_it = top_module.requests.find(name);
+        if (top_it == top_module.requests.end()) {
+            throw VulException("TestMain SERVICE '" + name + "' not found in top module '" + top_module.module_name + "'");
+        }
+        add_stim_port(stimulusReqServPort(StimulusPort::Service, name, serv, top_it->second, bundlelib));
+    }
+    for (const auto &[name, query] : std::map<string, VulStaticQuery>(test_module.queries.begin(), test_module.queries.end())) {
+        StimulusPort port;
+        port.kind = StimulusPort::Query;
+        port.name = name;
+        stimulusFlatten("__ret", query.ret_type, bundlelib, port.ret_decls, port.ret_fields);
+        add_stim_port(std::move(port));
+    }
+    auto stim_port = [&](StimulusPort::Kind kind, const string &name) -> const StimulusPort & {
+        return stim_ports[stim_index.at({kind, name})];
+    };
+
     for (const auto &req_entry : test_module.requests) {
         const auto &req = req_entry.second;
         string rettype = req.returnType();
@@ -1664,11 +2072,36 @@ StaticTestHarnessCodeHpp genStaticTestHarnessCodeHpp(
             member_field.push_back("template <uint32_t IDX = 0>\n");
         }
         member_field.push_back(rettype + " " + req_entry.first + "(" + arglists + ") {\n");
-        string return_prefix = (rettype == "void" ? "" : "return ");
-        if (is_arrayed) {
-            member_field.push_back(CodeTab + return_prefix + child_instptr_name + "->" + req_entry.first + "<IDX>(" + argnames + ");\n");
+        const string idx_suffix = is_arrayed ? "<IDX>" : "";
+        const StimulusPort &stim = stim_port(StimulusPort::Request, req_entry.first);
+        member_field.push_back(CodeTab + "__sim_active = true;\n");
+        // 录制时调用前写参数、返回后写结果，两者之间是请求处理过程中嵌套的服务调用
+        member_field.push_back(CodeTab + "if (vul_stimulus.recording()) [[unlikely]] {\n");
+        member_field.push_back(CodeTab + CodeTab + stimulusEventCall(stim, "IDX"));
+        stimulusPutFields(member_field, stim.arg_fields, CodeTab + CodeTab);
+        member_field.push_back(CodeTab + "}\n");
+        // 联合仿真构建中把请求与 VUL 侧的响应同步转发给 Verilator 影子模型
+        if (rettype == "void") {
+            member_field.push_back(CodeTab + child_instptr_name + "->" + req_entry.first + idx_suffix + "(" + argnames + ");\n");
+            member_field.push_back(CodeTab + "if (vul_stimulus.recording()) [[unlikely]] {\n");
+            member_field.push_back(CodeTab + CodeTab + "vul_stimulus.event(VulStimulusStream::TagResult);\n");
+            stimulusPutFields(member_field, stim.ret_fields, CodeTab + CodeTab);
+            member_field.push_back(CodeTab + "}\n");
+            member_field.push_back(CodeTab + "VUL_COSIM(vul_cosim.request_" + req_entry.first + idx_suffix + "(" + argnames + "));\n");
         } else {
-            member_field.push_back(CodeTab + return_prefix + child_instptr_name + "->" + req_entry.first + "(" + argnames + ");\n");
+            member_field.push_back(CodeTab + rettype + " __ret = " + child_instptr_name + "->" + req_entry.first + idx_suffix + "(" + argnames + ");\n");
+            member_field.push_back(CodeTab + "if (vul_stimulus.recording()) [[unlikely]] {\n");
+            member_field.push_back(CodeTab + CodeTab + "vul_stimulus.event(VulStimulusStream::TagResult);\n");
+            member_field.push_back(CodeTab + CodeTab + "vul_stimulus.put(__ret);\n");
+            if (!stim.ret_fields.empty()) {
+                // 握手失败时响应没有被写入，不记录
+                member_field.push_back(CodeTab + CodeTab + "if (__ret) {\n");
+                stimulusPutFields(member_field, stim.ret_fields, CodeTab + CodeTab + CodeTab);
+                member_field.push_back(CodeTab + CodeTab + "}\n");
+            }
+            member_field.push_back(CodeTab + "}\n");
+            member_field.push_back(CodeTab + "VUL_COSIM(vul_cosim.request_" + req_entry.first + idx_suffix + "(" + argnames + (argnames.empty() ? "" : ", ") + "__ret));\n");
+            member_field.push_back(CodeTab + "return __ret;\n");
         }
         member_field.push_back("}\n");
         member_field.push_back("\n");
@@ -1685,8 +2118,14 @@ StaticTestHarnessCodeHpp genStaticTestHarnessCodeHpp(
         if (!(decl_query.ret_type == top_query.ret_type)) {
             throw VulException("TestMain QUERY '" + query_name + "' return type mismatch with top module query");
         }
+        const StimulusPort &stim = stim_port(StimulusPort::Query, query_name);
         member_field.push_back(top_query.ret_type.toString() + " " + query_name + "() const {\n");
-        member_field.push_back(CodeTab + "return " + child_instptr_name + "->" + query_name + "();\n");
+        member_field.push_back(CodeTab + top_query.ret_type.toString() + " __ret = " + child_instptr_name + "->" + query_name + "();\n");
+        member_field.push_back(CodeTab + "if (vul_stimulus.recording()) [[unlikely]] {\n");
+        member_field.push_back(CodeTab + CodeTab + stimulusEventCall(stim, ""));
+        stimulusPutFields(member_field, stim.ret_fields, CodeTab + CodeTab);
+        member_field.push_back(CodeTab + "}\n");
+        member_field.push_back(CodeTab + "return __ret;\n");
         member_field.push_back("}\n");
         member_field.push_back("\n");
     }
@@ -1703,28 +2142,77 @@ StaticTestHarnessCodeHpp genStaticTestHarnessCodeHpp(
             public_member_field.push_back("template <uint32_t IDX = 0>\n");
         }
         public_member_field.push_back(rettype + " __wrapper_" + top_module.instance_path.back() + "_" + serve.first + "(" + arglists + ") {\n");
+        const StimulusPort &stim = stim_port(StimulusPort::Service, serv_name);
+        const string idx_suffix = is_arrayed ? "<IDX>" : "";
+        public_member_field.push_back(CodeTab + "__sim_active = true;\n");
+        // 回放时不执行 Main 的服务逻辑，检查参数后返回录制的握手结果与响应
+        public_member_field.push_back(CodeTab + "if (vul_stimulus.replaying()) [[unlikely]] {\n");
+        public_member_field.push_back(CodeTab + CodeTab + (serv.has_handshake ? "return " : "") + "__replay_" + serv_name + idx_suffix + "(" + argnames + ");\n");
+        if (!serv.has_handshake) {
+            public_member_field.push_back(CodeTab + CodeTab + "return;\n");
+        }
+        public_member_field.push_back(CodeTab + "}\n");
         if (serv.has_handshake) {
-            if (is_arrayed) {
-                public_member_field.push_back(CodeTab + "bool cond = __cond_" + serve.first + "<IDX>(" + argnames + ");\n");
-                public_member_field.push_back(CodeTab + "if (cond) __impl_" + serve.first + "<IDX>(" + argnames + ");\n");
-            } else {
-                public_member_field.push_back(CodeTab + "bool cond = __cond_" + serve.first + "(" + argnames + ");\n");
-                public_member_field.push_back(CodeTab + "if (cond) __impl_" + serve.first + "(" + argnames + ");\n");
+            public_member_field.push_back(CodeTab + "bool cond = __cond_" + serve.first + idx_suffix + "(" + argnames + ");\n");
+            public_member_field.push_back(CodeTab + "if (cond) __impl_" + serve.first + idx_suffix + "(" + argnames + ");\n");
+        } else {
+            public_member_field.push_back(CodeTab + "__impl_" + serve.first + idx_suffix + "(" + argnames + ");\n");
+        }
+        public_member_field.push_back(CodeTab + "if (vul_stimulus.recording()) [[unlikely]] {\n");
+        public_member_field.push_back(CodeTab + CodeTab + stimulusEventCall(stim, "IDX"));
+        stimulusPutFields(public_member_field, stim.arg_fields, CodeTab + CodeTab);
+        if (serv.has_handshake) {
+            public_member_field.push_back(CodeTab + CodeTab + "vul_stimulus.put(cond);\n");
+            if (!stim.ret_fields.empty()) {
+                public_member_field.push_back(CodeTab + CodeTab + "if (cond) {\n");
+                stimulusPutFields(public_member_field, stim.ret_fields, CodeTab + CodeTab + CodeTab);
+                public_member_field.push_back(CodeTab + CodeTab + "}\n");
             }
+        } else {
+            stimulusPutFields(public_member_field, stim.ret_fields, CodeTab + CodeTab);
+        }
+        public_member_field.push_back(CodeTab + "}\n");
+        if (serv.has_handshake) {
+            public_member_field.push_back(CodeTab + "VUL_COSIM(vul_cosim.service_" + serve.first + idx_suffix + "(" + argnames + (argnames.empty() ? "" : ", ") + "cond));\n");
             public_member_field.push_back(CodeTab + "return cond;\n");
         } else {
-            if (is_arrayed) {
-                public_member_field.push_back(CodeTab + "__impl_" + serve.first + "<IDX>(" + argnames + ");\n");
-            } else {
-                public_member_field.push_back(CodeTab + "__impl_" + serve.first + "(" + argnames + ");\n");
-            }
+            public_member_field.push_back(CodeTab + "VUL_COSIM(vul_cosim.service_" + serve.first + idx_suffix + "(" + argnames + "));\n");
         }
         public_member_field.push_back("}\n");
 
+        // 先回放录制在该服务调用之前的嵌套请求与 QUERY，再与录制的调用比较
+        if (is_arrayed) {
+            member_field.push_back("template <uint32_t IDX = 0>\n");
+        }
+        member_field.push_back(rettype + " __replay_" + serv_name + "(" + arglists + ") {\n");
+        member_field.push_back(CodeTab + "while (__replay_event(vul_stimulus.peek())) {\n");
+        member_field.push_back(CodeTab + "}\n");
+        member_field.push_back(CodeTab + "if (!vul_stimulus.expect(" + std::to_string(stim.tag) + ", " + (is_arrayed ? "IDX" : "-1") + ")) [[unlikely]] {\n");
+        member_field.push_back(CodeTab + CodeTab + "sim_replay_failed(__sim_cycles);\n");
+        member_field.push_back(CodeTab + "}\n");
+        stimulusCheckFields(member_field, stim.arg_fields, CodeTab);
+        member_field.push_back(CodeTab + "if (vul_stimulus.failed()) [[unlikely]] {\n");
+        member_field.push_back(CodeTab + CodeTab + "sim_replay_failed(__sim_cycles);\n");
+        member_field.push_back(CodeTab + "}\n");
+        if (serv.has_handshake) {
+            member_field.push_back(CodeTab + "bool cond = false;\n");
+            member_field.push_back(CodeTab + "vul_stimulus.get(cond);\n");
+            if (!stim.ret_fields.empty()) {
+                member_field.push_back(CodeTab + "if (cond) {\n");
+                stimulusGetFields(member_field, stim.ret_fields, CodeTab + CodeTab);
+                member_field.push_back(CodeTab + "}\n");
+            }
+            member_field.push_back(CodeTab + "return cond;\n");
+        } else {
+            stimulusGetFields(member_field, stim.ret_fields, CodeTab);
+        }
+        member_field.push_back("}\n");
+
         if (is_arrayed) {
             member_field.push_back("template <uint32_t IDX = 0>\n");
         }
         member_field.push_back("void __impl_" + serv_name + "(" + arglists + ") {\n");
+        member_field.push_back(CodeTab + "VUL_ALLOC_SCOPE(\"" + class_name + "::" + serv_name + "\");\n");
         vulDebugAppendLines(member_field, member_field_debug, serv.codelines, serv.codelines_debug);
         member_field.push_back("}\n");
         if (serv.has_handshake) {
@@ -1732,6 +2220,7 @@ StaticTestHarnessCodeHpp genStaticTestHarnessCodeHpp(
                 member_field.push_back("template <uint32_t IDX = 0>\n");
             }
             member_field.push_back("bool __cond_" + serv_name + "(" + arglists + ") {\n");
+            member_field.push_back(CodeTab + "VUL_ALLOC_SCOPE(\"" + class_name + "::__cond_" + serv_name + "\");\n");
             vulDebugAppendLine(member_field, member_field_debug, "return (" + serv.cond + ");\n", serv.cond_debug);
             member_field.push_back("}\n");
         }
@@ -1746,6 +2235,10 @@ StaticTestHarnessCodeHpp genStaticTestHarnessCodeHpp(
     out_lines.push_back("#include \"header.hpp\"\n");
     out_lines.push_back("#include \"vullib.h\"\n");
     out_lines.push_back("\n");
+    out_lines.push_back("#ifdef VULSIM_COSIM\n");
+    out_lines.push_back("#include \"VulCosim.hpp\"\n");
+    out_lines.push_back("#endif\n");
+    out_lines.push_back("\n");
 
     out_lines.push_back("#include \"" + top_module.simDeclPath() + "\"\n");
     out_lines.push_back("\n");
@@ -1755,7 +2248,6 @@ StaticTestHarnessCodeHpp genStaticTestHarnessCodeHpp(
     }
     out_lines.push_back("\n");
 
-    string class_name = top_module.parent->simClassName();
     out_lines.push_back("class " + class_name + " {\n");
 
     out_lines.push_back("protected:\n");
@@ -1790,21 +2282,200 @@ StaticTestHarnessCodeHpp genStaticTestHarnessCodeHpp(
     out_lines.push_back("}\n");
     out_lines.push_back("\n");
     out_lines.push_back("void simulation() {\n");
+    out_lines.push_back(CodeTab + "VUL_ALLOC_SCOPE(\"" + class_name + "::simulation\");\n");
     vulDebugAppendLines(out_lines, out_debug, simulation_field, simulation_field_debug);
     out_lines.push_back("}\n");
     out_lines.push_back("\n");
 
+    out_lines.push_back("uint64_t sim_cycles() const {\n");
+    out_lines.push_back(CodeTab + "return __sim_cycles;\n");
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+
+    // 回放：代替 simulation() 执行，按录制的顺序发出请求、推进周期，服务调用由 __replay_<服务名> 响应。
+    // 一个周期中第一次遇到服务调用事件时执行 sim_execute()，遇到周期计数时补齐 sim_execute() 并提交
+    uint64_t service_tag_begin = 4, service_tag_end = 4;
+    for (const auto &port : stim_ports) {
+        if (port.kind == StimulusPort::Request) {
+            service_tag_begin = service_tag_end = port.tag + 1;
+        } else if (port.kind == StimulusPort::Service) {
+            service_tag_end = port.tag + 1;
+        }
+    }
+    out_lines.push_back("void sim_replay() {\n");
+    out_lines.push_back(CodeTab + "bool executed = false;\n");
+    out_lines.push_back(CodeTab + "while (true) {\n");
+    out_lines.push_back(CodeTab + CodeTab + "const uint64_t tag = vul_stimulus.peek();\n");
+    out_lines.push_back(CodeTab + CodeTab + "if (tag == VulStimulusStream::TagCycles) {\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "if (!executed) {\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + CodeTab + "sim_execute();\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "}\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "vul_stimulus.take_cycle();\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "executed = false;\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "sim_commit();\n");
+    out_lines.push_back(CodeTab + CodeTab + "} else if (tag == VulStimulusStream::TagEnd) {\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "return;\n");
+    out_lines.push_back(CodeTab + CodeTab + "} else if (tag == VulStimulusStream::TagReset) {\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "vul_stimulus.take();\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "sim_reset();\n");
+    out_lines.push_back(CodeTab + CodeTab + "} else if (__replay_event(tag)) {\n");
+    out_lines.push_back(CodeTab + CodeTab + "} else if (tag >= " + std::to_string(service_tag_begin) + " && tag < " + std::to_string(service_tag_end) + ") {\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "if (executed) {\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + CodeTab + "vul_stimulus.report_missing(tag);\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + CodeTab + "sim_replay_failed(__sim_cycles);\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "}\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "executed = true;\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "sim_execute();\n");
+    out_lines.push_back(CodeTab + CodeTab + "} else {\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "vul_stimulus.report_corrupt(tag);\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "sim_replay_failed(__sim_cycles);\n");
+    out_lines.push_back(CodeTab + CodeTab + "}\n");
+    out_lines.push_back(CodeTab + "}\n");
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+
+    std::ostringstream signature_hex;
+    signature_hex << "0x" << std::hex << stimulusSignature(stim_ports) << "ULL";
+    out_lines.push_back("static_assert(VulStimulusStream::TagPortBase == " + std::to_string(StimulusTagPortBase) +
+                        ", \"stimulus port tags are numbered by vulsimgen\");\n");
+    out_lines.push_back("\n");
+    out_lines.push_back("static uint64_t sim_stimulus_signature() {\n");
+    out_lines.push_back(CodeTab + "return " + signature_hex.str() + ";\n");
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+    out_lines.push_back("static std::vector<std::string> sim_stimulus_ports() {\n");
+    out_lines.push_back(CodeTab + "return {\n");
+    for (const auto &port : stim_ports) {
+        out_lines.push_back(CodeTab + CodeTab + cppStringLiteral(port.label()) + ",\n");
+    }
+    out_lines.push_back(CodeTab + "};\n");
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+
+    // 实例边界捕获流的签名与端口，与 vulsimgen --isolate 为该实例生成的独立仿真一致；未选择捕获实例时端口为空
+    vector<StimulusPort> capture_ports;
+    if (capture_instance != nullptr) {
+        capture_ports = stimulusInstancePorts(*capture_instance, global_bundlelib);
+    }
+    std::ostringstream capture_signature_hex;
+    capture_signature_hex << "0x" << std::hex << stimulusSignature(capture_ports) << "ULL";
+    out_lines.push_back("static uint64_t sim_capture_signature() {\n");
+    out_lines.push_back(CodeTab + "return " + capture_signature_hex.str() + ";\n");
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+    out_lines.push_back("static std::vector<std::string> sim_capture_ports() {\n");
+    out_lines.push_back(CodeTab + "return {\n");
+    for (const auto &port : capture_ports) {
+        out_lines.push_back(CodeTab + CodeTab + cppStringLiteral(port.label()) + ",\n");
+    }
+    out_lines.push_back(CodeTab + "};\n");
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+
     out_lines.insert(out_lines.end(), public_member_field.begin(), public_member_field.end());
 
     out_lines.push_back("protected:\n");
     out_lines.push_back("\n");
 
+    // 已提交的周期数，sim_max_cycles 非零时到达上限即结束仿真
+    out_lines.push_back("uint64_t __sim_cycles = 0;\n");
+    out_lines.push_back("\n");
+
+    // 静默跳过：__sim_active 记录本周期 Main 是否发出请求或响应服务，__sim_skipped 为累计跳过的周期数
+    out_lines.push_back("bool __sim_skip_idle = false;\n");
+    out_lines.push_back("bool __sim_active = false;\n");
+    out_lines.push_back("uint64_t __sim_skipped = 0;\n");
+    out_lines.push_back("\n");
+
+    // sim_spawn() 加入的协程进程在每个周期开始、设计执行之前恢复一次，见 process.hpp
+    out_lines.push_back("VulProcessScheduler __sim_processes;\n");
+    out_lines.push_back("\n");
+
     out_lines.push_back("void sim_nextcycle() {\n");
+    out_lines.push_back(CodeTab + "__sim_processes.resume_all();\n");
     out_lines.push_back(CodeTab + "sim_execute();\n");
     out_lines.push_back(CodeTab + "sim_commit();\n");
     out_lines.push_back("}\n");
     out_lines.push_back("\n");
 
+    // 批量推进：循环体内联 execute/commit 与停止条件，不经过仿真入口的外层循环
+    // 开启静默跳过时，执行后、提交前检查整个设计是否只有计时寄存器在倒计数，是则把之后相同的周期折叠进本次提交
+    out_lines.push_back("template <typename StopPredicate>\n");
+    out_lines.push_back("VulRunResult sim_run(uint64_t max_cycles, StopPredicate &&stop) {\n");
+    out_lines.push_back(CodeTab + "uint64_t skipped = 0;\n");
+    out_lines.push_back(CodeTab + "for (uint64_t i = 0; i < max_cycles; ++i) {\n");
+    out_lines.push_back(CodeTab + CodeTab + "__sim_processes.resume_all();\n");
+    out_lines.push_back(CodeTab + CodeTab + "sim_execute();\n");
+    out_lines.push_back(CodeTab + CodeTab + "if (__sim_skip_idle) {\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "const uint64_t span = __sim_quiescent_span(max_cycles - i - 1);\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "if (span > 0) {\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + CodeTab + "__sim_skip(span);\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + CodeTab + "i += span;\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + CodeTab + "skipped += span;\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "}\n");
+    out_lines.push_back(CodeTab + CodeTab + "}\n");
+    out_lines.push_back(CodeTab + CodeTab + "sim_commit();\n");
+    out_lines.push_back(CodeTab + CodeTab + "if (stop()) [[unlikely]] {\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "return {VulRunStopped, i + 1, skipped};\n");
+    out_lines.push_back(CodeTab + CodeTab + "}\n");
+    out_lines.push_back(CodeTab + "}\n");
+    out_lines.push_back(CodeTab + "return {VulRunMaxCycles, max_cycles, skipped};\n");
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+    out_lines.push_back("VulRunResult sim_run(uint64_t max_cycles) {\n");
+    out_lines.push_back(CodeTab + "return sim_run(max_cycles, [] { return false; });\n");
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+
+    // 波形与联合仿真需要逐周期的记录，这两种构建中不跳过
+    out_lines.push_back("void sim_skip_idle(bool enable) {\n");
+    out_lines.push_back("#ifdef VULSIM_COSIM\n");
+    out_lines.push_back(CodeTab + "enable = false;\n");
+    out_lines.push_back("#endif\n");
+    out_lines.push_back(CodeTab + "__sim_skip_idle = " + string(enable_tracing ? "false && " : "") + "enable;\n");
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+    out_lines.push_back("uint64_t sim_skipped_cycles() const {\n");
+    out_lines.push_back(CodeTab + "return __sim_skipped;\n");
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+    // 本周期可以额外跳过的周期数：Main 的请求与服务、协程进程和激励录制都要求逐周期执行，
+    // 周期触发的事件（周期上限、遥测、快照、采样）最多落在跳过后提交的那个周期上，仍由 sim_commit() 触发
+    out_lines.push_back("uint64_t __sim_quiescent_span(uint64_t limit) const {\n");
+    out_lines.push_back(CodeTab + "if (__sim_active || !__sim_processes.empty() || vul_stimulus.recording()" + string(capture_instance != nullptr ? " || vul_capture.recording()" : "") + ") {\n");
+    out_lines.push_back(CodeTab + CodeTab + "return 0;\n");
+    out_lines.push_back(CodeTab + "}\n");
+    out_lines.push_back(CodeTab + "for (const uint64_t event : {sim_max_cycles, sim_telemetry_next, sim_snapshot_next, sim_sample_next}) {\n");
+    out_lines.push_back(CodeTab + CodeTab + "if (event > __sim_cycles) {\n");
+    out_lines.push_back(CodeTab + CodeTab + CodeTab + "limit = std::min(limit, event - __sim_cycles - 1);\n");
+    out_lines.push_back(CodeTab + CodeTab + "}\n");
+    out_lines.push_back(CodeTab + "}\n");
+    out_lines.push_back(CodeTab + "if (limit == 0) {\n");
+    out_lines.push_back(CodeTab + CodeTab + "return 0;\n");
+    out_lines.push_back(CodeTab + "}\n");
+    out_lines.push_back(CodeTab + "return " + child_instptr_name + "->__quiescent_span(limit);\n");
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+    out_lines.push_back("void __sim_skip(uint64_t cycles) {\n");
+    out_lines.push_back(CodeTab + child_instptr_name + "->__quiescent_skip(cycles);\n");
+    out_lines.push_back(CodeTab + "__sim_cycles += cycles;\n");
+    out_lines.push_back(CodeTab + "__sim_skipped += cycles;\n");
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+
+    out_lines.push_back("void sim_spawn(VulProcess &&process) {\n");
+    out_lines.push_back(CodeTab + "__sim_processes.spawn(std::move(process));\n");
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+    // 推进到所有进程结束，最后一个进程结束的周期同样执行并提交
+    out_lines.push_back("VulRunResult sim_run_processes(uint64_t max_cycles) {\n");
+    out_lines.push_back(CodeTab + "if (__sim_processes.empty()) {\n");
+    out_lines.push_back(CodeTab + CodeTab + "return {VulRunStopped, 0};\n");
+    out_lines.push_back(CodeTab + "}\n");
+    out_lines.push_back(CodeTab + "return sim_run(max_cycles, [this] { return __sim_processes.empty(); });\n");
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+
     out_lines.push_back("void sim_execute() {\n");
     out_lines.push_back(CodeTab + child_instptr_name + "->" + TickFunctionName + "();\n");
     out_lines.push_back("}\n");
@@ -1815,11 +2486,119 @@ StaticTestHarnessCodeHpp genStaticTestHarnessCodeHpp(
     if (enable_tracing) {
         out_lines.push_back(CodeTab + "trace_commit();\n");
     }
+    out_lines.push_back(CodeTab + "++__sim_cycles;\n");
+    out_lines.push_back(CodeTab + "__sim_active = false;\n");
+    out_lines.push_back(CodeTab + "VUL_ALLOC_CYCLE(__sim_cycles);\n");
+    out_lines.push_back(CodeTab + "VUL_COSIM(vul_cosim.commit(__sim_cycles, *" + child_instptr_name + "));\n");
+    out_lines.push_back(CodeTab + "if (vul_stimulus.recording()) [[unlikely]] {\n");
+    out_lines.push_back(CodeTab + CodeTab + "vul_stimulus.cycle();\n");
+    out_lines.push_back(CodeTab + "}\n");
+    if (capture_instance != nullptr) {
+        out_lines.push_back(CodeTab + "if (vul_capture.recording()) [[unlikely]] {\n");
+        out_lines.push_back(CodeTab + CodeTab + "vul_capture.cycle();\n");
+        out_lines.push_back(CodeTab + "}\n");
+    }
+    out_lines.push_back(CodeTab + "if (__sim_cycles == sim_telemetry_next) [[unlikely]] {\n");
+    out_lines.push_back(CodeTab + CodeTab + "sim_telemetry_update(__sim_cycles);\n");
+    out_lines.push_back(CodeTab + "}\n");
+    out_lines.push_back(CodeTab + "if (__sim_cycles == sim_snapshot_next) [[unlikely]] {\n");
+    out_lines.push_back(CodeTab + CodeTab + "sim_snapshot_take(__sim_cycles);\n");
+    out_lines.push_back(CodeTab + "}\n");
+    out_lines.push_back(CodeTab + "if (__sim_cycles == sim_sample_next) [[unlikely]] {\n");
+    out_lines.push_back(CodeTab + CodeTab + "sim_sample_event(__sim_cycles);\n");
+    out_lines.push_back(CodeTab + "}\n");
+    out_lines.push_back(CodeTab + "if (__sim_cycles == sim_max_cycles) [[unlikely]] {\n");
+    out_lines.push_back(CodeTab + CodeTab + "sim_cycle_limit_reached(__sim_cycles);\n");
+    out_lines.push_back(CodeTab + "}\n");
     out_lines.push_back("}\n");
     out_lines.push_back("\n");
 
     out_lines.push_back("void sim_reset() {\n");
     out_lines.push_back(CodeTab + child_instptr_name + "->reset();\n");
+    out_lines.push_back(CodeTab + "VUL_COSIM(vul_cosim.reset());\n");
+    out_lines.push_back(CodeTab + "if (vul_stimulus.recording()) [[unlikely]] {\n");
+    out_lines.push_back(CodeTab + CodeTab + "vul_stimulus.event(VulStimulusStream::TagReset);\n");
+    out_lines.push_back(CodeTab + "}\n");
+    if (capture_instance != nullptr) {
+        out_lines.push_back(CodeTab + "if (vul_capture.recording()) [[unlikely]] {\n");
+        out_lines.push_back(CodeTab + CodeTab + "vul_capture.event(VulStimulusStream::TagReset);\n");
+        out_lines.push_back(CodeTab + "}\n");
+    }
+    out_lines.push_back("}\n");
+    out_lines.push_back("\n");
+
+    // 回放一个请求或 QUERY 事件，不是这两类事件时返回 false
+    out_lines.push_back("bool __replay_event(uint64_t tag) {\n");
+    out_lines.push_back(CodeTab + "switch (tag) {\n");
+    for (const auto &port : stim_ports) {
+        if (port.kind == StimulusPort::Service) {
+            continue;
+        }
+        const string T1 = CodeTab + CodeTab;
+        out_lines.push_back(CodeTab + "case " + std::to_string(port.tag) + ": {\n");
+        out_lines.push_back(T1 + "vul_stimulus.take();\n");
+        if (port.kind == StimulusPort::Query) {
+            out_lines.push_back(T1 + "const auto __ret = " + port.name + "();\n");
+            out_lines.push_back(T1 + "vul_stimulus.begin(tag, -1);\n");
+            stimulusCheckFields(out_lines, port.ret_fields, T1);
+        } else {
+            string call_args;
+            if (port.is_arrayed) {
+                out_lines.push_back(T1 + "const uint32_t __idx = vul_stimulus.index();\n");
+            }
+            for (const auto &decl : port.arg_decls) {
+                out_lines.push_back(T1 + decl.second + " " + decl.first + " = {};\n");
+                call_args += (call_args.empty() ? "" : ", ") + decl.first;
+            }
+            for (const auto &decl : port.ret_decls) {
+                out_lines.push_back(T1 + decl.second + " " + decl.first + " = {};\n");
+                call_args += (call_args.empty() ? "" : ", ") + decl.first;
+            }
+            stimulusGetFields(out_lines, port.arg_fields, T1);
+            const string assign = port.has_handshake ? "__ret = " : "";
+            if (port.has_handshake) {
+                out_lines.push_back(T1 + "bool __ret = false;\n");
+            }
+            if (port.is_arrayed) {
+                out_lines.push_back(T1 + "switch (__idx) {\n");
+                for (uint32_t i = 0; i < port.array_size; ++i) {
+                    out_lines.push_back(T1 + "case " + std::to_string(i) + ":\n");
+                    out_lines.push_back(T1 + CodeTab + assign + port.name + "<" + std::to_string(i) + ">(" + call_args + ");\n");
+                    out_lines.push_back(T1 + CodeTab + "break;\n");
+                }
+                out_lines.push_back(T1 + "default:\n");
+                out_lines.push_back(T1 + CodeTab + "vul_stimulus.report_corrupt(tag);\n");
+                out_lines.push_back(T1 + CodeTab + "sim_replay_failed(__sim_cycles);\n");
+                out_lines.push_back(T1 + "}\n");
+            } else {
+                out_lines.push_back(T1 + assign + port.name + "(" + call_args + ");\n");
+            }
+            out_lines.push_back(T1 + "if (vul_stimulus.peek() != VulStimulusStream::TagResult) [[unlikely]] {\n");
+            out_lines.push_back(T1 + CodeTab + "vul_stimulus.report_corrupt(vul_stimulus.peek());\n");
+            out_lines.push_back(T1 + CodeTab + "sim_replay_failed(__sim_cycles);\n");
+            out_lines.push_back(T1 + "}\n");
+            out_lines.push_back(T1 + "vul_stimulus.take();\n");
+            out_lines.push_back(T1 + "vul_stimulus.begin(tag, " + string(port.is_arrayed ? "__idx" : "-1") + ");\n");
+            if (port.has_handshake) {
+                out_lines.push_back(T1 + "vul_stimulus.check(\"__ret\", __ret);\n");
+                if (!port.ret_fields.empty()) {
+                    out_lines.push_back(T1 + "if (__ret) {\n");
+                    stimulusCheckFields(out_lines, port.ret_fields, T1 + CodeTab);
+                    out_lines.push_back(T1 + "}\n");
+                }
+            } else {
+                stimulusCheckFields(out_lines, port.ret_fields, T1);
+            }
+        }
+        out_lines.push_back(T1 + "if (vul_stimulus.failed()) [[unlikely]] {\n");
+        out_lines.push_back(T1 + CodeTab + "sim_replay_failed(__sim_cycles);\n");
+        out_lines.push_back(T1 + "}\n");
+        out_lines.push_back(T1 + "return true;\n");
+        out_lines.push_back(CodeTab + "}\n");
+    }
+    out_lines.push_back(CodeTab + "default:\n");
+    out_lines.push_back(CodeTab + CodeTab + "return false;\n");
+    out_lines.push_back(CodeTab + "}\n");
     out_lines.push_back("}\n");
     out_lines.push_back("\n");
 
@@ -1835,16 +2614,20 @@ StaticTestHarnessCodeHpp genStaticTestHarnessCodeHpp(
 vector<string> genStaticTestHarnessHpp(
     const VulStaticTestHarnessModule &test_module,
     const VulStaticModuleInstance &top_module,
+    const VulStaticBundleLib &global_bundlelib,
     bool enable_tracing,
     const vector<VulBreakPointSpec> &break_specs,
-    uint64_t break_cycles
+    uint64_t break_cycles,
+    const VulStaticModuleInstance *capture_instance
 ) {
     return genStaticTestHarnessCodeHpp(
         test_module,
         top_module,
+        global_bundlelib,
         enable_tracing,
         break_specs,
-        break_cycles
+        break_cycles,
+        capture_instance
     ).codes;
 }
 
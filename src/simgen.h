@@ -62,14 +62,21 @@ struct StaticModuleCodeHpp {
     vector<string> resource_files;
 };
 
-StaticModuleCodeHpp genStaticModuleCodeHpp(const VulStaticModuleInstance &module_instance, const vector<VulTracedSignal> &traced_signals);
+// capture_global_bundlelib 非空时在该实例的边界上生成 vulsimgen --capture 的捕获代码
+StaticModuleCodeHpp genStaticModuleCodeHpp(
+    const VulStaticModuleInstance &module_instance,
+    const vector<VulTracedSignal> &traced_signals,
+    const VulStaticBundleLib *capture_global_bundlelib = nullptr
+);
 
 vector<string> genStaticTestHarnessHpp(
     const VulStaticTestHarnessModule &test_module,
     const VulStaticModuleInstance &top_module,
+    const VulStaticBundleLib &global_bundlelib,
     bool enable_tracing,
     const vector<VulBreakPointSpec> &break_specs,
-    uint64_t break_cycles
+    uint64_t break_cycles,
+    const VulStaticModuleInstance *capture_instance = nullptr // vulsimgen --capture 选中的实例
 );
 
 struct StaticTestHarnessCodeHpp {
@@ -81,9 +88,11 @@ struct StaticTestHarnessCodeHpp {
 StaticTestHarnessCodeHpp genStaticTestHarnessCodeHpp(
     const VulStaticTestHarnessModule &test_module,
     const VulStaticModuleInstance &top_module,
+    const VulStaticBundleLib &global_bundlelib,
     bool enable_tracing,
     const vector<VulBreakPointSpec> &break_specs,
-    uint64_t break_cycles
+    uint64_t break_cycles,
+    const VulStaticModuleInstance *capture_instance = nullptr // vulsimgen --capture 选中的实例
 );
 
 vector<string> genStaticTestMainHpp(shared_ptr<VulStaticModuleInstance> top_module);
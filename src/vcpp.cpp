@@ -554,7 +554,25 @@ public:
         context.temp.queries.push_back(std::move(query));
     }
 };
+class VCPPModuleQUERY_CACHED : public VCPPModuleHandler {
+public:
+    virtual string name() const { return "QUERY_CACHED"; }
+    virtual void run(VCPPModuleContext &context, const MacroEntry &entry) {
+        if (entry.args.size() != 2) {
+            throw VulException("QUERY_CACHED requires exactly 2 arguments at " + context.getOriginalPosition(entry.pos));
+        }
+        VulTempQuery query;
+        query.name = entry.args[0];
+        query.ret_type = entry.args[1];
+        query.cached = true;
+        query.codelines = entry.body;
+        query.codelines_debug = context.bodyDebugLocs(entry);
+        VulErrorContextGuard _err{"Processing QUERY_CACHED '" + query.name + "' at " + context.getOriginalPosition(entry.pos)};
+        context.temp.queries.push_back(std::move(query));
+    }
+};
 static VCPPModuleAutoRegisterHandler<VCPPModuleQUERY> _auto_register_QUERY_handler;
+static VCPPModuleAutoRegisterHandler<VCPPModuleQUERY_CACHED> _auto_register_QUERY_CACHED_handler;
 
 class VCPPModuleTICK_IMPL : public VCPPModuleHandler {
 public:
@@ -569,6 +587,37 @@ public:
 };
 static VCPPModuleAutoRegisterHandler<VCPPModuleTICK_IMPL> _auto_register_TICK_IMPL_handler;
 
+class VCPPModuleCLOCK_RATIO : public VCPPModuleHandler {
+public:
+    virtual string name() const { return "CLOCK_RATIO"; }
+    virtual void run(VCPPModuleContext &context, const MacroEntry &entry) {
+        if (entry.args.size() != 1) {
+            throw VulException("CLOCK_RATIO requires exactly 1 argument at " + context.getOriginalPosition(entry.pos));
+        }
+        if (!context.temp.clock_ratio.empty()) {
+            throw VulException("CLOCK_RATIO is declared more than once at " + context.getOriginalPosition(entry.pos));
+        }
+        context.temp.clock_ratio = entry.args[0];
+    }
+};
+static VCPPModuleAutoRegisterHandler<VCPPModuleCLOCK_RATIO> _auto_register_CLOCK_RATIO_handler;
+
+class VCPPModuleQUIESCENT_TIMER : public VCPPModuleHandler {
+public:
+    virtual string name() const { return "QUIESCENT_TIMER"; }
+    virtual void run(VCPPModuleContext &context, const MacroEntry &entry) {
+        if (entry.args.size() != 1) {
+            throw VulException("QUIESCENT_TIMER requires exactly 1 argument at " + context.getOriginalPosition(entry.pos));
+        }
+        const string reg_name = entry.args[0];
+        if (std::find(context.temp.quiescent_timers.begin(), context.temp.quiescent_timers.end(), reg_name) != context.temp.quiescent_timers.end()) {
+            throw VulException("QUIESCENT_TIMER '" + reg_name + "' is declared more than once at " + context.getOriginalPosition(entry.pos));
+        }
+        context.temp.quiescent_timers.push_back(reg_name);
+    }
+};
+static VCPPModuleAutoRegisterHandler<VCPPModuleQUIESCENT_TIMER> _auto_register_QUIESCENT_TIMER_handler;
+
 class VCPPModuleCHILD_INSTANCE : public VCPPModuleHandler {
 public:
     virtual string name() const { return "CHILD_INSTANCE"; }
@@ -843,11 +892,63 @@ public:
     }
 };
 
+class VCPPModuleDELAY_LINE : public VCPPModuleHandler {
+public:
+    virtual string name() const { return "DELAY_LINE"; }
+    virtual void run(VCPPModuleContext &context, const MacroEntry &entry) {
+        if (entry.args.size() != 3) {
+            throw VulException("DELAY_LINE requires exactly 3 arguments at " + context.getOriginalPosition(entry.pos));
+        }
+        VulTempDelayLine line;
+        line.name = entry.args[0];
+        line.type = entry.args[1];
+        line.latency = entry.args[2];
+        line.width = "";
+        context.temp.delay_lines.push_back(std::move(line));
+    }
+};
+
+class VCPPModuleDELAY_LINE_MP : public VCPPModuleHandler {
+public:
+    virtual string name() const { return "DELAY_LINE_MP"; }
+    virtual void run(VCPPModuleContext &context, const MacroEntry &entry) {
+        if (entry.args.size() != 4) {
+            throw VulException("DELAY_LINE_MP requires exactly 4 arguments at " + context.getOriginalPosition(entry.pos));
+        }
+        VulTempDelayLine line;
+        line.name = entry.args[0];
+        line.type = entry.args[1];
+        line.latency = entry.args[2];
+        line.width = entry.args[3];
+        context.temp.delay_lines.push_back(std::move(line));
+    }
+};
+
+class VCPPModuleCAM : public VCPPModuleHandler {
+public:
+    virtual string name() const { return "CAM"; }
+    virtual void run(VCPPModuleContext &context, const MacroEntry &entry) {
+        if (entry.args.size() != 5) {
+            throw VulException("CAM requires exactly 5 arguments at " + context.getOriginalPosition(entry.pos));
+        }
+        VulTempCAM cam;
+        cam.name = entry.args[0];
+        cam.key_type = entry.args[1];
+        cam.value_type = entry.args[2];
+        cam.entries = entry.args[3];
+        cam.write_ports = entry.args[4];
+        context.temp.cams.push_back(std::move(cam));
+    }
+};
+
 static VCPPModuleAutoRegisterHandler<VCPPModuleBRAM> _auto_register_BRAM_handler;
 static VCPPModuleAutoRegisterHandler<VCPPModuleBRAM_1RW> _auto_register_BRAM_1RW_handler;
 static VCPPModuleAutoRegisterHandler<VCPPModuleROM> _auto_register_ROM_handler;
 static VCPPModuleAutoRegisterHandler<VCPPModuleQUEUE> _auto_register_QUEUE_handler;
 static VCPPModuleAutoRegisterHandler<VCPPModuleQUEUE_MP> _auto_register_QUEUE_MP_handler;
+static VCPPModuleAutoRegisterHandler<VCPPModuleDELAY_LINE> _auto_register_DELAY_LINE_handler;
+static VCPPModuleAutoRegisterHandler<VCPPModuleDELAY_LINE_MP> _auto_register_DELAY_LINE_MP_handler;
+static VCPPModuleAutoRegisterHandler<VCPPModuleCAM> _auto_register_CAM_handler;
 
 class VCPPModuleHELPER : public VCPPModuleHandler {
 public:
@@ -1433,6 +1534,66 @@ static void parseProjectHeaders(
 }
 
 
+// 在顶层实例外包上 TestMain 与 SimTop 两个合成实例，把 Main 的请求与服务连接到顶层实例，再计算更新顺序
+static void _setupSimHierarchy(VulStaticProject &project, const string &main_file_path, VulInstanceID next_instance_id) {
+    shared_ptr<VulStaticModuleInstance> fake_main = std::make_shared<VulStaticModuleInstance>();
+    fake_main->instance_path = {"sim", "main"};
+    fake_main->module_name = "TestMain";
+    fake_main->instance_id = next_instance_id;
+    fake_main->tick_blocks.push_back(VulTickBlock());
+
+    shared_ptr<VulStaticModuleInstance> sim_top = std::make_shared<VulStaticModuleInstance>();
+    sim_top->instance_path = {"sim"};
+    sim_top->module_name = "SimTop";
+    sim_top->filepath = main_file_path;
+    sim_top->instance_id = next_instance_id + 1;
+    sim_top->tick_blocks.push_back(VulTickBlock());
+
+    for (const auto &req_entry: project.top_module_instance->requests) {
+        fake_main->services[req_entry.first] = req_entry.second;
+        VulLogicBlock logic_block;
+        logic_block.block_id = fake_main->services.size();
+        logic_block.with_priority = false;
+        fake_main->serv_logic_blocks[req_entry.first] = logic_block;
+        VulReqServConnection conn;
+        conn.req_instance = "top";
+        conn.req_name = req_entry.first;
+        conn.serv_instance = "main";
+        conn.serv_name = req_entry.first;
+        sim_top->req_connections.push_back(conn);
+    }
+    for (const auto &serv_entry: project.top_module_instance->services) {
+        fake_main->requests[serv_entry.first] = serv_entry.second;
+        LogicBlockCall call;
+        call.instance = "";
+        call.port = serv_entry.first;
+        fake_main->tick_blocks[0].call_requests.push_back(call);
+        VulReqServConnection conn;
+        conn.req_instance = "main";
+        conn.req_name = serv_entry.first;
+        conn.serv_instance = "top";
+        conn.serv_name = serv_entry.first;
+        sim_top->req_connections.push_back(conn);
+    }
+
+    VulStaticInstanceDecl main_decl;
+    main_decl.name = "main";
+    main_decl.module_name = "TestMain";
+    sim_top->instances["main"] = main_decl;
+    VulStaticInstanceDecl top_decl;
+    top_decl.name = "top";
+    top_decl.module_name = project.top_module_instance->module_name;
+    sim_top->instances["top"] = top_decl;
+
+    sim_top->children.push_back(fake_main);
+    sim_top->children.push_back(project.top_module_instance);
+
+    fake_main->parent = sim_top;
+    project.top_module_instance->parent = sim_top;
+
+    setupUpdateSequence(sim_top);
+}
+
 VulStaticProject parseVcppStaticProject(
     const string &project_dir,
     const string &top_file_path,
@@ -1650,64 +1811,96 @@ VulStaticProject parseVcppStaticProject(
 
     printf("Setting up simulation hierarchy and update sequence...\n");
 
-    shared_ptr<VulStaticModuleInstance> fake_main = std::make_shared<VulStaticModuleInstance>();
-    fake_main->instance_path = {"sim", "main"};
-    fake_main->module_name = "TestMain";
-    fake_main->instance_id = instance_count + 1;
-    fake_main->tick_blocks.push_back(VulTickBlock());
+    _setupSimHierarchy(project, main_file_path, instance_count + 1);
 
-    shared_ptr<VulStaticModuleInstance> sim_top = std::make_shared<VulStaticModuleInstance>();
-    sim_top->instance_path = {"sim"};
-    sim_top->module_name = "SimTop";
-    sim_top->filepath = main_file_path;
-    sim_top->instance_id = instance_count + 2;
-    sim_top->tick_blocks.push_back(VulTickBlock());
+    printf("Setup complete.\n");
 
-    for (const auto &req_entry: project.top_module_instance->requests) {
-        fake_main->services[req_entry.first] = req_entry.second;
-        VulLogicBlock logic_block;
-        logic_block.block_id = fake_main->services.size();
-        logic_block.with_priority = false;
-        fake_main->serv_logic_blocks[req_entry.first] = logic_block;
-        VulReqServConnection conn;
-        conn.req_instance = "top";
-        conn.req_name = req_entry.first;
-        conn.serv_instance = "main";
-        conn.serv_name = req_entry.first;
-        sim_top->req_connections.push_back(conn);
-    }
-    for (const auto &serv_entry: project.top_module_instance->services) {
-        fake_main->requests[serv_entry.first] = serv_entry.second;
-        LogicBlockCall call;
-        call.instance = "";
-        call.port = serv_entry.first;
-        fake_main->tick_blocks[0].call_requests.push_back(call);
-        VulReqServConnection conn;
-        conn.req_instance = "main";
-        conn.req_name = serv_entry.first;
-        conn.serv_instance = "top";
-        conn.serv_name = serv_entry.first;
-        sim_top->req_connections.push_back(conn);
-    }
+    return project;
+}
 
-    VulStaticInstanceDecl main_decl;
-    main_decl.name = "main";
-    main_decl.module_name = "TestMain";
-    sim_top->instances["main"] = main_decl;
-    VulStaticInstanceDecl top_decl;
-    top_decl.name = "top";
-    top_decl.module_name = project.top_module_instance->module_name;
-    sim_top->instances["top"] = top_decl;
+shared_ptr<VulStaticModuleInstance> findVcppStaticInstance(const VulStaticProject &project, const string &instance_path) {
+    std::deque<shared_ptr<VulStaticModuleInstance>> bfs_queue;
+    bfs_queue.push_back(project.top_module_instance);
+    string candidates;
+    while (!bfs_queue.empty()) {
+        auto inst = bfs_queue.front();
+        bfs_queue.pop_front();
+        const string path = inst->concatInstancePath(".");
+        if (path == instance_path) {
+            return inst;
+        }
+        candidates += "\n  " + path + " [" + inst->module_name + "]";
+        for (const auto &child : inst->children) {
+            bfs_queue.push_back(child);
+        }
+    }
+    throw VulException("Instance '" + instance_path + "' not found, available instances:" + candidates);
+}
 
-    sim_top->children.push_back(fake_main);
-    sim_top->children.push_back(project.top_module_instance);
+void isolateVcppStaticInstance(VulStaticProject &project, const string &instance_path) {
+    auto target = findVcppStaticInstance(project, instance_path);
+    if (target == project.top_module_instance) {
+        throw VulException("Instance '" + instance_path + "' is already the top module");
+    }
+    if (!target->instance_array_indices.empty()) {
+        throw VulException("Isolating an element of an instance array is not supported: '" + instance_path + "'");
+    }
+    VulErrorContextGuard _err{"isolating instance " + instance_path + " of module " + target->module_name};
 
-    fake_main->parent = sim_top;
-    project.top_module_instance->parent = sim_top;
+    const VulInstanceID next_instance_id = project.top_module_instance->parent->instance_id + 1;
+    const string main_file_path = project.top_module_instance->parent->filepath;
 
-    setupUpdateSequence(sim_top);
+    // 把目标实例及其子树的实例路径前缀换成 sim::top，生成的类名与文件路径与以该模块为顶层时一致
+    const size_t old_prefix_len = target->instance_path.size();
+    std::deque<shared_ptr<VulStaticModuleInstance>> bfs_queue;
+    bfs_queue.push_back(target);
+    while (!bfs_queue.empty()) {
+        auto inst = bfs_queue.front();
+        bfs_queue.pop_front();
+        vector<InstanceName> path = {"sim", "top"};
+        path.insert(path.end(), inst->instance_path.begin() + old_prefix_len, inst->instance_path.end());
+        inst->instance_path = std::move(path);
+        for (const auto &child : inst->children) {
+            bfs_queue.push_back(child);
+        }
+    }
+    target->parent.reset();
+    target->instance_decl_name.clear();
+    project.top_module_instance = target;
 
-    printf("Setup complete.\n");
+    // 合成只用于回放的 TestMain：请求对应目标实例的服务，服务对应目标实例的请求，参数名取自目标模块
+    auto to_temp = [](const VulStaticReqServ &port, VulTempReqServBase &temp) {
+        temp.name = port.name;
+        temp.array_size = port.is_arrayed ? std::to_string(port.array_size) : "";
+        temp.has_handshake = port.has_handshake;
+        for (const auto &arg : port.args) {
+            temp.args.push_back({arg.type.toString(), arg.name});
+        }
+        for (const auto &ret : port.rets) {
+            temp.rets.push_back({ret.type.toString(), ret.name});
+        }
+    };
+    VulStaticTestHarnessModule harness;
+    harness.top_module_path = project.test_harness.top_module_path;
+    harness.project_dir_path = project.test_harness.project_dir_path;
+    for (const auto &[name, serv] : target->services) {
+        VulTempReq req;
+        to_temp(serv, req);
+        harness.requests[name] = std::move(req);
+    }
+    for (const auto &[name, req] : target->requests) {
+        VulTempServ serv;
+        to_temp(req, serv);
+        serv.cond = "false";
+        harness.services[name] = std::move(serv);
+    }
+    harness.queries.insert(target->queries.begin(), target->queries.end());
+    harness.includedHeaders = {"cstdio", "cstdlib"};
+    harness.test_codelines = {
+        "    std::fprintf(stderr, \"[vulsim] isolated simulator of " + instance_path + " must be driven by VULSIM_REPLAY=<capture file>\\n\");\n",
+        "    std::exit(2);\n",
+    };
+    project.test_harness = std::move(harness);
 
-    return project;
+    _setupSimHierarchy(project, main_file_path, next_instance_id);
 }
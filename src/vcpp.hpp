@@ -30,3 +30,10 @@ VulStaticProject parseVcppStaticProject(
     const string &top_file,
     const string &main_file
 );
+
+// 按实例路径（如 top.core.lsu0）查找实例，找不到时抛出异常并列出所有实例
+shared_ptr<VulStaticModuleInstance> findVcppStaticInstance(const VulStaticProject &project, const string &instance_path);
+
+// 把项目改写为以指定实例为顶层的独立仿真：保留该实例实例化后的参数，合成一个只用于回放的 TestMain，
+// 其请求、服务与 QUERY 与该实例的边界一一对应，由 vulsimgen --capture 录制的边界流驱动
+void isolateVcppStaticInstance(VulStaticProject &project, const string &instance_path);
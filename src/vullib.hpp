@@ -26,20 +26,41 @@
 #include <array>
 #include <string_view>
 
-inline constexpr std::array<std::string_view, 8> VulLibFiles = {
+inline constexpr std::array<std::string_view, 19> VulLibFiles = {
     "vullib.h",
     "common.h",
     "queue.hpp",
+    "delayline.hpp",
+    "cam.hpp",
     "ram.hpp",
     "storage.hpp",
     "fixint.hpp",
     "vcdrecord.hpp",
+    "alloctrack.hpp",
+    "telemetry.hpp",
+    "snapshot.hpp",
+    "sample.hpp",
+    "cosim.hpp",
+    "sparsemem.hpp",
+    "stimulus.hpp",
+    "process.hpp",
+    "runresult.hpp",
     "main.cpp",
 };
 
-inline constexpr std::array<std::string_view, 2> VulRTLLibFiles = {
+inline constexpr std::array<std::string_view, 4> VulRTLLibFiles = {
     "ram_generic.sv",
     "queue.sv",
+    "delayline.sv",
+    "cam.sv",
+};
+
+// vulrtlgen --rtllib verilator 使用的等价实现，存储阵列按写使能逐项更新，便于 Verilator 优化
+inline constexpr std::array<std::string_view, 4> VulRTLVerilatorLibFiles = {
+    "ram_verilator.sv",
+    "queue_verilator.sv",
+    "delayline.sv",
+    "cam.sv",
 };
 
 inline constexpr std::array<std::string_view, 4> VulEscapedHeaders = {
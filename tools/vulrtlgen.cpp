@@ -56,6 +56,9 @@ int main(int argc, char * argv[]) {
     parser.add_argument("-p", "--project")
         .help("sets the project directory (default: parent directory of the top module file)")
         .default_value(std::string(""));
+    parser.add_argument("--rtllib")
+        .help("selects the vullib queue/RAM implementation copied to the output: generic or verilator (default: generic)")
+        .default_value(std::string("generic"));
     parser.add_argument("--v1")
         .help("use experimental RTL generator v1 path")
         .default_value(false)
@@ -78,6 +81,11 @@ int main(int argc, char * argv[]) {
     string out_dir = parser.get<std::string>("--out");
     string proj_dir = parser.get<std::string>("--project");
     string lib_dir = parser.get<std::string>("--lib");
+    string rtllib = parser.get<std::string>("--rtllib");
+    if (rtllib != "generic" && rtllib != "verilator") {
+        std::cerr << "Error: --rtllib must be generic or verilator, got: " << rtllib << std::endl;
+        return 1;
+    }
     bool use_v1 = parser.get<bool>("--v1");
     bool explicit_v2 = parser.get<bool>("--v2");
     if (use_v1 && explicit_v2) {
@@ -185,6 +193,76 @@ int main(int argc, char * argv[]) {
         VulErrorContextGuard _err("generating Verilator TestMain cpp");
         vector<string> testmain_code = rtlgen::genVerilatorTestMainCpp(project);
         writeLinesToFile(testmain_code, (out_path / "VulTestMain.cpp").string());
+        writeLinesToFile(rtlgen::genVerilatorCosimHpp(project), (out_path / "VulCosim.hpp").string());
+        // 仿真入口可以使用的 vullib 头文件，Verilator 主函数直接包含
+        for (const char *lib_file : {"sparsemem.hpp", "process.hpp", "runresult.hpp"}) {
+            const std::filesystem::path src_file = std::filesystem::path(lib_dir) / lib_file;
+            if (!std::filesystem::exists(src_file) || !std::filesystem::is_regular_file(src_file)) {
+                throw VulException("Runtime library file does not exist: " + src_file.string());
+            }
+            std::filesystem::copy_file(src_file, out_path / lib_file);
+        }
+
+        // Verilator 构建：默认单线程 -O3，可通过 make 变量开启多线程模型与分层 verilation
+        const string top_name = project.top_module_instance->simClassName();
+        std::ofstream makefile((out_path / "Makefile").string());
+        if (!makefile.is_open()) {
+            throw VulException("Failed to create Verilator Makefile.");
+        }
+        makefile << "# Verilator build for " << top_name << ", generated by VulSim RTLGen tool.\n";
+        makefile << "#   make                        build obj_dir/V" << top_name << " (-O3, single-threaded model)\n";
+        makefile << "#   make THREADS=4              multithreaded model (--threads)\n";
+        makefile << "#   make HIER_BLOCKS=\"A B\"      verilate modules A and B as separate hierarchical blocks\n";
+        makefile << "#   make run CYCLES=1000000     run with VULSIM_MAX_CYCLES and print the cycles/seconds report\n";
+        makefile << "#   make cosim VULSIM_DIR=DIR   lockstep co-simulation binary obj_cosim/cosim, DIR is the vulsimgen output\n";
+        makefile << "#                               directory of the same TestMain\n";
+        makefile << "TOP ?= " << top_name << "\n";
+        makefile << "VERILATOR ?= verilator\n";
+        makefile << "THREADS ?= 1\n";
+        makefile << "HIER_BLOCKS ?=\n";
+        makefile << "CXXOPT ?= -O3 -march=native\n";
+        makefile << "JOBS ?= $(shell nproc)\n";
+        makefile << "CYCLES ?=\n";
+        makefile << "VULSIM_DIR ?= ../simout\n";
+        makefile << "VERILATOR_INC = $(shell $(VERILATOR) --getenv VERILATOR_ROOT)/include\n";
+        makefile << "\n";
+        makefile << "SV_SRCS := $(shell find . -name '*.sv' -not -path './obj_dir/*' | sort)\n";
+        makefile << "VFLAGS := --cc --exe --build -j $(JOBS) --top-module $(TOP) -Mdir obj_dir -o V$(TOP) \\\n";
+        makefile << "    -O3 --x-assign fast --x-initial fast --noassert -Wno-fatal \\\n";
+        makefile << "    -CFLAGS \"-std=c++20 $(CXXOPT) -I$(CURDIR)\"\n";
+        makefile << "ifneq ($(THREADS),1)\n";
+        makefile << "VFLAGS += --threads $(THREADS)\n";
+        makefile << "endif\n";
+        // --hierarchical 不带参数，hier_block 配置以 .vlt 文件作为单独的输入文件传入
+        makefile << "HIER_VLT :=\n";
+        makefile << "ifneq ($(strip $(HIER_BLOCKS)),)\n";
+        makefile << "VFLAGS += --hierarchical\n";
+        makefile << "HIER_VLT := obj_dir/hier_blocks.vlt\n";
+        makefile << "endif\n";
+        makefile << "\n";
+        makefile << ".PHONY: all run cosim clean\n";
+        makefile << "all: obj_dir/V$(TOP)\n";
+        makefile << "\n";
+        makefile << "obj_dir/V$(TOP): $(SV_SRCS) VulTestMain.cpp Makefile\n";
+        makefile << "\t@mkdir -p obj_dir\n";
+        makefile << "\t@{ echo '`verilator_config'; for m in $(HIER_BLOCKS); do echo \"hier_block -module \\\"$$m\\\"\"; done; } > obj_dir/hier_blocks.vlt\n";
+        makefile << "\t$(VERILATOR) $(VFLAGS) $(HIER_VLT) $(SV_SRCS) VulTestMain.cpp\n";
+        makefile << "\n";
+        makefile << "run: obj_dir/V$(TOP)\n";
+        makefile << "\tVULSIM_MAX_CYCLES=$(CYCLES) ./obj_dir/V$(TOP)\n";
+        makefile << "\n";
+        makefile << "# 联合仿真：Verilated 模型编译为静态库，与 -DVULSIM_COSIM 构建的 VUL 仿真程序链接到同一个进程\n";
+        makefile << "cosim: obj_cosim/cosim\n";
+        makefile << "\n";
+        makefile << "obj_cosim/cosim: $(SV_SRCS) VulCosim.hpp Makefile $(wildcard $(VULSIM_DIR)/*.hpp $(VULSIM_DIR)/sim/*.hpp)\n";
+        makefile << "\t$(VERILATOR) --cc --build -j $(JOBS) --top-module $(TOP) -Mdir obj_cosim \\\n";
+        makefile << "\t    -O3 --x-assign fast --x-initial fast --noassert -Wno-fatal -CFLAGS \"-std=c++20 $(CXXOPT)\" $(SV_SRCS)\n";
+        makefile << "\t$(CXX) -std=c++20 $(CXXOPT) -DVULSIM_COSIM -I$(VULSIM_DIR) -I. -Iobj_cosim -I$(VERILATOR_INC) -I$(VERILATOR_INC)/vltstd \\\n";
+        makefile << "\t    $(VULSIM_DIR)/main.cpp obj_cosim/V$(TOP)__ALL.a obj_cosim/libverilated.a -pthread -o obj_cosim/cosim\n";
+        makefile << "\n";
+        makefile << "clean:\n";
+        makefile << "\trm -rf obj_dir obj_cosim\n";
+        makefile.close();
     }
 
     // copy vullib files to output directory
@@ -195,7 +273,8 @@ int main(int argc, char * argv[]) {
         if (!std::filesystem::exists(lib_path) || !std::filesystem::is_directory(lib_path)) {
             throw VulException("Library directory does not exist: " + lib_dir);
         }
-        for (const auto &filename : VulRTLLibFiles) {
+        const auto &rtl_lib_files = (rtllib == "verilator") ? VulRTLVerilatorLibFiles : VulRTLLibFiles;
+        for (const auto &filename : rtl_lib_files) {
             std::filesystem::path src_file = lib_path / filename;
             if (!std::filesystem::exists(src_file) || !std::filesystem::is_regular_file(src_file)) {
                 throw VulException("Runtime library file does not exist: " + src_file.string());
@@ -50,6 +50,9 @@ struct SimGenArgs {
     std::string break_file;
     std::string break_line;
     uint64_t break_cycles = 1024;
+    std::string capture_instance;
+    std::string isolate_instance;
+    std::string profile = "checked";
 };
 
 int simgenStatic(const SimGenArgs &args) {
@@ -80,6 +83,22 @@ int simgenStatic(const SimGenArgs &args) {
     VulErrorContextGuard _err{"generating project from " + main_path.parent_path().string()};
     VulStaticProject project = parseVcppStaticProject(proj_dir, top_file, main_path.string());
 
+    if (args.profile != "checked" && args.profile != "unchecked") {
+        throw VulException("Unknown build profile: " + args.profile + " (expected checked or unchecked)");
+    }
+    if (!args.capture_instance.empty() && !args.isolate_instance.empty()) {
+        throw VulException("--capture and --isolate cannot be used together");
+    }
+    // 边界捕获：在选中实例的服务、请求与 QUERY 上生成写入 vul_capture 的代码
+    shared_ptr<VulStaticModuleInstance> capture_instance;
+    if (!args.capture_instance.empty()) {
+        capture_instance = findVcppStaticInstance(project, args.capture_instance);
+    }
+    // 独立仿真：以选中实例为顶层，TestMain 只回放该实例的边界捕获流
+    if (!args.isolate_instance.empty()) {
+        isolateVcppStaticInstance(project, args.isolate_instance);
+    }
+
     std::filesystem::path effective_top_path;
     if (!top_file.empty()) {
         effective_top_path = std::filesystem::path(top_file);
@@ -212,7 +231,10 @@ int simgenStatic(const SimGenArgs &args) {
 
         VulErrorContextGuard _err("generating code for module instance: " + mod_instance->simClassName());
 
-        auto codes = simgen::genStaticModuleCodeHpp(*mod_instance, trace_table[mod_instance->instance_id]);
+        auto codes = simgen::genStaticModuleCodeHpp(
+            *mod_instance, trace_table[mod_instance->instance_id],
+            mod_instance == capture_instance ? &project.global_bundlelib : nullptr
+        );
         writeLinesToFile(codes.decl, (out_path / decl_path).string());
         vulDebugWriteMapToFile(codes.decl_debug_lines, (out_path / (decl_path + ".dbgmap")).string());
         const auto impl_path = mod_instance->simImplPath();
@@ -234,10 +256,11 @@ int simgenStatic(const SimGenArgs &args) {
         VulErrorContextGuard _err("generating test harness code");
 
         auto testharness_code = simgen::genStaticTestHarnessCodeHpp(
-            project.test_harness, *project.top_module_instance,
+            project.test_harness, *project.top_module_instance, project.global_bundlelib,
             /*enable_tracing=*/trace_matchers.size() > 0,
             break_specs,
-            args.break_cycles
+            args.break_cycles,
+            capture_instance.get()
         );
         const auto harness_path = project.top_module_instance->parent->simDeclPath();
         writeLinesToFile(testharness_code.codes, (out_path / harness_path).string());
@@ -271,8 +294,10 @@ int simgenStatic(const SimGenArgs &args) {
     }
 
     // generate build script
-    string projname = main_path.stem().string();
-    string build_cmd = "g++ -std=c++20 -g -O2 main.cpp -I. -o " + projname;
+    string projname = args.isolate_instance.empty() ? main_path.stem().string() : project.top_module_instance->module_name;
+    // unchecked 构建档位：去掉每周期调用次数检查的状态与提交时复位，其余断言保留
+    string profile_flags = args.profile == "unchecked" ? "-DVULSIM_UNCHECKED " : "";
+    string build_cmd = "g++ -std=c++20 -g -O2 " + profile_flags + "main.cpp -I. -o " + projname;
     std::ofstream build_script((out_path / "build.sh").string());
     if (!build_script.is_open()) {
         throw VulException("Failed to create build script.");
@@ -284,7 +309,7 @@ int simgenStatic(const SimGenArgs &args) {
     build_script << "popd\n";
     build_script.close();
 
-    string build_cmd_o3 = "g++ -std=c++20 -O3 main.cpp -I. -o " + projname + "_O3";
+    string build_cmd_o3 = "g++ -std=c++20 -O3 " + profile_flags + "main.cpp -I. -o " + projname + "_O3";
     std::ofstream build_script_o3((out_path / "release.sh").string());
     if (!build_script_o3.is_open()) {
         throw VulException("Failed to create O3 build script.");
@@ -296,13 +321,26 @@ int simgenStatic(const SimGenArgs &args) {
     build_script_o3 << "popd\n";
     build_script_o3.close();
 
+    // 堆分配统计构建：接管 malloc，报告预热后每个生成函数中的分配次数
+    string alloc_cmd = "g++ -std=c++20 -O2 -DVULSIM_ALLOC_TRACK " + profile_flags + "main.cpp -I. -o " + projname + "_alloc";
+    std::ofstream alloc_script((out_path / "alloctrack.sh").string());
+    if (!alloc_script.is_open()) {
+        throw VulException("Failed to create alloc tracking build script.");
+    }
+    alloc_script << "#!/bin/bash\necho \"Building " << projname << " with heap allocation tracking\"\n";
+    alloc_script << "SCRIPT_DIR=\"$(cd \"$(dirname \"${BASH_SOURCE[0]}\")\" && pwd)\"\n";
+    alloc_script << "pushd \"$SCRIPT_DIR\"\n";
+    alloc_script << alloc_cmd << "\n";
+    alloc_script << "popd\n";
+    alloc_script.close();
+
     string debug_cmd =
         "g++ -std=c++20 -g -O1 "
         "-fsanitize=address,undefined,leak "
         "-fno-omit-frame-pointer "
         "-Wall -Wextra -Wpedantic -Wconversion -Wsign-conversion "
         "-Wshadow -Wnull-dereference -Wdouble-promotion -Wformat=2 "
-        "-Wundef -Wuninitialized -Werror "
+        "-Wundef -Wuninitialized -Werror " + profile_flags +
         "main.cpp -I. -o " + projname + "_debug";
     std::ofstream debug_script((out_path / "debug.sh").string());
     if (!debug_script.is_open()) {
@@ -354,6 +392,15 @@ int main(int argc, char * argv[]) {
         .help("number of recent cycles buffered for breakpoint waveform dump")
         .scan<'u', uint64_t>()
         .default_value(uint64_t(64));
+    parser.add_argument("--capture")
+        .help("records the REQUEST/SERVICE/QUERY traffic of one instance (e.g. top.lsu0) to $VULSIM_CAPTURE at run time")
+        .default_value(std::string(""));
+    parser.add_argument("--isolate")
+        .help("generates a standalone simulator of one instance (e.g. top.lsu0) driven by its capture via $VULSIM_REPLAY")
+        .default_value(std::string(""));
+    parser.add_argument("--profile")
+        .help("build profile of the generated simulator: checked (default) keeps the once-per-cycle call checks, unchecked removes them")
+        .default_value(std::string("checked"));
     parser.add_argument("--dynamic")
         .help("generate dynamic simulation code instead of static code")
         .default_value(false)
@@ -376,7 +423,10 @@ int main(int argc, char * argv[]) {
     string break_file = parser.get<std::string>("--breakfile");
     string break_line = parser.get<std::string>("--break");
     uint64_t break_cycles = parser.get<uint64_t>("--breakcycles");
-    SimGenArgs args{top_file, main_file, proj_dir, out_dir, lib_dir, trace_file, trace_line, break_file, break_line, break_cycles};
+    string capture_instance = parser.get<std::string>("--capture");
+    string isolate_instance = parser.get<std::string>("--isolate");
+    string profile = parser.get<std::string>("--profile");
+    SimGenArgs args{top_file, main_file, proj_dir, out_dir, lib_dir, trace_file, trace_line, break_file, break_line, break_cycles, capture_instance, isolate_instance, profile};
 
     try{
         return simgenStatic(args);
@@ -0,0 +1,169 @@
+
+#include "argparse.hpp"
+
+#include "../vullib/telemetry.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <signal.h>
+
+// 监视一个或多个开启了 VULSIM_TELEMETRY 的仿真进程，只读映射其遥测页，不影响仿真速度
+
+namespace {
+
+struct WatchEntry {
+    std::string path;
+    VulTelemetryReader reader;
+};
+
+std::vector<std::string> discover_pages(const std::string &dir) {
+    std::vector<std::string> paths;
+    std::error_code ec;
+    for (const auto &entry : std::filesystem::directory_iterator(dir, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (entry.is_regular_file() && name.rfind("vulsim.", 0) == 0) {
+            paths.push_back(entry.path().string());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+bool process_alive(int64_t pid) {
+    return pid > 0 && (kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM);
+}
+
+std::string format_rate(double rate) {
+    char buf[32];
+    if (rate >= 1e6) {
+        std::snprintf(buf, sizeof(buf), "%.2fM", rate / 1e6);
+    } else if (rate >= 1e3) {
+        std::snprintf(buf, sizeof(buf), "%.2fK", rate / 1e3);
+    } else {
+        std::snprintf(buf, sizeof(buf), "%.0f", rate);
+    }
+    return buf;
+}
+
+void print_table(std::vector<WatchEntry> &entries, bool show_counters) {
+    const uint64_t now_ms = vul_telemetry_unix_ms();
+    std::printf("%-8s %-16s %-8s %14s %10s %10s %10s %8s\n",
+                "pid", "name", "state", "cycle", "cyc/s", "avg cyc/s", "trace MB", "age(s)");
+    for (auto &entry : entries) {
+        VulTelemetryPage page;
+        if (!entry.reader.read(page)) {
+            std::printf("%-8s %-16s (unreadable: %s)\n", "-", "-", entry.path.c_str());
+            continue;
+        }
+        const char *state = "running";
+        if (page.state == VulTelemetryFinished) {
+            state = "finished";
+        } else if (!process_alive(page.pid)) {
+            state = "dead";
+        }
+        const double age = now_ms >= page.update_unix_ms ? static_cast<double>(now_ms - page.update_unix_ms) / 1000.0 : 0.0;
+        std::printf("%-8lld %-16.16s %-8s %14llu %10s %10s %10.2f %8.1f\n",
+                    static_cast<long long>(page.pid), page.name, state,
+                    static_cast<unsigned long long>(page.cycle),
+                    format_rate(page.cycles_per_sec).c_str(),
+                    format_rate(page.avg_cycles_per_sec).c_str(),
+                    static_cast<double>(page.trace_bytes) / (1024.0 * 1024.0), age);
+        if (show_counters) {
+            for (uint32_t i = 0; i < page.counter_count && i < VulTelemetryMaxCounters; i++) {
+                std::printf("%-8s   %-40.*s %20llu\n", "", static_cast<int>(VulTelemetryNameSize),
+                            page.counters[i].name,
+                            static_cast<unsigned long long>(page.counters[i].value));
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    argparse::ArgumentParser parser("vulsimwatch", "VulSim Telemetry Watcher V1.0");
+    parser.add_argument("pages")
+        .help("telemetry page files to watch (default: every vulsim.* page in --dir)")
+        .remaining();
+    parser.add_argument("-d", "--dir")
+        .help("directory scanned for telemetry pages when none are given (default: /dev/shm)")
+        .default_value(std::string("/dev/shm"));
+    parser.add_argument("-i", "--interval")
+        .help("refresh interval in milliseconds (default: 1000)")
+        .scan<'u', uint64_t>()
+        .default_value(uint64_t(1000));
+    parser.add_argument("-c", "--counters")
+        .help("also print registered statistic counters")
+        .default_value(false)
+        .implicit_value(true);
+    parser.add_argument("--once")
+        .help("print one snapshot and exit")
+        .default_value(false)
+        .implicit_value(true);
+    parser.add_argument("--clean")
+        .help("remove pages of finished or dead simulators and exit")
+        .default_value(false)
+        .implicit_value(true);
+
+    try {
+        parser.parse_args(argc, argv);
+    } catch (const std::exception &e) {
+        std::cerr << "Argument parsing error: " << e.what() << "\n" << parser.help().str() << std::endl;
+        return 1;
+    }
+
+    const std::string dir = parser.get<std::string>("--dir");
+    const uint64_t interval_ms = parser.get<uint64_t>("--interval");
+    const bool show_counters = parser.get<bool>("--counters");
+    const bool once = parser.get<bool>("--once");
+    const bool clean = parser.get<bool>("--clean");
+
+    std::vector<std::string> explicit_paths;
+    if (parser.is_used("pages")) {
+        explicit_paths = parser.get<std::vector<std::string>>("pages");
+    }
+
+    if (clean) {
+        for (const auto &path : explicit_paths.empty() ? discover_pages(dir) : explicit_paths) {
+            VulTelemetryReader reader;
+            VulTelemetryPage page;
+            if (reader.open(path) && reader.read(page) && (page.state == VulTelemetryFinished || !process_alive(page.pid))) {
+                std::filesystem::remove(path);
+                std::printf("removed %s\n", path.c_str());
+            }
+        }
+        return 0;
+    }
+
+    while (true) {
+        // 每轮重新扫描目录，以便发现新启动的仿真进程
+        std::vector<WatchEntry> entries;
+        for (const auto &path : explicit_paths.empty() ? discover_pages(dir) : explicit_paths) {
+            WatchEntry entry{path, VulTelemetryReader()};
+            if (entry.reader.open(path)) {
+                entries.push_back(std::move(entry));
+            }
+        }
+        if (!once) {
+            std::printf("\033[H\033[2J");
+        }
+        if (entries.empty()) {
+            std::printf("no telemetry pages found\n");
+        } else {
+            print_table(entries, show_counters);
+        }
+        std::fflush(stdout);
+        if (once) {
+            return entries.empty() ? 1 : 0;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+    }
+}
@@ -0,0 +1,204 @@
+// MIT License
+
+// Copyright (c) 2025 Meng Chengzhen, in Shandong University
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// 仿真热路径堆分配统计
+// 以 -DVULSIM_ALLOC_TRACK 编译时（生成目录中的 alloctrack.sh），main.cpp 接管 malloc 系列函数，
+// 预热周期之后的每次分配都记到当前正在执行的生成函数（VUL_ALLOC_SCOPE 标记）名下。
+// 未定义 VULSIM_ALLOC_TRACK 时两个宏都展开为空语句，不影响正常构建。
+
+#ifdef VULSIM_ALLOC_TRACK
+
+#include <algorithm>
+#include <cstdio>
+
+namespace vulalloc {
+
+struct ScopeStat {
+    const char *scope;
+    uint64_t count;
+    uint64_t bytes;
+    uint64_t pending_count; // 当前周期内尚未计入的分配
+    uint64_t pending_bytes;
+};
+
+inline constexpr uint32_t ScopeTableSize = 1024;
+inline constexpr uint32_t TouchedListSize = 64;
+inline constexpr const char *HarnessScope = "<harness>";
+inline constexpr const char *OverflowScope = "<other>";
+
+// 仿真为单线程，这里不加锁；分配钩子中禁止再分配内存，因此使用定长开放寻址表
+// 分配先记为 pending，周期提交时才计入统计，仿真结束后的收尾分配（如首次 printf 的输出缓冲）不算稳态分配
+inline const char *current_scope = nullptr;
+inline bool steady = false;
+inline uint64_t warmup_cycles = 100;
+inline uint64_t steady_cycles = 0;
+inline uint64_t cycles_with_alloc = 0;
+inline uint64_t max_cycle_allocs = 0;
+inline uint64_t max_cycle_index = 0;
+inline uint64_t cycle_allocs = 0;
+inline uint64_t cycle_bytes = 0;
+inline uint64_t total_allocs = 0;
+inline uint64_t total_bytes = 0;
+inline ScopeStat scope_table[ScopeTableSize] = {};
+inline uint32_t touched[TouchedListSize] = {};
+inline uint32_t touched_count = 0;
+
+// 最后一项留给溢出，首个探测位置与线性探测都只落在前 ScopeTableSize - 1 项
+inline uint32_t find_slot(const char *scope) {
+    uint32_t slot = static_cast<uint32_t>((reinterpret_cast<uintptr_t>(scope) >> 3) % (ScopeTableSize - 1));
+    for (uint32_t probe = 0; probe < ScopeTableSize - 1; probe++) {
+        const ScopeStat &stat = scope_table[slot];
+        if (stat.scope == scope || stat.scope == nullptr) {
+            return slot;
+        }
+        slot = (slot + 1) % (ScopeTableSize - 1);
+    }
+    // 表满时不再细分，最后一项留给溢出
+    scope_table[ScopeTableSize - 1].scope = OverflowScope;
+    return ScopeTableSize - 1;
+}
+
+inline void record(size_t bytes) {
+    if (!steady) [[likely]] {
+        return;
+    }
+    cycle_allocs++;
+    cycle_bytes += bytes;
+    const char *scope = current_scope ? current_scope : HarnessScope;
+    const uint32_t slot = find_slot(scope);
+    ScopeStat &stat = scope_table[slot];
+    if (stat.scope == nullptr) {
+        stat.scope = scope;
+    }
+    if (stat.pending_count == 0) {
+        if (touched_count < TouchedListSize) {
+            touched[touched_count] = slot;
+        }
+        touched_count++;
+    }
+    stat.pending_count++;
+    stat.pending_bytes += bytes;
+}
+
+inline void flush_pending(bool commit) {
+    auto flush_one = [&](ScopeStat &stat) {
+        if (commit) {
+            stat.count += stat.pending_count;
+            stat.bytes += stat.pending_bytes;
+        }
+        stat.pending_count = 0;
+        stat.pending_bytes = 0;
+    };
+    if (touched_count <= TouchedListSize) {
+        for (uint32_t i = 0; i < touched_count; i++) {
+            flush_one(scope_table[touched[i]]);
+        }
+    } else {
+        for (auto &stat : scope_table) {
+            flush_one(stat);
+        }
+    }
+    touched_count = 0;
+}
+
+// 每个周期提交后调用，cycles 为已提交周期数
+inline void on_cycle(uint64_t cycles) {
+    if (steady) {
+        steady_cycles++;
+        if (cycle_allocs != 0) {
+            cycles_with_alloc++;
+            total_allocs += cycle_allocs;
+            total_bytes += cycle_bytes;
+            if (cycle_allocs > max_cycle_allocs) {
+                max_cycle_allocs = cycle_allocs;
+                max_cycle_index = cycles;
+            }
+            flush_pending(true);
+        }
+    } else if (cycles >= warmup_cycles) {
+        steady = true;
+    }
+    cycle_allocs = 0;
+    cycle_bytes = 0;
+}
+
+struct Scope {
+    const char *prev;
+    explicit Scope(const char *name) : prev(current_scope) {
+        current_scope = name;
+    }
+    ~Scope() {
+        current_scope = prev;
+    }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+};
+
+// 输出统计并返回稳态分配次数；调用后停止统计
+inline uint64_t report(FILE *out, uint32_t top_n = 10) {
+    steady = false;
+    flush_pending(false);
+    std::fprintf(out, "[vulsim-alloc] warmup=%llu steady_cycles=%llu allocs=%llu bytes=%llu cycles_with_alloc=%llu max_per_cycle=%llu (cycle %llu)\n",
+                 static_cast<unsigned long long>(warmup_cycles),
+                 static_cast<unsigned long long>(steady_cycles),
+                 static_cast<unsigned long long>(total_allocs),
+                 static_cast<unsigned long long>(total_bytes),
+                 static_cast<unsigned long long>(cycles_with_alloc),
+                 static_cast<unsigned long long>(max_cycle_allocs),
+                 static_cast<unsigned long long>(max_cycle_index));
+    ScopeStat sorted[ScopeTableSize];
+    uint32_t used = 0;
+    for (const auto &stat : scope_table) {
+        if (stat.count != 0) {
+            sorted[used++] = stat;
+        }
+    }
+    std::sort(sorted, sorted + used, [](const ScopeStat &a, const ScopeStat &b) {
+        return a.count > b.count;
+    });
+    for (uint32_t i = 0; i < used && i < top_n; i++) {
+        const double per_cycle = steady_cycles ? static_cast<double>(sorted[i].count) / static_cast<double>(steady_cycles) : 0.0;
+        std::fprintf(out, "[vulsim-alloc]   %-48s allocs=%llu bytes=%llu per_cycle=%.3f\n",
+                     sorted[i].scope,
+                     static_cast<unsigned long long>(sorted[i].count),
+                     static_cast<unsigned long long>(sorted[i].bytes),
+                     per_cycle);
+    }
+    return total_allocs;
+}
+
+} // namespace vulalloc
+
+#define VUL_ALLOC_SCOPE(name) ::vulalloc::Scope __vul_alloc_scope(name)
+#define VUL_ALLOC_CYCLE(cycles) ::vulalloc::on_cycle(cycles)
+
+#else
+
+#define VUL_ALLOC_SCOPE(name) ((void)0)
+#define VUL_ALLOC_CYCLE(cycles) ((void)0)
+
+#endif
@@ -0,0 +1,196 @@
+// MIT License
+
+// Copyright (c) 2025 Meng Chengzhen, in Shandong University
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// vullib 微基准测试的最小框架：
+// - 每个用例自动标定迭代次数，重复测量取最小 ns/op
+// - 结果可保存为基线文件（每行 "name ns_per_op"），后续运行与基线比较
+// - 任一用例比基线慢超过容差时返回非零退出码
+
+namespace vulbench {
+
+template <typename T>
+inline void do_not_optimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+
+struct BenchCase {
+    std::string name;
+    uint64_t ops_per_iter;
+    std::function<void(uint64_t)> body; // 执行 iters 次迭代
+};
+
+struct BenchResult {
+    std::string name;
+    double ns_per_op;
+};
+
+inline std::vector<BenchCase> &registry() {
+    static std::vector<BenchCase> cases;
+    return cases;
+}
+
+inline void add(const std::string &name, uint64_t ops_per_iter, std::function<void(uint64_t)> body) {
+    registry().push_back(BenchCase{name, ops_per_iter, std::move(body)});
+}
+
+inline double time_ns(const BenchCase &bench, uint64_t iters) {
+    const auto start = std::chrono::steady_clock::now();
+    bench.body(iters);
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count();
+}
+
+inline double measure(const BenchCase &bench, double min_time_ns, uint32_t repeats) {
+    uint64_t iters = 1;
+    double elapsed = time_ns(bench, iters);
+    while (elapsed < min_time_ns && iters < (uint64_t(1) << 40)) {
+        const double scale = elapsed > 0 ? std::min(10.0, std::max(2.0, 1.2 * min_time_ns / elapsed)) : 10.0;
+        iters = static_cast<uint64_t>(static_cast<double>(iters) * scale);
+        elapsed = time_ns(bench, iters);
+    }
+    double best = elapsed;
+    for (uint32_t i = 1; i < repeats; i++) {
+        best = std::min(best, time_ns(bench, iters));
+    }
+    return best / static_cast<double>(iters * bench.ops_per_iter);
+}
+
+inline std::map<std::string, double> load_baseline(const std::string &path) {
+    std::map<std::string, double> baseline;
+    std::ifstream ifs(path);
+    if (!ifs.is_open()) {
+        std::fprintf(stderr, "Cannot open baseline file: %s\n", path.c_str());
+        std::exit(2);
+    }
+    std::string line;
+    while (std::getline(ifs, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream iss(line);
+        std::string name;
+        double ns = 0;
+        if (iss >> name >> ns) {
+            baseline[name] = ns;
+        }
+    }
+    return baseline;
+}
+
+inline void save_baseline(const std::string &path, const std::vector<BenchResult> &results) {
+    std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+    if (!ofs.is_open()) {
+        std::fprintf(stderr, "Cannot write baseline file: %s\n", path.c_str());
+        std::exit(2);
+    }
+    ofs << "# vullib benchmark baseline: name ns_per_op\n";
+    for (const auto &result : results) {
+        ofs << result.name << " " << result.ns_per_op << "\n";
+    }
+}
+
+inline void print_usage(const char *prog) {
+    std::printf("Usage: %s [--filter SUBSTR] [--baseline FILE] [--save FILE] [--tolerance PCT] [--min-time MS] [--repeats N] [--list]\n", prog);
+}
+
+inline int run_main(int argc, char **argv) {
+    std::string filter;
+    std::string baseline_path;
+    std::string save_path;
+    double tolerance_pct = 15.0;
+    double min_time_ms = 50.0;
+    uint32_t repeats = 5;
+    bool list_only = false;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        auto next_value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                std::fprintf(stderr, "Missing value for %s\n", arg.c_str());
+                std::exit(2);
+            }
+            return argv[++i];
+        };
+        if (arg == "--filter") {
+            filter = next_value();
+        } else if (arg == "--baseline") {
+            baseline_path = next_value();
+        } else if (arg == "--save") {
+            save_path = next_value();
+        } else if (arg == "--tolerance") {
+            tolerance_pct = std::stod(next_value());
+        } else if (arg == "--min-time") {
+            min_time_ms = std::stod(next_value());
+        } else if (arg == "--repeats") {
+            repeats = static_cast<uint32_t>(std::stoul(next_value()));
+        } else if (arg == "--list") {
+            list_only = true;
+        } else {
+            print_usage(argv[0]);
+            return arg == "--help" || arg == "-h" ? 0 : 2;
+        }
+    }
+
+    std::map<std::string, double> baseline;
+    if (!baseline_path.empty()) {
+        baseline = load_baseline(baseline_path);
+    }
+
+    std::vector<BenchResult> results;
+    uint32_t regressions = 0;
+    if (!list_only) {
+        std::printf("%-40s %12s %12s %9s\n", "benchmark", "ns/op", "baseline", "delta");
+    }
+    for (const auto &bench : registry()) {
+        if (!filter.empty() && bench.name.find(filter) == std::string::npos) {
+            continue;
+        }
+        if (list_only) {
+            std::printf("%s\n", bench.name.c_str());
+            continue;
+        }
+        const double ns = measure(bench, min_time_ms * 1e6, std::max<uint32_t>(1, repeats));
+        results.push_back(BenchResult{bench.name, ns});
+        auto it = baseline.find(bench.name);
+        if (it == baseline.end() || it->second <= 0) {
+            std::printf("%-40s %12.3f %12s %9s\n", bench.name.c_str(), ns, "-", "-");
+            continue;
+        }
+        const double delta_pct = (ns / it->second - 1.0) * 100.0;
+        const bool regressed = delta_pct > tolerance_pct;
+        regressions += regressed ? 1 : 0;
+        std::printf("%-40s %12.3f %12.3f %+8.1f%%%s\n", bench.name.c_str(), ns, it->second, delta_pct,
+                    regressed ? "  REGRESSION" : "");
+    }
+
+    if (!save_path.empty()) {
+        save_baseline(save_path, results);
+        std::printf("Baseline saved to %s\n", save_path.c_str());
+    }
+    if (regressions != 0) {
+        std::printf("%u benchmark(s) regressed by more than %.1f%%\n", regressions, tolerance_pct);
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace vulbench
@@ -0,0 +1,177 @@
+#include "fixint.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <utility>
+
+// Int<N> 窄字存储的内存占用对比：以 ooo_backend（MainWide 配置，2 条 ALU、2 条 LSU 流水线）的全部时序状态为例，
+// 把其中的窄字段改写为按实际位宽声明的 Int<N>，比较每个 Int 固定占用 64 位字与按位宽选择
+// uint8_t/uint16_t/uint32_t 两种存储下的状态字节数，以及整体拷贝一次状态（快照、整段提交）的耗时。
+// 编译：g++ -std=c++20 -O2 -DNDEBUG -Ivullib vullib/bench/int_footprint.cpp
+
+namespace {
+
+// 窄字存储之前的布局：每个 Int 至少一个 64 位字
+template <uint32_t W>
+struct WordInt {
+    std::array<uint64_t, (W + 63) / 64> data{};
+};
+
+// 字段位宽取自 example/ooo_backend 的配置：PHYS_REGS=20、ROB_SIZE=16、IQ_SIZE=16、ARCH_REGS=8、12 种 opcode
+constexpr uint32_t TAG_BITS = 5;
+constexpr uint32_t ROB_IDX_BITS = 4;
+constexpr uint32_t OPCODE_BITS = 4;
+constexpr uint32_t ARCH_REG_BITS = 3;
+constexpr uint32_t PTR_BITS = 5;
+
+template <template <uint32_t> class I>
+struct BackendInstrT {
+    I<1> valid;
+    I<OPCODE_BITS> opcode;
+    I<ARCH_REG_BITS> rd;
+    I<ARCH_REG_BITS> rs1;
+    I<ARCH_REG_BITS> rs2;
+    I<64> imm;
+};
+
+template <template <uint32_t> class I>
+struct IssueEntryT {
+    I<1> valid;
+    I<1> is_lsu;
+    I<OPCODE_BITS> opcode;
+    I<ROB_IDX_BITS> rob_idx;
+    I<TAG_BITS> dst_phys;
+    I<TAG_BITS> src1_tag;
+    I<TAG_BITS> src2_tag;
+    I<1> src1_ready;
+    I<1> src2_ready;
+    I<64> src1_value;
+    I<64> src2_value;
+    I<64> imm;
+    I<64> seq;
+};
+
+template <template <uint32_t> class I>
+struct RobEntryT {
+    I<1> valid;
+    I<1> ready;
+    I<1> has_dest;
+    I<OPCODE_BITS> opcode;
+    I<ARCH_REG_BITS> arch_rd;
+    I<TAG_BITS> dst_phys;
+    I<TAG_BITS> old_phys;
+    I<64> value;
+    I<64> seq;
+};
+
+template <template <uint32_t> class I>
+struct FuRequestT {
+    I<1> valid;
+    I<OPCODE_BITS> opcode;
+    I<ROB_IDX_BITS> rob_idx;
+    I<TAG_BITS> dst_phys;
+    I<64> src1_value;
+    I<64> src2_value;
+    I<64> imm;
+    I<64> seq;
+};
+
+template <template <uint32_t> class I>
+struct WritebackEventT {
+    I<1> valid;
+    I<1> has_dest;
+    I<ROB_IDX_BITS> rob_idx;
+    I<TAG_BITS> dst_phys;
+    I<64> value;
+    I<64> seq;
+};
+
+template <template <uint32_t> class I>
+struct LSUSlotT {
+    I<1> valid;
+    I<1> waiting_mem;
+    I<1> sent_req;
+    I<2> remain;
+    FuRequestT<I> req;
+};
+
+template <template <uint32_t> class I>
+struct ALUPipelineT {
+    std::array<FuRequestT<I>, 8> issueq;
+    std::array<WritebackEventT<I>, 8> resultq;
+    std::array<I<1>, 8> slot_valid;
+    std::array<I<4>, 8> slot_remain;
+    std::array<FuRequestT<I>, 8> slot_req;
+};
+
+template <template <uint32_t> class I>
+struct LSUPipelineT {
+    std::array<FuRequestT<I>, 4> issueq;
+    std::array<WritebackEventT<I>, 4> resultq;
+    std::array<LSUSlotT<I>, 4> slot_state;
+};
+
+template <template <uint32_t> class I>
+struct BackendCoreT {
+    std::array<I<64>, 5> counters;
+    std::array<I<PTR_BITS>, 11> pointers;
+    I<1> halted;
+    std::array<I<TAG_BITS>, 8> map_table;
+    std::array<I<1>, 20> phys_ready;
+    std::array<I<64>, 20> phys_value;
+    std::array<I<TAG_BITS>, 20> free_tags;
+    std::array<RobEntryT<I>, 16> rob;
+    std::array<IssueEntryT<I>, 16> iq;
+    std::array<I<1>, 2> push_valid;
+    std::array<BackendInstrT<I>, 2> push_data;
+    std::array<BackendInstrT<I>, 16> ingress_buf;
+    std::array<ALUPipelineT<I>, 2> alu;
+    std::array<LSUPipelineT<I>, 2> lsu;
+};
+
+template <typename Narrow, typename Wide>
+void print_row(const char *name) {
+    const size_t wide = sizeof(Wide);
+    const size_t narrow = sizeof(Narrow);
+    std::printf("%-28s %10zu %10zu %8.2fx\n", name, wide, narrow, double(wide) / double(narrow));
+}
+
+template <typename State>
+double copy_ns(uint32_t rounds) {
+    auto src = std::make_unique<State>();
+    auto dst = std::make_unique<State>();
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < rounds; i++) {
+        *dst = *src;
+        asm volatile("" : : "r"(dst.get()), "r"(src.get()) : "memory");
+        std::swap(src, dst);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / rounds;
+}
+
+} // namespace
+
+int main() {
+    std::printf("%-28s %10s %10s %9s\n", "state (bytes)", "u64 words", "narrow", "ratio");
+    print_row<IssueEntryT<Int>, IssueEntryT<WordInt>>("IssueEntry");
+    print_row<RobEntryT<Int>, RobEntryT<WordInt>>("RobEntry");
+    print_row<FuRequestT<Int>, FuRequestT<WordInt>>("FuRequest");
+    print_row<WritebackEventT<Int>, WritebackEventT<WordInt>>("WritebackEvent");
+    print_row<BackendInstrT<Int>, BackendInstrT<WordInt>>("BackendInstr");
+    print_row<decltype(BackendCoreT<Int>::rob), decltype(BackendCoreT<WordInt>::rob)>("core.rob[16]");
+    print_row<decltype(BackendCoreT<Int>::iq), decltype(BackendCoreT<WordInt>::iq)>("core.iq[16]");
+    print_row<decltype(BackendCoreT<Int>::free_tags), decltype(BackendCoreT<WordInt>::free_tags)>("core.free_tags[20]");
+    print_row<ALUPipelineT<Int>, ALUPipelineT<WordInt>>("ALUPipeline");
+    print_row<LSUPipelineT<Int>, LSUPipelineT<WordInt>>("LSUPipeline");
+    print_row<BackendCoreT<Int>, BackendCoreT<WordInt>>("ooo_backend total");
+
+    const uint32_t rounds = 200000;
+    const double wide_ns = copy_ns<BackendCoreT<WordInt>>(rounds);
+    const double narrow_ns = copy_ns<BackendCoreT<Int>>(rounds);
+    std::printf("\nfull state copy: u64 words %.1f ns, narrow %.1f ns\n", wide_ns, narrow_ns);
+    return 0;
+}
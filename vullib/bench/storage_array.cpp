@@ -0,0 +1,83 @@
+#include "storage.hpp"
+#include "storage_dirty.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+// VulRegisterArray 各实现在不同写入密度下的 setnext + apply_next_tick 开销
+// 编译：g++ -std=c++20 -O2 -DNDEBUG -Ivullib vullib/bench/storage_array.cpp
+
+namespace {
+
+struct Entry {
+    uint64_t tag;
+    uint32_t pc;
+    uint32_t flags;
+};
+
+volatile uint64_t g_sink = 0;
+
+template <uint32_t Size, typename Impl>
+double run_case(Impl &impl, uint32_t writes_per_cycle, uint32_t cycles) {
+    std::mt19937 rng(20261017u + Size + writes_per_cycle);
+    // 预先生成不重复的写入下标序列，避免计时包含随机数开销
+    std::vector<uint32_t> indices(Size);
+    for (uint32_t i = 0; i < Size; i++) {
+        indices[i] = i;
+    }
+    std::vector<std::vector<uint32_t>> schedule(16);
+    for (auto &cycle_indices : schedule) {
+        std::shuffle(indices.begin(), indices.end(), rng);
+        cycle_indices.assign(indices.begin(), indices.begin() + writes_per_cycle);
+    }
+
+    uint64_t seq = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t cycle = 0; cycle < cycles; cycle++) {
+        for (uint32_t index : schedule[cycle & 15]) {
+            impl.template setnext<0>(index, Entry{seq++, index, cycle});
+        }
+        impl.apply_next_tick();
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    g_sink = g_sink + impl[writes_per_cycle ? schedule[0][0] : 0].tag;
+    return std::chrono::duration<double, std::nano>(stop - start).count() / cycles;
+}
+
+template <uint32_t Size>
+void run_size() {
+    const uint32_t cycles = Size >= 65536 ? 2000 : 20000;
+    const uint32_t densities_pct[] = {1, 5, 25, 50, 100};
+    for (uint32_t pct : densities_pct) {
+        const uint32_t writes = std::max<uint32_t>(1, Size * pct / 100);
+        // 大数组放在堆上，避免占满栈空间
+        auto dirty = std::make_unique<vulstorage::VulRegisterArrayDirtyImpl<Entry, Size, 1>>();
+        auto adaptive = std::make_unique<vulstorage::VulRegisterArrayAdaptiveImpl<Entry, Size, 1>>();
+        auto bitmap = std::make_unique<vulstorage::VulRegisterArrayBitmapImpl<Entry, Size, 1>>();
+        const double dirty_ns = run_case<Size>(*dirty, writes, cycles);
+        const double adaptive_ns = run_case<Size>(*adaptive, writes, cycles);
+        const double bitmap_ns = run_case<Size>(*bitmap, writes, cycles);
+        std::printf("%8u %5u%% %8u | %12.1f %12.1f %12.1f | %8.2f %8.2f %8.2f\n",
+                    Size, pct, writes, dirty_ns, adaptive_ns, bitmap_ns,
+                    dirty_ns / writes, adaptive_ns / writes, bitmap_ns / writes);
+    }
+}
+
+} // namespace
+
+int main() {
+    std::printf("%8s %6s %8s | %12s %12s %12s | %8s %8s %8s\n",
+                "size", "dense", "writes", "dirty ns/cy", "adapt ns/cy", "bitmap ns/cy",
+                "dirty/w", "adapt/w", "bitmap/w");
+    run_size<64>();
+    run_size<256>();
+    run_size<4096>();
+    run_size<65536>();
+    std::printf("(sink %llu)\n", static_cast<unsigned long long>(g_sink));
+    return 0;
+}
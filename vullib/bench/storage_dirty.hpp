@@ -0,0 +1,281 @@
+// MIT License
+
+// Copyright (c) 2025 Meng Chengzhen, in Shandong University
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "storage.hpp"
+
+// 脏下标列表实现：VulRegisterArray 早期对 Size > 16 的数组使用的实现，现已不再选用。
+// 保留在这里作为 storage_array.cpp 的对照基准，以及 vullib/test 中 storage_* 测试逐周期比对的参考实现。
+
+namespace vulstorage {
+
+template<typename T, uint32_t Size, uint32_t WRPortNum = 1>
+class VulRegisterArrayDirtyImpl {
+
+    static_assert(Size >= 1, "Size must be at least 1");
+    static_assert(WRPortNum >= 1, "WRPortNum must be at least 1");
+    static_assert(WRPortNum < 64, "WRPortNum must be less than 64");
+
+protected:
+    struct PendingSlot {
+        T value;
+        uint32_t best_prio;
+        bool has_write;
+        bool hold_next;
+        bool reset_next;
+#ifndef VULSIM_UNCHECKED
+        uint64_t issued_write_ports = 0;
+#endif
+
+        PendingSlot()
+            : value(), best_prio(WRPortNum), has_write(false), hold_next(false),
+              reset_next(false) {}
+    };
+    std::array<T, Size> curr_;
+    std::array<T, Size> reset_values_;
+    std::array<PendingSlot, Size> pending_;
+
+    std::array<uint32_t, Size> dirty_indices_{};
+    uint32_t dirty_count_ = 0;
+    std::array<uint8_t, Size> dirty_flags_{};
+
+    // 每周期至多一个整段写入区间 [bulk_lo_, bulk_hi_)，提交时整段拷贝
+    std::array<T, Size> bulk_next_{};
+    uint32_t bulk_lo_ = 0;
+    uint32_t bulk_hi_ = 0;
+    uint32_t bulk_prio_ = WRPortNum;
+
+public:
+
+    VulRegisterArrayDirtyImpl() : curr_(), pending_() {}
+    VulRegisterArrayDirtyImpl(const T &initial_value) : curr_(), pending_() {
+        for (auto &elem : curr_) {
+            elem = initial_value;
+        }
+        for (auto &elem : reset_values_) {
+            elem = initial_value;
+        }
+        for (auto &slot : pending_) {
+            slot.value = initial_value;
+        }
+    }
+
+    template <uint32_t P = 0>
+    void setnext(const uint32_t index, const T &value) {
+        assert(index < Size);
+        static_assert(P < WRPortNum);
+        auto &slot = pending_[index];
+        if (slot.reset_next || slot.hold_next) {
+            return;
+        }
+#ifndef VULSIM_UNCHECKED
+        assert((slot.issued_write_ports & (uint64_t(1) << P)) == 0 &&
+               "VulRegisterArray::setnext() may only be called once per cycle for each register write port");
+        assert(!(P == bulk_prio_ && index >= bulk_lo_ && index < bulk_hi_) &&
+               "VulRegisterArray::setnext() may only be called once per cycle for each register write port");
+        slot.issued_write_ports |= uint64_t(1) << P;
+#endif
+        if (!slot.has_write || P < slot.best_prio) {
+            slot.value = value;
+            slot.best_prio = P;
+            slot.has_write = true;
+            if (dirty_flags_[index] == 0) {
+                dirty_indices_[dirty_count_++] = index;
+                dirty_flags_[index] = 1;
+            }
+        }
+    }
+    template <uint32_t P = 0>
+    void setnext_range(const uint32_t lo, const uint32_t hi, const T *src) {
+        assert(lo <= hi && hi <= Size);
+        static_assert(P < WRPortNum);
+        if (lo == hi) {
+            return;
+        }
+        if (bulk_lo_ != bulk_hi_) {
+            // 同周期的第二个整段写入退化为逐项写入
+            for (uint32_t i = lo; i < hi; i++) {
+                setnext<P>(i, src[i - lo]);
+            }
+            return;
+        }
+        std::copy(src, src + (hi - lo), bulk_next_.begin() + lo);
+        bulk_lo_ = lo;
+        bulk_hi_ = hi;
+        bulk_prio_ = P;
+    }
+    void apply_next_tick() {
+        if (bulk_lo_ != bulk_hi_) {
+            apply_bulk();
+            return;
+        }
+        for (uint32_t i = 0; i < dirty_count_; i++) {
+            uint32_t index = dirty_indices_[i];
+            if (pending_[index].reset_next) {
+                curr_[index] = reset_values_[index];
+                pending_[index].value = reset_values_[index];
+            } else if (pending_[index].hold_next) {
+                pending_[index].value = curr_[index];
+            } else if (pending_[index].has_write) {
+                curr_[index] = pending_[index].value;
+            }
+            pending_[index].has_write = false;
+            pending_[index].best_prio = WRPortNum;
+            pending_[index].hold_next = false;
+            pending_[index].reset_next = false;
+#ifndef VULSIM_UNCHECKED
+            pending_[index].issued_write_ports = 0;
+#endif
+            dirty_flags_[index] = 0;
+        }
+        dirty_count_ = 0;
+    }
+    const T& operator[](uint32_t index) const {
+        assert(index < Size);
+        return curr_[index];
+    }
+    std::span<const T, Size> view() const {
+        return curr_;
+    }
+    void holdnext(uint32_t index) {
+        assert(index < Size);
+        auto &slot = pending_[index];
+        if (slot.reset_next) {
+            return;
+        }
+        slot.hold_next = true;
+        slot.has_write = false;
+        slot.best_prio = WRPortNum;
+#ifndef VULSIM_UNCHECKED
+        slot.issued_write_ports = 0;
+#endif
+        mark_dirty(index);
+    }
+    void holdnext() {
+        for (uint32_t i = 0; i < Size; i++) {
+            holdnext(i);
+        }
+    }
+    void resetnext(uint32_t index) {
+        assert(index < Size);
+        auto &slot = pending_[index];
+        slot.reset_next = true;
+        slot.hold_next = false;
+        slot.has_write = false;
+        slot.best_prio = WRPortNum;
+#ifndef VULSIM_UNCHECKED
+        slot.issued_write_ports = 0;
+#endif
+        mark_dirty(index);
+    }
+    void resetnext() {
+        for (uint32_t i = 0; i < Size; i++) {
+            resetnext(i);
+        }
+    }
+    void _set_reset_value(const T &value) {
+        for (auto &elem : reset_values_) {
+            elem = value;
+        }
+    }
+    void _set_reset_value(const array<T, Size> &values) {
+        reset_values_ = values;
+    }
+    void _reset() {
+        for (auto &elem : curr_) {
+            elem = T{};
+        }
+        curr_ = reset_values_;
+        for (auto &slot : pending_) {
+            slot.value = T{};
+            slot.best_prio = WRPortNum;
+            slot.has_write = false;
+            slot.hold_next = false;
+            slot.reset_next = false;
+#ifndef VULSIM_UNCHECKED
+            slot.issued_write_ports = 0;
+#endif
+        }
+        for (uint32_t i = 0; i < Size; i++) {
+            pending_[i].value = reset_values_[i];
+        }
+        dirty_count_ = 0;
+        dirty_flags_.fill(0);
+        bulk_lo_ = 0;
+        bulk_hi_ = 0;
+        bulk_prio_ = WRPortNum;
+    }
+    bool _quiescent() const {
+        return dirty_count_ == 0 && bulk_lo_ == bulk_hi_;
+    }
+
+private:
+    void mark_dirty(uint32_t index) {
+        if (dirty_flags_[index] == 0) {
+            dirty_indices_[dirty_count_++] = index;
+            dirty_flags_[index] = 1;
+        }
+    }
+
+    void apply_bulk() {
+        // 先按旧的 curr_ 决议脏项（hold 需要旧值），再整段拷贝，最后回填脏项
+        for (uint32_t i = 0; i < dirty_count_; i++) {
+            uint32_t index = dirty_indices_[i];
+            auto &slot = pending_[index];
+            const bool in_bulk = (index >= bulk_lo_ && index < bulk_hi_);
+#ifndef VULSIM_UNCHECKED
+            assert(!(in_bulk && (slot.issued_write_ports & (uint64_t(1) << bulk_prio_))) &&
+                   "VulRegisterArray::setnext() may only be called once per cycle for each register write port");
+#endif
+            if (slot.reset_next) {
+                slot.value = reset_values_[index];
+            } else if (slot.hold_next) {
+                slot.value = curr_[index];
+            } else if (in_bulk && (!slot.has_write || bulk_prio_ < slot.best_prio)) {
+                slot.value = bulk_next_[index];
+            } else if (!slot.has_write) {
+                slot.value = curr_[index];
+            }
+        }
+        std::copy(bulk_next_.begin() + bulk_lo_, bulk_next_.begin() + bulk_hi_, curr_.begin() + bulk_lo_);
+        for (uint32_t i = 0; i < dirty_count_; i++) {
+            uint32_t index = dirty_indices_[i];
+            auto &slot = pending_[index];
+            curr_[index] = slot.value;
+            slot.has_write = false;
+            slot.best_prio = WRPortNum;
+            slot.hold_next = false;
+            slot.reset_next = false;
+#ifndef VULSIM_UNCHECKED
+            slot.issued_write_ports = 0;
+#endif
+            dirty_flags_[index] = 0;
+        }
+        dirty_count_ = 0;
+        bulk_lo_ = 0;
+        bulk_hi_ = 0;
+        bulk_prio_ = WRPortNum;
+    }
+};
+
+} // namespace vulstorage
@@ -0,0 +1,416 @@
+#include "benchutil.hpp"
+
+#include "fixint.hpp"
+#include "queue.hpp"
+#include "ram.hpp"
+#include "sparsemem.hpp"
+#include "storage.hpp"
+#include "vcdrecord.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <random>
+
+// vullib 运行时原语的微基准测试，结果单位为 ns/op
+// 构建与运行见 scripts/bench_vullib.sh
+
+namespace {
+
+using vulbench::do_not_optimize;
+
+// ---------------- Int<N> ----------------
+
+template <uint32_t W>
+Int<W> make_int(uint64_t seed) {
+    Int<W> value = 0;
+    for (uint32_t lo = 0; lo < W; lo += 64) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        value = (value << 64) | Int<W>(seed);
+    }
+    return value;
+}
+
+template <uint32_t W>
+void add_int_cases() {
+    const std::string prefix = "int" + std::to_string(W) + "/";
+
+    vulbench::add(prefix + "add", 1, [](uint64_t iters) {
+        Int<W> a = make_int<W>(1);
+        const Int<W> b = make_int<W>(2);
+        for (uint64_t i = 0; i < iters; i++) {
+            a = a + b;
+            do_not_optimize(a);
+        }
+    });
+    vulbench::add(prefix + "mul", 1, [](uint64_t iters) {
+        Int<W> a = make_int<W>(3);
+        const Int<W> b = make_int<W>(4);
+        for (uint64_t i = 0; i < iters; i++) {
+            a = a * b;
+            do_not_optimize(a);
+        }
+    });
+    vulbench::add(prefix + "xor_and", 1, [](uint64_t iters) {
+        Int<W> a = make_int<W>(5);
+        const Int<W> b = make_int<W>(6);
+        const Int<W> c = make_int<W>(7);
+        for (uint64_t i = 0; i < iters; i++) {
+            a = (a ^ b) & c;
+            do_not_optimize(a);
+        }
+    });
+    vulbench::add(prefix + "shift", 1, [](uint64_t iters) {
+        Int<W> a = make_int<W>(8);
+        for (uint64_t i = 0; i < iters; i++) {
+            a = (a << 3) | (a >> (W - 3));
+            do_not_optimize(a);
+        }
+    });
+    vulbench::add(prefix + "slice_read", 1, [](uint64_t iters) {
+        Int<W> a = make_int<W>(9);
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < iters; i++) {
+            acc += Int<W / 2>(a.template at<W - 2, W / 2 - 1>()).template to<uint64_t>();
+            do_not_optimize(a);
+        }
+        do_not_optimize(acc);
+    });
+    vulbench::add(prefix + "slice_write", 1, [](uint64_t iters) {
+        Int<W> a = make_int<W>(10);
+        Int<W / 2> b = make_int<W / 2>(11);
+        for (uint64_t i = 0; i < iters; i++) {
+            a.template at<W - 2, W / 2 - 1>() = b;
+            do_not_optimize(a);
+            b = b + Int<W / 2>(1);
+        }
+    });
+    // 四个 W/8 位字段分别位于 [W/8-1:0]、[W/4+W/8-1:W/4]、[W/2+W/8-1:W/2]、[3W/4+W/8-1:3W/4]，
+    // 对比逐字段切片拼接与一次 BitGather / BitScatter
+    constexpr uint32_t F = W / 8;
+    vulbench::add(prefix + "fields_slice_read", 1, [](uint64_t iters) {
+        Int<W> a = make_int<W>(14);
+        for (uint64_t i = 0; i < iters; i++) {
+            const Int<4 * F> packed = Cat(a.template at<3 * W / 4 + F - 1, 3 * W / 4>(), a.template at<W / 2 + F - 1, W / 2>(),
+                                          a.template at<W / 4 + F - 1, W / 4>(), a.template at<F - 1, 0>());
+            do_not_optimize(packed);
+            do_not_optimize(a);
+        }
+    });
+    vulbench::add(prefix + "fields_gather", 1, [](uint64_t iters) {
+        Int<W> a = make_int<W>(14);
+        const Int<W> mask = Repeat<4>(Cat(Int<W / 4 - F>(0), ~Int<F>(0)));
+        for (uint64_t i = 0; i < iters; i++) {
+            const Int<W> packed = BitGather(a, mask);
+            do_not_optimize(packed);
+            do_not_optimize(a);
+        }
+    });
+    vulbench::add(prefix + "fields_slice_write", 1, [](uint64_t iters) {
+        Int<W> a = 0;
+        Int<4 * F> b = make_int<4 * F>(15);
+        for (uint64_t i = 0; i < iters; i++) {
+            a.template at<F - 1, 0>() = b.template at<F - 1, 0>();
+            a.template at<W / 4 + F - 1, W / 4>() = b.template at<2 * F - 1, F>();
+            a.template at<W / 2 + F - 1, W / 2>() = b.template at<3 * F - 1, 2 * F>();
+            a.template at<3 * W / 4 + F - 1, 3 * W / 4>() = b.template at<4 * F - 1, 3 * F>();
+            do_not_optimize(a);
+            b = b + Int<4 * F>(1);
+        }
+    });
+    vulbench::add(prefix + "fields_scatter", 1, [](uint64_t iters) {
+        Int<W> a = 0;
+        Int<W> b = make_int<W>(15);
+        const Int<W> mask = Repeat<4>(Cat(Int<W / 4 - F>(0), ~Int<F>(0)));
+        for (uint64_t i = 0; i < iters; i++) {
+            a = BitScatter(b, mask);
+            do_not_optimize(a);
+            b = b + Int<W>(1);
+        }
+    });
+    vulbench::add(prefix + "pack_bools_loop", 1, [](uint64_t iters) {
+        std::array<bool, W> bools{};
+        for (uint32_t j = 0; j < W; j++) {
+            bools[j] = (j * 7) % 3 == 0;
+        }
+        for (uint64_t i = 0; i < iters; i++) {
+            Int<W> a = 0;
+            for (uint32_t j = 0; j < W; j++) {
+                a.pick(j) = bools[j];
+            }
+            do_not_optimize(a);
+            do_not_optimize(bools);
+        }
+    });
+    vulbench::add(prefix + "pack_bools", 1, [](uint64_t iters) {
+        std::array<bool, W> bools{};
+        for (uint32_t j = 0; j < W; j++) {
+            bools[j] = (j * 7) % 3 == 0;
+        }
+        for (uint64_t i = 0; i < iters; i++) {
+            const Int<W> a = PackBools(bools);
+            do_not_optimize(a);
+            do_not_optimize(bools);
+        }
+    });
+    vulbench::add(prefix + "unpack_bools", 1, [](uint64_t iters) {
+        Int<W> a = make_int<W>(16);
+        for (uint64_t i = 0; i < iters; i++) {
+            const std::array<bool, W> bools = UnpackBools(a);
+            do_not_optimize(bools);
+            do_not_optimize(a);
+        }
+    });
+    vulbench::add(prefix + "compare", 1, [](uint64_t iters) {
+        Int<W> a = make_int<W>(12);
+        const Int<W> b = make_int<W>(13);
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < iters; i++) {
+            acc += (a < b) ? 1 : 0;
+            do_not_optimize(a);
+        }
+        do_not_optimize(acc);
+    });
+}
+
+// ---------------- VulRegister / VulRegisterArray ----------------
+
+void add_register_cases() {
+    vulbench::add("reg/u64/setnext_commit", 1, [](uint64_t iters) {
+        VulRegister<uint64_t> reg;
+        for (uint64_t i = 0; i < iters; i++) {
+            reg.setnext(reg.get() + 1);
+            reg.apply_next_tick();
+            do_not_optimize(reg);
+        }
+        do_not_optimize(reg.get());
+    });
+    vulbench::add("reg/int128x2/setnext_commit", 1, [](uint64_t iters) {
+        VulRegister<Int<128>, 2> reg;
+        for (uint64_t i = 0; i < iters; i++) {
+            reg.setnext<1>(reg.get() + Int<128>(1));
+            reg.setnext<0>(reg.get() + Int<128>(2));
+            reg.apply_next_tick();
+            do_not_optimize(reg);
+        }
+        do_not_optimize(reg.get());
+    });
+}
+
+// 每周期写入 Writes 个不重复下标后提交，ns/op 为每周期开销
+template <uint32_t Size, uint32_t Writes>
+void add_array_case() {
+    const std::string name = "regarray/" + std::to_string(Size) + "/w" + std::to_string(Writes);
+    vulbench::add(name, 1, [](uint64_t iters) {
+        auto reg = std::make_unique<VulRegisterArray<uint64_t, Size>>();
+        const uint32_t stride = (Size / Writes) | 1;
+        uint32_t base = 0;
+        for (uint64_t i = 0; i < iters; i++) {
+            for (uint32_t w = 0; w < Writes; w++) {
+                const uint32_t index = (base + w * stride) % Size;
+                reg->setnext(index, i);
+            }
+            base = (base + 1) % Size;
+            reg->apply_next_tick();
+        }
+        do_not_optimize((*reg)[0]);
+    });
+}
+
+template <uint32_t Size>
+void add_array_bulk_case() {
+    const std::string name = "regarray/" + std::to_string(Size) + "/setnext_all";
+    vulbench::add(name, 1, [](uint64_t iters) {
+        auto reg = std::make_unique<VulRegisterArray<uint64_t, Size>>();
+        std::array<uint64_t, Size> next{};
+        for (uint64_t i = 0; i < iters; i++) {
+            next[i % Size] = i;
+            reg->setnext_all(next);
+            reg->apply_next_tick();
+        }
+        do_not_optimize((*reg)[0]);
+    });
+}
+
+// ---------------- VulQueue / VulQueueMP ----------------
+
+template <uint32_t Depth>
+void add_queue_case() {
+    vulbench::add("queue/" + std::to_string(Depth) + "/enq_deq", 1, [](uint64_t iters) {
+        VulQueue<uint64_t, Depth> q;
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < iters; i++) {
+            if (q.deqvalid()) {
+                acc += q.front();
+                q.deqnext();
+            }
+            if (q.enqready()) {
+                q.enqnext(i);
+            }
+            q.apply_next_tick();
+        }
+        do_not_optimize(acc);
+    });
+}
+
+template <uint32_t Depth, uint32_t Width>
+void add_queue_mp_case() {
+    vulbench::add("queuemp/" + std::to_string(Depth) + "x" + std::to_string(Width) + "/enq_deq", 1,
+                  [](uint64_t iters) {
+        VulQueueMP<uint64_t, Depth, Width, Width> q;
+        std::array<uint64_t, Width> values{};
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < iters; i++) {
+            const uint32_t valid = q.deqvalid();
+            if (valid) {
+                acc += q.front()[0];
+                q.deqnext(valid);
+            }
+            const uint32_t ready = q.enqreqdy();
+            if (ready) {
+                values[0] = i;
+                q.enqnext(values, ready);
+            }
+            q.apply_next_tick();
+        }
+        do_not_optimize(acc);
+    });
+}
+
+// ---------------- VulBRAM ----------------
+
+template <uint64_t Size, uint32_t Ports>
+void add_bram_case() {
+    vulbench::add("bram/" + std::to_string(Size) + "/" + std::to_string(Ports) + "r" + std::to_string(Ports) + "w",
+                  1, [](uint64_t iters) {
+        using Bram = VulBRAM<uint64_t, Size, Ports, Ports>;
+        auto bram = std::make_unique<Bram>();
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < iters; i++) {
+            [&]<uint32_t... P>(std::integer_sequence<uint32_t, P...>) {
+                (bram->template readreq<P>(typename Bram::AddrType((i * 7 + P * 13) % Size)), ...);
+                (bram->template write<P>(typename Bram::AddrType((i * 5 + P * 11) % Size), i + P), ...);
+            }(std::make_integer_sequence<uint32_t, Ports>{});
+            bram->apply_next_tick();
+            acc += bram->template readdata<0>();
+        }
+        do_not_optimize(acc);
+    });
+}
+
+// ---------------- VulSparseMemory ----------------
+
+// 对比仿真入口中常见的平坦数组逐字节小端读写与 VulSparseMemory，访问模式相同：
+// 工作集 Span 字节内的随机 8/4 字节读改写，其中约 1/8 的访问不对齐
+template <uint64_t Span>
+uint64_t mem_bench_addr(uint64_t i) {
+    const uint64_t addr = ((i * 0x9e3779b97f4a7c15ULL) >> 20) % (Span - 8);
+    return (i & 7) == 0 ? addr : (addr & ~uint64_t(7));
+}
+
+template <uint64_t Span>
+void add_mem_cases() {
+    const std::string suffix = "/" + std::to_string(Span >> 10) + "k/load_store";
+    vulbench::add("mem/flat_bytewise" + suffix, 1, [](uint64_t iters) {
+        std::vector<uint8_t> memory(Span, 0);
+        auto load_le = [&](uint64_t addr, uint32_t width) {
+            uint64_t value = 0;
+            for (uint32_t b = 0; b < width; b++) {
+                value |= static_cast<uint64_t>(memory[addr + b]) << (8U * b);
+            }
+            return value;
+        };
+        auto store_le = [&](uint64_t addr, uint64_t value, uint32_t width) {
+            for (uint32_t b = 0; b < width; b++) {
+                memory[addr + b] = static_cast<uint8_t>(value >> (8U * b));
+            }
+        };
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < iters; i++) {
+            const uint64_t addr = mem_bench_addr<Span>(i);
+            const uint32_t width = (i & 2) ? 8 : 4;
+            acc += load_le(addr, width);
+            store_le(addr, acc, width);
+        }
+        do_not_optimize(acc);
+    });
+    vulbench::add("mem/sparse" + suffix, 1, [](uint64_t iters) {
+        VulSparseMemory memory;
+        uint64_t acc = 0;
+        for (uint64_t i = 0; i < iters; i++) {
+            const uint64_t addr = mem_bench_addr<Span>(i);
+            const uint32_t width = (i & 2) ? 8 : 4;
+            acc += memory.load_le(addr, width);
+            memory.store_le(addr, acc, width);
+        }
+        do_not_optimize(acc);
+    });
+}
+
+// ---------------- GlobalVCDRecord ----------------
+
+template <uint32_t Signals, uint32_t Width>
+void add_vcd_case() {
+    vulbench::add("vcd/" + std::to_string(Signals) + "x" + std::to_string(Width) + "/record_commit", 1,
+                  [](uint64_t iters) {
+        const auto path = std::filesystem::temp_directory_path() / "vullib_bench.vcd";
+        GlobalVCDRecord rec;
+        std::vector<uint32_t> ids;
+        for (uint32_t s = 0; s < Signals; s++) {
+            ids.push_back(rec.registe("top.sig" + std::to_string(s), Width));
+        }
+        rec.init(path.string(), 1, 1024);
+        const uint64_t mask = Width >= 64 ? ~uint64_t(0) : ((uint64_t(1) << Width) - 1);
+        for (uint64_t i = 0; i < iters; i++) {
+            for (uint32_t s = 0; s < Signals; s++) {
+                // 约一半信号每周期变化
+                rec.record(ids[s], ((i >> (s & 1)) + s) & mask);
+            }
+            rec.commit();
+        }
+        rec.close();
+        std::filesystem::remove(path);
+    });
+}
+
+void register_cases() {
+    add_int_cases<8>();
+    add_int_cases<32>();
+    add_int_cases<64>();
+    add_int_cases<128>();
+    add_int_cases<256>();
+
+    add_register_cases();
+    add_array_case<16, 1>();
+    add_array_case<16, 16>();
+    add_array_case<64, 4>();
+    add_array_case<64, 32>();
+    add_array_case<1024, 8>();
+    add_array_case<1024, 256>();
+    add_array_case<1024, 1024>();
+    add_array_bulk_case<64>();
+    add_array_bulk_case<1024>();
+
+    add_queue_case<2>();
+    add_queue_case<16>();
+    add_queue_case<256>();
+    add_queue_mp_case<16, 2>();
+    add_queue_mp_case<64, 4>();
+    add_queue_mp_case<256, 8>();
+
+    add_bram_case<1024, 1>();
+    add_bram_case<1024, 2>();
+    add_bram_case<65536, 4>();
+
+    add_mem_cases<64 * 1024>();
+    add_mem_cases<16 * 1024 * 1024>();
+
+    add_vcd_case<16, 1>();
+    add_vcd_case<64, 32>();
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    register_cases();
+    return vulbench::run_main(argc, argv);
+}
@@ -0,0 +1,273 @@
+// MIT License
+
+// Copyright (c) 2026 Meng Chengzhen, in Shandong University
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "common.h"
+#include "fixint.hpp"
+#include <array>
+#include <type_traits>
+
+// 全相联查找表：Entries 个表项，每项为 (valid, key, value)。
+// 读接口（find/valid/key/value/findfree）看到的是已提交的状态；writenext/invalidatenext/clrnext 在提交时生效。
+// 提交顺序：clrnext 最先并丢弃同周期的写入；然后按端口顺序执行 invalidatenext 与 writenext。
+// find() 返回 key 匹配的最小有效表项下标，未命中返回 Entries，与 RTL 比较器阵列加优先编码器的结果一致。
+//
+// 仿真用开放寻址的散列索引代替逐项比较：槽位存放有效表项的下标，线性探测，删除时回移后继槽位。
+// 散列表容量为不小于 2 * Entries 的 2 的幂，查找、写入与失效的期望开销与 Entries 无关。
+// 允许多个有效表项的 key 相同，find() 扫描整个探测序列取最小下标。
+namespace vulcam {
+
+inline uint64_t mix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+template<typename Key>
+uint64_t key_hash(const Key &key) {
+    if constexpr (std::is_integral_v<Key> || std::is_enum_v<Key>) {
+        return mix64(static_cast<uint64_t>(key));
+    } else {
+        uint64_t h = 0;
+        for (uint64_t word : key.get_data()) {
+            h = mix64(h ^ word);
+        }
+        return h;
+    }
+}
+
+constexpr uint32_t table_capacity(uint32_t entries) {
+    uint32_t cap = 1;
+    while (cap < entries * 2) {
+        cap <<= 1;
+    }
+    return cap;
+}
+
+} // namespace vulcam
+
+template<typename Key, typename Value, uint32_t Entries, uint32_t WritePorts = 1>
+class VulCAM {
+    static_assert(Entries >= 1, "Entries must be at least 1");
+    static_assert(WritePorts >= 1, "WritePorts must be at least 1");
+public:
+    VulCAM() {
+        slots_.fill(EMPTY_SLOT);
+    }
+
+    bool valid(const uint32_t idx) const {
+        assert(idx < Entries);
+        return (valid_bits_[idx / 64] >> (idx % 64)) & 1;
+    }
+
+    const Key& key(const uint32_t idx) const {
+        assert(idx < Entries);
+        return keys_[idx];
+    }
+
+    const Value& value(const uint32_t idx) const {
+        assert(idx < Entries);
+        return values_[idx];
+    }
+
+    uint32_t find(const Key &key) const {
+        uint32_t best = Entries;
+        uint32_t pos = home(key);
+        while (slots_[pos] != EMPTY_SLOT) {
+            const uint32_t idx = slots_[pos];
+            if (idx < best && keys_[idx] == key) {
+                best = idx;
+            }
+            pos = (pos + 1) & TABLE_MASK;
+        }
+        return best;
+    }
+
+    bool contains(const Key &key) const {
+        return find(key) != Entries;
+    }
+
+    // 最小的无效表项下标，表满时返回 Entries
+    uint32_t findfree() const {
+        for (uint32_t w = 0; w < VALID_WORDS; ++w) {
+            uint64_t free_bits = ~valid_bits_[w];
+            if (w == VALID_WORDS - 1 && Entries % 64 != 0) {
+                free_bits &= (uint64_t(1) << (Entries % 64)) - 1;
+            }
+            if (free_bits != 0) {
+                return w * 64 + static_cast<uint32_t>(__builtin_ctzll(free_bits));
+            }
+        }
+        return Entries;
+    }
+
+    uint32_t size() const {
+        return size_;
+    }
+
+    template<uint32_t P = 0>
+    void writenext(const uint32_t idx, const Key &key, const Value &value) {
+        static_assert(P < WritePorts, "Port index out of range");
+        assert(idx < Entries);
+        assert(write_op_[P] == WRITE_NONE);
+        write_op_[P] = WRITE_SET;
+        write_idx_[P] = idx;
+        write_key_[P] = key;
+        write_value_[P] = value;
+        has_pending_ = true;
+    }
+
+    template<uint32_t P = 0>
+    void invalidatenext(const uint32_t idx) {
+        static_assert(P < WritePorts, "Port index out of range");
+        assert(idx < Entries);
+        assert(write_op_[P] == WRITE_NONE);
+        write_op_[P] = WRITE_INVALIDATE;
+        write_idx_[P] = idx;
+        has_pending_ = true;
+    }
+
+    void clrnext() {
+#ifndef VULSIM_UNCHECKED
+        assert(!clr_called_);
+        clr_called_ = true;
+#endif
+        clr_pending_ = true;
+        has_pending_ = true;
+    }
+
+    void apply_next_tick() {
+        if (!has_pending_) {
+            return;
+        }
+        if (clr_pending_) {
+            // 清空只在冲刷时发生，直接重置整个散列表
+            slots_.fill(EMPTY_SLOT);
+            valid_bits_.fill(0);
+            size_ = 0;
+        } else {
+#ifndef NDEBUG
+            for (uint32_t p = 0; p < WritePorts; ++p) {
+                for (uint32_t q = p + 1; q < WritePorts; ++q) {
+                    assert(write_op_[p] == WRITE_NONE || write_op_[q] == WRITE_NONE || write_idx_[p] != write_idx_[q]);
+                }
+            }
+#endif
+            for (uint32_t p = 0; p < WritePorts; ++p) {
+                const uint32_t idx = write_idx_[p];
+                if (write_op_[p] == WRITE_INVALIDATE) {
+                    if (valid(idx)) {
+                        erase(idx);
+                    }
+                } else if (write_op_[p] == WRITE_SET) {
+                    if (valid(idx) && keys_[idx] == write_key_[p]) {
+                        values_[idx] = write_value_[p];
+                        continue;
+                    }
+                    if (valid(idx)) {
+                        erase(idx);
+                    }
+                    keys_[idx] = write_key_[p];
+                    values_[idx] = write_value_[p];
+                    insert(idx);
+                }
+            }
+        }
+        write_op_.fill(WRITE_NONE);
+        clr_pending_ = false;
+#ifndef VULSIM_UNCHECKED
+        clr_called_ = false;
+#endif
+        has_pending_ = false;
+    }
+
+    // 本周期没有写入、失效或清空，提交不改变内容
+    bool _quiescent() const {
+        return !has_pending_;
+    }
+
+private:
+    static constexpr uint32_t TABLE_SIZE = vulcam::table_capacity(Entries);
+    static constexpr uint32_t TABLE_MASK = TABLE_SIZE - 1;
+    static constexpr uint32_t EMPTY_SLOT = UINT32_MAX;
+    static constexpr uint32_t VALID_WORDS = (Entries + 63) / 64;
+
+    static constexpr uint8_t WRITE_NONE = 0;
+    static constexpr uint8_t WRITE_SET = 1;
+    static constexpr uint8_t WRITE_INVALIDATE = 2;
+
+    static uint32_t home(const Key &key) {
+        return static_cast<uint32_t>(vulcam::key_hash(key)) & TABLE_MASK;
+    }
+
+    void insert(const uint32_t idx) {
+        uint32_t pos = home(keys_[idx]);
+        while (slots_[pos] != EMPTY_SLOT) {
+            pos = (pos + 1) & TABLE_MASK;
+        }
+        slots_[pos] = idx;
+        valid_bits_[idx / 64] |= uint64_t(1) << (idx % 64);
+        ++size_;
+    }
+
+    void erase(const uint32_t idx) {
+        uint32_t pos = home(keys_[idx]);
+        while (slots_[pos] != idx) {
+            assert(slots_[pos] != EMPTY_SLOT);
+            pos = (pos + 1) & TABLE_MASK;
+        }
+        // 线性探测的回移删除：把后继槽位中探测起点不在 (pos, next] 内的表项移到空出的位置
+        uint32_t next = (pos + 1) & TABLE_MASK;
+        while (slots_[next] != EMPTY_SLOT) {
+            const uint32_t want = home(keys_[slots_[next]]);
+            const bool in_range = (pos <= next) ? (pos < want && want <= next) : (pos < want || want <= next);
+            if (!in_range) {
+                slots_[pos] = slots_[next];
+                pos = next;
+            }
+            next = (next + 1) & TABLE_MASK;
+        }
+        slots_[pos] = EMPTY_SLOT;
+        valid_bits_[idx / 64] &= ~(uint64_t(1) << (idx % 64));
+        --size_;
+    }
+
+    std::array<Key, Entries> keys_{};
+    std::array<Value, Entries> values_{};
+    std::array<uint64_t, VALID_WORDS> valid_bits_{};
+    std::array<uint32_t, TABLE_SIZE> slots_{};
+    uint32_t size_ = 0;
+
+    std::array<uint8_t, WritePorts> write_op_{};
+    std::array<uint32_t, WritePorts> write_idx_{};
+    std::array<Key, WritePorts> write_key_{};
+    std::array<Value, WritePorts> write_value_{};
+    bool clr_pending_ = false;
+#ifndef VULSIM_UNCHECKED
+    bool clr_called_ = false;
+#endif
+    bool has_pending_ = false;
+};
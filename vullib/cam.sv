@@ -0,0 +1,67 @@
+// VulCAM：全相联查找表，周期行为与 cam.hpp 一致。
+// 表项 (valid, key, value) 全部以阵列形式输出，查找在逻辑侧由比较器阵列加优先编码器完成，取匹配的最小下标。
+// 写端口在时钟沿生效：wen 有效时 wvalid 为 1 写入 key/value 并置有效位，为 0 只清有效位。
+// 多个写端口按端口顺序生效，同一周期不应写同一个表项。
+// key/value 阵列不复位，有效位复位为 0；清空只清有效位，并丢弃同周期的写入。
+
+module VulCAM #(
+    parameter int unsigned KeyWidth = 32,
+    parameter int unsigned ValueWidth = 32,
+    parameter int unsigned Entries = 8,
+    parameter int unsigned WritePorts = 1,
+    parameter int unsigned IdxWidth = $clog2(Entries + 1)
+) (
+    input  logic                  clk,
+    input  logic                  rstn,
+
+    output logic                  valid  [0:Entries-1],
+    output logic [KeyWidth-1:0]   keys   [0:Entries-1],
+    output logic [ValueWidth-1:0] values [0:Entries-1],
+
+    input  logic                  wen    [0:WritePorts-1],  // 本周期该端口是否写入
+    input  logic                  wvalid [0:WritePorts-1],  // 1 为写入表项，0 为使表项失效
+    input  logic [IdxWidth-1:0]   widx   [0:WritePorts-1],
+    input  logic [KeyWidth-1:0]   wkey   [0:WritePorts-1],
+    input  logic [ValueWidth-1:0] wvalue [0:WritePorts-1],
+
+    input  logic                  clrnext                   // 清空所有表项，在下个周期生效
+);
+
+logic [KeyWidth-1:0]   key_q   [0:Entries-1];
+logic [ValueWidth-1:0] value_q [0:Entries-1];
+logic [Entries-1:0]    valid_q;
+
+always_ff @(posedge clk) begin
+    if (rstn && !clrnext) begin
+        for (int p = 0; p < WritePorts; p = p + 1) begin
+            if (wen[p] && wvalid[p] && int'(widx[p]) < Entries) begin
+                key_q[widx[p]] <= wkey[p];
+                value_q[widx[p]] <= wvalue[p];
+            end
+        end
+    end
+end
+
+always_ff @(posedge clk or negedge rstn) begin
+    if (!rstn) begin
+        valid_q <= '0;
+    end else if (clrnext) begin
+        valid_q <= '0;
+    end else begin
+        for (int p = 0; p < WritePorts; p = p + 1) begin
+            if (wen[p] && int'(widx[p]) < Entries) begin
+                valid_q[widx[p]] <= wvalid[p];
+            end
+        end
+    end
+end
+
+always_comb begin
+    for (int i = 0; i < Entries; i = i + 1) begin
+        valid[i] = valid_q[i];
+        keys[i] = key_q[i];
+        values[i] = value_q[i];
+    end
+end
+
+endmodule
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include <stdint.h>
 
@@ -34,6 +35,9 @@
 #define FORCE_INLINE inline
 #endif
 
+// VULSIM_UNCHECKED：unchecked 构建档位（vulsimgen --profile unchecked）。
+// 去掉“每周期至多调用一次”一类检查所用的标志位及其提交时的复位，其余断言不受影响。
+
 static_assert(sizeof(bool) == 1, "sizeof(bool) == 1");
 static_assert(sizeof(__uint128_t) == 16, "sizeof(__uint128_t) == 16");
 static_assert(sizeof(__int128_t) == 16, "sizeof(__int128_t) == 16");
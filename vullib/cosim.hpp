@@ -0,0 +1,198 @@
+// MIT License
+
+// Copyright (c) 2025 Meng Chengzhen, in Shandong University
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+// VUL 仿真与 Verilator 模型锁步联合仿真的一致性检查
+// 两侧把每个周期可观察的边界事件（事务端口的参数与响应、QUERY 取值）编码为 64 位字序列。
+// 事件哈希按与顺序无关的方式累加为周期哈希，周期哈希再滚动合并为前缀哈希。
+// 每 interval 个周期比较一次两侧的前缀哈希；不一致时在窗口内二分前缀哈希，
+// 定位第一个出现差异的周期并输出该周期两侧的事件。
+
+enum VulCosimSide : uint32_t {
+    VulCosimRef = 0, // VUL 仿真
+    VulCosimDut = 1, // Verilator 模型
+};
+
+inline uint64_t vul_cosim_mix(uint64_t h, uint64_t v) {
+    uint64_t x = h ^ (v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+class VulCosimChecker {
+public:
+    void configure(uint64_t interval, std::vector<std::string> port_names) {
+        interval_ = interval ? interval : 1;
+        port_names_ = std::move(port_names);
+        for (auto &side : sides_) {
+            side.prefixes.reserve(interval_);
+        }
+    }
+
+    void begin_event(VulCosimSide side, uint32_t port, uint32_t index) {
+        Side &s = sides_[side];
+        s.event_hash = vul_cosim_mix(vul_cosim_mix(0, port + 1), index);
+        s.event_start = s.log.size();
+        s.log.push_back(port);
+        s.log.push_back(index);
+        s.log.push_back(0);
+    }
+
+    void word(VulCosimSide side, uint64_t value) {
+        Side &s = sides_[side];
+        s.event_hash = vul_cosim_mix(s.event_hash, value);
+        s.log.push_back(value);
+    }
+
+    void end_event(VulCosimSide side) {
+        Side &s = sides_[side];
+        s.log[s.event_start + 2] = s.log.size() - s.event_start - 3;
+        s.cycle_hash += s.event_hash;
+    }
+
+    // 一个周期结束；发现不一致时输出报告并返回 false
+    bool end_cycle(uint64_t cycle) {
+        for (auto &s : sides_) {
+            s.prefix = vul_cosim_mix(s.prefix, s.cycle_hash);
+            s.cycle_hash = 0;
+            s.prefixes.push_back(s.prefix);
+            s.log.push_back(LogCycleEnd);
+        }
+        cycles_++;
+        if (sides_[0].prefixes.size() < interval_) {
+            return true;
+        }
+        return check(cycle);
+    }
+
+    // 仿真结束时检查最后不满一个间隔的周期
+    bool finish(uint64_t cycle) {
+        if (failed_) {
+            return false;
+        }
+        if (!sides_[0].prefixes.empty() && !check(cycle)) {
+            return false;
+        }
+        std::fprintf(stderr, "[vulsim-cosim] cycles=%llu checks=%llu: match\n",
+                     static_cast<unsigned long long>(cycles_), static_cast<unsigned long long>(checks_));
+        return true;
+    }
+
+    bool failed() const {
+        return failed_;
+    }
+
+    // 第一个出现差异的周期，未发现差异时为 0
+    uint64_t mismatch_cycle() const {
+        return mismatch_cycle_;
+    }
+
+private:
+    // 周期结束标记，端口编号不会取到该值
+    static constexpr uint64_t LogCycleEnd = ~0ULL;
+
+    struct Side {
+        uint64_t event_hash = 0;
+        uint64_t cycle_hash = 0;
+        uint64_t prefix = 0;
+        size_t event_start = 0;
+        std::vector<uint64_t> prefixes; // 窗口内每个周期结束时的前缀哈希
+        std::vector<uint64_t> log;      // 窗口内的事件：port, index, n, words[n]，每个周期以 LogCycleEnd 结束
+    };
+
+    bool check(uint64_t cycle) {
+        checks_++;
+        const size_t n = sides_[0].prefixes.size();
+        const uint64_t window_start = cycle - n;
+        if (sides_[0].prefix == sides_[1].prefix) {
+            for (auto &s : sides_) {
+                s.prefixes.clear();
+                s.log.clear();
+            }
+            return true;
+        }
+        // 前缀哈希一旦不同就一直不同，二分找到第一个不同的位置
+        size_t lo = 0, hi = n - 1;
+        while (lo < hi) {
+            const size_t mid = lo + (hi - lo) / 2;
+            if (sides_[0].prefixes[mid] != sides_[1].prefixes[mid]) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        failed_ = true;
+        mismatch_cycle_ = window_start + lo + 1;
+        std::fprintf(stderr, "[vulsim-cosim] mismatch in cycles %llu..%llu, first divergent cycle %llu\n",
+                     static_cast<unsigned long long>(window_start + 1), static_cast<unsigned long long>(cycle),
+                     static_cast<unsigned long long>(mismatch_cycle_));
+        dump(VulCosimRef, "vul", lo);
+        dump(VulCosimDut, "rtl", lo);
+        return false;
+    }
+
+    void dump(VulCosimSide side, const char *label, size_t cycle_offset) const {
+        const auto &log = sides_[side].log;
+        size_t pos = 0;
+        for (size_t c = 0; c < cycle_offset; pos++) {
+            if (log[pos] == LogCycleEnd) {
+                c++;
+            } else {
+                pos += 2 + log[pos + 2];
+            }
+        }
+        while (log[pos] != LogCycleEnd) {
+            const uint64_t port = log[pos];
+            const uint64_t index = log[pos + 1];
+            const uint64_t count = log[pos + 2];
+            std::string line = port < port_names_.size() ? port_names_[port] : ("port" + std::to_string(port));
+            line += "[" + std::to_string(index) + "]:";
+            char buf[24];
+            for (uint64_t i = 0; i < count; i++) {
+                std::snprintf(buf, sizeof(buf), " 0x%llx", static_cast<unsigned long long>(log[pos + 3 + i]));
+                line += buf;
+            }
+            std::fprintf(stderr, "[vulsim-cosim]   %s %s\n", label, line.c_str());
+            pos += 3 + count;
+        }
+    }
+
+    uint64_t interval_ = 1024;
+    std::vector<std::string> port_names_;
+    Side sides_[2];
+    uint64_t cycles_ = 0;
+    uint64_t checks_ = 0;
+    uint64_t mismatch_cycle_ = 0;
+    bool failed_ = false;
+};
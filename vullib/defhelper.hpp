@@ -91,9 +91,15 @@ inline constexpr int64_t clog2(int64_t value) {
 
 #define QUERY(name, rettype) rettype name()
 
+#define QUERY_CACHED(name, rettype) rettype name()
+
 
 #define TICK_IMPL() void tick()
 
+#define CLOCK_RATIO(ratio) static_assert((ratio) >= 1)
+
+#define QUIESCENT_TIMER(reg) static_assert(sizeof(reg) > 0)
+
 #define CHILD_INSTANCE(module, name, ...) void * name = nullptr;
 #define CHILD_INSTANCE_ARRAY1(module, name, N0, ...) void * name[N0];
 #define CHILD_INSTANCE_ARRAY2(module, name, N0, N1, ...) void * name[N0][N1];
@@ -119,3 +125,9 @@ inline constexpr int64_t clog2(int64_t value) {
 #define QUEUE(name, type, depth) VulQueue<type, depth> name;
 
 #define QUEUE_MP(name, type, depth, enqwidth, deqwidth) VulQueueMP<type, depth, enqwidth, deqwidth> name;
+
+#define DELAY_LINE(name, type, latency) VulDelayLine<type, latency> name;
+
+#define DELAY_LINE_MP(name, type, latency, width) VulDelayLineMP<type, latency, width> name;
+
+#define CAM(name, keytype, valuetype, entries, writeports) VulCAM<keytype, valuetype, entries, writeports> name;
@@ -0,0 +1,211 @@
+// MIT License
+
+// Copyright (c) 2026 Meng Chengzhen, in Shandong University
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "common.h"
+#include "fixint.hpp"
+#include <array>
+
+// 固定延迟线：第 t 个周期 pushnext() 压入的元素在第 t + Latency 个周期从 out() 输出，只保持一个周期。
+// 没有反压，输出必须在当周期被使用。
+//
+// 存储为 Latency + 1 个槽位的环形缓冲：head_ 是本周期输出的槽位，(head_ + Latency) % (Latency + 1)
+// 是本周期压入的槽位，它上个周期刚输出完，不会被读取，pushnext() 直接写入而不经过暂存。
+// 每次提交只写一个槽位的计数并推进 head_，压入、读取与提交都与 Latency 无关。
+// 清空通过代号实现：槽位记录写入时的代号，与当前代号不同的槽位视为空。
+// 一个在途槽位最多经过 Latency 次提交就被重写，代号差不超过 Latency，32 位代号回绕不会误判。
+namespace vuldelayline {
+
+template<typename Slot, uint32_t Latency>
+class Ring {
+    static_assert(Latency >= 1, "Latency must be at least 1");
+public:
+    static constexpr uint32_t Slots = Latency + 1;
+
+    uint32_t outnum() const {
+        return gen_[head_] == cur_gen_ ? num_[head_] : 0;
+    }
+
+    const Slot &outslot() const {
+        return data_[head_];
+    }
+
+    Slot &pushslot() {
+        return data_[tail()];
+    }
+
+    void commit(uint32_t push_num, bool clr) {
+        if (outnum() > 0) {
+            inflight_ -= num_[head_];
+        }
+        if (clr) {
+            ++cur_gen_;
+            inflight_ = 0;
+            push_num = 0;
+        }
+        const uint32_t idx = tail();
+        num_[idx] = push_num;
+        gen_[idx] = cur_gen_;
+        inflight_ += push_num;
+        if (++head_ == Slots) {
+            head_ = 0;
+        }
+    }
+
+    uint64_t inflight() const {
+        return inflight_;
+    }
+
+private:
+    uint32_t tail() const {
+        const uint32_t idx = head_ + Latency;
+        return idx >= Slots ? idx - Slots : idx;
+    }
+
+    std::array<Slot, Slots> data_{};
+    std::array<uint32_t, Slots> num_{};
+    std::array<uint32_t, Slots> gen_{};
+    uint32_t head_ = 0;
+    uint32_t cur_gen_ = 1;
+    uint64_t inflight_ = 0;
+};
+
+} // namespace vuldelayline
+
+template<typename T, uint32_t Latency>
+class VulDelayLine {
+public:
+    VulDelayLine() = default;
+
+    bool outvalid() const {
+        return ring_.outnum() > 0;
+    }
+
+    const T& out() const {
+        return ring_.outslot();
+    }
+
+    void pushnext(const T &value) {
+#ifndef VULSIM_UNCHECKED
+        assert(!push_called_);
+        push_called_ = true;
+#endif
+        ring_.pushslot() = value;
+        push_pending_ = true;
+    }
+
+    void clrnext() {
+#ifndef VULSIM_UNCHECKED
+        assert(!clr_called_);
+        clr_called_ = true;
+#endif
+        clr_pending_ = true;
+    }
+
+    void apply_next_tick() {
+        ring_.commit(push_pending_ ? 1 : 0, clr_pending_);
+        push_pending_ = false;
+        clr_pending_ = false;
+#ifndef VULSIM_UNCHECKED
+        push_called_ = false;
+        clr_called_ = false;
+#endif
+    }
+
+    // 没有在途元素且本周期没有压入或清空，之后的周期都不会有输出
+    bool _quiescent() const {
+        return !push_pending_ && !clr_pending_ && ring_.inflight() == 0;
+    }
+
+private:
+    vuldelayline::Ring<T, Latency> ring_;
+
+    bool push_pending_ = false;
+    bool clr_pending_ = false;
+#ifndef VULSIM_UNCHECKED
+    bool push_called_ = false;
+    bool clr_called_ = false;
+#endif
+};
+
+template<typename T, uint32_t Latency, uint32_t Width>
+class VulDelayLineMP {
+    static_assert(Width >= 1, "Width must be at least 1");
+public:
+    VulDelayLineMP() = default;
+
+    uint32_t outvalid() const {
+        return ring_.outnum();
+    }
+
+    // 只有前 outvalid() 个元素有效
+    const std::array<T, Width>& out(const uint32_t num = Width) const {
+        (void)num;
+        return ring_.outslot();
+    }
+
+    void pushnext(const std::array<T, Width> &values, const uint32_t num = Width) {
+#ifndef VULSIM_UNCHECKED
+        assert(!push_called_);
+        push_called_ = true;
+#endif
+        const uint32_t req = num < Width ? num : Width;
+        auto &slot = ring_.pushslot();
+        for (uint32_t i = 0; i < req; ++i) {
+            slot[i] = values[i];
+        }
+        push_pending_num_ = req;
+    }
+
+    void clrnext() {
+#ifndef VULSIM_UNCHECKED
+        assert(!clr_called_);
+        clr_called_ = true;
+#endif
+        clr_pending_ = true;
+    }
+
+    void apply_next_tick() {
+        ring_.commit(push_pending_num_, clr_pending_);
+        push_pending_num_ = 0;
+        clr_pending_ = false;
+#ifndef VULSIM_UNCHECKED
+        push_called_ = false;
+        clr_called_ = false;
+#endif
+    }
+
+    bool _quiescent() const {
+        return push_pending_num_ == 0 && !clr_pending_ && ring_.inflight() == 0;
+    }
+
+private:
+    vuldelayline::Ring<std::array<T, Width>, Latency> ring_;
+
+    uint32_t push_pending_num_ = 0;
+    bool clr_pending_ = false;
+#ifndef VULSIM_UNCHECKED
+    bool push_called_ = false;
+    bool clr_called_ = false;
+#endif
+};
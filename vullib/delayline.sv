@@ -0,0 +1,121 @@
+// VulDelayLine / VulDelayLineMP：固定延迟线，周期行为与 delayline.hpp 一致。
+// 第 t 个周期压入的数据在第 t + Latency 个周期出现在输出端，只保持一个周期，没有反压。
+// 存储为 Latency 个表项的环形缓冲，head_q 指向本周期输出的表项；时钟沿上该表项被本周期压入的数据覆盖，
+// 随后 head_q 前进，Latency 个周期后回到同一表项。每周期只写一个表项，开销与 Latency 无关。
+// 数据阵列不复位，有效位复位为 0；清空只清有效位，并丢弃同周期的压入。
+
+module VulDelayLine #(
+    parameter int unsigned Width = 32,
+    parameter int unsigned Latency = 1
+) (
+    input  logic             clk,
+    input  logic             rstn,
+
+    input  logic             pushnext_vld,  // 压入一个元素，Latency 个周期后输出
+    input  logic [Width-1:0] pushnext_data,
+
+    output logic             out_vld,       // 本周期输出是否有效
+    output logic [Width-1:0] out_data,
+
+    input  logic             clrnext        // 清空所有在途元素，在下个周期生效
+);
+
+localparam int unsigned PtrW = (Latency <= 1) ? 1 : $clog2(Latency);
+
+logic [Width-1:0]   data_q [0:Latency-1];
+logic [Latency-1:0] valid_q;
+logic [PtrW-1:0]    head_q;
+
+always_ff @(posedge clk) begin
+    if (rstn && pushnext_vld && !clrnext) begin
+        data_q[head_q] <= pushnext_data;
+    end
+end
+
+always_ff @(posedge clk or negedge rstn) begin
+    if (!rstn) begin
+        valid_q <= '0;
+        head_q <= '0;
+    end else begin
+        if (clrnext) begin
+            valid_q <= '0;
+        end else begin
+            valid_q[head_q] <= pushnext_vld;
+        end
+        head_q <= (int'(head_q) + 1 == Latency) ? '0 : head_q + 1'b1;
+    end
+end
+
+always_comb begin
+    out_vld = valid_q[head_q];
+    out_data = data_q[head_q];
+end
+
+endmodule
+
+
+module VulDelayLineMP #(
+    parameter int unsigned Width = 32,
+    parameter int unsigned Latency = 1,
+    parameter int unsigned PushWidth = 2
+) (
+    input  logic                               clk,
+    input  logic                               rstn,
+
+    input  logic [$clog2(PushWidth+1)-1:0]    pushnext_vld,                 // 本周期压入的数量，超过 PushWidth 时截断
+    input  logic [Width-1:0]                  pushnext_data [0:PushWidth-1],
+
+    output logic [$clog2(PushWidth+1)-1:0]    out_vld,                      // 本周期输出的数量
+    output logic [Width-1:0]                  out_data [0:PushWidth-1],
+
+    input  logic                               clrnext        // 清空所有在途元素，在下个周期生效
+);
+
+localparam int unsigned PtrW = (Latency <= 1) ? 1 : $clog2(Latency);
+localparam int unsigned CntW = $clog2(PushWidth + 1);
+
+logic [Width-1:0] data_q [0:Latency-1][0:PushWidth-1];
+logic [CntW-1:0]  num_q  [0:Latency-1];
+logic [PtrW-1:0]  head_q;
+logic [CntW-1:0]  push_num;
+
+always_comb begin
+    push_num = (int'(pushnext_vld) > PushWidth) ? CntW'(PushWidth) : pushnext_vld;
+end
+
+always_ff @(posedge clk) begin
+    if (rstn && !clrnext) begin
+        for (int i = 0; i < PushWidth; i = i + 1) begin
+            if (i < int'(push_num)) begin
+                data_q[head_q][i] <= pushnext_data[i];
+            end
+        end
+    end
+end
+
+always_ff @(posedge clk or negedge rstn) begin
+    if (!rstn) begin
+        for (int i = 0; i < Latency; i = i + 1) begin
+            num_q[i] <= '0;
+        end
+        head_q <= '0;
+    end else begin
+        if (clrnext) begin
+            for (int i = 0; i < Latency; i = i + 1) begin
+                num_q[i] <= '0;
+            end
+        end else begin
+            num_q[head_q] <= push_num;
+        end
+        head_q <= (int'(head_q) + 1 == Latency) ? '0 : head_q + 1'b1;
+    end
+end
+
+always_comb begin
+    out_vld = num_q[head_q];
+    for (int i = 0; i < PushWidth; i = i + 1) begin
+        out_data[i] = data_q[head_q][i];
+    end
+end
+
+endmodule
@@ -26,8 +26,13 @@
 
 #include <array>
 #include <cassert>
+#include <cstring>
 #include <type_traits>
 
+#if defined(__BMI2__) && !defined(VULFIXINT_HLS)
+#include <immintrin.h>
+#endif
+
 namespace vulfixint {
 
 template <uint32_t BitWidth>
@@ -212,6 +217,81 @@ inline constexpr uint64_t low_mask64(uint32_t bits) {
     return (uint64_t(1) << bits) - 1;
 }
 
+// 位宽不超过 32 的 Int 只有一个字，用 uint8_t/uint16_t/uint32_t 保存，使寄存器数组、队列与 BRAM 中的窄字段
+// （tag、valid、小计数器）按实际位宽占用内存。对 Int 内部它仍表现为一个 64 位字：读出零扩展为 uint64_t，
+// 写入截断到存储字宽；Int 保证超出位宽的高位始终为 0，截断不丢失有效位。
+template <typename Word>
+class IntNarrowWords {
+public:
+    class WordRef {
+    public:
+        constexpr explicit WordRef(Word& word) : word_(word) {}
+
+        constexpr operator uint64_t() const {
+            return word_;
+        }
+
+        constexpr WordRef& operator=(uint64_t value) {
+            word_ = static_cast<Word>(value);
+            return *this;
+        }
+
+        constexpr WordRef& operator&=(uint64_t value) {
+            word_ = static_cast<Word>(word_ & value);
+            return *this;
+        }
+
+        constexpr WordRef& operator|=(uint64_t value) {
+            word_ = static_cast<Word>(word_ | value);
+            return *this;
+        }
+
+    private:
+        Word& word_;
+    };
+
+    constexpr IntNarrowWords() : word_(0) {}
+
+    constexpr uint64_t operator[]([[maybe_unused]] uint32_t idx) const {
+        assert(idx == 0);
+        return word_;
+    }
+
+    constexpr WordRef operator[]([[maybe_unused]] uint32_t idx) {
+        assert(idx == 0);
+        return WordRef(word_);
+    }
+
+    constexpr WordRef back() {
+        return WordRef(word_);
+    }
+
+    constexpr IntNarrowWords& operator=(const std::array<uint64_t, 1>& words) {
+        word_ = static_cast<Word>(words[0]);
+        return *this;
+    }
+
+    constexpr operator std::array<uint64_t, 1>() const {
+        return {word_};
+    }
+
+private:
+    Word word_;
+};
+
+#ifdef VULFIXINT_HLS
+// 综合流程按位宽生成寄存器，不需要窄存储
+template <uint32_t BitWidth>
+using IntWords = std::array<uint64_t, (BitWidth + 63) / 64>;
+#else
+template <uint32_t BitWidth>
+using IntWords = std::conditional_t<
+    (BitWidth <= 8), IntNarrowWords<uint8_t>,
+    std::conditional_t<(BitWidth <= 16), IntNarrowWords<uint16_t>,
+                       std::conditional_t<(BitWidth <= 32), IntNarrowWords<uint32_t>,
+                                          std::array<uint64_t, (BitWidth + 63) / 64>>>>;
+#endif
+
 template <uint32_t ShiftBitWidth>
 constexpr bool shift_amount_at_least_width(const Int<ShiftBitWidth>& shift, uint32_t width);
 
@@ -226,7 +306,7 @@ private:
     static_assert(BitWidth > 0, "BitWidth must be greater than 0");
     static constexpr uint32_t LOW_MASK_BITS = BitWidth % WORD_BITS;
 
-    std::array<uint64_t, NUM_WORDS> data;
+    IntWords<BitWidth> data;
 
     static constexpr uint64_t word_mask(uint32_t bits) {
         return low_mask64(bits);
@@ -416,10 +496,16 @@ private:
     }
 
 public:
-    std::array<uint64_t, NUM_WORDS> get_data() const {
+    constexpr std::array<uint64_t, NUM_WORDS> get_data() const {
         return data;
     }
 
+    // 按 64 位字整体赋值，超出位宽的高位被截断
+    constexpr void set_data(const std::array<uint64_t, NUM_WORDS> &words) {
+        data = words;
+        mask_high_bits();
+    }
+
     constexpr Int() : data{} {}
 
     constexpr Int(bool value) : data{} {
@@ -1741,6 +1827,395 @@ constexpr auto Cat(const Operands&... operands) {
     return out;
 }
 
+// 位扫描与优先选择。字内计数与扫描在仿真中使用编译器内建指令；定义 VULFIXINT_HLS 时（RTL 生成流程会定义）
+// 改为逐位的固定循环，展开后是加法树与优先级链，便于综合。两种实现对全部输入给出相同结果。
+#ifdef VULFIXINT_HLS
+inline constexpr uint32_t word_popcount(uint64_t word) {
+    uint32_t cnt = 0;
+    for (uint32_t i = 0; i < 64; ++i) {
+        cnt += static_cast<uint32_t>((word >> i) & uint64_t(1));
+    }
+    return cnt;
+}
+
+inline constexpr uint32_t word_ctz(uint64_t word) {
+    uint32_t idx = 64;
+    for (uint32_t i = 64; i > 0; --i) {
+        if (((word >> (i - 1)) & uint64_t(1)) != 0) {
+            idx = i - 1;
+        }
+    }
+    return idx;
+}
+
+inline constexpr uint32_t word_clz(uint64_t word) {
+    uint32_t cnt = 64;
+    for (uint32_t i = 0; i < 64; ++i) {
+        if (((word >> i) & uint64_t(1)) != 0) {
+            cnt = 63 - i;
+        }
+    }
+    return cnt;
+}
+#else
+inline constexpr uint32_t word_popcount(uint64_t word) {
+    return static_cast<uint32_t>(__builtin_popcountll(word));
+}
+
+inline constexpr uint32_t word_ctz(uint64_t word) {
+    return word == 0 ? 64 : static_cast<uint32_t>(__builtin_ctzll(word));
+}
+
+inline constexpr uint32_t word_clz(uint64_t word) {
+    return word == 0 ? 64 : static_cast<uint32_t>(__builtin_clzll(word));
+}
+#endif
+
+template <typename Operand>
+    requires(IntOperandTraits<std::remove_cvref_t<Operand>>::VALID
+             && !IntOperandTraits<std::remove_cvref_t<Operand>>::IS_SIGNED)
+constexpr uint32_t PopCount(const Operand& operand) {
+    constexpr uint32_t BIT_WIDTH = int_operand_bit_width_v<Operand>;
+    const auto words = get_int_operand_value(operand).get_data();
+    uint32_t cnt = 0;
+    for (uint32_t i = 0; i < Int<BIT_WIDTH>::NUM_WORDS; ++i) {
+        cnt += word_popcount(words[i]);
+    }
+    return cnt;
+}
+
+// 最低位 1 的下标，全 0 时返回位宽
+template <typename Operand>
+    requires(IntOperandTraits<std::remove_cvref_t<Operand>>::VALID
+             && !IntOperandTraits<std::remove_cvref_t<Operand>>::IS_SIGNED)
+constexpr uint32_t CountTrailingZeros(const Operand& operand) {
+    constexpr uint32_t BIT_WIDTH = int_operand_bit_width_v<Operand>;
+    const auto words = get_int_operand_value(operand).get_data();
+    for (uint32_t i = 0; i < Int<BIT_WIDTH>::NUM_WORDS; ++i) {
+        if (words[i] != 0) {
+            return i * 64 + word_ctz(words[i]);
+        }
+    }
+    return BIT_WIDTH;
+}
+
+// 从最高有效位往下数连续 0 的个数，全 0 时返回位宽
+template <typename Operand>
+    requires(IntOperandTraits<std::remove_cvref_t<Operand>>::VALID
+             && !IntOperandTraits<std::remove_cvref_t<Operand>>::IS_SIGNED)
+constexpr uint32_t CountLeadingZeros(const Operand& operand) {
+    constexpr uint32_t BIT_WIDTH = int_operand_bit_width_v<Operand>;
+    constexpr uint32_t NUM_WORDS = Int<BIT_WIDTH>::NUM_WORDS;
+    constexpr uint32_t PAD_BITS = NUM_WORDS * 64 - BIT_WIDTH;
+    const auto words = get_int_operand_value(operand).get_data();
+    for (uint32_t i = NUM_WORDS; i > 0; --i) {
+        if (words[i - 1] != 0) {
+            return (NUM_WORDS - i) * 64 + word_clz(words[i - 1]) - PAD_BITS;
+        }
+    }
+    return BIT_WIDTH;
+}
+
+// 轮转查找：从 from 开始向高位找第一个 1，找不到时从第 0 位继续，全 0 时返回位宽。
+// from 不小于位宽时等价于 CountTrailingZeros。
+template <typename Operand>
+    requires(IntOperandTraits<std::remove_cvref_t<Operand>>::VALID
+             && !IntOperandTraits<std::remove_cvref_t<Operand>>::IS_SIGNED)
+constexpr uint32_t FindFirstSet(const Operand& operand, uint32_t from) {
+    constexpr uint32_t BIT_WIDTH = int_operand_bit_width_v<Operand>;
+    const Int<BIT_WIDTH> value = get_int_operand_value(operand);
+    if (from < BIT_WIDTH) {
+        const auto words = value.get_data();
+        for (uint32_t i = from / 64; i < Int<BIT_WIDTH>::NUM_WORDS; ++i) {
+            uint64_t word = words[i];
+            if (i == from / 64) {
+                word &= ~low_mask64(from % 64);
+            }
+            if (word != 0) {
+                return i * 64 + word_ctz(word);
+            }
+        }
+    }
+    return CountTrailingZeros(value);
+}
+
+// 下标 idx 处为 1 的独热码，idx 不小于位宽时返回 0
+template <uint32_t BitWidth>
+constexpr Int<BitWidth> OneHot(uint32_t idx) {
+    std::array<uint64_t, Int<BitWidth>::NUM_WORDS> words{};
+    if (idx < BitWidth) {
+        words[idx / 64] = uint64_t(1) << (idx % 64);
+    }
+    Int<BitWidth> out;
+    out.set_data(words);
+    return out;
+}
+
+// 独热码转下标；输入必须为独热码或全 0，全 0 时返回 0
+template <typename Operand>
+    requires(IntOperandTraits<std::remove_cvref_t<Operand>>::VALID
+             && !IntOperandTraits<std::remove_cvref_t<Operand>>::IS_SIGNED)
+constexpr uint32_t OneHotIndex(const Operand& operand) {
+    constexpr uint32_t BIT_WIDTH = int_operand_bit_width_v<Operand>;
+    const Int<BIT_WIDTH> value = get_int_operand_value(operand);
+    assert(PopCount(value) <= 1);
+    const uint32_t idx = CountTrailingZeros(value);
+    return idx == BIT_WIDTH ? 0 : idx;
+}
+
+// 只保留最低位的 1，即固定优先级仲裁的授权向量
+template <typename Operand>
+    requires(IntOperandTraits<std::remove_cvref_t<Operand>>::VALID
+             && !IntOperandTraits<std::remove_cvref_t<Operand>>::IS_SIGNED)
+constexpr auto LowestSet(const Operand& operand) {
+    constexpr uint32_t BIT_WIDTH = int_operand_bit_width_v<Operand>;
+    return OneHot<BIT_WIDTH>(CountTrailingZeros(operand));
+}
+
+// 只保留最高位的 1
+template <typename Operand>
+    requires(IntOperandTraits<std::remove_cvref_t<Operand>>::VALID
+             && !IntOperandTraits<std::remove_cvref_t<Operand>>::IS_SIGNED)
+constexpr auto HighestSet(const Operand& operand) {
+    constexpr uint32_t BIT_WIDTH = int_operand_bit_width_v<Operand>;
+    const uint32_t clz = CountLeadingZeros(operand);
+    return OneHot<BIT_WIDTH>(clz == BIT_WIDTH ? BIT_WIDTH : BIT_WIDTH - 1 - clz);
+}
+
+// 前缀或：第 i 位为第 0..i 位的或，即最低位的 1 及其以上全部置 1
+template <typename Operand>
+    requires(IntOperandTraits<std::remove_cvref_t<Operand>>::VALID
+             && !IntOperandTraits<std::remove_cvref_t<Operand>>::IS_SIGNED)
+constexpr auto PrefixOr(const Operand& operand) {
+    constexpr uint32_t BIT_WIDTH = int_operand_bit_width_v<Operand>;
+    const uint32_t lo = CountTrailingZeros(operand);
+    std::array<uint64_t, Int<BIT_WIDTH>::NUM_WORDS> words{};
+    for (uint32_t i = 0; i < Int<BIT_WIDTH>::NUM_WORDS; ++i) {
+        const uint32_t word_lo = i * 64;
+        if (lo <= word_lo) {
+            words[i] = ~uint64_t(0);
+        } else if (lo < word_lo + 64) {
+            words[i] = ~low_mask64(lo - word_lo);
+        }
+    }
+    Int<BIT_WIDTH> out;
+    out.set_data(words);
+    return out;
+}
+
+// 后缀或：第 i 位为第 i 位及以上各位的或，即最高位的 1 及其以下全部置 1
+template <typename Operand>
+    requires(IntOperandTraits<std::remove_cvref_t<Operand>>::VALID
+             && !IntOperandTraits<std::remove_cvref_t<Operand>>::IS_SIGNED)
+constexpr auto SuffixOr(const Operand& operand) {
+    constexpr uint32_t BIT_WIDTH = int_operand_bit_width_v<Operand>;
+    const uint32_t clz = CountLeadingZeros(operand);
+    const uint32_t len = BIT_WIDTH - clz;
+    std::array<uint64_t, Int<BIT_WIDTH>::NUM_WORDS> words{};
+    for (uint32_t i = 0; i < Int<BIT_WIDTH>::NUM_WORDS; ++i) {
+        const uint32_t word_lo = i * 64;
+        if (len >= word_lo + 64) {
+            words[i] = ~uint64_t(0);
+        } else if (len > word_lo) {
+            words[i] = low_mask64(len - word_lo);
+        }
+    }
+    Int<BIT_WIDTH> out;
+    out.set_data(words);
+    return out;
+}
+
+// 字内位收集与位散布，语义同 BMI2 的 pext/pdep。以 -mbmi2（或包含 BMI2 的 -march）编译时使用硬件指令，
+// 否则按 mask 中连续为 1 的段逐段移位拼接，开销与段数成正比；定义 VULFIXINT_HLS 时为固定 64 次的循环。
+#ifdef VULFIXINT_HLS
+inline constexpr uint64_t word_pext(uint64_t word, uint64_t mask) {
+    uint64_t out = 0;
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < 64; ++i) {
+        if (((mask >> i) & uint64_t(1)) != 0) {
+            out |= ((word >> i) & uint64_t(1)) << pos;
+            ++pos;
+        }
+    }
+    return out;
+}
+
+inline constexpr uint64_t word_pdep(uint64_t word, uint64_t mask) {
+    uint64_t out = 0;
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < 64; ++i) {
+        if (((mask >> i) & uint64_t(1)) != 0) {
+            out |= ((word >> pos) & uint64_t(1)) << i;
+            ++pos;
+        }
+    }
+    return out;
+}
+#else
+inline constexpr uint64_t word_pext(uint64_t word, uint64_t mask) {
+#ifdef __BMI2__
+    if (!std::is_constant_evaluated()) {
+        return _pext_u64(word, mask);
+    }
+#endif
+    uint64_t out = 0;
+    uint32_t pos = 0;
+    while (mask != 0) {
+        const uint32_t lo = word_ctz(mask);
+        const uint32_t len = word_ctz(~(mask >> lo));
+        out |= ((word >> lo) & low_mask64(len)) << pos;
+        pos += len;
+        mask &= ~(low_mask64(len) << lo);
+    }
+    return out;
+}
+
+inline constexpr uint64_t word_pdep(uint64_t word, uint64_t mask) {
+#ifdef __BMI2__
+    if (!std::is_constant_evaluated()) {
+        return _pdep_u64(word, mask);
+    }
+#endif
+    uint64_t out = 0;
+    uint32_t pos = 0;
+    while (mask != 0) {
+        const uint32_t lo = word_ctz(mask);
+        const uint32_t len = word_ctz(~(mask >> lo));
+        out |= ((word >> pos) & low_mask64(len)) << lo;
+        pos += len;
+        mask &= ~(low_mask64(len) << lo);
+    }
+    return out;
+}
+#endif
+
+// 位收集：按 mask 中 1 的位置从低到高取出 value 的对应位，依次紧排到结果低位，其余位为 0。
+// 多个字段分散在一条总线中时，用一次 BitGather 代替逐字段的切片读取与拼接。
+template <typename ValueOperand, typename MaskOperand>
+    requires(IntOperandTraits<std::remove_cvref_t<ValueOperand>>::VALID
+             && IntOperandTraits<std::remove_cvref_t<MaskOperand>>::VALID
+             && !IntOperandTraits<std::remove_cvref_t<ValueOperand>>::IS_SIGNED
+             && !IntOperandTraits<std::remove_cvref_t<MaskOperand>>::IS_SIGNED
+             && int_operand_bit_width_v<ValueOperand> == int_operand_bit_width_v<MaskOperand>)
+constexpr auto BitGather(const ValueOperand& value_operand, const MaskOperand& mask_operand) {
+    constexpr uint32_t BIT_WIDTH = int_operand_bit_width_v<ValueOperand>;
+    constexpr uint32_t NUM_WORDS = Int<BIT_WIDTH>::NUM_WORDS;
+    const auto value = get_int_operand_value(value_operand).get_data();
+    const auto mask = get_int_operand_value(mask_operand).get_data();
+    std::array<uint64_t, NUM_WORDS> words{};
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < NUM_WORDS; ++i) {
+        const uint64_t bits = word_pext(value[i], mask[i]);
+        const uint32_t off = pos % 64;
+        words[pos / 64] |= bits << off;
+        if (off != 0 && pos / 64 + 1 < NUM_WORDS) {
+            words[pos / 64 + 1] |= bits >> (64 - off);
+        }
+        pos += word_popcount(mask[i]);
+    }
+    Int<BIT_WIDTH> out;
+    out.set_data(words);
+    return out;
+}
+
+// 位散布：BitGather 的逆操作。把 value 的低位依次放到 mask 中 1 的位置上，其余位为 0。
+template <typename ValueOperand, typename MaskOperand>
+    requires(IntOperandTraits<std::remove_cvref_t<ValueOperand>>::VALID
+             && IntOperandTraits<std::remove_cvref_t<MaskOperand>>::VALID
+             && !IntOperandTraits<std::remove_cvref_t<ValueOperand>>::IS_SIGNED
+             && !IntOperandTraits<std::remove_cvref_t<MaskOperand>>::IS_SIGNED
+             && int_operand_bit_width_v<ValueOperand> == int_operand_bit_width_v<MaskOperand>)
+constexpr auto BitScatter(const ValueOperand& value_operand, const MaskOperand& mask_operand) {
+    constexpr uint32_t BIT_WIDTH = int_operand_bit_width_v<ValueOperand>;
+    constexpr uint32_t NUM_WORDS = Int<BIT_WIDTH>::NUM_WORDS;
+    const auto value = get_int_operand_value(value_operand).get_data();
+    const auto mask = get_int_operand_value(mask_operand).get_data();
+    std::array<uint64_t, NUM_WORDS> words{};
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < NUM_WORDS; ++i) {
+        const uint32_t cnt = word_popcount(mask[i]);
+        if (cnt == 0) {
+            continue;
+        }
+        const uint32_t off = pos % 64;
+        uint64_t bits = value[pos / 64] >> off;
+        if (off != 0 && pos / 64 + 1 < NUM_WORDS) {
+            bits |= value[pos / 64 + 1] << (64 - off);
+        }
+        words[i] = word_pdep(bits, mask[i]);
+        pos += cnt;
+    }
+    Int<BIT_WIDTH> out;
+    out.set_data(words);
+    return out;
+}
+
+// PackBools/UnpackBools 是否把 8 个 bool 当作一个 64 位字处理：要求小端，HLS 下为逐元素循环
+inline constexpr bool bool_lanes_supported =
+#if !defined(VULFIXINT_HLS) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    true;
+#else
+    false;
+#endif
+static_assert(sizeof(bool) == 1, "bool lanes assume one byte per bool");
+
+// 8 个 bool（每字节为 0 或 1）的最低位收集为 8 位整数
+inline uint64_t bool_lanes_to_byte(uint64_t lanes) {
+#if defined(__BMI2__) && !defined(VULFIXINT_HLS)
+    return _pext_u64(lanes, 0x0101010101010101ULL);
+#else
+    return (lanes * 0x0102040810204080ULL) >> 56;
+#endif
+}
+
+// bool_lanes_to_byte 的逆操作，bits 只使用低 8 位
+inline uint64_t byte_to_bool_lanes(uint64_t bits) {
+#if defined(__BMI2__) && !defined(VULFIXINT_HLS)
+    return _pdep_u64(bits, 0x0101010101010101ULL);
+#else
+    const uint64_t spread = ((bits & 0xff) * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+    return ((spread + 0x7f7f7f7f7f7f7f7fULL) >> 7) & 0x0101010101010101ULL;
+#endif
+}
+
+// bool 数组与位向量互转，第 i 个元素对应第 i 位，常用于把每项一个 valid/ready 的数组压成位向量后做位扫描。
+// 仿真中每 8 个元素作为一个 64 位字整体处理；定义 VULFIXINT_HLS 时为逐元素循环。
+template <size_t N>
+inline Int<N> PackBools(const std::array<bool, N>& bools) {
+    std::array<uint64_t, Int<N>::NUM_WORDS> words{};
+    uint32_t i = 0;
+    if constexpr (bool_lanes_supported) {
+        for (; i + 8 <= N; i += 8) {
+            uint64_t lanes;
+            std::memcpy(&lanes, bools.data() + i, 8);
+            words[i / 64] |= bool_lanes_to_byte(lanes) << (i % 64);
+        }
+    }
+    for (; i < N; ++i) {
+        words[i / 64] |= uint64_t(bools[i] ? 1 : 0) << (i % 64);
+    }
+    Int<N> out;
+    out.set_data(words);
+    return out;
+}
+
+template <uint32_t N>
+inline std::array<bool, N> UnpackBools(const Int<N>& value) {
+    const auto words = value.get_data();
+    std::array<bool, N> bools{};
+    uint32_t i = 0;
+    if constexpr (bool_lanes_supported) {
+        for (; i + 8 <= N; i += 8) {
+            const uint64_t lanes = byte_to_bool_lanes(words[i / 64] >> (i % 64));
+            std::memcpy(bools.data() + i, &lanes, 8);
+        }
+    }
+    for (; i < N; ++i) {
+        bools[i] = ((words[i / 64] >> (i % 64)) & uint64_t(1)) != 0;
+    }
+    return bools;
+}
+
 template <typename LhsOperand, typename RhsOperand>
     requires(IntOperandTraits<std::remove_cvref_t<LhsOperand>>::VALID
              && IntOperandTraits<std::remove_cvref_t<RhsOperand>>::VALID
@@ -1940,3 +2415,17 @@ using vulfixint::ReduceOr;
 using vulfixint::ReduceXor;
 using vulfixint::Repeat;
 using vulfixint::Cat;
+using vulfixint::PopCount;
+using vulfixint::CountLeadingZeros;
+using vulfixint::CountTrailingZeros;
+using vulfixint::FindFirstSet;
+using vulfixint::OneHot;
+using vulfixint::OneHotIndex;
+using vulfixint::LowestSet;
+using vulfixint::HighestSet;
+using vulfixint::PrefixOr;
+using vulfixint::SuffixOr;
+using vulfixint::BitGather;
+using vulfixint::BitScatter;
+using vulfixint::PackBools;
+using vulfixint::UnpackBools;
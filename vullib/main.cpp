@@ -23,9 +23,331 @@
 #include "VulTestMain.hpp"
 
 #include "vcdrecord.hpp"
+#include "telemetry.hpp"
+#include "snapshot.hpp"
+#include "sample.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
 
 GlobalVCDRecord global_vcd_record;
 
+uint64_t sim_max_cycles = 0;
+
+// 设置 VULSIM_RECORD 时把 Main 与顶层模块之间的交互录制到该文件；设置 VULSIM_REPLAY 时不执行 simulation()，
+// 而是用录制的激励驱动设计并检查设计的输出，见 stimulus.hpp
+VulStimulusStream vul_stimulus;
+
+// 设置 VULSIM_CAPTURE 时把 vulsimgen --capture 选中实例边界上的交互录制到该文件，
+// 供 vulsimgen --isolate 生成的独立仿真以 VULSIM_REPLAY 回放
+VulStimulusStream vul_capture;
+
+// 设置了 VULSIM_MAX_CYCLES 时，结束前向 stderr 输出一行统计，供 scripts/bench_examples.py 解析
+static bool sim_report_enabled = false;
+static std::chrono::steady_clock::time_point sim_start_time;
+
+// 设置 VULSIM_TELEMETRY 时每 VULSIM_TELEMETRY_INTERVAL 个周期更新一次共享内存遥测页，见 telemetry.hpp
+static VulTelemetryWriter sim_telemetry;
+static uint64_t sim_telemetry_interval = 0;
+uint64_t sim_telemetry_next = 0;
+
+void sim_telemetry_update(uint64_t cycles) {
+    sim_telemetry.update(cycles, global_vcd_record.bytes_written());
+    sim_telemetry_next = cycles + sim_telemetry_interval;
+}
+
+// 通过 sim_register_counter 注册的统计计数，遥测与采样共用
+static std::vector<VulSampleCounter> sim_counters;
+
+void sim_register_counter(const std::string &name, const uint64_t *value) {
+    sim_counters.push_back(VulSampleCounter{name, value});
+    if (!sim_telemetry.register_counter(name, value)) {
+        std::fprintf(stderr, "[vulsim] telemetry counter table full, ignoring %s\n", name.c_str());
+    }
+}
+
+static void sim_telemetry_open(const char *setting) {
+    std::string name = "vulsim";
+    std::ifstream comm("/proc/self/comm");
+    if (comm.is_open()) {
+        std::getline(comm, name);
+    }
+    std::string path = setting;
+    if (path.empty() || path == "1") {
+        path = "/dev/shm/vulsim." + std::to_string(getpid());
+    }
+    if (!sim_telemetry.open(path, name)) {
+        std::fprintf(stderr, "[vulsim] cannot open telemetry page %s\n", path.c_str());
+        return;
+    }
+    sim_telemetry_interval = 100000;
+    if (const char *env = std::getenv("VULSIM_TELEMETRY_INTERVAL")) {
+        sim_telemetry_interval = std::max<uint64_t>(1, std::strtoull(env, nullptr, 10));
+    }
+    sim_telemetry_next = sim_telemetry_interval;
+}
+
+// 设置 VULSIM_SNAPSHOT_INTERVAL 时每隔该周期数 fork 一个暂停的快照进程，最多保留 VULSIM_SNAPSHOT_KEEP 个（默认 4），见 snapshot.hpp
+// 断点菜单中选择 (r)ewind 即从快照处重新执行；恢复后断点历史多保留 间隔 × 快照数 个周期，足以覆盖从最旧的快照到原断点
+static VulSnapshotManager sim_snapshots;
+static uint64_t sim_snapshot_interval = 0;
+uint64_t sim_snapshot_next = 0;
+
+void sim_snapshot_take(uint64_t cycles) {
+    sim_snapshot_next = cycles + sim_snapshot_interval;
+    if (sim_snapshots.take(cycles)) {
+        const uint64_t rewind_cycles = sim_snapshot_interval * sim_snapshots.capacity();
+        global_vcd_record.extend_break_history(rewind_cycles);
+        std::cout << "[Snapshot] Resumed at cycle " << cycles << ", trace history extended by " << rewind_cycles << " cycles" << std::endl;
+    }
+}
+
+static void sim_snapshot_rewind(uint64_t cycles) {
+    const auto &snaps = sim_snapshots.snapshots();
+    if (snaps.empty()) {
+        std::cout << "[Snapshot] No snapshot available" << std::endl;
+        return;
+    }
+    std::cout << "[Snapshot] Available cycles:";
+    for (const auto &snap : snaps) {
+        std::cout << " " << snap.cycle;
+    }
+    const int64_t nearest = std::max<int64_t>(0, sim_snapshots.nearest_before(cycles));
+    std::cout << "\n[Snapshot] Resume from cycle [default: " << snaps[nearest].cycle << "]: ";
+    std::string input;
+    if (!std::getline(std::cin, input) || input.empty()) {
+        sim_snapshots.resume(static_cast<size_t>(nearest));
+    }
+    const uint64_t target = std::strtoull(input.c_str(), nullptr, 10);
+    for (size_t i = 0; i < snaps.size(); i++) {
+        if (snaps[i].cycle == target) {
+            sim_snapshots.resume(i);
+        }
+    }
+    std::cout << "[Snapshot] No snapshot at cycle " << target << std::endl;
+}
+
+static void sim_snapshot_open(const char *setting) {
+    sim_snapshot_interval = std::strtoull(setting, nullptr, 10);
+    if (sim_snapshot_interval == 0) {
+        return;
+    }
+    if (const char *env = std::getenv("VULSIM_SNAPSHOT_KEEP")) {
+        sim_snapshots.set_capacity(static_cast<uint32_t>(std::strtoul(env, nullptr, 10)));
+    }
+    sim_snapshot_next = sim_snapshot_interval;
+    global_vcd_record.set_rewind_handler(sim_snapshot_rewind);
+}
+
+// 设置 VULSIM_SAMPLE_PERIOD 与 VULSIM_SAMPLE_WINDOW 时进行周期性采样仿真，见 sample.hpp
+// 波形只在测量窗口内记录；VULSIM_SAMPLE_JOBS 大于 0 时各窗口在子进程中执行，波形分别写入 <trace>.w<k>.vcd
+static VulSampler sim_sampler;
+static std::string sim_sample_out;
+uint64_t sim_sample_next = 0;
+
+void sim_sample_event(uint64_t cycles) {
+    sim_sample_next = sim_sampler.on_event(cycles);
+}
+
+bool sim_sample_measuring() {
+    return !sim_sampler.enabled() || sim_sampler.phase() == VulSampleMeasure;
+}
+
+bool sim_sample_detailed() {
+    return !sim_sampler.enabled() || sim_sampler.phase() != VulSampleFastForward;
+}
+
+static uint64_t sim_env_u64(const char *name, uint64_t fallback) {
+    const char *env = std::getenv(name);
+    return env ? std::strtoull(env, nullptr, 10) : fallback;
+}
+
+static void sim_sample_open() {
+    VulSampleConfig config;
+    config.period = sim_env_u64("VULSIM_SAMPLE_PERIOD", 0);
+    config.warmup = sim_env_u64("VULSIM_SAMPLE_WARMUP", 0);
+    config.window = sim_env_u64("VULSIM_SAMPLE_WINDOW", 0);
+    config.offset = sim_env_u64("VULSIM_SAMPLE_OFFSET", 0);
+    config.jobs = static_cast<uint32_t>(sim_env_u64("VULSIM_SAMPLE_JOBS", 0));
+    if (!sim_sampler.configure(config, &sim_counters)) {
+        std::fprintf(stderr, "[vulsim-sample] invalid sampling config, require VULSIM_SAMPLE_WINDOW > 0 and WARMUP + WINDOW <= PERIOD\n");
+        std::exit(2);
+    }
+    if (const char *env = std::getenv("VULSIM_SAMPLE_OUT")) {
+        sim_sample_out = env;
+    }
+    sim_sampler.on_measure = [](bool measuring) {
+        global_vcd_record.set_enabled(measuring);
+    };
+    sim_sampler.on_window_process = [](uint64_t index) {
+        // 窗口子进程只负责测量，不更新遥测、不产生快照、不输出结束统计
+        sim_telemetry_next = 0;
+        sim_snapshot_next = 0;
+        sim_snapshots.forget();
+        sim_report_enabled = false;
+        // 录制只由主进程完成，窗口子进程不能写入与主进程共享的流
+        vul_stimulus.detach();
+        vul_capture.detach();
+        const std::string &trace = global_vcd_record.filename();
+        if (!trace.empty()) {
+            const size_t dot = trace.rfind('.');
+            const std::string stem = dot == std::string::npos ? trace : trace.substr(0, dot);
+            global_vcd_record.redirect(stem + ".w" + std::to_string(index) + ".vcd");
+        }
+    };
+    global_vcd_record.set_enabled(false);
+    sim_sample_next = sim_sampler.first_event();
+}
+
+// 有窗口在子进程中失败时返回 false
+static bool sim_sample_finish() {
+    const bool ok = sim_sampler.collect();
+    sim_sampler.report(stderr);
+    if (!sim_sample_out.empty() && !sim_sampler.write_json(sim_sample_out)) {
+        std::fprintf(stderr, "[vulsim-sample] cannot write %s\n", sim_sample_out.c_str());
+    }
+    return ok;
+}
+
+#ifdef VULSIM_ALLOC_TRACK
+// 设置 VULSIM_ALLOC_STRICT 时，预热后出现任何堆分配都以退出码 3 结束
+static bool sim_alloc_strict = false;
+#endif
+
+// 输出结束统计，返回进程应使用的退出码
+static int sim_report(uint64_t cycles, bool in_simulation) {
+    // 窗口结束前仿真已经结束，该窗口作废
+    sim_sampler.abandon_window_process();
+    int status = 0;
+    // 窗口子进程中的失败以退出码 1 结束，与 sim_exit() 一致
+    if (sim_sampler.enabled() && !sim_sample_finish()) {
+        status = 1;
+    }
+    // simulation() 返回后其中注册的局部计数变量已失效，不再采样
+    sim_telemetry.update(cycles, global_vcd_record.bytes_written(), VulTelemetryFinished, in_simulation);
+#ifdef VULSIM_ALLOC_TRACK
+    if (vulalloc::report(stderr) != 0 && sim_alloc_strict) {
+        status = 3;
+    }
+#endif
+#ifdef VULSIM_COSIM
+    // 检查最后不满一个间隔的周期，不一致时以退出码 4 结束
+    if (!vul_cosim.finish(cycles)) {
+        status = 4;
+    }
+#endif
+    // 录制时写出流的剩余部分；回放不一致或流未读完时以退出码 5 结束
+    if (!vul_stimulus.close()) {
+        status = 5;
+    }
+    if (!vul_capture.close()) {
+        status = 5;
+    }
+    if (sim_report_enabled) {
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - sim_start_time).count();
+        std::fprintf(stderr, "[vulsim] cycles=%llu seconds=%.6f\n", static_cast<unsigned long long>(cycles), seconds);
+    }
+    return status;
+}
+
+#ifdef VULSIM_ALLOC_TRACK
+#if defined(__GLIBC__)
+// 直接替换 malloc 系列函数，operator new、std::string、std::function 等最终都经过这里
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void *__libc_valloc(size_t size);
+void *__libc_pvalloc(size_t size);
+
+void *malloc(size_t size) noexcept {
+    vulalloc::record(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) noexcept {
+    vulalloc::record(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) noexcept {
+    vulalloc::record(size);
+    return __libc_realloc(ptr, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) noexcept {
+    vulalloc::record(size);
+    return __libc_memalign(alignment, size);
+}
+
+void *memalign(size_t alignment, size_t size) noexcept {
+    vulalloc::record(size);
+    return __libc_memalign(alignment, size);
+}
+
+void *valloc(size_t size) noexcept {
+    vulalloc::record(size);
+    return __libc_valloc(size);
+}
+
+void *pvalloc(size_t size) noexcept {
+    vulalloc::record(size);
+    return __libc_pvalloc(size);
+}
+
+int posix_memalign(void **memptr, size_t alignment, size_t size) noexcept {
+    vulalloc::record(size);
+    void *ptr = __libc_memalign(alignment, size);
+    if (ptr == nullptr) {
+        return ENOMEM;
+    }
+    *memptr = ptr;
+    return 0;
+}
+}
+#else
+// 非 glibc 平台只能替换全局 operator new
+#include <new>
+
+void *operator new(size_t size) {
+    vulalloc::record(size);
+    if (void *ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size) {
+    vulalloc::record(size);
+    if (void *ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+    std::free(ptr);
+}
+#endif
+#endif
+
 uint32_t trace_registe_signal(const std::string &signal_name, uint32_t signal_width) {
     return global_vcd_record.registe(signal_name, signal_width);
 }
@@ -43,26 +365,120 @@ void trace_add_break_point(const std::vector<TraceBreakConditionSpec> &condition
 }
 
 void trace_record(uint32_t signal_id, uint64_t signal_value) {
+    VUL_ALLOC_SCOPE("trace_record");
     global_vcd_record.record(signal_id, signal_value);
 }
 
 void trace_record(uint32_t signal_id, const std::vector<uint64_t> &signal_value) {
+    VUL_ALLOC_SCOPE("trace_record");
     global_vcd_record.record(signal_id, signal_value);
 }
 
 void trace_commit() {
+    VUL_ALLOC_SCOPE("trace_commit");
     global_vcd_record.commit();
 }
 
 void sim_exit() {
+    sim_sampler.fail_window_process();
     global_vcd_record.commit();
     global_vcd_record.close();
+    sim_telemetry.update(sim_telemetry.last_cycle(), global_vcd_record.bytes_written(), VulTelemetryFinished);
+#ifdef VULSIM_ALLOC_TRACK
+    vulalloc::report(stderr);
+#endif
+    vul_stimulus.close();
+    vul_capture.close();
     exit(1);
 }
 
+void sim_cycle_limit_reached(uint64_t cycles) {
+    global_vcd_record.close();
+    exit(sim_report(cycles, true));
+}
+
+#ifdef VULSIM_COSIM
+void sim_cosim_failed(uint64_t cycles) {
+    sim_sampler.fail_window_process();
+    global_vcd_record.close();
+    exit(sim_report(cycles, true));
+}
+#endif
+
+void sim_replay_failed(uint64_t cycles) {
+    sim_sampler.fail_window_process();
+    global_vcd_record.close();
+    exit(sim_report(cycles, true));
+}
+
+static void sim_stimulus_open(const char *record, const char *replay) {
+    if (record != nullptr && replay != nullptr) {
+        std::fprintf(stderr, "[vulsim] VULSIM_RECORD and VULSIM_REPLAY cannot be used together\n");
+        std::exit(2);
+    }
+    const bool ok = record != nullptr
+        ? vul_stimulus.open_record(record, VulTestMain::sim_stimulus_signature(), VulTestMain::sim_stimulus_ports())
+        : vul_stimulus.open_replay(replay, VulTestMain::sim_stimulus_signature(), VulTestMain::sim_stimulus_ports());
+    if (!ok) {
+        std::fprintf(stderr, "[vulsim] %s\n", vul_stimulus.error().c_str());
+        std::exit(2);
+    }
+}
+
+static void sim_capture_open(const char *path) {
+    if (VulTestMain::sim_capture_ports().empty()) {
+        std::fprintf(stderr, "[vulsim] VULSIM_CAPTURE requires a simulator generated with vulsimgen --capture <instance>\n");
+        std::exit(2);
+    }
+    if (!vul_capture.open_record(path, VulTestMain::sim_capture_signature(), VulTestMain::sim_capture_ports())) {
+        std::fprintf(stderr, "[vulsim] %s\n", vul_capture.error().c_str());
+        std::exit(2);
+    }
+}
+
 int main() {
+    if (const char *env = std::getenv("VULSIM_MAX_CYCLES")) {
+        sim_max_cycles = std::strtoull(env, nullptr, 10);
+        sim_report_enabled = true;
+    }
+    if (const char *env = std::getenv("VULSIM_TELEMETRY")) {
+        sim_telemetry_open(env);
+    }
+    if (const char *env = std::getenv("VULSIM_SNAPSHOT_INTERVAL")) {
+        sim_snapshot_open(env);
+    }
+#ifdef VULSIM_ALLOC_TRACK
+    if (const char *env = std::getenv("VULSIM_ALLOC_WARMUP")) {
+        vulalloc::warmup_cycles = std::strtoull(env, nullptr, 10);
+    }
+    sim_alloc_strict = std::getenv("VULSIM_ALLOC_STRICT") != nullptr;
+#endif
+#ifdef VULSIM_COSIM
+    vul_cosim.open(sim_env_u64("VULSIM_COSIM_INTERVAL", 1024));
+#endif
+    const char *stimulus_record = std::getenv("VULSIM_RECORD");
+    const char *stimulus_replay = std::getenv("VULSIM_REPLAY");
+    // 回退后仿真从快照周期重新执行，原进程与快照进程都无法写出一个完整的流
+    if (sim_snapshot_interval != 0 && (stimulus_record != nullptr || std::getenv("VULSIM_CAPTURE") != nullptr)) {
+        std::fprintf(stderr, "[vulsim] VULSIM_RECORD and VULSIM_CAPTURE cannot be used with VULSIM_SNAPSHOT_INTERVAL\n");
+        std::exit(2);
+    }
+    if (stimulus_record != nullptr || stimulus_replay != nullptr) {
+        sim_stimulus_open(stimulus_record, stimulus_replay);
+    }
+    if (const char *env = std::getenv("VULSIM_CAPTURE")) {
+        sim_capture_open(env);
+    }
     VulTestMain test_main;
-    test_main.simulation();
+    if (std::getenv("VULSIM_SAMPLE_PERIOD") != nullptr) {
+        sim_sample_open();
+    }
+    sim_start_time = std::chrono::steady_clock::now();
+    if (vul_stimulus.replaying()) {
+        test_main.sim_replay();
+    } else {
+        test_main.simulation();
+    }
     global_vcd_record.close();
-    return 0;
+    return sim_report(test_main.sim_cycles(), false);
 }
@@ -0,0 +1,285 @@
+// MIT License
+
+// Copyright (c) 2025 Meng Chengzhen, in Shandong University
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <coroutine>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Main 中的协程进程
+// 返回 VulProcess 的函数是一个 C++20 协程，用 sim_spawn() 交给生成的仿真类后，由调度器在每个周期开始、
+// 设计执行之前恢复一次，进程在本周期发出请求后以 co_await 挂起：
+//   co_await vul_next_cycle();      下一个周期继续
+//   co_await vul_wait_cycles(n);    n 个周期后继续，n 为 0 时不挂起
+//   co_await vul_until(pred);       pred() 成立时继续；立即成立时不挂起，否则从下一个周期起每个周期开始时检查
+//   co_await sub_process(...);      在当前周期立即执行另一个 VulProcess，它结束后继续
+// 所有进程在同一个线程中按创建顺序依次恢复，不需要加锁；只有创建协程帧时分配内存，逐周期的调度不分配。
+
+class VulProcessScheduler;
+
+class VulProcess {
+public:
+    struct promise_type {
+        // 作为子过程被 co_await 时，结束后返回的调用者
+        std::coroutine_handle<> continuation;
+
+        VulProcess get_return_object() {
+            return VulProcess(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+
+        // 创建后不立即执行，由调度器或 co_await 它的调用者启动
+        std::suspend_always initial_suspend() noexcept {
+            return {};
+        }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept {
+                return false;
+            }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept {
+                const auto next = handle.promise().continuation;
+                return next ? next : std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+
+        // 结束时保留协程帧，由所有者销毁
+        FinalAwaiter final_suspend() noexcept {
+            return {};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception() {
+            std::fprintf(stderr, "[vulsim] unhandled exception in harness process\n");
+            std::abort();
+        }
+    };
+
+    VulProcess() = default;
+    VulProcess(const VulProcess &) = delete;
+    VulProcess &operator=(const VulProcess &) = delete;
+    VulProcess(VulProcess &&other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    VulProcess &operator=(VulProcess &&other) noexcept {
+        if (this != &other) {
+            reset();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    ~VulProcess() {
+        reset();
+    }
+
+    bool valid() const {
+        return static_cast<bool>(handle_);
+    }
+
+    bool done() const {
+        return handle_ && handle_.done();
+    }
+
+    // co_await 另一个进程：在当前周期立即执行，它在其中挂起时整个进程一起挂起
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> child;
+            bool await_ready() noexcept {
+                return !child || child.done();
+            }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+                child.promise().continuation = caller;
+                return child;
+            }
+            void await_resume() noexcept {}
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    friend class VulProcessScheduler;
+
+    explicit VulProcess(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    void reset() {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = {};
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+class VulProcessScheduler {
+public:
+    VulProcessScheduler() = default;
+    VulProcessScheduler(const VulProcessScheduler &) = delete;
+    VulProcessScheduler &operator=(const VulProcessScheduler &) = delete;
+
+    ~VulProcessScheduler() {
+        for (auto &slot : slots_) {
+            slot.root.destroy();
+        }
+    }
+
+    // 加入一个进程，在本周期（正在恢复进程时）或下一次 resume_all() 中开始执行
+    void spawn(VulProcess &&process) {
+        if (!process.valid() || process.done()) {
+            return;
+        }
+        const auto root = std::exchange(process.handle_, {});
+        slots_.push_back({root, root, cycle_, nullptr, nullptr});
+    }
+
+    bool empty() const {
+        return slots_.empty();
+    }
+
+    // 仍未结束的进程数
+    size_t size() const {
+        return slots_.size();
+    }
+
+    // 已调用 resume_all() 的周期数
+    uint64_t cycle() const {
+        return cycle_;
+    }
+
+    // 按创建顺序恢复所有已满足唤醒条件的进程，每个进程运行到下一次挂起或结束，返回是否还有进程
+    bool resume_all() {
+        if (slots_.empty()) {
+            return false;
+        }
+        if (active_ == this) {
+            std::fprintf(stderr, "[vulsim] a harness process advanced the simulation itself, use co_await vul_next_cycle() instead of sim_nextcycle()/sim_run()\n");
+            std::abort();
+        }
+        bool finished = false;
+        // 进程可能在运行中创建新进程，slots_ 会扩容，只能按下标访问
+        for (size_t i = 0; i < slots_.size(); ++i) {
+            if (slots_[i].wake_cycle > cycle_) {
+                continue;
+            }
+            if (slots_[i].check != nullptr && !slots_[i].check(slots_[i].check_ctx)) {
+                continue;
+            }
+            slots_[i].check = nullptr;
+            VulProcessScheduler *const outer = active_;
+            const size_t outer_index = active_index_;
+            active_ = this;
+            active_index_ = i;
+            slots_[i].resume.resume();
+            active_ = outer;
+            active_index_ = outer_index;
+            if (slots_[i].root.done()) {
+                slots_[i].root.destroy();
+                slots_[i].root = {};
+                finished = true;
+            }
+        }
+        if (finished) {
+            size_t keep = 0;
+            for (size_t i = 0; i < slots_.size(); ++i) {
+                if (slots_[i].root) {
+                    slots_[keep++] = slots_[i];
+                }
+            }
+            slots_.resize(keep);
+        }
+        cycle_++;
+        return !slots_.empty();
+    }
+
+    // 由挂起的等待对象调用：记录当前进程下次恢复的协程与唤醒条件
+    static void suspend_current(std::coroutine_handle<> resume, uint64_t cycles, bool (*check)(void *), void *check_ctx) {
+        if (active_ == nullptr) {
+            std::fprintf(stderr, "[vulsim] harness process awaited outside the process scheduler, start it with sim_spawn()\n");
+            std::abort();
+        }
+        Slot &slot = active_->slots_[active_index_];
+        slot.resume = resume;
+        slot.wake_cycle = active_->cycle_ + cycles;
+        slot.check = check;
+        slot.check_ctx = check_ctx;
+    }
+
+private:
+    struct Slot {
+        std::coroutine_handle<> root;   // 进程最外层的协程帧
+        std::coroutine_handle<> resume; // 下次恢复的协程，进程正在执行子过程时为最内层的子过程
+        uint64_t wake_cycle;            // 不早于该周期恢复
+        bool (*check)(void *);          // 非空时还需该条件成立
+        void *check_ctx;
+    };
+
+    std::vector<Slot> slots_;
+    uint64_t cycle_ = 0;
+
+    static inline VulProcessScheduler *active_ = nullptr;
+    static inline size_t active_index_ = 0;
+};
+
+struct VulWaitCycles {
+    uint64_t cycles;
+
+    bool await_ready() const noexcept {
+        return cycles == 0;
+    }
+    void await_suspend(std::coroutine_handle<> handle) const {
+        VulProcessScheduler::suspend_current(handle, cycles, nullptr, nullptr);
+    }
+    void await_resume() const noexcept {}
+};
+
+// 谓词保存在等待对象中，等待对象在挂起期间位于进程的协程帧内
+template <typename Pred>
+struct VulWaitUntil {
+    Pred pred;
+
+    bool await_ready() {
+        return static_cast<bool>(pred());
+    }
+    void await_suspend(std::coroutine_handle<> handle) {
+        VulProcessScheduler::suspend_current(handle, 1, [](void *self) {
+            return static_cast<bool>(static_cast<VulWaitUntil *>(self)->pred());
+        }, this);
+    }
+    void await_resume() const noexcept {}
+};
+
+inline VulWaitCycles vul_next_cycle() {
+    return {1};
+}
+
+inline VulWaitCycles vul_wait_cycles(uint64_t cycles) {
+    return {cycles};
+}
+
+template <typename Pred>
+VulWaitUntil<std::decay_t<Pred>> vul_until(Pred &&pred) {
+    return {std::forward<Pred>(pred)};
+}
@@ -41,8 +41,10 @@ public:
     }
 
     void enqnext(const T &value) {
+#ifndef VULSIM_UNCHECKED
         assert(!enq_called_);
         enq_called_ = true;
+#endif
         assert(enqready_());
         enq_buf_ = value;
         enq_pending_ = true;
@@ -53,15 +55,19 @@ public:
     }
 
     void deqnext() {
+#ifndef VULSIM_UNCHECKED
         assert(!deq_called_);
-        assert(deqvalid());
         deq_called_ = true;
+#endif
+        assert(deqvalid());
         deq_pending_ = true;
     }
 
     void clrnext() {
+#ifndef VULSIM_UNCHECKED
         assert(!clr_called_);
         clr_called_ = true;
+#endif
         clr_pending_ = true;
     }
 
@@ -87,9 +93,11 @@ public:
 
         deq_pending_ = false;
         enq_pending_ = false;
+#ifndef VULSIM_UNCHECKED
         deq_called_ = false;
         enq_called_ = false;
         clr_called_ = false;
+#endif
 
         if (size_ > 0) {
             deq_buf_ = data_[head_];
@@ -99,6 +107,11 @@ public:
         }
     }
 
+    // 本周期没有入队、出队或清空，提交不改变队列内容
+    bool _quiescent() const {
+        return !enq_pending_ && !deq_pending_ && !clr_pending_;
+    }
+
 private:
     bool enqready_() const {
         return size_ < Depth;
@@ -117,9 +130,11 @@ private:
     bool deq_pending_ = false;
 
     bool clr_pending_ = false;
+#ifndef VULSIM_UNCHECKED
     bool enq_called_ = false;
     bool deq_called_ = false;
     bool clr_called_ = false;
+#endif
 };
 
 template<typename T, uint32_t Depth, uint32_t EnqWidth, uint32_t DeqWidth>
@@ -140,10 +155,12 @@ public:
     }
 
     void enqnext(const std::array<T, EnqWidth> &values, const uint32_t num = EnqWidth) {
+#ifndef VULSIM_UNCHECKED
         assert(!enq_called_);
         enq_called_ = true;
+#endif
         const uint32_t req = num < EnqWidth ? num : EnqWidth;
-        const uint32_t rdy = enqreqdy();
+        [[maybe_unused]] const uint32_t rdy = enqreqdy();
         assert(req <= rdy);
         for (uint32_t i = 0; i < req; ++i) {
             enq_buf_[i] = values[i];
@@ -157,17 +174,21 @@ public:
     }
 
     void deqnext(const uint32_t num = DeqWidth) {
+#ifndef VULSIM_UNCHECKED
         assert(!deq_called_);
         deq_called_ = true;
+#endif
         const uint32_t req = num < DeqWidth ? num : DeqWidth;
-        const uint32_t valid = deqvalid();
+        [[maybe_unused]] const uint32_t valid = deqvalid();
         assert(req <= valid);
         deq_pending_num_ = req;
     }
 
     void clrnext() {
+#ifndef VULSIM_UNCHECKED
         assert(!clr_called_);
         clr_called_ = true;
+#endif
         clr_pending_ = true;
     }
 
@@ -208,9 +229,11 @@ public:
 
         enq_pending_num_ = 0;
         deq_pending_num_ = 0;
+#ifndef VULSIM_UNCHECKED
         enq_called_ = false;
         deq_called_ = false;
         clr_called_ = false;
+#endif
 
         deq_valid_num_ = size_ < DeqWidth ? size_ : DeqWidth;
         uint32_t idx = head_;
@@ -222,6 +245,10 @@ public:
         }
     }
 
+    bool _quiescent() const {
+        return enq_pending_num_ == 0 && deq_pending_num_ == 0 && !clr_pending_;
+    }
+
 private:
     std::array<T, Depth> data_{};
     uint32_t head_ = 0;
@@ -236,7 +263,9 @@ private:
     uint32_t deq_pending_num_ = 0;
 
     bool clr_pending_ = false;
+#ifndef VULSIM_UNCHECKED
     bool enq_called_ = false;
     bool deq_called_ = false;
     bool clr_called_ = false;
+#endif
 };
@@ -0,0 +1,303 @@
+// VulQueue / VulQueueMP 的 Verilator 友好实现，端口、参数与周期行为与 queue.sv 完全一致。
+// queue.sv 在 always_comb 中把整个 data_q 复制到 data_d 再整体寄存，Verilator 会为此生成每周期 O(Depth) 的复制；
+// 这里存储阵列只在独立的 always_ff 中按写使能写入入队的表项，出队缓冲通过旁路读取本周期写入的数据，
+// 每周期的开销与 Depth 无关。存储阵列不复位：队列为空时表项不可见，复位后读出的数据总是先被写入过。
+// 由 vulrtlgen --rtllib verilator 选用，替代 queue.sv。
+
+module VulQueue #(
+    parameter int unsigned Width = 32,
+    parameter int unsigned Depth = 4
+) (
+    input  logic             clk,
+    input  logic             rstn,
+
+    output logic             enqready,  // 本周期是否能接受enqnext()调用
+    output logic             deqready,  // 本周期是否能接受deqnext()调用
+
+    input  logic             enqnext_vld,   // enq一个元素，在下个周期生效
+    input  logic [Width-1:0] enqnext_data,
+
+    input  logic             deqnext_vld,   // deq一个元素，在下个周期生效
+    output logic [Width-1:0] deqnext_data,
+
+    input  logic             clrnext        // 清空队列，在下个周期生效
+);
+
+localparam int unsigned PtrW  = (Depth <= 1) ? 1 : $clog2(Depth);
+localparam int unsigned SizeW = $clog2(Depth + 1);
+
+logic [Width-1:0] data_q [0:Depth-1];
+logic [PtrW-1:0]  head_q;
+logic [PtrW-1:0]  tail_q;
+logic [SizeW-1:0] size_q;
+logic [Width-1:0] deq_buf_q;
+logic             deq_buf_valid_q;
+
+logic [PtrW-1:0]  head_d;
+logic [PtrW-1:0]  tail_d;
+logic [SizeW-1:0] size_d;
+logic [Width-1:0] deq_buf_d;
+logic             deq_buf_valid_d;
+
+logic             wr_en;
+logic [PtrW-1:0]  wr_idx;
+
+always_comb begin
+    int unsigned head_n;
+    int unsigned tail_n;
+    int unsigned size_n;
+
+    head_n = int'(head_q);
+    tail_n = int'(tail_q);
+    size_n = int'(size_q);
+
+    // apply_next_tick(): clr -> deq -> enq.
+    if (clrnext) begin
+        head_n = 0;
+        tail_n = 0;
+        size_n = 0;
+    end
+
+    if (deqnext_vld && (size_n > 0)) begin
+        head_n = (head_n + 1 == Depth) ? 0 : head_n + 1;
+        size_n = size_n - 1;
+    end
+
+    // enqnext() acceptance is decided in current-cycle visible state.
+    wr_en = enqnext_vld && (int'(size_q) < Depth) && (size_n < Depth);
+    wr_idx = tail_n[PtrW-1:0];
+    if (wr_en) begin
+        tail_n = (tail_n + 1 == Depth) ? 0 : tail_n + 1;
+        size_n = size_n + 1;
+    end
+
+    head_d = head_n[PtrW-1:0];
+    tail_d = tail_n[PtrW-1:0];
+    size_d = size_n[SizeW-1:0];
+
+    deq_buf_d = deq_buf_q;
+    deq_buf_valid_d = (size_n > 0);
+    if (size_n > 0) begin
+        // 新的队首可能正是本周期写入的表项
+        deq_buf_d = (wr_en && wr_idx == head_n[PtrW-1:0]) ? enqnext_data : data_q[head_n[PtrW-1:0]];
+    end
+end
+
+always_ff @(posedge clk) begin
+    if (rstn && wr_en) begin
+        data_q[wr_idx] <= enqnext_data;
+    end
+end
+
+always_ff @(posedge clk or negedge rstn) begin
+    if (!rstn) begin
+        head_q <= '0;
+        tail_q <= '0;
+        size_q <= '0;
+        deq_buf_q <= '0;
+        deq_buf_valid_q <= 1'b0;
+    end else begin
+        head_q <= head_d;
+        tail_q <= tail_d;
+        size_q <= size_d;
+        deq_buf_q <= deq_buf_d;
+        deq_buf_valid_q <= deq_buf_valid_d;
+    end
+end
+
+always_comb begin
+    enqready = (int'(size_q) < Depth);
+    deqready = deq_buf_valid_q;
+    deqnext_data = deq_buf_q;
+end
+
+endmodule
+
+
+module VulQueueMP #(
+    parameter int unsigned Width = 32,
+    parameter int unsigned Depth = 4,
+    parameter int unsigned EnqWidth = 2,
+    parameter int unsigned DeqWidth = 2
+) (
+    input  logic                               clk,
+    input  logic                               rstn,
+
+    output logic [$clog2(EnqWidth+1)-1:0]     enqready,     // 本周期能接受的enq数量
+    output logic [$clog2(DeqWidth+1)-1:0]     deqready,     // 本周期能接受的deq数量
+
+    input  logic [$clog2(EnqWidth+1)-1:0]     enqnext_vld,                  // 本周期需要enq的数量，在下个周期生效，值被截断到enqready
+    input  logic [Width-1:0]                  enqnext_data [0:EnqWidth-1],
+
+    input  logic [$clog2(DeqWidth+1)-1:0]     deqnext_vld,                  // 本周期需要deq的数量，在下个周期生效，值被截断到deqready
+    output logic [Width-1:0]                  deqnext_data [0:DeqWidth-1],
+
+    input  logic                               clrnext        // 清空队列，在下个周期生效
+);
+
+localparam int unsigned PtrW     = (Depth <= 1) ? 1 : $clog2(Depth);
+localparam int unsigned SizeW    = $clog2(Depth + 1);
+localparam int unsigned EnqCntW  = $clog2(EnqWidth + 1);
+localparam int unsigned DeqCntW  = $clog2(DeqWidth + 1);
+
+logic [Width-1:0] data_q [0:Depth-1];
+logic [PtrW-1:0]  head_q;
+logic [PtrW-1:0]  tail_q;
+logic [SizeW-1:0] size_q;
+
+logic [Width-1:0] deq_buf_q [0:DeqWidth-1];
+logic [DeqCntW-1:0] deq_valid_num_q;
+
+logic [PtrW-1:0]  head_d;
+logic [PtrW-1:0]  tail_d;
+logic [SizeW-1:0] size_d;
+
+logic [Width-1:0] deq_buf_d [0:DeqWidth-1];
+logic [DeqCntW-1:0] deq_valid_num_d;
+
+// 第 i 个入队端口本周期写入的表项，同一周期内各端口的写入位置互不相同
+logic             wr_en  [0:EnqWidth-1];
+logic [PtrW-1:0]  wr_idx [0:EnqWidth-1];
+
+always_comb begin
+    int unsigned head_n;
+    int unsigned tail_n;
+    int unsigned size_n;
+    int unsigned idx_n;
+
+    int unsigned free_slots_pre;
+    int unsigned enq_req;
+    int unsigned enq_rdy_pre;
+    int unsigned enq_accepted;
+
+    int unsigned deq_req;
+    int unsigned deq_pending_num;
+    int unsigned pop_num;
+
+    int unsigned can_push;
+    int unsigned push_num;
+
+    head_n = int'(head_q);
+    tail_n = int'(tail_q);
+    size_n = int'(size_q);
+
+    free_slots_pre = Depth - int'(size_q);
+
+    enq_req = int'(enqnext_vld);
+    if (enq_req > EnqWidth) begin
+        enq_req = EnqWidth;
+    end
+
+    enq_rdy_pre = free_slots_pre;
+    if (enq_rdy_pre > EnqWidth) begin
+        enq_rdy_pre = EnqWidth;
+    end
+
+    enq_accepted = (enq_req < enq_rdy_pre) ? enq_req : enq_rdy_pre;
+
+    deq_req = int'(deqnext_vld);
+    if (deq_req > DeqWidth) begin
+        deq_req = DeqWidth;
+    end
+    deq_pending_num = (deq_req < int'(deq_valid_num_q)) ? deq_req : int'(deq_valid_num_q);
+
+    // apply_next_tick(): clr -> deq -> enq.
+    if (clrnext) begin
+        head_n = 0;
+        tail_n = 0;
+        size_n = 0;
+    end
+
+    // pop_num <= size_n <= Depth，指针前移最多回绕一次
+    pop_num = (deq_pending_num < size_n) ? deq_pending_num : size_n;
+    head_n = head_n + pop_num;
+    if (head_n >= Depth) begin
+        head_n = head_n - Depth;
+    end
+    size_n = size_n - pop_num;
+
+    can_push = Depth - size_n;
+    push_num = (enq_accepted < can_push) ? enq_accepted : can_push;
+    idx_n = tail_n;
+    for (int i = 0; i < EnqWidth; i = i + 1) begin
+        wr_en[i] = (i < push_num);
+        wr_idx[i] = idx_n[PtrW-1:0];
+        idx_n = (idx_n + 1 == Depth) ? 0 : idx_n + 1;
+    end
+    tail_n = tail_n + push_num;
+    if (tail_n >= Depth) begin
+        tail_n = tail_n - Depth;
+    end
+    size_n = size_n + push_num;
+
+    head_d = head_n[PtrW-1:0];
+    tail_d = tail_n[PtrW-1:0];
+    size_d = size_n[SizeW-1:0];
+
+    deq_valid_num_d = (size_n < DeqWidth) ? size_n[DeqCntW-1:0] : DeqWidth[DeqCntW-1:0];
+    idx_n = head_n;
+    for (int i = 0; i < DeqWidth; i = i + 1) begin
+        deq_buf_d[i] = deq_buf_q[i];
+        if (i < deq_valid_num_d) begin
+            deq_buf_d[i] = data_q[idx_n[PtrW-1:0]];
+            for (int k = 0; k < EnqWidth; k = k + 1) begin
+                if (wr_en[k] && wr_idx[k] == idx_n[PtrW-1:0]) begin
+                    deq_buf_d[i] = enqnext_data[k];
+                end
+            end
+        end
+        idx_n = (idx_n + 1 == Depth) ? 0 : idx_n + 1;
+    end
+end
+
+always_ff @(posedge clk) begin
+    if (rstn) begin
+        for (int i = 0; i < EnqWidth; i = i + 1) begin
+            if (wr_en[i]) begin
+                data_q[wr_idx[i]] <= enqnext_data[i];
+            end
+        end
+    end
+end
+
+always_ff @(posedge clk or negedge rstn) begin
+    if (!rstn) begin
+        for (int i = 0; i < DeqWidth; i = i + 1) begin
+            deq_buf_q[i] <= '0;
+        end
+        head_q <= '0;
+        tail_q <= '0;
+        size_q <= '0;
+        deq_valid_num_q <= '0;
+    end else begin
+        for (int i = 0; i < DeqWidth; i = i + 1) begin
+            deq_buf_q[i] <= deq_buf_d[i];
+        end
+        head_q <= head_d;
+        tail_q <= tail_d;
+        size_q <= size_d;
+        deq_valid_num_q <= deq_valid_num_d;
+    end
+end
+
+always_comb begin
+    int unsigned free_slots;
+    logic [EnqCntW-1:0] enq_rdy_cnt;
+
+    free_slots = Depth - int'(size_q);
+    enq_rdy_cnt = (free_slots < EnqWidth) ? EnqCntW'(free_slots) : EnqCntW'(EnqWidth);
+
+    enqready = enq_rdy_cnt;
+
+    if (deqnext_vld != '0) begin
+        deqready = '0;
+    end else begin
+        deqready = deq_valid_num_q;
+    end
+
+    for (int i = 0; i < DeqWidth; i = i + 1) begin
+        deqnext_data[i] = deq_buf_q[i];
+    end
+end
+
+endmodule
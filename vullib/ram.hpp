@@ -52,24 +52,25 @@ protected:
 
     std::array<DataT, Size> memory_{};
 
-    uint64_t addr_index_ = 0;
+    // 本周期没有请求时为 NO_REQUEST，同时用于检查每周期至多一次请求
+    static constexpr uint64_t NO_REQUEST = ~uint64_t(0);
+
+    uint64_t addr_index_ = NO_REQUEST;
     DataT write_data_{};
     DataT read_data_{};
     bool read_data_valid_ = false;
     bool write_en_ = false;
-    bool req_issued_ = false;
 
 public:
     VulBRAM1RW() : write_en_(false) {}
 
     void req(const AddrType &addr, const DataT &write_data, bool write_en) {
-        assert(!req_issued_ && "VulBRAM1RW::req() may only be called once per cycle");
+        assert(addr_index_ == NO_REQUEST && "VulBRAM1RW::req() may only be called once per cycle");
         const uint64_t addr_index = addr.template to<uint64_t>();
         assert(addr_index < Size && "Address out of range");
         addr_index_ = addr_index;
         write_data_ = write_data;
         write_en_ = write_en;
-        req_issued_ = true;
     }
 
     const DataT& readdata() const {
@@ -78,9 +79,7 @@ public:
     }
 
     void apply_next_tick() {
-        if (!req_issued_) {
-            read_data_valid_ = false;
-        } else if (addr_index_ >= Size) {
+        if (addr_index_ >= Size) {
             read_data_valid_ = false;
         } else if (write_en_) {
             memory_[addr_index_] = write_data_;
@@ -89,8 +88,13 @@ public:
             read_data_ = memory_[addr_index_];
             read_data_valid_ = true;
         }
+        addr_index_ = NO_REQUEST;
         write_en_ = false;
-        req_issued_ = false;
+    }
+
+    // 本周期没有请求，且上一周期的读数据已经失效，提交不改变任何状态
+    bool _quiescent() const {
+        return addr_index_ == NO_REQUEST && !read_data_valid_;
     }
 };
 
@@ -179,6 +183,18 @@ public:
         }
     }
 
+    bool _quiescent() const {
+        if (write_enables_ != 0) {
+            return false;
+        }
+        for (uint32_t i = 0; i < ReadPorts; ++i) {
+            if (readreq_issued_[i] || read_data_valid_[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
 protected:
 
 };
@@ -253,6 +269,15 @@ public:
         });
     }
 
+    bool _quiescent() const {
+        for (uint32_t i = 0; i < ReadPorts; ++i) {
+            if (readreq_issued_[i] || read_data_valid_[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
 
 protected:
 
@@ -0,0 +1,171 @@
+// VulBRAM1RW / VulBRAM / VulROM 的 Verilator 友好实现，端口、参数与周期行为与 ram_generic.sv 完全一致。
+// 存储阵列只在独立的、不带异步复位的 always_ff 中按写使能逐项写入，不进入复位分支与组合逻辑；
+// 读地址选择用连续赋值代替 always_comb 中的整体复制。
+// 由 vulrtlgen --rtllib verilator 选用，替代 ram_generic.sv。
+
+module VulBRAM1RW #(
+    parameter DataWidth = 32,
+    parameter AddrWidth = 10
+) (
+    input wire clk,
+    input wire rstn,
+
+    input wire s1_en,
+    input wire s1_we,
+    input wire [AddrWidth-1:0] s1_addr,
+    input wire [DataWidth-1:0] s1_wdata,
+
+    output wire [DataWidth-1:0] s2_rdata
+);
+
+localparam int unsigned Depth = (1 << AddrWidth);
+
+logic [DataWidth-1:0] memory [0:Depth-1];
+
+logic [AddrWidth-1:0] req_addr_q;
+logic [DataWidth-1:0] req_wdata_q;
+logic                 req_we_q;
+logic [DataWidth-1:0] read_data_q;
+
+wire [AddrWidth-1:0] req_addr_n  = s1_en ? s1_addr : req_addr_q;
+wire [DataWidth-1:0] req_wdata_n = s1_en ? s1_wdata : req_wdata_q;
+wire                 req_we_n    = s1_en ? s1_we : req_we_q;
+
+assign s2_rdata = read_data_q;
+
+always_ff @(posedge clk) begin
+    if (rstn && req_we_n) begin
+        memory[req_addr_n] <= req_wdata_n;
+    end
+end
+
+always_ff @(posedge clk or negedge rstn) begin
+    if (!rstn) begin
+        req_addr_q <= '0;
+        req_wdata_q <= '0;
+        req_we_q <= 1'b0;
+        read_data_q <= '0;
+    end else begin
+        req_addr_q <= req_addr_n;
+        req_wdata_q <= req_wdata_n;
+        req_we_q <= req_we_n;
+        // VulBRAM1RW::apply_next_tick(): write then read.
+        read_data_q <= req_we_n ? req_wdata_n : memory[req_addr_n];
+    end
+end
+
+endmodule
+
+
+module VulBRAM #(
+    parameter DataWidth = 32,
+    parameter AddrWidth = 10,
+    parameter ReadPorts = 2,
+    parameter WritePorts = 1
+) (
+    input wire clk,
+    input wire rstn,
+
+    input wire                  s1_readreq [ReadPorts],
+    input wire [AddrWidth-1:0]  s1_readaddr [ReadPorts],
+
+    output wire [DataWidth-1:0] s2_readdata [ReadPorts],
+
+    input wire                  s1_write [WritePorts],
+    input wire [AddrWidth-1:0]  s1_writeaddr [WritePorts],
+    input wire [DataWidth-1:0]  s1_writedata [WritePorts]
+);
+
+localparam int unsigned Depth = (1 << AddrWidth);
+
+logic [DataWidth-1:0] memory [0:Depth-1];
+
+logic [AddrWidth-1:0] read_addr_q [ReadPorts];
+logic [AddrWidth-1:0] read_addr_n [ReadPorts];
+logic [DataWidth-1:0] read_data_q [ReadPorts];
+
+assign s2_readdata = read_data_q;
+
+// Larger write-port index has higher priority for same address.
+always_ff @(posedge clk) begin
+    if (rstn) begin
+        for (int i = 0; i < WritePorts; i = i + 1) begin
+            if (s1_write[i]) begin
+                memory[s1_writeaddr[i]] <= s1_writedata[i];
+            end
+        end
+    end
+end
+
+for (genvar i = 0; i < ReadPorts; i = i + 1) begin : g_read_addr
+    assign read_addr_n[i] = s1_readreq[i] ? s1_readaddr[i] : read_addr_q[i];
+end
+
+always_ff @(posedge clk or negedge rstn) begin
+    if (!rstn) begin
+        for (int i = 0; i < ReadPorts; i = i + 1) begin
+            read_addr_q[i] <= '0;
+            read_data_q[i] <= '0;
+        end
+    end else begin
+        for (int i = 0; i < ReadPorts; i = i + 1) begin
+            read_addr_q[i] <= read_addr_n[i];
+            // VulBRAM::apply_next_tick(): read then write.
+            read_data_q[i] <= memory[read_addr_n[i]];
+        end
+    end
+end
+
+endmodule
+
+
+module VulROM #(
+    parameter DataWidth = 32,
+    parameter AddrWidth = 10,
+    parameter ReadPorts = 2,
+    parameter string ReadMemHPath = ""
+) (
+    input wire clk,
+    input wire rstn,
+
+    input wire                  s1_readreq [ReadPorts],
+    input wire [AddrWidth-1:0]  s1_readaddr [ReadPorts],
+
+    output wire [DataWidth-1:0] s2_readdata [ReadPorts]
+);
+
+localparam int unsigned Depth = (1 << AddrWidth);
+
+logic [DataWidth-1:0] memory [0:Depth-1];
+
+logic [AddrWidth-1:0] read_addr_q [ReadPorts];
+logic [AddrWidth-1:0] read_addr_n [ReadPorts];
+logic [DataWidth-1:0] read_data_q [ReadPorts];
+
+assign s2_readdata = read_data_q;
+
+initial begin
+    if (ReadMemHPath != "") begin
+        $readmemh(ReadMemHPath, memory);
+    end
+end
+
+for (genvar i = 0; i < ReadPorts; i = i + 1) begin : g_read_addr
+    assign read_addr_n[i] = s1_readreq[i] ? s1_readaddr[i] : read_addr_q[i];
+end
+
+always_ff @(posedge clk or negedge rstn) begin
+    if (!rstn) begin
+        for (int i = 0; i < ReadPorts; i = i + 1) begin
+            read_addr_q[i] <= '0;
+            read_data_q[i] <= '0;
+        end
+    end else begin
+        for (int i = 0; i < ReadPorts; i = i + 1) begin
+            read_addr_q[i] <= read_addr_n[i];
+            read_data_q[i] <= memory[read_addr_n[i]];
+        end
+    end
+end
+
+endmodule
@@ -6,13 +6,43 @@
 #include <string.h>
 
 #include <iostream>
+#include <string>
+
+#include "process.hpp"
+#include "runresult.hpp"
 
 void sim_nextcycle();
 
+// 连续执行至多 max_cycles 个周期，每个周期提交后求值 stop()，为真时立即返回
+template <typename StopPredicate>
+VulRunResult sim_run(uint64_t max_cycles, StopPredicate &&stop);
+
+VulRunResult sim_run(uint64_t max_cycles);
+
+// 开启后 sim_run 在设计中只有 QUIESCENT_TIMER 寄存器倒计数时直接跳到唤醒的周期，结果与逐周期执行一致
+void sim_skip_idle(bool enable);
+
+// 累计跳过的周期数，已计入 sim_cycles()
+uint64_t sim_skipped_cycles();
+
+// 加入一个协程进程，每个周期开始时由生成的调度器恢复，见 process.hpp
+void sim_spawn(VulProcess &&process);
+
+// 连续执行至多 max_cycles 个周期，所有进程结束后返回
+VulRunResult sim_run_processes(uint64_t max_cycles);
+
+uint64_t sim_cycles();
+
 void sim_reset();
 
 void sim_exit();
 
+void sim_register_counter(const std::string &name, const uint64_t *value);
+
+bool sim_sample_measuring();
+
+bool sim_sample_detailed();
+
 #define SIMULATION() void sim_main()
 
 #define GLOBAL() inline namespace global
@@ -0,0 +1,455 @@
+// MIT License
+
+// Copyright (c) 2025 Meng Chengzhen, in Shandong University
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// 周期性采样仿真（SMARTS 式系统采样）
+// 仿真被划分为长度 period 的区间，每个区间从 offset + k * period 开始依次经过 warmup 个预热周期和 window 个测量周期，
+// 其余周期为快进。测量窗口内统计各注册计数的增量，结束时按窗口给出每周期速率的均值与 95% 置信区间。
+// jobs 大于 0 时每个窗口在 fork 出的子进程中执行，主进程不等待窗口结束、直接快进到下一个窗口，同时最多运行 jobs 个窗口。
+
+enum VulSamplePhase : uint32_t {
+    VulSampleFastForward = 0,
+    VulSampleWarmup = 1,
+    VulSampleMeasure = 2,
+};
+
+struct VulSampleConfig {
+    uint64_t period = 0;
+    uint64_t warmup = 0;
+    uint64_t window = 0;
+    uint64_t offset = 0; // 第一个窗口的起始周期，0 表示取 period
+    uint32_t jobs = 0;
+};
+
+struct VulSampleCounter {
+    std::string name;
+    const uint64_t *value;
+};
+
+// 单个计数在各窗口中的每周期速率统计
+struct VulSampleSummary {
+    uint64_t windows = 0;
+    double mean = 0;
+    double stddev = 0;
+    double ci95 = 0; // 置信区间半宽
+    double min = 0;
+    double max = 0;
+};
+
+// 双侧 95% 置信度的 t 分布分位数，自由度超过 30 时取正态近似
+inline double vul_sample_t95(uint64_t dof) {
+    static constexpr double table[30] = {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042,
+    };
+    if (dof == 0) {
+        return 0;
+    }
+    return dof <= 30 ? table[dof - 1] : 1.960;
+}
+
+inline VulSampleSummary vul_sample_summarize(const std::vector<double> &values) {
+    VulSampleSummary sum;
+    sum.windows = values.size();
+    if (values.empty()) {
+        return sum;
+    }
+    double total = 0;
+    sum.min = sum.max = values.front();
+    for (const double v : values) {
+        total += v;
+        sum.min = std::min(sum.min, v);
+        sum.max = std::max(sum.max, v);
+    }
+    sum.mean = total / static_cast<double>(values.size());
+    if (values.size() > 1) {
+        double sq = 0;
+        for (const double v : values) {
+            sq += (v - sum.mean) * (v - sum.mean);
+        }
+        sum.stddev = std::sqrt(sq / static_cast<double>(values.size() - 1));
+        sum.ci95 = vul_sample_t95(values.size() - 1) * sum.stddev / std::sqrt(static_cast<double>(values.size()));
+    }
+    return sum;
+}
+
+class VulSampler {
+public:
+    struct Window {
+        uint64_t index;
+        std::vector<uint64_t> deltas; // 与注册计数一一对应，窗口开始后才注册的计数不在其中
+    };
+
+    // 测量窗口开始/结束时调用，参数为 true 表示进入测量
+    std::function<void(bool)> on_measure;
+    // fork 模式下在窗口子进程中调用一次，参数为窗口序号
+    std::function<void(uint64_t)> on_window_process;
+
+    VulSampler() = default;
+    VulSampler(const VulSampler &) = delete;
+    VulSampler &operator=(const VulSampler &) = delete;
+
+    // 配置非法时返回 false
+    bool configure(const VulSampleConfig &config, const std::vector<VulSampleCounter> *counters) {
+        if (config.period == 0 || config.window == 0 || config.warmup + config.window > config.period) {
+            return false;
+        }
+        config_ = config;
+        if (config_.offset == 0) {
+            config_.offset = config_.period;
+        }
+        counters_ = counters;
+        enabled_ = true;
+        return true;
+    }
+
+    bool enabled() const {
+        return enabled_;
+    }
+
+    const VulSampleConfig &config() const {
+        return config_;
+    }
+
+    VulSamplePhase phase() const {
+        return phase_;
+    }
+
+    bool in_window_process() const {
+        return window_process_;
+    }
+
+    // 第一个事件所在的周期
+    uint64_t first_event() const {
+        return config_.offset;
+    }
+
+    // 在第 cycles 个周期提交后处理到期事件，返回下一个事件的周期
+    uint64_t on_event(uint64_t cycles) {
+        uint64_t next = cycles;
+        while (next == cycles) {
+            next = step();
+        }
+        return next;
+    }
+
+    // 窗口子进程在窗口结束前正常结束（到达周期上限等）时调用，该窗口作废
+    void abandon_window_process() {
+        if (window_process_) {
+            _exit(0);
+        }
+    }
+
+    // 窗口子进程中仿真以失败结束（sim_exit）时调用，以非零退出码通知主进程
+    void fail_window_process() {
+        if (window_process_) {
+            _exit(1);
+        }
+    }
+
+    // 等待所有窗口子进程结束并收集结果，有窗口失败时返回 false
+    bool collect() {
+        while (!jobs_.empty()) {
+            reap_oldest();
+        }
+        return failed_.empty();
+    }
+
+    const std::vector<Window> &windows() const {
+        return windows_;
+    }
+
+    uint64_t dropped_windows() const {
+        return dropped_;
+    }
+
+    // 子进程以非零退出码结束或被信号终止的窗口序号
+    const std::vector<uint64_t> &failed_windows() const {
+        return failed_;
+    }
+
+    // 第 i 个计数在各窗口中的每周期速率
+    std::vector<double> rates(size_t counter) const {
+        std::vector<double> values;
+        for (const auto &w : windows_) {
+            if (counter < w.deltas.size()) {
+                values.push_back(static_cast<double>(w.deltas[counter]) / static_cast<double>(config_.window));
+            }
+        }
+        return values;
+    }
+
+    void report(FILE *out) const {
+        std::fprintf(out, "[vulsim-sample] windows=%zu dropped=%llu failed=%zu period=%llu warmup=%llu window=%llu jobs=%u\n",
+                     windows_.size(), static_cast<unsigned long long>(dropped_), failed_.size(),
+                     static_cast<unsigned long long>(config_.period),
+                     static_cast<unsigned long long>(config_.warmup),
+                     static_cast<unsigned long long>(config_.window), config_.jobs);
+        for (const uint64_t index : failed_) {
+            std::fprintf(out, "[vulsim-sample]   window %llu failed (cycle %llu)\n",
+                         static_cast<unsigned long long>(index),
+                         static_cast<unsigned long long>(window_begin(index)));
+        }
+        for (size_t i = 0; i < counters_->size(); i++) {
+            const VulSampleSummary sum = vul_sample_summarize(rates(i));
+            if (sum.windows == 0) {
+                continue;
+            }
+            const double rel = sum.mean != 0 ? 100.0 * sum.ci95 / std::fabs(sum.mean) : 0.0;
+            std::fprintf(out, "[vulsim-sample]   %-40s per_cycle=%.6f ci95=+-%.6f (%.2f%%) min=%.6f max=%.6f\n",
+                         (*counters_)[i].name.c_str(), sum.mean, sum.ci95, rel, sum.min, sum.max);
+        }
+    }
+
+    bool write_json(const std::string &path) const {
+        FILE *fp = std::fopen(path.c_str(), "w");
+        if (fp == nullptr) {
+            return false;
+        }
+        std::fprintf(fp, "{\n  \"period\": %llu,\n  \"warmup\": %llu,\n  \"window\": %llu,\n  \"offset\": %llu,\n  \"jobs\": %u,\n  \"dropped\": %llu,\n  \"failed\": [",
+                     static_cast<unsigned long long>(config_.period),
+                     static_cast<unsigned long long>(config_.warmup),
+                     static_cast<unsigned long long>(config_.window),
+                     static_cast<unsigned long long>(config_.offset), config_.jobs,
+                     static_cast<unsigned long long>(dropped_));
+        for (size_t i = 0; i < failed_.size(); i++) {
+            std::fprintf(fp, "%s%llu", i ? ", " : "", static_cast<unsigned long long>(failed_[i]));
+        }
+        std::fprintf(fp, "],\n  \"counters\": {");
+        for (size_t i = 0; i < counters_->size(); i++) {
+            const VulSampleSummary sum = vul_sample_summarize(rates(i));
+            std::fprintf(fp, "%s\n    \"%s\": {\"windows\": %llu, \"per_cycle\": %.9g, \"stddev\": %.9g, \"ci95\": %.9g, \"min\": %.9g, \"max\": %.9g}",
+                         i ? "," : "", json_escape((*counters_)[i].name).c_str(),
+                         static_cast<unsigned long long>(sum.windows), sum.mean, sum.stddev, sum.ci95, sum.min, sum.max);
+        }
+        std::fprintf(fp, "\n  },\n  \"windows\": [");
+        for (size_t w = 0; w < windows_.size(); w++) {
+            std::fprintf(fp, "%s\n    {\"index\": %llu, \"deltas\": [", w ? "," : "",
+                         static_cast<unsigned long long>(windows_[w].index));
+            for (size_t i = 0; i < windows_[w].deltas.size(); i++) {
+                std::fprintf(fp, "%s%llu", i ? ", " : "", static_cast<unsigned long long>(windows_[w].deltas[i]));
+            }
+            std::fprintf(fp, "]}");
+        }
+        std::fprintf(fp, "\n  ]\n}\n");
+        return std::fclose(fp) == 0;
+    }
+
+private:
+    enum class Stage {
+        Idle,
+        Warmup,
+        Measure,
+    };
+
+    struct Job {
+        pid_t pid;
+        int result_fd;
+        uint64_t index;
+    };
+
+    uint64_t window_begin(uint64_t index) const {
+        return config_.offset + index * config_.period;
+    }
+
+    // 处理一个阶段转换，返回下一个事件的周期；返回值等于当前周期时表示同一周期还有事件
+    uint64_t step() {
+        const uint64_t begin = window_begin(index_);
+        switch (stage_) {
+        case Stage::Idle:
+            if (config_.jobs > 0 && !window_process_ && !fork_window()) {
+                // 主进程跳过该窗口，直接等待下一个窗口
+                index_++;
+                return window_begin(index_);
+            }
+            stage_ = Stage::Warmup;
+            phase_ = VulSampleWarmup;
+            return begin + config_.warmup;
+        case Stage::Warmup:
+            begin_values_.clear();
+            for (const auto &c : *counters_) {
+                begin_values_.push_back(*c.value);
+            }
+            stage_ = Stage::Measure;
+            phase_ = VulSampleMeasure;
+            if (on_measure) {
+                on_measure(true);
+            }
+            return begin + config_.warmup + config_.window;
+        case Stage::Measure: {
+            Window w{index_, {}};
+            for (size_t i = 0; i < begin_values_.size(); i++) {
+                w.deltas.push_back(*(*counters_)[i].value - begin_values_[i]);
+            }
+            if (on_measure) {
+                on_measure(false);
+            }
+            if (window_process_) {
+                send_result(w);
+                _exit(0);
+            }
+            windows_.push_back(std::move(w));
+            stage_ = Stage::Idle;
+            phase_ = VulSampleFastForward;
+            index_++;
+            return window_begin(index_);
+        }
+        }
+        return 0;
+    }
+
+    // 主进程中返回 false，窗口子进程中返回 true
+    bool fork_window() {
+        while (jobs_.size() >= config_.jobs) {
+            reap_oldest();
+        }
+        int fds[2];
+        if (pipe(fds) != 0) {
+            dropped_++;
+            return false;
+        }
+        std::fflush(nullptr);
+        const pid_t pid = fork();
+        if (pid < 0) {
+            close(fds[0]);
+            close(fds[1]);
+            dropped_++;
+            return false;
+        }
+        if (pid == 0) {
+            close(fds[0]);
+            for (const auto &job : jobs_) {
+                close(job.result_fd);
+            }
+            jobs_.clear();
+            window_process_ = true;
+            result_fd_ = fds[1];
+            // 窗口子进程不产生终端输出，也不读取输入
+            const int null_fd = open("/dev/null", O_RDWR);
+            if (null_fd >= 0) {
+                dup2(null_fd, STDIN_FILENO);
+                dup2(null_fd, STDOUT_FILENO);
+                close(null_fd);
+            }
+            if (on_window_process) {
+                on_window_process(index_);
+            }
+            return true;
+        }
+        close(fds[1]);
+        jobs_.push_back(Job{pid, fds[0], index_});
+        return false;
+    }
+
+    void send_result(const Window &w) {
+        std::vector<uint64_t> msg;
+        msg.push_back(w.index);
+        msg.push_back(w.deltas.size());
+        msg.insert(msg.end(), w.deltas.begin(), w.deltas.end());
+        const char *data = reinterpret_cast<const char *>(msg.data());
+        size_t left = msg.size() * sizeof(uint64_t);
+        while (left > 0) {
+            const ssize_t n = write(result_fd_, data, left);
+            if (n <= 0) {
+                break;
+            }
+            data += n;
+            left -= static_cast<size_t>(n);
+        }
+        close(result_fd_);
+    }
+
+    void reap_oldest() {
+        const Job job = jobs_.front();
+        jobs_.pop_front();
+        std::vector<uint64_t> msg;
+        uint64_t word = 0;
+        size_t filled = 0;
+        while (true) {
+            const ssize_t n = read(job.result_fd, reinterpret_cast<char *>(&word) + filled, sizeof(word) - filled);
+            if (n <= 0) {
+                break;
+            }
+            filled += static_cast<size_t>(n);
+            if (filled == sizeof(word)) {
+                msg.push_back(word);
+                filled = 0;
+            }
+        }
+        close(job.result_fd);
+        int status = 0;
+        waitpid(job.pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            // 窗口内仿真失败（sim_exit、断言等），整次运行按失败处理
+            failed_.push_back(job.index);
+            return;
+        }
+        if (msg.size() < 2 || msg.size() != 2 + msg[1]) {
+            // 窗口结束前仿真已经结束
+            dropped_++;
+            return;
+        }
+        Window w{msg[0], std::vector<uint64_t>(msg.begin() + 2, msg.end())};
+        // 子进程按启动顺序回收，结果天然按窗口序号排列
+        windows_.push_back(std::move(w));
+    }
+
+    static std::string json_escape(const std::string &s) {
+        std::string out;
+        for (const char ch : s) {
+            if (ch == '"' || ch == '\\') {
+                out.push_back('\\');
+            }
+            out.push_back(ch);
+        }
+        return out;
+    }
+
+    VulSampleConfig config_;
+    const std::vector<VulSampleCounter> *counters_ = nullptr;
+    bool enabled_ = false;
+    bool window_process_ = false;
+    int result_fd_ = -1;
+    Stage stage_ = Stage::Idle;
+    VulSamplePhase phase_ = VulSampleFastForward;
+    uint64_t index_ = 0;
+    std::vector<uint64_t> begin_values_;
+    std::vector<Window> windows_;
+    std::deque<Job> jobs_;
+    uint64_t dropped_ = 0;
+    std::vector<uint64_t> failed_;
+};
@@ -0,0 +1,172 @@
+// MIT License
+
+// Copyright (c) 2025 Meng Chengzhen, in Shandong University
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sys/prctl.h>
+#endif
+
+// 基于 fork() 的进程快照
+// take() 在周期边界 fork 出一个暂停的子进程，子进程与父进程写时复制共享内存，
+// 在父进程修改页面之前几乎不占额外内存。resume() 唤醒某个快照并把控制权交给它，父进程随之退出。
+// 快照数量有上限，超出时丢弃最旧的快照。
+
+class VulSnapshotManager {
+public:
+    struct Snapshot {
+        pid_t pid;
+        int command_fd; // 向暂停的子进程发送命令的管道写端
+        uint64_t cycle;
+    };
+
+    VulSnapshotManager() = default;
+    VulSnapshotManager(const VulSnapshotManager &) = delete;
+    VulSnapshotManager &operator=(const VulSnapshotManager &) = delete;
+
+    ~VulSnapshotManager() {
+        discard_all();
+    }
+
+    void set_capacity(uint32_t capacity) {
+        capacity_ = capacity ? capacity : 1;
+    }
+
+    uint32_t capacity() const {
+        return capacity_;
+    }
+
+    const std::deque<Snapshot> &snapshots() const {
+        return snapshots_;
+    }
+
+    // 在父进程中返回 false；被 resume() 唤醒的快照进程从这里返回 true 并继续仿真
+    bool take(uint64_t cycle) {
+        int fds[2];
+        if (pipe(fds) != 0) {
+            return false;
+        }
+        // 避免父子进程重复输出缓冲区中的内容
+        std::fflush(nullptr);
+        std::cout.flush();
+        const pid_t parent = getpid();
+        const pid_t pid = fork();
+        if (pid < 0) {
+            close(fds[0]);
+            close(fds[1]);
+            return false;
+        }
+        if (pid == 0) {
+            close(fds[1]);
+            wait_for_resume(fds[0], parent);
+            return true;
+        }
+        close(fds[0]);
+        snapshots_.push_back(Snapshot{pid, fds[1], cycle});
+        while (snapshots_.size() > capacity_) {
+            discard(snapshots_.front());
+            snapshots_.pop_front();
+        }
+        return false;
+    }
+
+    // 丢弃其余快照，唤醒 index 指定的快照并等待它结束，然后以它的退出码退出当前进程
+    [[noreturn]] void resume(size_t index) {
+        Snapshot chosen = snapshots_.at(index);
+        snapshots_.erase(snapshots_.begin() + static_cast<std::ptrdiff_t>(index));
+        discard_all();
+        std::fflush(nullptr);
+        std::cout.flush();
+        const char command = 'r';
+        if (write(chosen.command_fd, &command, 1) != 1) {
+            std::fprintf(stderr, "[Snapshot] Failed to resume snapshot at cycle %llu\n",
+                         static_cast<unsigned long long>(chosen.cycle));
+            _exit(1);
+        }
+        close(chosen.command_fd);
+        int status = 0;
+        while (waitpid(chosen.pid, &status, 0) < 0) {
+        }
+        _exit(WIFEXITED(status) ? WEXITSTATUS(status) : 1);
+    }
+
+    // 最近一个不晚于 cycle 的快照下标，不存在时返回 -1
+    int64_t nearest_before(uint64_t cycle) const {
+        for (size_t i = snapshots_.size(); i > 0; i--) {
+            if (snapshots_[i - 1].cycle <= cycle) {
+                return static_cast<int64_t>(i - 1);
+            }
+        }
+        return -1;
+    }
+
+    void discard_all() {
+        for (auto &snap : snapshots_) {
+            discard(snap);
+        }
+        snapshots_.clear();
+    }
+
+    // 在 fork 出的子进程中调用：继承来的快照属于父进程，只关闭管道，不能 kill
+    void forget() {
+        for (auto &snap : snapshots_) {
+            close(snap.command_fd);
+        }
+        snapshots_.clear();
+    }
+
+private:
+    void discard(const Snapshot &snap) {
+        close(snap.command_fd);
+        kill(snap.pid, SIGKILL);
+        waitpid(snap.pid, nullptr, 0);
+    }
+
+    void wait_for_resume(int command_fd, pid_t parent) {
+#if defined(__linux__)
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+        if (getppid() != parent) {
+            _exit(0);
+        }
+        forget();
+        char command = 0;
+        const ssize_t n = read(command_fd, &command, 1);
+        close(command_fd);
+        if (n != 1 || command != 'r') {
+            // 父进程丢弃了该快照或已经退出
+            _exit(0);
+        }
+    }
+
+    std::deque<Snapshot> snapshots_;
+    uint32_t capacity_ = 4;
+};
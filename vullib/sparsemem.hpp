@@ -0,0 +1,573 @@
+// MIT License
+
+// Copyright (c) 2025 Meng Chengzhen, in Shandong University
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 仿真入口使用的稀疏小端字节内存模型
+// 按 4 KiB 页按需分配，未写过的页读出为 0 且不占内存；直接映射的软件 TLB 缓存最近访问的页，
+// 不跨页的 1/2/4/8 字节访问在命中时只有一次比较和一次 memcpy，跨页的非对齐访问逐页拆分。
+// 拷贝构造只复制页表，页面在两个实例间共享，任一方第一次写入某页时才复制该页（写时复制），
+// 因此可以先装载一次程序镜像，再为批量的仿真实例各拷贝一份。
+// 从 ELF 或平坦二进制文件装载时，文件以只读方式 mmap，页对齐且完整落在文件数据内的页直接引用映射，不复制。
+
+static_assert(std::endian::native == std::endian::little, "VulSparseMemory assumes a little-endian host");
+
+struct VulElfImage {
+    uint64_t entry = 0;
+    uint64_t low = 0;       // 所有 PT_LOAD 段覆盖的最低地址
+    uint64_t high = 0;      // 所有 PT_LOAD 段覆盖的最高地址（不含）
+    uint32_t segments = 0;  // 装载的 PT_LOAD 段数
+};
+
+class VulSparseMemory {
+public:
+    static constexpr uint32_t PageBits = 12;
+    static constexpr uint64_t PageSize = 1ULL << PageBits;
+    static constexpr uint64_t PageMask = PageSize - 1;
+
+    VulSparseMemory() {
+        flush_tlb();
+    }
+
+    // 写时复制：共享 other 的全部页面，之后双方各自写入时复制被写的页
+    VulSparseMemory(const VulSparseMemory &other) : pages_(other.pages_) {
+        flush_tlb();
+        other.flush_tlb();
+    }
+
+    VulSparseMemory &operator=(const VulSparseMemory &other) {
+        if (this != &other) {
+            pages_ = other.pages_;
+            flush_tlb();
+            other.flush_tlb();
+        }
+        return *this;
+    }
+
+    VulSparseMemory(VulSparseMemory &&other) noexcept : pages_(std::move(other.pages_)) {
+        flush_tlb();
+        other.flush_tlb();
+    }
+
+    VulSparseMemory &operator=(VulSparseMemory &&other) noexcept {
+        if (this != &other) {
+            pages_ = std::move(other.pages_);
+            flush_tlb();
+            other.flush_tlb();
+        }
+        return *this;
+    }
+
+    // 释放所有页面，内存恢复为全 0
+    void clear() {
+        pages_ = PageTable();
+        flush_tlb();
+    }
+
+    template <typename T>
+    T load(uint64_t addr) const {
+        static_assert(std::is_trivially_copyable_v<T>, "VulSparseMemory::load requires a trivially copyable type");
+        T value;
+        const uint64_t offset = addr & PageMask;
+        if (offset + sizeof(T) <= PageSize) [[likely]] {
+            std::memcpy(&value, read_ptr(addr >> PageBits) + offset, sizeof(T));
+        } else {
+            read(addr, &value, sizeof(T));
+        }
+        return value;
+    }
+
+    template <typename T>
+    void store(uint64_t addr, const T &value) {
+        static_assert(std::is_trivially_copyable_v<T>, "VulSparseMemory::store requires a trivially copyable type");
+        const uint64_t offset = addr & PageMask;
+        if (offset + sizeof(T) <= PageSize) [[likely]] {
+            std::memcpy(write_ptr(addr >> PageBits) + offset, &value, sizeof(T));
+        } else {
+            write(addr, &value, sizeof(T));
+        }
+    }
+
+    // 读取 width（1..8）字节的小端值，高位补 0
+    uint64_t load_le(uint64_t addr, uint32_t width) const {
+        switch (width) {
+        case 1: return load<uint8_t>(addr);
+        case 2: return load<uint16_t>(addr);
+        case 4: return load<uint32_t>(addr);
+        case 8: return load<uint64_t>(addr);
+        default: {
+            uint64_t value = 0;
+            read(addr, &value, width);
+            return value;
+        }
+        }
+    }
+
+    // 以小端写入 value 的低 width（1..8）字节
+    void store_le(uint64_t addr, uint64_t value, uint32_t width) {
+        switch (width) {
+        case 1: store<uint8_t>(addr, static_cast<uint8_t>(value)); break;
+        case 2: store<uint16_t>(addr, static_cast<uint16_t>(value)); break;
+        case 4: store<uint32_t>(addr, static_cast<uint32_t>(value)); break;
+        case 8: store<uint64_t>(addr, value); break;
+        default: write(addr, &value, width); break;
+        }
+    }
+
+    void read(uint64_t addr, void *dst, uint64_t len) const {
+        uint8_t *out = static_cast<uint8_t *>(dst);
+        while (len > 0) {
+            const uint64_t offset = addr & PageMask;
+            const uint64_t chunk = std::min(len, PageSize - offset);
+            std::memcpy(out, read_ptr(addr >> PageBits) + offset, chunk);
+            addr += chunk;
+            out += chunk;
+            len -= chunk;
+        }
+    }
+
+    void write(uint64_t addr, const void *src, uint64_t len) {
+        const uint8_t *in = static_cast<const uint8_t *>(src);
+        while (len > 0) {
+            const uint64_t offset = addr & PageMask;
+            const uint64_t chunk = std::min(len, PageSize - offset);
+            std::memcpy(write_ptr(addr >> PageBits) + offset, in, chunk);
+            addr += chunk;
+            in += chunk;
+            len -= chunk;
+        }
+    }
+
+    // 把区间清零；整页落在区间内的页直接释放，未分配的页保持未分配
+    void zero(uint64_t addr, uint64_t len) {
+        while (len > 0) {
+            const uint64_t vpn = addr >> PageBits;
+            const uint64_t offset = addr & PageMask;
+            const uint64_t chunk = std::min(len, PageSize - offset);
+            if (pages_.find(vpn) != nullptr) {
+                if (chunk == PageSize) {
+                    pages_.erase(vpn);
+                    invalidate(vpn);
+                } else {
+                    std::memset(write_ptr(vpn) + offset, 0, chunk);
+                }
+            }
+            addr += chunk;
+            len -= chunk;
+        }
+    }
+
+    // 已分配（含共享与文件映射）的页数
+    size_t page_count() const {
+        return pages_.count();
+    }
+
+    // 本实例独占且自行分配的页数，即写时复制之后实际占用的私有内存
+    size_t private_page_count() const {
+        size_t count = 0;
+        pages_.for_each([&](const Slot &slot) {
+            if (slot.page->owned && slot.page.use_count() == 1) {
+                count++;
+            }
+        });
+        return count;
+    }
+
+    const std::string &error() const {
+        return error_;
+    }
+
+    // 装载小端 ELF32/ELF64 可执行文件的全部 PT_LOAD 段（按 p_vaddr），filesz 之外到 memsz 的部分清零
+    bool load_elf(const std::string &path, VulElfImage *image = nullptr) {
+        std::shared_ptr<const uint8_t> file;
+        uint64_t size = 0;
+        if (!map_file(path, file, size)) {
+            return false;
+        }
+        const uint8_t *base = file.get();
+        if (size < EI_NIDENT || std::memcmp(base, ELFMAG, SELFMAG) != 0) {
+            return fail("not an ELF file: " + path);
+        }
+        if (base[EI_DATA] != ELFDATA2LSB) {
+            return fail("big-endian ELF is not supported: " + path);
+        }
+        if (base[EI_CLASS] == ELFCLASS64) {
+            return load_elf_segments<Elf64_Ehdr, Elf64_Phdr>(path, file, size, image);
+        }
+        if (base[EI_CLASS] == ELFCLASS32) {
+            return load_elf_segments<Elf32_Ehdr, Elf32_Phdr>(path, file, size, image);
+        }
+        return fail("unknown ELF class: " + path);
+    }
+
+    // 把整个文件装载到 [addr, addr + 文件大小)
+    bool load_binary(const std::string &path, uint64_t addr, uint64_t *loaded_size = nullptr) {
+        std::shared_ptr<const uint8_t> file;
+        uint64_t size = 0;
+        if (!map_file(path, file, size)) {
+            return false;
+        }
+        place(addr, file, 0, size);
+        if (loaded_size != nullptr) {
+            *loaded_size = size;
+        }
+        return true;
+    }
+
+private:
+    // 页面存储的所有者：自行分配的页或文件映射
+    struct Page {
+        std::unique_ptr<uint8_t[]> owned;
+        std::shared_ptr<const uint8_t> backing;  // 直接引用文件映射时保持映射存活
+    };
+
+    struct Slot {
+        uint8_t *data = nullptr;  // 为空表示该页未分配
+        bool writable = false;    // 本实例独占且自行分配，可以直接写入
+        std::shared_ptr<Page> page;
+    };
+
+    struct TlbEntry {
+        uint64_t vpn;
+        const uint8_t *read;
+        uint8_t *write;  // 为空表示该页尚不可直接写入（未分配、共享或引用文件映射）
+    };
+
+    // 两级页表：按 2 MiB 区域哈希到叶表，叶表内按页号直接索引；最近使用的叶表缓存在一个直接映射的小表中
+    // 槽位内联数据指针与可写标记，TLB 缺失时不需要访问页面对象
+    class PageTable {
+    public:
+        static constexpr uint32_t LeafBits = 9;
+        static constexpr uint64_t LeafMask = (1ULL << LeafBits) - 1;
+
+        PageTable() = default;
+
+        // 复制叶表（即复制各页的引用），页面本身共享；双方的页都变为不可直接写入，写入时再判断是否需要复制
+        PageTable(const PageTable &other) : count_(other.count_) {
+            for (const auto &[key, leaf] : other.leaves_) {
+                for (auto &slot : leaf->slots) {
+                    slot.writable = false;
+                }
+                leaves_.emplace(key, std::make_unique<Leaf>(*leaf));
+            }
+        }
+
+        PageTable &operator=(const PageTable &other) {
+            if (this != &other) {
+                PageTable copy(other);
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        PageTable(PageTable &&other) noexcept
+            : leaves_(std::move(other.leaves_)), count_(std::exchange(other.count_, 0)) {
+            other.leaves_.clear();
+            other.reset_cache();
+        }
+
+        PageTable &operator=(PageTable &&other) noexcept {
+            if (this != &other) {
+                leaves_ = std::move(other.leaves_);
+                count_ = std::exchange(other.count_, 0);
+                reset_cache();
+                other.leaves_.clear();
+                other.reset_cache();
+            }
+            return *this;
+        }
+
+        // 返回该页的槽位，页未分配时返回空指针
+        Slot *find(uint64_t vpn) const {
+            Leaf *leaf = find_leaf(vpn >> LeafBits);
+            if (leaf == nullptr || leaf->slots[vpn & LeafMask].data == nullptr) {
+                return nullptr;
+            }
+            return &leaf->slots[vpn & LeafMask];
+        }
+
+        // 返回该页的槽位，必要时创建叶表；返回的槽位可能尚未分配页面，由调用者填入
+        Slot &get(uint64_t vpn) {
+            const uint64_t key = vpn >> LeafBits;
+            Leaf *leaf = find_leaf(key);
+            if (leaf == nullptr) {
+                leaf = leaves_.emplace(key, std::make_unique<Leaf>()).first->second.get();
+                cache_[key & (LeafCacheEntries - 1)] = LeafCacheEntry{key, leaf};
+            }
+            return leaf->slots[vpn & LeafMask];
+        }
+
+        // 页面由未分配变为已分配时由调用者通知，用于统计页数
+        void note_allocated() {
+            count_++;
+        }
+
+        void erase(uint64_t vpn) {
+            Leaf *leaf = find_leaf(vpn >> LeafBits);
+            if (leaf != nullptr && leaf->slots[vpn & LeafMask].data != nullptr) {
+                leaf->slots[vpn & LeafMask] = Slot{};
+                count_--;
+            }
+        }
+
+        size_t count() const {
+            return count_;
+        }
+
+        template <typename Fn>
+        void for_each(Fn &&fn) const {
+            for (const auto &[key, leaf] : leaves_) {
+                for (const auto &slot : leaf->slots) {
+                    if (slot.data != nullptr) {
+                        fn(slot);
+                    }
+                }
+            }
+        }
+
+    private:
+        struct Leaf {
+            Slot slots[1ULL << LeafBits];
+        };
+
+        struct LeafCacheEntry {
+            uint64_t key = ~0ULL;
+            Leaf *leaf = nullptr;
+        };
+
+        static constexpr size_t LeafCacheEntries = 32;
+
+        Leaf *find_leaf(uint64_t key) const {
+            LeafCacheEntry &entry = cache_[key & (LeafCacheEntries - 1)];
+            if (entry.key == key) {
+                return entry.leaf;
+            }
+            auto iter = leaves_.find(key);
+            if (iter == leaves_.end()) {
+                return nullptr;
+            }
+            entry = LeafCacheEntry{key, iter->second.get()};
+            return entry.leaf;
+        }
+
+        void reset_cache() {
+            for (auto &entry : cache_) {
+                entry = LeafCacheEntry{};
+            }
+        }
+
+        std::unordered_map<uint64_t, std::unique_ptr<Leaf>> leaves_;
+        size_t count_ = 0;
+        mutable LeafCacheEntry cache_[LeafCacheEntries];
+    };
+
+    static constexpr size_t TlbEntries = 256;
+    static constexpr uint64_t TlbInvalid = ~0ULL;
+
+    static const uint8_t *zero_page() {
+        alignas(64) static const uint8_t page[PageSize] = {};
+        return page;
+    }
+
+    void flush_tlb() const {
+        for (auto &entry : tlb_) {
+            entry = TlbEntry{TlbInvalid, nullptr, nullptr};
+        }
+    }
+
+    void invalidate(uint64_t vpn) const {
+        TlbEntry &entry = tlb_[vpn & (TlbEntries - 1)];
+        if (entry.vpn == vpn) {
+            entry = TlbEntry{TlbInvalid, nullptr, nullptr};
+        }
+    }
+
+    const uint8_t *read_ptr(uint64_t vpn) const {
+        const TlbEntry &entry = tlb_[vpn & (TlbEntries - 1)];
+        if (entry.vpn == vpn) [[likely]] {
+            return entry.read;
+        }
+        return read_ptr_slow(vpn);
+    }
+
+    uint8_t *write_ptr(uint64_t vpn) {
+        const TlbEntry &entry = tlb_[vpn & (TlbEntries - 1)];
+        if (entry.vpn == vpn && entry.write != nullptr) [[likely]] {
+            return entry.write;
+        }
+        return write_ptr_slow(vpn);
+    }
+
+    const uint8_t *read_ptr_slow(uint64_t vpn) const {
+        const Slot *slot = pages_.find(vpn);
+        TlbEntry &entry = tlb_[vpn & (TlbEntries - 1)];
+        if (slot == nullptr) {
+            entry = TlbEntry{vpn, zero_page(), nullptr};
+        } else {
+            entry = TlbEntry{vpn, slot->data, slot->writable ? slot->data : nullptr};
+        }
+        return entry.read;
+    }
+
+    uint8_t *write_ptr_slow(uint64_t vpn) {
+        Slot &slot = pages_.get(vpn);
+        if (slot.data == nullptr) {
+            slot.page = std::make_shared<Page>();
+            slot.page->owned = std::make_unique<uint8_t[]>(PageSize);
+            slot.data = slot.page->owned.get();
+            slot.writable = true;
+            pages_.note_allocated();
+        } else if (!slot.writable) {
+            if (slot.page->owned && slot.page.use_count() == 1) {
+                // 曾经共享该页的实例已经释放了它
+                slot.writable = true;
+            } else {
+                auto copy = std::make_shared<Page>();
+                copy->owned = std::make_unique_for_overwrite<uint8_t[]>(PageSize);
+                std::memcpy(copy->owned.get(), slot.data, PageSize);
+                slot.page = std::move(copy);
+                slot.data = slot.page->owned.get();
+                slot.writable = true;
+            }
+        }
+        tlb_[vpn & (TlbEntries - 1)] = TlbEntry{vpn, slot.data, slot.data};
+        return slot.data;
+    }
+
+    bool fail(const std::string &message) {
+        error_ = message;
+        return false;
+    }
+
+    bool map_file(const std::string &path, std::shared_ptr<const uint8_t> &file, uint64_t &size) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return fail("cannot open " + path + ": " + std::strerror(errno));
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            ::close(fd);
+            return fail("cannot stat " + path + ": " + std::strerror(errno));
+        }
+        size = static_cast<uint64_t>(st.st_size);
+        if (size == 0) {
+            ::close(fd);
+            file.reset();
+            return true;
+        }
+        void *mem = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED) {
+            return fail("cannot mmap " + path + ": " + std::strerror(errno));
+        }
+        file = std::shared_ptr<const uint8_t>(static_cast<const uint8_t *>(mem), [size](const uint8_t *p) {
+            munmap(const_cast<uint8_t *>(p), size);
+        });
+        return true;
+    }
+
+    // 把文件 [offset, offset + len) 放到 addr；与文件页对齐的整页直接引用映射，其余部分复制
+    void place(uint64_t addr, const std::shared_ptr<const uint8_t> &file, uint64_t offset, uint64_t len) {
+        const bool aligned = ((addr ^ offset) & PageMask) == 0;
+        while (len > 0) {
+            const uint64_t vpn = addr >> PageBits;
+            const uint64_t page_offset = addr & PageMask;
+            const uint64_t chunk = std::min(len, PageSize - page_offset);
+            if (aligned && chunk == PageSize) {
+                Slot &slot = pages_.get(vpn);
+                if (slot.data == nullptr) {
+                    pages_.note_allocated();
+                }
+                slot.page = std::make_shared<Page>();
+                slot.page->backing = file;
+                slot.data = const_cast<uint8_t *>(file.get() + offset);
+                slot.writable = false;
+                invalidate(vpn);
+            } else {
+                std::memcpy(write_ptr(vpn) + page_offset, file.get() + offset, chunk);
+            }
+            addr += chunk;
+            offset += chunk;
+            len -= chunk;
+        }
+    }
+
+    template <typename Ehdr, typename Phdr>
+    bool load_elf_segments(const std::string &path, const std::shared_ptr<const uint8_t> &file, uint64_t size,
+                           VulElfImage *image) {
+        Ehdr ehdr;
+        if (size < sizeof(Ehdr)) {
+            return fail("truncated ELF header: " + path);
+        }
+        std::memcpy(&ehdr, file.get(), sizeof(Ehdr));
+        if (ehdr.e_phentsize != sizeof(Phdr) ||
+            static_cast<uint64_t>(ehdr.e_phoff) + static_cast<uint64_t>(ehdr.e_phnum) * sizeof(Phdr) > size) {
+            return fail("bad ELF program header table: " + path);
+        }
+        VulElfImage result;
+        result.entry = ehdr.e_entry;
+        result.low = ~0ULL;
+        for (uint32_t i = 0; i < ehdr.e_phnum; i++) {
+            Phdr phdr;
+            std::memcpy(&phdr, file.get() + ehdr.e_phoff + i * sizeof(Phdr), sizeof(Phdr));
+            if (phdr.p_type != PT_LOAD || phdr.p_memsz == 0) {
+                continue;
+            }
+            if (phdr.p_filesz > phdr.p_memsz || static_cast<uint64_t>(phdr.p_offset) + phdr.p_filesz > size) {
+                return fail("bad PT_LOAD segment " + std::to_string(i) + ": " + path);
+            }
+            place(phdr.p_vaddr, file, phdr.p_offset, phdr.p_filesz);
+            zero(static_cast<uint64_t>(phdr.p_vaddr) + phdr.p_filesz, phdr.p_memsz - phdr.p_filesz);
+            result.low = std::min<uint64_t>(result.low, phdr.p_vaddr);
+            result.high = std::max<uint64_t>(result.high, static_cast<uint64_t>(phdr.p_vaddr) + phdr.p_memsz);
+            result.segments++;
+        }
+        if (result.segments == 0) {
+            result.low = 0;
+        }
+        if (image != nullptr) {
+            *image = result;
+        }
+        return true;
+    }
+
+    PageTable pages_;
+    mutable TlbEntry tlb_[TlbEntries];
+    std::string error_;
+};
@@ -0,0 +1,533 @@
+// MIT License
+
+// Copyright (c) 2025 Meng Chengzhen, in Shandong University
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "fixint.hpp"
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// 录制缓冲写满该字节数后写出到文件；测试中可以调小以覆盖缓冲写出的路径
+#ifndef VULSIM_STIMULUS_FLUSH_BYTES
+#define VULSIM_STIMULUS_FLUSH_BYTES (1 << 20)
+#endif
+
+// 测试激励的录制与回放
+// 录制时把 Main 与顶层模块之间的每次交互按发生顺序写成紧凑的二进制流：Main 发出的请求（参数，以及握手结果与响应）、
+// 顶层模块调用的 Main 服务（参数，以及 Main 给出的握手结果与响应）、QUERY 的取值、复位与周期边界。
+// 每个值按平铺字段拆成 64 位字，以 LEB128 变长整数写入；连续的无事件周期合并为一个周期计数。
+// 回放时不执行 simulation()，由生成的 sim_replay() 按流中的顺序重新发出请求、用记录的结果响应服务调用，
+// 并把设计一侧的输出（服务参数、请求结果、QUERY 取值）与记录比较，报告第一个出现差异的周期与字段。
+//
+// 流格式：8 字节魔数 "VULSTIM1"，8 字节小端接口签名，之后是事件序列。每个事件以标记开头：
+//   0 流结束；1 周期计数 n；2 复位；3 请求结果；4 + k 第 k 个端口（数组端口随后是下标）。
+// 请求在调用前写参数、返回后写结果，两者之间是请求处理过程中嵌套发生的服务调用。
+
+// 值与 64 位字序列之间的转换，整数与枚举按无符号位模式，Int<N> 按其存储字
+template <typename T>
+struct VulStimWords;
+
+// 严格的 -std=c++20 下 std::is_integral 不包含 128 位整数
+template <typename T>
+concept VulStimScalar = std::is_integral_v<T> || std::is_enum_v<T> || std::is_same_v<T, __int128_t> || std::is_same_v<T, __uint128_t>;
+
+template <VulStimScalar T>
+struct VulStimWords<T> {
+    static constexpr uint32_t Count = sizeof(T) > 8 ? 2 : 1;
+    using Raw = std::conditional_t<(sizeof(T) > 8), __uint128_t, uint64_t>;
+
+    static std::array<uint64_t, Count> get(const T &value) {
+        Raw raw;
+        if constexpr (std::is_same_v<T, bool>) {
+            raw = value ? 1 : 0;
+        } else if constexpr (std::is_enum_v<T>) {
+            raw = static_cast<Raw>(static_cast<std::make_unsigned_t<std::underlying_type_t<T>>>(value));
+        } else if constexpr (sizeof(T) > 8) {
+            raw = static_cast<Raw>(value);
+        } else {
+            raw = static_cast<Raw>(static_cast<std::make_unsigned_t<T>>(value));
+        }
+        if constexpr (Count == 2) {
+            return {static_cast<uint64_t>(raw), static_cast<uint64_t>(raw >> 64)};
+        } else {
+            return {raw};
+        }
+    }
+
+    static T make(const std::array<uint64_t, Count> &words) {
+        Raw raw = words[0];
+        if constexpr (Count == 2) {
+            raw |= static_cast<Raw>(words[1]) << 64;
+        }
+        if constexpr (std::is_same_v<T, bool>) {
+            return raw != 0;
+        } else {
+            return static_cast<T>(raw);
+        }
+    }
+};
+
+template <uint32_t BitWidth>
+struct VulStimWords<Int<BitWidth>> {
+    static constexpr uint32_t Count = Int<BitWidth>::NUM_WORDS;
+
+    static std::array<uint64_t, Count> get(const Int<BitWidth> &value) {
+        return value.get_data();
+    }
+
+    static Int<BitWidth> make(const std::array<uint64_t, Count> &words) {
+        Int<BitWidth> value;
+        value.set_data(words);
+        return value;
+    }
+};
+
+class VulStimulusStream {
+public:
+    static constexpr uint64_t TagEnd = 0;
+    static constexpr uint64_t TagCycles = 1;
+    static constexpr uint64_t TagReset = 2;
+    static constexpr uint64_t TagResult = 3;
+    static constexpr uint64_t TagPortBase = 4;
+
+    VulStimulusStream() = default;
+    VulStimulusStream(const VulStimulusStream &) = delete;
+    VulStimulusStream &operator=(const VulStimulusStream &) = delete;
+
+    ~VulStimulusStream() {
+        close();
+        release();
+    }
+
+    bool recording() const {
+        return mode_ == ModeRecord;
+    }
+
+    bool replaying() const {
+        return mode_ == ModeReplay;
+    }
+
+    // 回放中是否已发现不一致
+    bool failed() const {
+        return failed_;
+    }
+
+    const std::string &error() const {
+        return error_;
+    }
+
+    uint64_t cycles() const {
+        return cycles_;
+    }
+
+    uint64_t events() const {
+        return events_;
+    }
+
+    // signature 描述生成时的端口与字段布局，回放时必须与录制时一致；ports 为各端口名，用于报告
+    bool open_record(const std::string &path, uint64_t signature, std::vector<std::string> ports) {
+        file_ = std::fopen(path.c_str(), "wb");
+        if (file_ == nullptr) {
+            return fail("cannot create " + path + ": " + std::strerror(errno));
+        }
+        // 录制自行缓冲，文件不再经过 stdio 缓冲：fork 出的子进程调用 detach() 关闭文件时不会写出任何数据
+        std::setvbuf(file_, nullptr, _IONBF, 0);
+        path_ = path;
+        ports_ = std::move(ports);
+        buffer_.reserve(FlushBytes + 64);
+        buffer_.insert(buffer_.end(), Magic, Magic + 8);
+        for (uint32_t i = 0; i < 8; i++) {
+            buffer_.push_back(static_cast<uint8_t>(signature >> (8 * i)));
+        }
+        mode_ = ModeRecord;
+        return true;
+    }
+
+    bool open_replay(const std::string &path, uint64_t signature, std::vector<std::string> ports) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return fail("cannot open " + path + ": " + std::strerror(errno));
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < 16) {
+            ::close(fd);
+            return fail(path + " is not a stimulus stream");
+        }
+        void *mem = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED) {
+            return fail("cannot mmap " + path + ": " + std::strerror(errno));
+        }
+        map_ = static_cast<const uint8_t *>(mem);
+        map_size_ = static_cast<size_t>(st.st_size);
+        if (std::memcmp(map_, Magic, 8) != 0) {
+            release();
+            return fail(path + " is not a stimulus stream");
+        }
+        uint64_t recorded = 0;
+        for (uint32_t i = 0; i < 8; i++) {
+            recorded |= static_cast<uint64_t>(map_[8 + i]) << (8 * i);
+        }
+        if (recorded != signature) {
+            release();
+            return fail(path + " was recorded from a different harness interface");
+        }
+        madvise(const_cast<uint8_t *>(map_), map_size_, MADV_SEQUENTIAL);
+        pos_ = map_ + 16;
+        end_ = map_ + map_size_;
+        path_ = path;
+        ports_ = std::move(ports);
+        mode_ = ModeReplay;
+        return true;
+    }
+
+    // ---------------- 录制 ----------------
+
+    void event(uint64_t tag) {
+        flush_cycles();
+        put_varint(tag);
+        events_++;
+    }
+
+    void event(uint64_t tag, uint32_t index) {
+        event(tag);
+        put_varint(index);
+    }
+
+    template <typename T>
+    void put(const T &value) {
+        for (uint64_t word : VulStimWords<T>::get(value)) {
+            put_varint(word);
+        }
+    }
+
+    // 一个周期提交
+    void cycle() {
+        pending_cycles_++;
+        cycles_++;
+    }
+
+    // 在 fork 出的子进程中调用：丢弃从父进程继承的未写出数据并关闭文件，之后不再录制。
+    // 子进程与父进程共享文件偏移，继续写入会把重复与交错的事件写进父进程的流
+    void detach() {
+        if (mode_ != ModeRecord) {
+            return;
+        }
+        mode_ = ModeOff;
+        buffer_.clear();
+        pending_cycles_ = 0;
+        std::fclose(file_);
+        file_ = nullptr;
+    }
+
+    // 录制时写入结束标记并关闭文件；回放时确认流已完整读完。返回流是否完好
+    bool close() {
+        if (mode_ == ModeRecord) {
+            mode_ = ModeOff;
+            flush_cycles();
+            put_varint(TagEnd);
+            const bool ok = flush() && std::fclose(file_) == 0;
+            file_ = nullptr;
+            std::fprintf(stderr, "[vulsim-record] cycles=%llu events=%llu bytes=%llu -> %s\n",
+                         static_cast<unsigned long long>(cycles_), static_cast<unsigned long long>(events_),
+                         static_cast<unsigned long long>(written_), path_.c_str());
+            if (!ok) {
+                std::fprintf(stderr, "[vulsim-record] write error on %s\n", path_.c_str());
+            }
+            return ok;
+        }
+        if (mode_ == ModeReplay) {
+            mode_ = ModeOff;
+            if (failed_) {
+                return false;
+            }
+            if (pending_cycles_ != 0 || !has_tag_ || tag_ != TagEnd || truncated_ || pos_ != end_) {
+                std::fprintf(stderr, "[vulsim-replay] stream %s ended early or has trailing data after cycle %llu\n",
+                             path_.c_str(), static_cast<unsigned long long>(cycles_));
+                failed_ = true;
+                return false;
+            }
+            std::fprintf(stderr, "[vulsim-replay] cycles=%llu events=%llu: match\n",
+                         static_cast<unsigned long long>(cycles_), static_cast<unsigned long long>(events_));
+        }
+        return true;
+    }
+
+    // ---------------- 回放 ----------------
+
+    // 下一个事件的标记；当前周期的提交尚未执行时为 TagCycles
+    uint64_t peek() {
+        if (pending_cycles_ == 0 && !has_tag_) {
+            fetch();
+        }
+        return pending_cycles_ != 0 ? TagCycles : tag_;
+    }
+
+    // 消费 peek() 返回的非周期事件
+    void take() {
+        has_tag_ = false;
+        events_++;
+    }
+
+    // 消费一个周期提交
+    void take_cycle() {
+        pending_cycles_--;
+        cycles_++;
+    }
+
+    uint32_t index() {
+        return static_cast<uint32_t>(get_varint());
+    }
+
+    template <typename T>
+    void get(T &value) {
+        value = VulStimWords<T>::make(get_words<T>());
+    }
+
+    // 设计在本周期调用了端口 tag（数组端口的下标为 index，非数组端口为 -1），与流中的下一个事件比较
+    bool expect(uint64_t tag, int64_t index) {
+        const uint64_t next = peek();
+        if (next == tag) {
+            take();
+            const int64_t recorded = index < 0 ? -1 : static_cast<int64_t>(get_varint());
+            if (recorded == index) {
+                begin(tag, index);
+                return true;
+            }
+            report_header();
+            std::fprintf(stderr, "design called %s, recorded call is %s\n",
+                         port_label(tag, index).c_str(), port_label(tag, recorded).c_str());
+        } else {
+            report_header();
+            std::fprintf(stderr, "design called %s, recorded stream expects %s\n",
+                         port_label(tag, index).c_str(), describe(next).c_str());
+        }
+        failed_ = true;
+        return false;
+    }
+
+    // 流中记录的调用没有在设计中发生
+    void report_missing(uint64_t tag) {
+        report_header();
+        std::fprintf(stderr, "recorded call to %s was not made by the design\n", port_label(tag, -1).c_str());
+        failed_ = true;
+    }
+
+    // 流与生成的回放代码不匹配
+    void report_corrupt(uint64_t tag) {
+        report_header();
+        std::fprintf(stderr, "unexpected %s in stream %s\n", describe(tag).c_str(), path_.c_str());
+        failed_ = true;
+    }
+
+    // 之后的 check() 属于端口 tag 的第 index 个实例
+    void begin(uint64_t tag, int64_t index) {
+        check_tag_ = tag;
+        check_index_ = index;
+    }
+
+    // 读出记录值与设计一侧的值比较，不一致时报告字段并标记失败
+    template <typename T>
+    void check(const char *field, const T &actual) {
+        constexpr uint32_t Count = VulStimWords<T>::Count;
+        const std::array<uint64_t, Count> expected = get_words<T>();
+        const std::array<uint64_t, Count> got = VulStimWords<T>::get(actual);
+        if (expected == got) {
+            return;
+        }
+        report_header();
+        std::fprintf(stderr, "%s.%s recorded %s replayed %s\n", port_label(check_tag_, check_index_).c_str(), field,
+                     hex(expected.data(), Count).c_str(), hex(got.data(), Count).c_str());
+        failed_ = true;
+    }
+
+private:
+    static constexpr char Magic[8] = {'V', 'U', 'L', 'S', 'T', 'I', 'M', '1'};
+    static constexpr size_t FlushBytes = VULSIM_STIMULUS_FLUSH_BYTES;
+
+    enum Mode : uint32_t {
+        ModeOff = 0,
+        ModeRecord = 1,
+        ModeReplay = 2,
+    };
+
+    bool fail(std::string message) {
+        error_ = std::move(message);
+        return false;
+    }
+
+    void release() {
+        if (map_ != nullptr) {
+            munmap(const_cast<uint8_t *>(map_), map_size_);
+            map_ = nullptr;
+        }
+    }
+
+    void put_varint(uint64_t value) {
+        while (value >= 0x80) {
+            buffer_.push_back(static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        buffer_.push_back(static_cast<uint8_t>(value));
+    }
+
+    void flush_cycles() {
+        if (pending_cycles_ != 0) {
+            put_varint(TagCycles);
+            put_varint(pending_cycles_);
+            pending_cycles_ = 0;
+        }
+        if (buffer_.size() >= FlushBytes) {
+            flush();
+        }
+    }
+
+    bool flush() {
+        const size_t n = std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+        written_ += n;
+        const bool ok = n == buffer_.size();
+        buffer_.clear();
+        return ok;
+    }
+
+    uint64_t get_varint() {
+        uint64_t value = 0;
+        for (uint32_t shift = 0; shift < 64 && pos_ < end_; shift += 7) {
+            const uint8_t byte = *pos_++;
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        truncated_ = true;
+        pos_ = end_;
+        return 0;
+    }
+
+    template <typename T>
+    std::array<uint64_t, VulStimWords<T>::Count> get_words() {
+        std::array<uint64_t, VulStimWords<T>::Count> words;
+        for (uint64_t &word : words) {
+            word = get_varint();
+        }
+        return words;
+    }
+
+    void fetch() {
+        if (pos_ >= end_) {
+            truncated_ = true;
+            tag_ = TagEnd;
+        } else {
+            tag_ = get_varint();
+            if (tag_ == TagCycles) {
+                pending_cycles_ = get_varint();
+                if (pending_cycles_ != 0) {
+                    return;
+                }
+                truncated_ = true;
+                tag_ = TagEnd;
+            }
+        }
+        has_tag_ = true;
+    }
+
+    void report_header() const {
+        std::fprintf(stderr, "[vulsim-replay] mismatch in cycle %llu: ", static_cast<unsigned long long>(cycles_ + 1));
+    }
+
+    std::string port_label(uint64_t tag, int64_t index) const {
+        const uint64_t port = tag - TagPortBase;
+        std::string label = tag >= TagPortBase && port < ports_.size() ? ports_[port] : ("port" + std::to_string(tag));
+        if (index >= 0) {
+            label += "[" + std::to_string(index) + "]";
+        }
+        return label;
+    }
+
+    std::string describe(uint64_t tag) const {
+        switch (tag) {
+        case TagEnd:
+            return "end of stream";
+        case TagCycles:
+            return "end of cycle";
+        case TagReset:
+            return "reset";
+        case TagResult:
+            return "request result";
+        default:
+            return port_label(tag, -1);
+        }
+    }
+
+    static std::string hex(const uint64_t *words, uint32_t count) {
+        std::string out = "0x";
+        char buf[24];
+        bool leading = true;
+        for (uint32_t i = count; i > 0; i--) {
+            if (leading && words[i - 1] == 0 && i > 1) {
+                continue;
+            }
+            std::snprintf(buf, sizeof(buf), leading ? "%llx" : "%016llx", static_cast<unsigned long long>(words[i - 1]));
+            out += buf;
+            leading = false;
+        }
+        return out;
+    }
+
+    Mode mode_ = ModeOff;
+    std::string path_;
+    std::string error_;
+    std::vector<std::string> ports_;
+    uint64_t cycles_ = 0;
+    uint64_t events_ = 0;
+    uint64_t pending_cycles_ = 0; // 录制时尚未写出的周期数，回放时当前周期计数事件中尚未执行的周期数
+    bool failed_ = false;
+
+    // 录制
+    std::FILE *file_ = nullptr;
+    std::vector<uint8_t> buffer_;
+    uint64_t written_ = 0;
+
+    // 回放
+    const uint8_t *map_ = nullptr;
+    size_t map_size_ = 0;
+    const uint8_t *pos_ = nullptr;
+    const uint8_t *end_ = nullptr;
+    uint64_t tag_ = TagEnd;
+    bool has_tag_ = false;
+    bool truncated_ = false;
+    uint64_t check_tag_ = 0;
+    int64_t check_index_ = -1;
+};
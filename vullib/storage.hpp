@@ -26,10 +26,40 @@
 
 #include <assert.h>
 
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <span>
+#include <vector>
+
 using std::array;
 
 namespace vulstorage {
 
+namespace detail {
+
+// 静默检测：没有 operator== 的类型（如 STRUCT）写入即视为改变了值
+template<typename T>
+inline bool same_value(const T &lhs, const T &rhs) {
+    if constexpr (std::equality_comparable<T>) {
+        return lhs == rhs;
+    } else {
+        return false;
+    }
+}
+
+// QUIESCENT_TIMER 寄存器的计数值，类型为内置整数或 Int<N>
+template<typename T>
+inline uint64_t timer_value(const T &value) {
+    if constexpr (std::is_integral_v<T>) {
+        return static_cast<uint64_t>(value);
+    } else {
+        return value.template to<uint64_t>();
+    }
+}
+
+} // namespace detail
+
 template<typename T, uint32_t WRPortNum>
 class VulRegisterImpl {
 public:
@@ -42,9 +72,11 @@ public:
         if (reset_next_ || hold_next_) {
             return;
         }
+#ifndef VULSIM_UNCHECKED
         assert((issued_write_ports_ & (uint64_t(1) << P)) == 0 &&
                "VulRegister::setnext() may only be called once per cycle for each write port");
         issued_write_ports_ |= uint64_t(1) << P;
+#endif
         if (P < pending_write_ports_) {
             next_ = value;
             pending_write_ports_ = P;
@@ -69,7 +101,9 @@ public:
             data_ = next_;
         }
         pending_write_ports_ = WRPortNum;
+#ifndef VULSIM_UNCHECKED
         issued_write_ports_ = 0;
+#endif
         hold_next_ = false;
         reset_next_ = false;
     }
@@ -89,11 +123,32 @@ public:
         reset_value_ = value;
     }
 
+    // 本周期的提交不会改变寄存器的值，未写入时 next_ 与 data_ 一致
+    bool _quiescent() const {
+        if (reset_next_) {
+            return detail::same_value(reset_value_, data_);
+        }
+        return hold_next_ || pending_write_ports_ == WRPortNum || detail::same_value(next_, data_);
+    }
+
+    // 本周期把非零的计数值减一
+    bool _timer_counting() const {
+        return !reset_next_ && !hold_next_ && pending_write_ports_ < WRPortNum &&
+               detail::timer_value(data_) != 0 && detail::timer_value(next_) + 1 == detail::timer_value(data_);
+    }
+
+    // 在本周期提交之外再跳过 cycles 个同样的计数周期
+    void _timer_skip(uint64_t cycles) {
+        next_ = static_cast<T>(detail::timer_value(next_) - cycles);
+    }
+
     void _reset() {
         data_ = reset_value_;
         next_ = reset_value_;
         pending_write_ports_ = WRPortNum;
+#ifndef VULSIM_UNCHECKED
         issued_write_ports_ = 0;
+#endif
         hold_next_ = false;
         reset_next_ = false;
     }
@@ -103,7 +158,9 @@ protected:
     T next_{};
     T reset_value_{};
     uint32_t pending_write_ports_ = WRPortNum;
+#ifndef VULSIM_UNCHECKED
     uint64_t issued_write_ports_ = 0;
+#endif
     bool hold_next_ = false;
     bool reset_next_ = false;
 };
@@ -156,6 +213,22 @@ public:
         reset_value_ = value;
     }
 
+    bool _quiescent() const {
+        if (reset_next_) {
+            return detail::same_value(reset_value_, data_);
+        }
+        return hold_next_ || !write_issued_ || detail::same_value(next_buffer_, data_);
+    }
+
+    bool _timer_counting() const {
+        return !reset_next_ && !hold_next_ && write_issued_ &&
+               detail::timer_value(data_) != 0 && detail::timer_value(next_buffer_) + 1 == detail::timer_value(data_);
+    }
+
+    void _timer_skip(uint64_t cycles) {
+        next_buffer_ = static_cast<T>(detail::timer_value(next_buffer_) - cycles);
+    }
+
     void _reset() {
         data_ = reset_value_;
         next_buffer_ = reset_value_;
@@ -207,6 +280,19 @@ public:
     void _reset() {
         impl_._reset();
     }
+    bool _quiescent() const {
+        return impl_._quiescent();
+    }
+    bool _timer_counting() const {
+        return impl_._timer_counting();
+    }
+    // 计数中的计时寄存器在本周期之后、减到 0 之前可以跳过的周期数
+    uint64_t _timer_span() const {
+        return detail::timer_value(get()) - 1;
+    }
+    void _timer_skip(uint64_t cycles) {
+        impl_._timer_skip(cycles);
+    }
 };
 
 template<typename T, uint32_t Size, uint32_t WRPortNum = 1>
@@ -217,215 +303,518 @@ class VulRegisterArrayFullImpl {
     static_assert(WRPortNum < 64, "WRPortNum must be less than 64");
 
 protected:
-    std::array<VulRegister<T, WRPortNum>, Size> data_;
+    // 小数组整体扫描：next_ 在每次提交后与 curr_ 保持一致，提交时整体拷贝
+    std::array<T, Size> curr_;
+    std::array<T, Size> next_;
+    std::array<T, Size> reset_values_;
+    std::array<uint32_t, Size> pending_write_ports_;
+#ifndef VULSIM_UNCHECKED
+    std::array<uint64_t, Size> issued_write_ports_{};
+#endif
+    std::array<uint8_t, Size> hold_next_{};
+    std::array<uint8_t, Size> reset_next_{};
+    bool has_control_ = false;
 
 public:
+    VulRegisterArrayFullImpl() : curr_(), next_(), reset_values_() {
+        pending_write_ports_.fill(WRPortNum);
+    }
+    VulRegisterArrayFullImpl(const T &initial_value) {
+        curr_.fill(initial_value);
+        next_.fill(initial_value);
+        reset_values_.fill(initial_value);
+        pending_write_ports_.fill(WRPortNum);
+    }
+
     template <uint32_t P = 0>
     void setnext(const uint32_t index, const T &value) {
         assert(index < Size);
-        data_[index].template setnext<P>(value);
+        static_assert(P < WRPortNum);
+        if (reset_next_[index] || hold_next_[index]) {
+            return;
+        }
+#ifndef VULSIM_UNCHECKED
+        assert((issued_write_ports_[index] & (uint64_t(1) << P)) == 0 &&
+               "VulRegisterArray::setnext() may only be called once per cycle for each register write port");
+        issued_write_ports_[index] |= uint64_t(1) << P;
+#endif
+        if (P < pending_write_ports_[index]) {
+            next_[index] = value;
+            pending_write_ports_[index] = P;
+        }
+    }
+    template <uint32_t P = 0>
+    void setnext_range(const uint32_t lo, const uint32_t hi, const T *src) {
+        assert(lo <= hi && hi <= Size);
+        for (uint32_t i = lo; i < hi; i++) {
+            setnext<P>(i, src[i - lo]);
+        }
     }
     void holdnext(const uint32_t index) {
         assert(index < Size);
-        data_[index].holdnext();
+        if (!reset_next_[index]) {
+            hold_next_[index] = 1;
+            has_control_ = true;
+        }
     }
     void holdnext() {
-        for (auto &elem : data_) {
-            elem.holdnext();
+        for (uint32_t i = 0; i < Size; i++) {
+            holdnext(i);
         }
     }
     void resetnext(const uint32_t index) {
         assert(index < Size);
-        data_[index].resetnext();
+        reset_next_[index] = 1;
+        hold_next_[index] = 0;
+        has_control_ = true;
     }
     void resetnext() {
-        for (auto &elem : data_) {
-            elem.resetnext();
-        }
+        reset_next_.fill(1);
+        hold_next_.fill(0);
+        has_control_ = true;
     }
     void apply_next_tick() {
-        for (auto &elem : data_) {
-            elem.apply_next_tick();
+        if (has_control_) {
+            for (uint32_t i = 0; i < Size; i++) {
+                if (reset_next_[i]) {
+                    next_[i] = reset_values_[i];
+                } else if (hold_next_[i]) {
+                    next_[i] = curr_[i];
+                }
+            }
+            hold_next_.fill(0);
+            reset_next_.fill(0);
+            has_control_ = false;
         }
+        curr_ = next_;
+        pending_write_ports_.fill(WRPortNum);
+#ifndef VULSIM_UNCHECKED
+        issued_write_ports_.fill(0);
+#endif
     }
     const T& operator[](uint32_t index) const {
         assert(index < Size);
-        return data_[index].get();
+        return curr_[index];
+    }
+    std::span<const T, Size> view() const {
+        return curr_;
     }
     void _set_reset_value(const T &value) {
-        for (auto &elem : data_) {
-            elem._set_reset_value(value);
-        }
+        reset_values_.fill(value);
     }
     void _set_reset_value(const array<T, Size> &values) {
+        reset_values_ = values;
+    }
+    void _reset() {
+        curr_ = reset_values_;
+        next_ = reset_values_;
+        pending_write_ports_.fill(WRPortNum);
+#ifndef VULSIM_UNCHECKED
+        issued_write_ports_.fill(0);
+#endif
+        hold_next_.fill(0);
+        reset_next_.fill(0);
+        has_control_ = false;
+    }
+    // 寄存器数组按是否有写入判断，不比较写入值
+    bool _quiescent() const {
+        if (has_control_) {
+            return false;
+        }
         for (uint32_t i = 0; i < Size; i++) {
-            data_[i]._set_reset_value(values[i]);
+            if (pending_write_ports_[i] != WRPortNum) {
+                return false;
+            }
         }
+        return true;
     }
-    void _reset() {
-        for (auto &elem : data_) {
-            elem._reset();
+};
+
+namespace detail {
+
+// 位图辅助：Size 位的位图按 64 位字存放，最后一个字高位恒为 0
+template<uint32_t Size>
+struct BitmapWords {
+    static constexpr uint32_t Words = (Size + 63) / 64;
+    static constexpr uint64_t TailMask = (Size % 64 == 0) ? ~uint64_t(0) : ((uint64_t(1) << (Size % 64)) - 1);
+
+    static void fill(std::array<uint64_t, Words> &bits) {
+        bits.fill(~uint64_t(0));
+        bits[Words - 1] = TailMask;
+    }
+
+    // 对区间 [lo, hi) 内的每个字调用 fn(word_index, mask)
+    template<typename Fn>
+    static void for_each_range_word(uint32_t lo, uint32_t hi, Fn &&fn) {
+        while (lo < hi) {
+            const uint32_t word = lo >> 6;
+            const uint32_t end = std::min(hi, (word + 1) << 6);
+            const uint32_t width = end - lo;
+            const uint64_t mask = (width == 64 ? ~uint64_t(0) : ((uint64_t(1) << width) - 1)) << (lo & 63);
+            fn(word, mask);
+            lo = end;
         }
     }
 };
 
+} // namespace detail
+
 template<typename T, uint32_t Size, uint32_t WRPortNum = 1>
-class VulRegisterArrayDirtyImpl {
+class VulRegisterArrayAdaptiveImpl {
 
     static_assert(Size >= 1, "Size must be at least 1");
     static_assert(WRPortNum >= 1, "WRPortNum must be at least 1");
     static_assert(WRPortNum < 64, "WRPortNum must be less than 64");
 
+    using Bits = detail::BitmapWords<Size>;
+    static constexpr uint32_t Words = Bits::Words;
+    static constexpr uint32_t PortSlots = (WRPortNum > 1) ? Size : 0;
+
+public:
+    // 按正在提交的这一周期的写入项数逐周期选择提交方式，不统计历史密度：
+    // 写入项数达到 Size / DenseWriteDivisor 时整体拷贝提交，否则按位图逐项提交
+    static constexpr uint32_t DenseWriteDivisor = 8;
+
 protected:
-    struct PendingSlot {
-        T value;
-        uint32_t best_prio;
-        bool has_write;
-        bool hold_next;
-        bool reset_next;
-        uint64_t issued_write_ports;
-
-        PendingSlot()
-            : value(), best_prio(WRPortNum), has_write(false), hold_next(false),
-              reset_next(false), issued_write_ports(0) {}
-    };
+    // next_ 在每次提交后与 curr_ 保持一致，因此两种提交方式可以逐周期自由切换
     std::array<T, Size> curr_;
+    std::array<T, Size> next_;
     std::array<T, Size> reset_values_;
-    std::array<PendingSlot, Size> pending_;
-
-    std::array<uint32_t, Size> dirty_indices_{};
-    uint32_t dirty_count_ = 0;
-    std::array<uint8_t, Size> dirty_flags_{};
+    std::array<uint64_t, Words> write_bits_{};
+    std::array<uint64_t, Words> hold_bits_{};
+    std::array<uint64_t, Words> reset_bits_{};
+    std::array<uint8_t, PortSlots> best_prio_{};
+#ifndef VULSIM_UNCHECKED
+    std::array<uint64_t, PortSlots> issued_write_ports_{};
+#endif
+    uint32_t write_count_ = 0;
+    bool has_control_ = false;
 
 public:
+    VulRegisterArrayAdaptiveImpl() : curr_(), next_(), reset_values_() {}
+    VulRegisterArrayAdaptiveImpl(const T &initial_value) {
+        curr_.fill(initial_value);
+        next_.fill(initial_value);
+        reset_values_.fill(initial_value);
+    }
 
-    VulRegisterArrayDirtyImpl() : curr_(), pending_() {}
-    VulRegisterArrayDirtyImpl(const T &initial_value) : curr_(), pending_() {
-        for (auto &elem : curr_) {
-            elem = initial_value;
+    template <uint32_t P = 0>
+    void setnext(const uint32_t index, const T &value) {
+        assert(index < Size);
+        static_assert(P < WRPortNum);
+        const uint32_t word = index >> 6;
+        const uint64_t bit = uint64_t(1) << (index & 63);
+        if ((hold_bits_[word] | reset_bits_[word]) & bit) {
+            return;
+        }
+        if constexpr (WRPortNum == 1) {
+            assert((write_bits_[word] & bit) == 0 &&
+                   "VulRegisterArray::setnext() may only be called once per cycle for each register write port");
+            next_[index] = value;
+            write_bits_[word] |= bit;
+            write_count_++;
+        } else {
+            if ((write_bits_[word] & bit) == 0) {
+                next_[index] = value;
+                best_prio_[index] = P;
+#ifndef VULSIM_UNCHECKED
+                issued_write_ports_[index] = uint64_t(1) << P;
+#endif
+                write_bits_[word] |= bit;
+                write_count_++;
+                return;
+            }
+#ifndef VULSIM_UNCHECKED
+            assert((issued_write_ports_[index] & (uint64_t(1) << P)) == 0 &&
+                   "VulRegisterArray::setnext() may only be called once per cycle for each register write port");
+            issued_write_ports_[index] |= uint64_t(1) << P;
+#endif
+            if (P < best_prio_[index]) {
+                next_[index] = value;
+                best_prio_[index] = P;
+            }
+        }
+    }
+    template <uint32_t P = 0>
+    void setnext_range(const uint32_t lo, const uint32_t hi, const T *src) {
+        assert(lo <= hi && hi <= Size);
+        static_assert(P < WRPortNum);
+        if constexpr (WRPortNum == 1) {
+            if (!has_control_) {
+                // 单写端口且无 hold/reset：整段拷贝并按字置位
+                std::copy(src, src + (hi - lo), next_.begin() + lo);
+                Bits::for_each_range_word(lo, hi, [this](uint32_t word, uint64_t mask) {
+                    assert((write_bits_[word] & mask) == 0 &&
+                           "VulRegisterArray::setnext() may only be called once per cycle for each register write port");
+                    write_bits_[word] |= mask;
+                });
+                write_count_ += hi - lo;
+                return;
+            }
+        }
+        for (uint32_t i = lo; i < hi; i++) {
+            setnext<P>(i, src[i - lo]);
+        }
+    }
+    void apply_next_tick() {
+        if (has_control_) {
+            for (uint32_t word = 0; word < Words; word++) {
+                uint64_t bits = hold_bits_[word] | reset_bits_[word];
+                while (bits) {
+                    const uint32_t index = (word << 6) + static_cast<uint32_t>(std::countr_zero(bits));
+                    next_[index] = (reset_bits_[word] >> (index & 63)) & 1 ? reset_values_[index] : curr_[index];
+                    curr_[index] = next_[index];
+                    bits &= bits - 1;
+                }
+            }
+            hold_bits_.fill(0);
+            reset_bits_.fill(0);
+            has_control_ = false;
+        }
+        if (write_count_ >= Size / DenseWriteDivisor) {
+            curr_ = next_;
+        } else {
+            for (uint32_t word = 0; word < Words; word++) {
+                uint64_t bits = write_bits_[word];
+                while (bits) {
+                    const uint32_t index = (word << 6) + static_cast<uint32_t>(std::countr_zero(bits));
+                    curr_[index] = next_[index];
+                    bits &= bits - 1;
+                }
+            }
         }
-        for (auto &elem : reset_values_) {
-            elem = initial_value;
+        write_bits_.fill(0);
+        write_count_ = 0;
+    }
+    const T& operator[](uint32_t index) const {
+        assert(index < Size);
+        return curr_[index];
+    }
+    std::span<const T, Size> view() const {
+        return curr_;
+    }
+    void holdnext(const uint32_t index) {
+        assert(index < Size);
+        const uint32_t word = index >> 6;
+        const uint64_t bit = uint64_t(1) << (index & 63);
+        if ((reset_bits_[word] & bit) == 0) {
+            hold_bits_[word] |= bit;
+            has_control_ = true;
         }
-        for (auto &slot : pending_) {
-            slot.value = initial_value;
+    }
+    void holdnext() {
+        for (uint32_t word = 0; word < Words; word++) {
+            hold_bits_[word] = ~reset_bits_[word];
         }
+        hold_bits_[Words - 1] &= Bits::TailMask;
+        has_control_ = true;
+    }
+    void resetnext(const uint32_t index) {
+        assert(index < Size);
+        const uint32_t word = index >> 6;
+        const uint64_t bit = uint64_t(1) << (index & 63);
+        reset_bits_[word] |= bit;
+        hold_bits_[word] &= ~bit;
+        has_control_ = true;
+    }
+    void resetnext() {
+        Bits::fill(reset_bits_);
+        hold_bits_.fill(0);
+        has_control_ = true;
+    }
+    void _set_reset_value(const T &value) {
+        reset_values_.fill(value);
+    }
+    void _set_reset_value(const array<T, Size> &values) {
+        reset_values_ = values;
+    }
+    void _reset() {
+        curr_ = reset_values_;
+        next_ = reset_values_;
+        write_bits_.fill(0);
+        hold_bits_.fill(0);
+        reset_bits_.fill(0);
+        write_count_ = 0;
+        has_control_ = false;
+    }
+    bool _quiescent() const {
+        return write_count_ == 0 && !has_control_;
+    }
+};
+
+template<typename T, uint32_t Size, uint32_t WRPortNum = 1>
+class VulRegisterArrayBitmapImpl {
+
+    static_assert(Size >= 1, "Size must be at least 1");
+    static_assert(WRPortNum >= 1, "WRPortNum must be at least 1");
+    static_assert(WRPortNum < 64, "WRPortNum must be less than 64");
+
+    using Bits = detail::BitmapWords<Size>;
+    static constexpr uint32_t Words = Bits::Words;
+    static constexpr uint32_t SummaryWords = (Words + 63) / 64;
+    // 侧表在构造时预留的项数；clear() 保留容量，之后只有单周期写入项数超过历史最大值时才会扩容
+    static constexpr uint32_t InitialPendingCapacity = Size < 4096 ? Size : 4096;
+
+protected:
+    // 待提交的写入值放在紧凑的侧表中，slot_of_ 仅在对应写位有效时有意义
+    struct PendingEntry {
+        T value;
+        uint32_t best_prio;
+#ifndef VULSIM_UNCHECKED
+        uint64_t issued_write_ports = 0;
+#endif
+    };
+    std::array<T, Size> curr_;
+    std::array<T, Size> reset_values_;
+    std::array<uint32_t, Size> slot_of_{};
+    std::vector<PendingEntry> pending_;
+    std::array<uint64_t, Words> write_bits_{};
+    std::array<uint64_t, Words> hold_bits_{};
+    std::array<uint64_t, Words> reset_bits_{};
+    // 第二级位图：标记哪些字非零，稀疏写入时提交开销与写入项数成正比
+    std::array<uint64_t, SummaryWords> summary_bits_{};
+
+public:
+    VulRegisterArrayBitmapImpl() : curr_(), reset_values_() {
+        pending_.reserve(InitialPendingCapacity);
+    }
+    VulRegisterArrayBitmapImpl(const T &initial_value) {
+        curr_.fill(initial_value);
+        reset_values_.fill(initial_value);
+        pending_.reserve(InitialPendingCapacity);
     }
 
     template <uint32_t P = 0>
     void setnext(const uint32_t index, const T &value) {
         assert(index < Size);
         static_assert(P < WRPortNum);
-        auto &slot = pending_[index];
-        if (slot.reset_next || slot.hold_next) {
+        const uint32_t word = index >> 6;
+        const uint64_t bit = uint64_t(1) << (index & 63);
+        if ((hold_bits_[word] | reset_bits_[word]) & bit) {
+            return;
+        }
+        if ((write_bits_[word] & bit) == 0) {
+            slot_of_[index] = static_cast<uint32_t>(pending_.size());
+            PendingEntry entry{value, P};
+#ifndef VULSIM_UNCHECKED
+            entry.issued_write_ports = uint64_t(1) << P;
+#endif
+            pending_.push_back(entry);
+            write_bits_[word] |= bit;
+            mark_word(word);
             return;
         }
-        assert((slot.issued_write_ports & (uint64_t(1) << P)) == 0 &&
+        auto &entry = pending_[slot_of_[index]];
+#ifndef VULSIM_UNCHECKED
+        assert((entry.issued_write_ports & (uint64_t(1) << P)) == 0 &&
                "VulRegisterArray::setnext() may only be called once per cycle for each register write port");
-        slot.issued_write_ports |= uint64_t(1) << P;
-        if (!slot.has_write || P < slot.best_prio) {
-            slot.value = value;
-            slot.best_prio = P;
-            slot.has_write = true;
-            if (dirty_flags_[index] == 0) {
-                dirty_indices_[dirty_count_++] = index;
-                dirty_flags_[index] = 1;
-            }
+        entry.issued_write_ports |= uint64_t(1) << P;
+#endif
+        if (P < entry.best_prio) {
+            entry.value = value;
+            entry.best_prio = P;
+        }
+    }
+    template <uint32_t P = 0>
+    void setnext_range(const uint32_t lo, const uint32_t hi, const T *src) {
+        assert(lo <= hi && hi <= Size);
+        for (uint32_t i = lo; i < hi; i++) {
+            setnext<P>(i, src[i - lo]);
         }
     }
     void apply_next_tick() {
-        for (uint32_t i = 0; i < dirty_count_; i++) {
-            uint32_t index = dirty_indices_[i];
-            if (pending_[index].reset_next) {
-                curr_[index] = reset_values_[index];
-                pending_[index].value = reset_values_[index];
-            } else if (pending_[index].hold_next) {
-                pending_[index].value = curr_[index];
-            } else if (pending_[index].has_write) {
-                curr_[index] = pending_[index].value;
+        for (uint32_t sword = 0; sword < SummaryWords; sword++) {
+            uint64_t words = summary_bits_[sword];
+            while (words) {
+                const uint32_t word = (sword << 6) + static_cast<uint32_t>(std::countr_zero(words));
+                uint64_t bits = write_bits_[word] | hold_bits_[word] | reset_bits_[word];
+                while (bits) {
+                    const uint32_t offset = static_cast<uint32_t>(std::countr_zero(bits));
+                    const uint32_t index = (word << 6) + offset;
+                    if ((reset_bits_[word] >> offset) & 1) {
+                        curr_[index] = reset_values_[index];
+                    } else if (((hold_bits_[word] >> offset) & 1) == 0) {
+                        curr_[index] = pending_[slot_of_[index]].value;
+                    }
+                    bits &= bits - 1;
+                }
+                write_bits_[word] = 0;
+                hold_bits_[word] = 0;
+                reset_bits_[word] = 0;
+                words &= words - 1;
             }
-            pending_[index].has_write = false;
-            pending_[index].best_prio = WRPortNum;
-            pending_[index].hold_next = false;
-            pending_[index].reset_next = false;
-            pending_[index].issued_write_ports = 0;
-            dirty_flags_[index] = 0;
+            summary_bits_[sword] = 0;
         }
-        dirty_count_ = 0;
+        pending_.clear();
     }
     const T& operator[](uint32_t index) const {
         assert(index < Size);
         return curr_[index];
     }
-    void holdnext(uint32_t index) {
+    std::span<const T, Size> view() const {
+        return curr_;
+    }
+    void holdnext(const uint32_t index) {
         assert(index < Size);
-        auto &slot = pending_[index];
-        if (slot.reset_next) {
-            return;
+        const uint32_t word = index >> 6;
+        const uint64_t bit = uint64_t(1) << (index & 63);
+        if ((reset_bits_[word] & bit) == 0) {
+            hold_bits_[word] |= bit;
+            mark_word(word);
         }
-        slot.hold_next = true;
-        slot.has_write = false;
-        slot.best_prio = WRPortNum;
-        slot.issued_write_ports = 0;
-        mark_dirty(index);
     }
     void holdnext() {
-        for (uint32_t i = 0; i < Size; i++) {
-            holdnext(i);
+        for (uint32_t word = 0; word < Words; word++) {
+            hold_bits_[word] = ~reset_bits_[word];
         }
+        hold_bits_[Words - 1] &= Bits::TailMask;
+        detail::BitmapWords<Words>::fill(summary_bits_);
     }
-    void resetnext(uint32_t index) {
+    void resetnext(const uint32_t index) {
         assert(index < Size);
-        auto &slot = pending_[index];
-        slot.reset_next = true;
-        slot.hold_next = false;
-        slot.has_write = false;
-        slot.best_prio = WRPortNum;
-        slot.issued_write_ports = 0;
-        mark_dirty(index);
+        const uint32_t word = index >> 6;
+        const uint64_t bit = uint64_t(1) << (index & 63);
+        reset_bits_[word] |= bit;
+        hold_bits_[word] &= ~bit;
+        mark_word(word);
     }
     void resetnext() {
-        for (uint32_t i = 0; i < Size; i++) {
-            resetnext(i);
-        }
+        Bits::fill(reset_bits_);
+        hold_bits_.fill(0);
+        detail::BitmapWords<Words>::fill(summary_bits_);
     }
     void _set_reset_value(const T &value) {
-        for (auto &elem : reset_values_) {
-            elem = value;
-        }
+        reset_values_.fill(value);
     }
     void _set_reset_value(const array<T, Size> &values) {
         reset_values_ = values;
     }
     void _reset() {
-        for (auto &elem : curr_) {
-            elem = T{};
-        }
         curr_ = reset_values_;
-        for (auto &slot : pending_) {
-            slot.value = T{};
-            slot.best_prio = WRPortNum;
-            slot.has_write = false;
-            slot.hold_next = false;
-            slot.reset_next = false;
-            slot.issued_write_ports = 0;
-        }
-        for (uint32_t i = 0; i < Size; i++) {
-            pending_[i].value = reset_values_[i];
+        pending_.clear();
+        write_bits_.fill(0);
+        hold_bits_.fill(0);
+        reset_bits_.fill(0);
+        summary_bits_.fill(0);
+    }
+    bool _quiescent() const {
+        for (uint32_t sword = 0; sword < SummaryWords; sword++) {
+            if (summary_bits_[sword] != 0) {
+                return false;
+            }
         }
-        dirty_count_ = 0;
-        dirty_flags_.fill(0);
+        return true;
     }
 
 private:
-    void mark_dirty(uint32_t index) {
-        if (dirty_flags_[index] == 0) {
-            dirty_indices_[dirty_count_++] = index;
-            dirty_flags_[index] = 1;
-        }
+    void mark_word(uint32_t word) {
+        summary_bits_[word >> 6] |= uint64_t(1) << (word & 63);
     }
 };
 
+// 超过该字节数的数组不再保留整份 next 副本，改用位图 + 紧凑侧表
+inline constexpr uint64_t VulRegisterArrayAdaptiveMaxBytes = uint64_t(1) << 20;
+
 template<typename T, uint32_t Size, uint32_t WRPortNum = 1>
 class VulRegisterArray {
 
@@ -435,7 +824,9 @@ class VulRegisterArray {
 
     using ImplType = std::conditional_t<(Size <= 16),
                                         VulRegisterArrayFullImpl<T, Size, WRPortNum>,
-                                        VulRegisterArrayDirtyImpl<T, Size, WRPortNum>>;
+                     std::conditional_t<(uint64_t(Size) * sizeof(T) <= VulRegisterArrayAdaptiveMaxBytes),
+                                        VulRegisterArrayAdaptiveImpl<T, Size, WRPortNum>,
+                                        VulRegisterArrayBitmapImpl<T, Size, WRPortNum>>>;
     ImplType impl_;
 
 public:
@@ -446,6 +837,14 @@ public:
     void setnext(const uint32_t index, const T &value) {
         impl_.template setnext<P>(index, value);
     }
+    template <uint32_t P = 0>
+    void setnext_all(std::span<const T, Size> src) {
+        impl_.template setnext_range<P>(0, Size, src.data());
+    }
+    template <uint32_t P = 0>
+    void setnext_range(const uint32_t lo, const uint32_t hi, const T *src) {
+        impl_.template setnext_range<P>(lo, hi, src);
+    }
     void holdnext(const uint32_t index) {
         impl_.holdnext(index);
     }
@@ -464,6 +863,9 @@ public:
     const T& operator[](uint32_t index) const {
         return impl_[index];
     }
+    std::span<const T, Size> view() const {
+        return impl_.view();
+    }
     void _set_reset_value(const T &value) {
         impl_._set_reset_value(value);
     }
@@ -473,6 +875,9 @@ public:
     void _reset() {
         impl_._reset();
     }
+    bool _quiescent() const {
+        return impl_._quiescent();
+    }
 };
 
 } // namespace vulstorage
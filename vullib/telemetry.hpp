@@ -0,0 +1,257 @@
+// MIT License
+
+// Copyright (c) 2025 Meng Chengzhen, in Shandong University
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// 运行中仿真程序的共享内存遥测页
+// 仿真线程每隔若干周期把当前周期数、速度、波形字节数和注册的统计计数写入一个 mmap 文件（默认在 /dev/shm），
+// 读者（tools/vulsimwatch）通过 seqlock 读取一致快照，写者从不等待读者。
+
+inline constexpr uint64_t VulTelemetryMagic = 0x31454c45544c5556ULL; // "VULTELE1"
+inline constexpr uint32_t VulTelemetryVersion = 1;
+inline constexpr uint32_t VulTelemetryMaxCounters = 32;
+inline constexpr uint32_t VulTelemetryNameSize = 56;
+
+enum VulTelemetryState : uint32_t {
+    VulTelemetryRunning = 1,
+    VulTelemetryFinished = 2,
+};
+
+struct VulTelemetryCounter {
+    char name[VulTelemetryNameSize];
+    uint64_t value;
+};
+
+// 页面布局保持平凡可复制，读者直接整页拷贝后校验序号
+struct VulTelemetryPage {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t state;
+    int64_t pid;
+    uint64_t seq;                 // seqlock 序号，奇数表示写入进行中
+    uint64_t cycle;
+    double cycles_per_sec;        // 最近一个更新间隔内的速度
+    double avg_cycles_per_sec;    // 自仿真开始的平均速度
+    uint64_t trace_bytes;
+    uint64_t start_unix_ms;
+    uint64_t update_unix_ms;
+    uint32_t counter_count;
+    uint32_t reserved;
+    char name[VulTelemetryNameSize];
+    VulTelemetryCounter counters[VulTelemetryMaxCounters];
+};
+
+inline uint64_t vul_telemetry_unix_ms() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+class VulTelemetryWriter {
+public:
+    VulTelemetryWriter() = default;
+    VulTelemetryWriter(const VulTelemetryWriter &) = delete;
+    VulTelemetryWriter &operator=(const VulTelemetryWriter &) = delete;
+
+    ~VulTelemetryWriter() {
+        if (page_ != nullptr) {
+            munmap(page_, sizeof(VulTelemetryPage));
+        }
+    }
+
+    bool open(const std::string &path, const std::string &name) {
+        const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        if (ftruncate(fd, sizeof(VulTelemetryPage)) != 0) {
+            ::close(fd);
+            return false;
+        }
+        void *mem = mmap(nullptr, sizeof(VulTelemetryPage), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED) {
+            return false;
+        }
+        page_ = static_cast<VulTelemetryPage *>(mem);
+        path_ = path;
+        start_time_ = last_time_ = std::chrono::steady_clock::now();
+        last_cycle_ = 0;
+
+        std::memset(page_, 0, sizeof(VulTelemetryPage));
+        page_->version = VulTelemetryVersion;
+        page_->state = VulTelemetryRunning;
+        page_->pid = static_cast<int64_t>(getpid());
+        page_->start_unix_ms = page_->update_unix_ms = vul_telemetry_unix_ms();
+        std::strncpy(page_->name, name.c_str(), VulTelemetryNameSize - 1);
+        // magic 最后写入，读者据此判断页面已初始化
+        std::atomic_ref<uint64_t>(page_->magic).store(VulTelemetryMagic, std::memory_order_release);
+        return true;
+    }
+
+    bool is_open() const {
+        return page_ != nullptr;
+    }
+
+    const std::string &path() const {
+        return path_;
+    }
+
+    uint64_t last_cycle() const {
+        return last_cycle_;
+    }
+
+    // 注册一个统计计数，value 指向的变量在每次更新时被采样；超出容量时返回 false
+    bool register_counter(const std::string &name, const uint64_t *value) {
+        if (counters_.size() >= VulTelemetryMaxCounters) {
+            return false;
+        }
+        counters_.push_back(CounterSource{name, value});
+        return true;
+    }
+
+    // sample_counters 为 false 时保留上一次采样值，用于计数变量可能已失效的收尾更新
+    void update(uint64_t cycle, uint64_t trace_bytes, VulTelemetryState state = VulTelemetryRunning, bool sample_counters = true) {
+        if (page_ == nullptr) {
+            return;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        const double interval = std::chrono::duration<double>(now - last_time_).count();
+        const double elapsed = std::chrono::duration<double>(now - start_time_).count();
+
+        std::atomic_ref<uint64_t> seq(page_->seq);
+        const uint64_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        page_->state = state;
+        page_->cycle = cycle;
+        if (interval > 0 && cycle > last_cycle_) {
+            page_->cycles_per_sec = static_cast<double>(cycle - last_cycle_) / interval;
+        }
+        if (elapsed > 0) {
+            page_->avg_cycles_per_sec = static_cast<double>(cycle) / elapsed;
+        }
+        page_->trace_bytes = trace_bytes;
+        page_->update_unix_ms = vul_telemetry_unix_ms();
+        if (sample_counters) {
+            page_->counter_count = static_cast<uint32_t>(counters_.size());
+            for (uint32_t i = 0; i < counters_.size(); i++) {
+                auto &slot = page_->counters[i];
+                if (slot.name[0] == '\0') {
+                    std::strncpy(slot.name, counters_[i].name.c_str(), VulTelemetryNameSize - 1);
+                }
+                slot.value = *counters_[i].value;
+            }
+        }
+
+        seq.store(s + 2, std::memory_order_release);
+        last_cycle_ = cycle;
+        last_time_ = now;
+    }
+
+private:
+    struct CounterSource {
+        std::string name;
+        const uint64_t *value;
+    };
+
+    VulTelemetryPage *page_ = nullptr;
+    std::string path_;
+    std::vector<CounterSource> counters_;
+    std::chrono::steady_clock::time_point start_time_;
+    std::chrono::steady_clock::time_point last_time_;
+    uint64_t last_cycle_ = 0;
+};
+
+// 只读映射遥测页，read() 返回一致快照；写者正在更新时自旋重试
+class VulTelemetryReader {
+public:
+    VulTelemetryReader() = default;
+    VulTelemetryReader(const VulTelemetryReader &) = delete;
+    VulTelemetryReader &operator=(const VulTelemetryReader &) = delete;
+
+    VulTelemetryReader(VulTelemetryReader &&other) noexcept : page_(other.page_) {
+        other.page_ = nullptr;
+    }
+
+    ~VulTelemetryReader() {
+        if (page_ != nullptr) {
+            munmap(const_cast<VulTelemetryPage *>(page_), sizeof(VulTelemetryPage));
+        }
+    }
+
+    bool open(const std::string &path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        const off_t size = lseek(fd, 0, SEEK_END);
+        if (size < static_cast<off_t>(sizeof(VulTelemetryPage))) {
+            ::close(fd);
+            return false;
+        }
+        void *mem = mmap(nullptr, sizeof(VulTelemetryPage), PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (mem == MAP_FAILED) {
+            return false;
+        }
+        page_ = static_cast<const VulTelemetryPage *>(mem);
+        return true;
+    }
+
+    bool read(VulTelemetryPage &out, uint32_t max_retries = 1000) const {
+        if (page_ == nullptr) {
+            return false;
+        }
+        auto &page = const_cast<VulTelemetryPage &>(*page_);
+        if (std::atomic_ref<uint64_t>(page.magic).load(std::memory_order_acquire) != VulTelemetryMagic) {
+            return false;
+        }
+        std::atomic_ref<uint64_t> seq(page.seq);
+        for (uint32_t i = 0; i < max_retries; i++) {
+            const uint64_t s1 = seq.load(std::memory_order_acquire);
+            if (s1 & 1) {
+                continue;
+            }
+            std::memcpy(&out, page_, sizeof(VulTelemetryPage));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == s1) {
+                return out.version == VulTelemetryVersion;
+            }
+        }
+        return false;
+    }
+
+private:
+    const VulTelemetryPage *page_ = nullptr;
+};
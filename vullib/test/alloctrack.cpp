@@ -0,0 +1,96 @@
+#define VULSIM_ALLOC_TRACK
+#include "alloctrack.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+
+constexpr uint32_t RegularSlots = vulalloc::ScopeTableSize - 1;
+constexpr uint32_t FillScopes = RegularSlots + 64;
+
+// 作为作用域名使用的地址，按 8 字节对齐，保证相邻名字落在相邻的哈希位置
+alignas(8) char scope_names[(2 * vulalloc::ScopeTableSize + FillScopes) * 8] = {};
+
+uint32_t home_slot(const char *scope) {
+    return static_cast<uint32_t>((reinterpret_cast<uintptr_t>(scope) >> 3) % vulalloc::ScopeTableSize);
+}
+
+void alloc_in(const char *scope, size_t bytes) {
+    VUL_ALLOC_SCOPE(scope);
+    vulalloc::record(bytes);
+}
+
+const vulalloc::ScopeStat &stat_of(const char *scope) {
+    for (const auto &stat : vulalloc::scope_table) {
+        if (stat.scope == scope) {
+            return stat;
+        }
+    }
+    assert(false && "scope not found");
+    return vulalloc::scope_table[0];
+}
+
+void test_collision_and_overflow() {
+    vulalloc::warmup_cycles = 0;
+    VUL_ALLOC_CYCLE(0);
+    assert(vulalloc::steady);
+
+    // 两个名字哈希到同一位置，线性探测后各自占一项
+    const char *first = scope_names;
+    const char *second = scope_names + RegularSlots * 8;
+    alloc_in(first, 16);
+    alloc_in(second, 32);
+    VUL_ALLOC_CYCLE(1);
+    assert(vulalloc::find_slot(first) != vulalloc::find_slot(second));
+    assert(stat_of(first).count == 1 && stat_of(first).bytes == 16);
+    assert(stat_of(second).count == 1 && stat_of(second).bytes == 32);
+
+    // 按 ScopeTableSize 取模会直接落在溢出项上的名字
+    const char *edge = nullptr;
+    for (uint32_t i = 0; i < vulalloc::ScopeTableSize; i++) {
+        if (home_slot(scope_names + i * 8) == vulalloc::ScopeTableSize - 1) {
+            edge = scope_names + i * 8;
+            break;
+        }
+    }
+    assert(edge != nullptr && edge != first && edge != second);
+    alloc_in(edge, 8);
+    VUL_ALLOC_CYCLE(2);
+    assert(vulalloc::find_slot(edge) != vulalloc::ScopeTableSize - 1);
+
+    // 填满表：超出的名字都计入溢出项，已有名字的统计不受影响
+    const char *fill_base = scope_names + 2 * vulalloc::ScopeTableSize * 8;
+    for (uint32_t i = 0; i < FillScopes; i++) {
+        alloc_in(fill_base + i * 8, 1);
+    }
+    VUL_ALLOC_CYCLE(3);
+    const vulalloc::ScopeStat &overflow = vulalloc::scope_table[vulalloc::ScopeTableSize - 1];
+    assert(overflow.scope == vulalloc::OverflowScope);
+    assert(overflow.count == 3 + FillScopes - RegularSlots);
+    assert(stat_of(first).count == 1);
+    assert(stat_of(second).count == 1);
+    assert(stat_of(edge).count == 1 && stat_of(edge).bytes == 8);
+
+    uint64_t counted = 0;
+    for (const auto &stat : vulalloc::scope_table) {
+        counted += stat.count;
+    }
+    assert(counted == vulalloc::total_allocs);
+    assert(vulalloc::total_allocs == 3 + FillScopes);
+
+    FILE *null_out = std::fopen("/dev/null", "w");
+    assert(null_out != nullptr);
+    assert(vulalloc::report(null_out) == 3 + FillScopes);
+    std::fclose(null_out);
+}
+
+} // namespace
+
+int main() {
+    test_collision_and_overflow();
+    std::cout << "alloctrack tests passed" << std::endl;
+    return 0;
+}
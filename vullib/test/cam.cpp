@@ -0,0 +1,179 @@
+#include "cam.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+void test_basic_two_phase() {
+    VulCAM<uint32_t, uint32_t, 8> cam;
+    assert(cam.find(5) == 8);
+    assert(cam.findfree() == 0);
+    cam.writenext(3, 5, 50);
+    // 写入在提交前不可见
+    assert(!cam.contains(5));
+    cam.apply_next_tick();
+    assert(cam.find(5) == 3);
+    assert(cam.value(3) == 50);
+    assert(cam.size() == 1);
+    assert(cam.findfree() == 0);
+
+    // 覆盖同一表项时旧 key 失效
+    cam.writenext(3, 6, 60);
+    cam.apply_next_tick();
+    assert(!cam.contains(5));
+    assert(cam.find(6) == 3);
+    assert(cam.size() == 1);
+
+    // 相同 key 只更新 value
+    cam.writenext(3, 6, 61);
+    cam.apply_next_tick();
+    assert(cam.value(3) == 61);
+
+    cam.invalidatenext(3);
+    cam.apply_next_tick();
+    assert(!cam.contains(6));
+    assert(!cam.valid(3));
+    assert(cam.size() == 0);
+}
+
+void test_duplicate_keys_and_clear() {
+    VulCAM<uint32_t, uint32_t, 4, 2> cam;
+    cam.writenext<0>(2, 9, 1);
+    cam.writenext<1>(1, 9, 2);
+    cam.apply_next_tick();
+    // 多个表项 key 相同时返回最小下标
+    assert(cam.find(9) == 1);
+    cam.invalidatenext<0>(1);
+    cam.apply_next_tick();
+    assert(cam.find(9) == 2);
+
+    cam.writenext<0>(0, 7, 3);
+    cam.clrnext();
+    assert(!cam._quiescent());
+    cam.apply_next_tick();
+    assert(cam._quiescent());
+    assert(cam.size() == 0);
+    assert(!cam.contains(7));
+    assert(!cam.contains(9));
+}
+
+void test_findfree_wide() {
+    VulCAM<uint32_t, uint32_t, 130> cam;
+    for (uint32_t i = 0; i < 130; ++i) {
+        assert(cam.findfree() == i);
+        cam.writenext(i, i * 3, i);
+        cam.apply_next_tick();
+    }
+    assert(cam.findfree() == 130);
+    cam.invalidatenext(77);
+    cam.apply_next_tick();
+    assert(cam.findfree() == 77);
+}
+
+void test_int_keys() {
+    VulCAM<Int<40>, uint32_t, 16> cam;
+    cam.writenext(4, Int<40>(0x123456789ull), 1);
+    cam.apply_next_tick();
+    assert(cam.find(Int<40>(0x123456789ull)) == 4);
+    assert(cam.find(Int<40>(0x123456788ull)) == 16);
+}
+
+// 与逐项比较的参考模型对照随机写入、失效与清空
+void test_against_linear_scan() {
+    constexpr uint32_t Entries = 48;
+    VulCAM<uint16_t, uint32_t, Entries, 3> cam;
+    std::vector<bool> ref_valid(Entries, false);
+    std::vector<uint16_t> ref_key(Entries, 0);
+    std::vector<uint32_t> ref_value(Entries, 0);
+    uint32_t seed = 7;
+    auto rnd = [&]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+    for (uint32_t cycle = 0; cycle < 20000; ++cycle) {
+        for (uint32_t q = 0; q < 4; ++q) {
+            const uint16_t key = static_cast<uint16_t>(rnd() % 64);
+            uint32_t expect = Entries;
+            for (uint32_t i = 0; i < Entries; ++i) {
+                if (ref_valid[i] && ref_key[i] == key) {
+                    expect = i;
+                    break;
+                }
+            }
+            assert(cam.find(key) == expect);
+            if (expect != Entries) {
+                assert(cam.value(expect) == ref_value[expect]);
+            }
+        }
+        uint32_t expect_free = Entries;
+        for (uint32_t i = 0; i < Entries; ++i) {
+            if (!ref_valid[i]) {
+                expect_free = i;
+                break;
+            }
+        }
+        assert(cam.findfree() == expect_free);
+
+        std::vector<uint32_t> used;
+        auto pick_idx = [&]() {
+            while (true) {
+                const uint32_t idx = rnd() % Entries;
+                bool dup = false;
+                for (uint32_t u : used) dup = dup || u == idx;
+                if (!dup) {
+                    used.push_back(idx);
+                    return idx;
+                }
+            }
+        };
+        struct Op { int kind; uint32_t idx; uint16_t key; uint32_t value; };
+        std::vector<Op> ops;
+        for (uint32_t p = 0; p < 3; ++p) {
+            const uint32_t r = rnd() % 4;
+            Op op{0, 0, 0, 0};
+            if (r == 1 || r == 2) {
+                op = {1, pick_idx(), static_cast<uint16_t>(rnd() % 64), rnd()};
+            } else if (r == 3) {
+                op = {2, pick_idx(), 0, 0};
+            }
+            ops.push_back(op);
+        }
+        if (ops[0].kind == 1) cam.writenext<0>(ops[0].idx, ops[0].key, ops[0].value);
+        if (ops[0].kind == 2) cam.invalidatenext<0>(ops[0].idx);
+        if (ops[1].kind == 1) cam.writenext<1>(ops[1].idx, ops[1].key, ops[1].value);
+        if (ops[1].kind == 2) cam.invalidatenext<1>(ops[1].idx);
+        if (ops[2].kind == 1) cam.writenext<2>(ops[2].idx, ops[2].key, ops[2].value);
+        if (ops[2].kind == 2) cam.invalidatenext<2>(ops[2].idx);
+        const bool clr = rnd() % 500 == 0;
+        if (clr) {
+            cam.clrnext();
+            std::fill(ref_valid.begin(), ref_valid.end(), false);
+        } else {
+            for (const auto &op : ops) {
+                if (op.kind == 1) {
+                    ref_valid[op.idx] = true;
+                    ref_key[op.idx] = op.key;
+                    ref_value[op.idx] = op.value;
+                } else if (op.kind == 2) {
+                    ref_valid[op.idx] = false;
+                }
+            }
+        }
+        cam.apply_next_tick();
+    }
+}
+
+} // namespace
+
+int main() {
+    test_basic_two_phase();
+    test_duplicate_keys_and_clear();
+    test_findfree_wide();
+    test_int_keys();
+    test_against_linear_scan();
+    std::cout << "cam tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "cosim.hpp"
+
+#include <cassert>
+#include <iostream>
+
+namespace {
+
+void emit(VulCosimChecker &checker, VulCosimSide side, uint32_t port, uint32_t index, uint64_t value) {
+    checker.begin_event(side, port, index);
+    checker.word(side, value);
+    checker.end_event(side);
+}
+
+void test_match_with_reordered_events() {
+    VulCosimChecker checker;
+    checker.configure(4, {"request:a", "service:b"});
+    for (uint64_t cycle = 1; cycle <= 10; ++cycle) {
+        emit(checker, VulCosimRef, 0, 0, cycle);
+        emit(checker, VulCosimRef, 1, 0, cycle * 3);
+        // 同一周期内的事件顺序不影响结果
+        emit(checker, VulCosimDut, 1, 0, cycle * 3);
+        emit(checker, VulCosimDut, 0, 0, cycle);
+        assert(checker.end_cycle(cycle));
+    }
+    assert(checker.finish(10));
+    assert(!checker.failed());
+}
+
+void test_first_divergent_cycle() {
+    VulCosimChecker checker;
+    checker.configure(16, {"query:state"});
+    bool ok = true;
+    uint64_t cycle = 0;
+    while (ok && cycle < 64) {
+        ++cycle;
+        emit(checker, VulCosimRef, 0, 0, cycle);
+        emit(checker, VulCosimDut, 0, 0, cycle == 21 ? 0 : cycle);
+        ok = checker.end_cycle(cycle);
+    }
+    // 第二个检查窗口 (16, 32] 内发现差异，二分到第 21 个周期
+    assert(!ok);
+    assert(cycle == 32);
+    assert(checker.mismatch_cycle() == 21);
+    assert(!checker.finish(cycle));
+}
+
+void test_missing_event_and_tail_window() {
+    VulCosimChecker checker;
+    checker.configure(100, {"service:out"});
+    for (uint64_t cycle = 1; cycle <= 7; ++cycle) {
+        emit(checker, VulCosimRef, 0, 1, 42);
+        if (cycle != 5) {
+            emit(checker, VulCosimDut, 0, 1, 42);
+        }
+        assert(checker.end_cycle(cycle));
+    }
+    // 不满一个间隔的周期在结束时检查
+    assert(!checker.finish(7));
+    assert(checker.mismatch_cycle() == 5);
+}
+
+void test_index_is_part_of_event() {
+    VulCosimChecker checker;
+    checker.configure(1, {"request:a"});
+    emit(checker, VulCosimRef, 0, 0, 7);
+    emit(checker, VulCosimDut, 0, 1, 7);
+    assert(!checker.end_cycle(1));
+    assert(checker.mismatch_cycle() == 1);
+}
+
+} // namespace
+
+int main() {
+    test_match_with_reordered_events();
+    test_first_divergent_cycle();
+    test_missing_event_and_tail_window();
+    test_index_is_part_of_event();
+
+    std::cout << "VulCosimChecker tests passed!" << std::endl;
+    return 0;
+}
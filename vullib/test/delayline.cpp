@@ -0,0 +1,126 @@
+#include "delayline.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+void test_latency_one() {
+    VulDelayLine<int, 1> d;
+    assert(!d.outvalid());
+    d.pushnext(5);
+    assert(!d.outvalid());
+    d.apply_next_tick();
+    assert(d.outvalid());
+    assert(d.out() == 5);
+    d.apply_next_tick();
+    assert(!d.outvalid());
+}
+
+void test_fixed_latency() {
+    VulDelayLine<uint32_t, 4> d;
+    // 每个周期压入周期号，第 t 个周期输出第 t - 4 个周期压入的值
+    for (uint32_t t = 0; t < 32; ++t) {
+        if (t < 4) {
+            assert(!d.outvalid());
+        } else {
+            assert(d.outvalid());
+            assert(d.out() == t - 4);
+        }
+        d.pushnext(t);
+        d.apply_next_tick();
+    }
+}
+
+void test_gaps_and_quiescent() {
+    VulDelayLine<uint32_t, 3> d;
+    assert(d._quiescent());
+    d.pushnext(7);
+    assert(!d._quiescent());
+    d.apply_next_tick();
+    assert(!d._quiescent());
+    d.apply_next_tick();
+    assert(!d.outvalid());
+    d.apply_next_tick();
+    assert(d.outvalid() && d.out() == 7);
+    assert(!d._quiescent());
+    d.apply_next_tick();
+    assert(!d.outvalid());
+    assert(d._quiescent());
+}
+
+void test_clear() {
+    VulDelayLine<uint32_t, 5> d;
+    for (uint32_t t = 0; t < 3; ++t) {
+        d.pushnext(t + 1);
+        d.apply_next_tick();
+    }
+    // 清空优先于同周期的压入
+    d.pushnext(100);
+    d.clrnext();
+    d.apply_next_tick();
+    assert(d._quiescent());
+    d.pushnext(200);
+    d.apply_next_tick();
+    for (uint32_t t = 0; t < 4; ++t) {
+        assert(!d.outvalid());
+        d.apply_next_tick();
+    }
+    assert(d.outvalid() && d.out() == 200);
+    d.apply_next_tick();
+    assert(!d.outvalid());
+}
+
+void test_mp_against_reference() {
+    constexpr uint32_t Latency = 7;
+    constexpr uint32_t Width = 3;
+    VulDelayLineMP<uint32_t, Latency, Width> d;
+    std::deque<std::vector<uint32_t>> ref(Latency);
+    uint32_t seed = 1;
+    uint32_t next_value = 0;
+    for (uint32_t t = 0; t < 2000; ++t) {
+        const std::vector<uint32_t> &expect = ref.front();
+        assert(d.outvalid() == expect.size());
+        for (uint32_t i = 0; i < expect.size(); ++i) {
+            assert(d.out()[i] == expect[i]);
+        }
+        ref.pop_front();
+
+        seed = seed * 1103515245u + 12345u;
+        const uint32_t num = (seed >> 16) % (Width + 1);
+        const bool clr = ((seed >> 8) & 63) == 0;
+        std::array<uint32_t, Width> values{};
+        std::vector<uint32_t> pushed;
+        for (uint32_t i = 0; i < num; ++i) {
+            values[i] = next_value++;
+            pushed.push_back(values[i]);
+        }
+        if (num > 0) {
+            d.pushnext(values, num);
+        }
+        if (clr) {
+            d.clrnext();
+            for (auto &entry : ref) {
+                entry.clear();
+            }
+            pushed.clear();
+        }
+        ref.push_back(pushed);
+        d.apply_next_tick();
+    }
+}
+
+} // namespace
+
+int main() {
+    test_latency_one();
+    test_fixed_latency();
+    test_gaps_and_quiescent();
+    test_clear();
+    test_mp_against_reference();
+    std::cout << "delayline tests passed" << std::endl;
+    return 0;
+}
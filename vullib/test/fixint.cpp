@@ -120,6 +120,18 @@ concept HasFixintGe = requires(const L& lhs, const R& rhs) {
     lhs >= rhs;
 };
 
+// 随机化测试共用的 xorshift64 序列
+struct XorShift64 {
+    uint64_t state;
+
+    uint64_t next() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
 void test_static_at() {
     Int<8> a = 0b11010110;
 
@@ -1317,6 +1329,253 @@ void test_concat_ops() {
     static_assert(!HasFixintCat<int, Int<8>>);
 }
 
+template <uint32_t W>
+void check_bitscan_against_reference(const Int<W>& value, uint32_t from) {
+    uint32_t pop = 0;
+    uint32_t lowest = W;
+    uint32_t highest = W;
+    for (uint32_t i = 0; i < W; ++i) {
+        if (value.pick(i)) {
+            pop++;
+            if (lowest == W) {
+                lowest = i;
+            }
+            highest = i;
+        }
+    }
+    assert(PopCount(value) == pop);
+    assert(CountTrailingZeros(value) == lowest);
+    assert(CountLeadingZeros(value) == (highest == W ? W : W - 1 - highest));
+
+    uint32_t rr = W;
+    for (uint32_t k = 0; k < W && rr == W; ++k) {
+        const uint32_t i = (from < W) ? (from + k) % W : k;
+        if (value.pick(i)) {
+            rr = i;
+        }
+    }
+    assert(FindFirstSet(value, from) == rr);
+
+    Int<W> prefix = 0;
+    Int<W> suffix = 0;
+    for (uint32_t i = 0; i < W; ++i) {
+        prefix.pick(i) = lowest != W && i >= lowest;
+        suffix.pick(i) = highest != W && i <= highest;
+    }
+    expect_eq(PrefixOr(value), prefix);
+    expect_eq(SuffixOr(value), suffix);
+    expect_eq(LowestSet(value), lowest == W ? Int<W>(0) : OneHot<W>(lowest));
+    expect_eq(HighestSet(value), highest == W ? Int<W>(0) : OneHot<W>(highest));
+}
+
+void test_bitscan_ops() {
+    Int<8> a = 0b01011000;
+    assert(PopCount(a) == 3);
+    assert(CountTrailingZeros(a) == 3);
+    assert(CountLeadingZeros(a) == 1);
+    assert(FindFirstSet(a, 0) == 3);
+    assert(FindFirstSet(a, 4) == 4);
+    assert(FindFirstSet(a, 5) == 6);
+    assert(FindFirstSet(a, 7) == 3);
+    assert(FindFirstSet(a, 100) == 3);
+    expect_eq(PrefixOr(a), Int<8>(0b11111000));
+    expect_eq(SuffixOr(a), Int<8>(0b01111111));
+    expect_eq(LowestSet(a), Int<8>(0b00001000));
+    expect_eq(HighestSet(a), Int<8>(0b01000000));
+
+    Int<8> zero = 0;
+    assert(PopCount(zero) == 0);
+    assert(CountTrailingZeros(zero) == 8);
+    assert(CountLeadingZeros(zero) == 8);
+    assert(FindFirstSet(zero, 3) == 8);
+    expect_eq(PrefixOr(zero), zero);
+    expect_eq(SuffixOr(zero), zero);
+    expect_eq(LowestSet(zero), zero);
+    expect_eq(HighestSet(zero), zero);
+
+    expect_eq(OneHot<8>(5), Int<8>(0x20));
+    expect_eq(OneHot<8>(8), Int<8>(0));
+    assert(OneHotIndex(Int<8>(0x20)) == 5);
+    assert(OneHotIndex(Int<8>(0)) == 0);
+
+    Int<8> slices = 0b10110000;
+    assert(PopCount(slices.at<7, 4>()) == 3);
+    assert(CountTrailingZeros(std::as_const(slices).at<7, 4>()) == 0);
+    assert(CountLeadingZeros(slices.at<3, 0>()) == 4);
+    assert(PopCount(slices.at<7>()) == 1);
+
+    Int<130> wide = 0;
+    wide.at<64>() = true;
+    wide.at<129>() = true;
+    assert(PopCount(wide) == 2);
+    assert(CountTrailingZeros(wide) == 64);
+    assert(CountLeadingZeros(wide) == 0);
+    assert(FindFirstSet(wide, 65) == 129);
+    assert(OneHotIndex(OneHot<130>(127)) == 127);
+
+    XorShift64 rng{0x9E3779B97F4A7C15ULL};
+    for (uint32_t iter = 0; iter < 2000; ++iter) {
+        // 稀疏与稠密的输入都要覆盖
+        const uint64_t sparse = rng.next() & rng.next() & rng.next();
+        Int<7> v7 = sparse;
+        Int<64> v64 = (iter % 2 == 0) ? sparse : rng.next();
+        Int<130> v130 = 0;
+        v130.at<63, 0>() = Int<64>(rng.next() & rng.next());
+        v130.at<127, 64>() = Int<64>(iter % 3 == 0 ? 0 : sparse);
+        v130.at<129, 128>() = Int<2>(rng.next());
+        const uint32_t from = static_cast<uint32_t>(rng.next() % 140);
+        check_bitscan_against_reference(v7, from % 9);
+        check_bitscan_against_reference(v64, from % 70);
+        check_bitscan_against_reference(v130, from);
+    }
+
+    static_assert(PopCount(Int<12>(0xF0F)) == 8);
+    static_assert(CountTrailingZeros(Int<12>(0x100)) == 8);
+    static_assert(CountLeadingZeros(Int<12>(0x100)) == 3);
+    static_assert(FindFirstSet(Int<12>(0x101), 1) == 8);
+    static_assert(OneHot<12>(3) == Int<12>(0x8));
+    static_assert(PrefixOr(Int<12>(0x010)) == Int<12>(0xFF0));
+    static_assert(SuffixOr(Int<12>(0x010)) == Int<12>(0x01F));
+}
+
+template <uint32_t W>
+void check_gather_scatter_against_reference(const Int<W>& value, const Int<W>& mask) {
+    Int<W> gathered = 0;
+    Int<W> scattered = 0;
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < W; ++i) {
+        if (mask.pick(i)) {
+            gathered.pick(pos) = value.pick(i);
+            scattered.pick(i) = value.pick(pos);
+            pos++;
+        }
+    }
+    expect_eq(BitGather(value, mask), gathered);
+    expect_eq(BitScatter(value, mask), scattered);
+    expect_eq(BitGather(BitScatter(value, mask), mask), BitGather(scattered, mask));
+    expect_eq(BitScatter(BitGather(value, mask), mask), value & mask);
+
+    std::array<bool, W> bools{};
+    for (uint32_t i = 0; i < W; ++i) {
+        bools[i] = value.pick(i);
+    }
+    expect_eq(PackBools(bools), value);
+    assert(UnpackBools(value) == bools);
+}
+
+void test_gather_scatter_ops() {
+    // 两个 3 位字段位于 [2:0] 与 [9:7]
+    Int<12> bus = 0b1011'1010'0101;
+    const Int<12> fields = 0b0011'1000'0111;
+    expect_eq(BitGather(bus, fields), Int<12>(0b111'101));
+    expect_eq(BitScatter(Int<12>(0b010'110), fields), Int<12>(0b0001'0000'0110));
+    expect_eq(BitGather(bus, Int<12>(0)), Int<12>(0));
+    expect_eq(BitGather(bus, Int<12>(0xFFF)), bus);
+    expect_eq(BitScatter(bus, Int<12>(0xFFF)), bus);
+    expect_eq(BitGather(bus.at<11, 4>(), std::as_const(bus).at<7, 0>()), Int<8>(0b1100));
+
+    std::array<bool, 10> flags{true, false, false, true, true, false, false, false, true, true};
+    expect_eq(PackBools(flags), Int<10>(0b1100011001));
+    assert(UnpackBools(Int<10>(0b1100011001)) == flags);
+
+    XorShift64 rng{0x2545F4914F6CDD1DULL};
+    for (uint32_t iter = 0; iter < 2000; ++iter) {
+        const uint64_t sparse = rng.next() & rng.next();
+        Int<8> v8 = rng.next();
+        Int<8> m8 = (iter % 2 == 0) ? sparse : rng.next();
+        Int<64> v64 = rng.next();
+        Int<64> m64 = (iter % 2 == 0) ? sparse : rng.next();
+        Int<130> v130 = 0;
+        Int<130> m130 = 0;
+        v130.at<63, 0>() = Int<64>(rng.next());
+        v130.at<127, 64>() = Int<64>(rng.next());
+        v130.at<129, 128>() = Int<2>(rng.next());
+        m130.at<63, 0>() = Int<64>(iter % 3 == 0 ? ~uint64_t(0) : rng.next());
+        m130.at<127, 64>() = Int<64>(iter % 3 == 1 ? 0 : sparse);
+        m130.at<129, 128>() = Int<2>(rng.next());
+        check_gather_scatter_against_reference(v8, m8);
+        check_gather_scatter_against_reference(v64, m64);
+        check_gather_scatter_against_reference(v130, m130);
+    }
+
+    static_assert(BitGather(Int<12>(0xA5C), Int<12>(0xF0F)) == Int<12>(0xAC));
+    static_assert(BitScatter(Int<12>(0xAC), Int<12>(0xF0F)) == Int<12>(0xA0C));
+}
+
+template <uint32_t W>
+void check_narrow_storage_against_uint64(uint64_t a_raw, uint64_t b_raw, uint32_t shift) {
+    const uint64_t mask = (W == 64) ? ~uint64_t(0) : ((uint64_t(1) << W) - 1);
+    const Int<W> a = a_raw;
+    const Int<W> b = b_raw;
+    const uint64_t a_ref = a_raw & mask;
+    const uint64_t b_ref = b_raw & mask;
+    shift %= W;
+
+    assert(a.template to<uint64_t>() == a_ref);
+    assert(Int<W>(a + b).template to<uint64_t>() == ((a_ref + b_ref) & mask));
+    assert(Int<W>(a - b).template to<uint64_t>() == ((a_ref - b_ref) & mask));
+    assert(Int<W>(a * b).template to<uint64_t>() == ((a_ref * b_ref) & mask));
+    assert(Int<W>(~a).template to<uint64_t>() == (~a_ref & mask));
+    assert(Int<W>(a ^ b).template to<uint64_t>() == (a_ref ^ b_ref));
+    assert(Int<W>(a << shift).template to<uint64_t>() == ((a_ref << shift) & mask));
+    assert(Int<W>(a >> shift).template to<uint64_t>() == (a_ref >> shift));
+    assert((a < b) == (a_ref < b_ref));
+    assert((a == b) == (a_ref == b_ref));
+
+    // 符号扩展与宽度转换
+    const int64_t a_signed = static_cast<int64_t>(a_ref << (64 - W)) >> (64 - W);
+    assert(a.template to<int64_t>() == a_signed);
+    assert(Int<64>(a.sint()).template to<int64_t>() == a_signed);
+    assert(Int<64>(a).template to<uint64_t>() == a_ref);
+
+    if constexpr (W >= 2) {
+        assert(a.pick(shift) == (((a_ref >> shift) & 1) != 0));
+        Int<W> c = a;
+        c.template at<W - 1, W / 2>() = b.template at<W - W / 2 - 1, 0>();
+        const uint64_t hi_mask = mask & ~((uint64_t(1) << (W / 2)) - 1);
+        assert(c.template to<uint64_t>() == ((a_ref & ~hi_mask) | ((b_ref << (W / 2)) & hi_mask)));
+    }
+}
+
+void test_narrow_storage() {
+#ifndef VULFIXINT_HLS
+    static_assert(sizeof(Int<1>) == 1);
+    static_assert(sizeof(Int<8>) == 1);
+    static_assert(sizeof(Int<9>) == 2);
+    static_assert(sizeof(Int<16>) == 2);
+    static_assert(sizeof(Int<17>) == 4);
+    static_assert(sizeof(Int<32>) == 4);
+    static_assert(sizeof(Int<33>) == 8);
+    static_assert(sizeof(Int<130>) == 24);
+#endif
+    static_assert(std::is_trivially_copyable_v<Int<5>>);
+    static_assert(Int<12>::NUM_WORDS == 1);
+    static_assert(Int<12>(0xABC).get_data()[0] == 0xABC);
+
+    XorShift64 rng{0xD1B54A32D192ED03ULL};
+    for (uint32_t iter = 0; iter < 2000; ++iter) {
+        const uint64_t a = rng.next();
+        const uint64_t b = (iter % 4 == 0) ? a : rng.next();
+        const uint32_t shift = static_cast<uint32_t>(rng.next() % 64);
+        check_narrow_storage_against_uint64<1>(a, b, shift);
+        check_narrow_storage_against_uint64<7>(a, b, shift);
+        check_narrow_storage_against_uint64<8>(a, b, shift);
+        check_narrow_storage_against_uint64<9>(a, b, shift);
+        check_narrow_storage_against_uint64<16>(a, b, shift);
+        check_narrow_storage_against_uint64<17>(a, b, shift);
+        check_narrow_storage_against_uint64<31>(a, b, shift);
+        check_narrow_storage_against_uint64<32>(a, b, shift);
+        check_narrow_storage_against_uint64<33>(a, b, shift);
+    }
+
+    // 窄存储与宽存储混合运算
+    const Int<5> tag = 0x1F;
+    const Int<40> wide = 0xFF'0000'0001ULL;
+    assert(Int<40>(wide + tag).template to<uint64_t>() == 0xFF'0000'0020ULL);
+    assert(Cat(tag, Int<3>(0b101)).template to<uint64_t>() == 0xFD);
+    assert(Int<5>(wide).template to<uint64_t>() == 1);
+}
+
 } // namespace
 
 int main() {
@@ -1341,6 +1600,9 @@ int main() {
     test_comparison_ops();
     test_reduce_ops();
     test_concat_ops();
+    test_bitscan_ops();
+    test_gather_scatter_ops();
+    test_narrow_storage();
 
     std::cout << "All fixint tests passed!" << std::endl;
     return 0;
@@ -0,0 +1,197 @@
+#include "process.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<std::string> trace;
+
+void log(const std::string &name, uint64_t cycle) {
+    trace.push_back(name + "@" + std::to_string(cycle));
+}
+
+VulProcess ticker(const VulProcessScheduler &sched, std::string name, int count) {
+    for (int i = 0; i < count; ++i) {
+        log(name, sched.cycle());
+        co_await vul_next_cycle();
+    }
+}
+
+void test_resume_order_and_next_cycle() {
+    trace.clear();
+    VulProcessScheduler sched;
+    sched.spawn(ticker(sched, "a", 2));
+    sched.spawn(ticker(sched, "b", 3));
+    assert(sched.size() == 2);
+    assert(sched.resume_all());
+    assert(sched.resume_all());
+    // a 在第 2 个周期从最后一次挂起恢复后结束
+    assert(sched.resume_all());
+    assert(sched.size() == 1);
+    assert(!sched.resume_all());
+    assert(sched.empty());
+    const std::vector<std::string> expect = {"a@0", "b@0", "a@1", "b@1", "b@2"};
+    assert(trace == expect);
+}
+
+VulProcess waiter(const VulProcessScheduler &sched, uint64_t cycles, uint64_t *woke) {
+    co_await vul_wait_cycles(0);
+    const uint64_t start = sched.cycle();
+    co_await vul_wait_cycles(cycles);
+    *woke = sched.cycle() - start;
+}
+
+void test_wait_cycles() {
+    VulProcessScheduler sched;
+    uint64_t woke = 0;
+    sched.spawn(waiter(sched, 5, &woke));
+    uint64_t rounds = 0;
+    while (sched.resume_all()) {
+        ++rounds;
+    }
+    assert(woke == 5);
+    assert(rounds == 5);
+}
+
+VulProcess until_flag(const VulProcessScheduler &sched, const bool &flag, uint64_t *seen) {
+    co_await vul_until([&] { return flag; });
+    *seen = sched.cycle();
+    // 条件已经成立时不挂起
+    co_await vul_until([&] { return flag; });
+    assert(*seen == sched.cycle());
+}
+
+void test_until() {
+    VulProcessScheduler sched;
+    bool flag = false;
+    uint64_t seen = ~0ULL;
+    sched.spawn(until_flag(sched, flag, &seen));
+    for (int i = 0; i < 4; ++i) {
+        assert(sched.resume_all());
+    }
+    assert(seen == ~0ULL);
+    flag = true;
+    assert(!sched.resume_all());
+    assert(seen == 4);
+}
+
+VulProcess leaf(const VulProcessScheduler &sched, int depth) {
+    log("leaf" + std::to_string(depth), sched.cycle());
+    co_await vul_next_cycle();
+    if (depth > 0) {
+        co_await leaf(sched, depth - 1);
+    }
+}
+
+VulProcess nested(const VulProcessScheduler &sched) {
+    log("enter", sched.cycle());
+    co_await leaf(sched, 2);
+    log("exit", sched.cycle());
+}
+
+void test_nested_subprocess() {
+    trace.clear();
+    VulProcessScheduler sched;
+    sched.spawn(nested(sched));
+    while (sched.resume_all()) {
+    }
+    const std::vector<std::string> expect = {"enter@0", "leaf2@0", "leaf1@1", "leaf0@2", "exit@3"};
+    assert(trace == expect);
+}
+
+VulProcess spawner(VulProcessScheduler &sched) {
+    log("parent", sched.cycle());
+    // 在本周期中加入的进程排在后面，同一次 resume_all() 中就开始执行
+    sched.spawn(ticker(sched, "child", 2));
+    co_await vul_next_cycle();
+    log("parent", sched.cycle());
+}
+
+void test_spawn_from_process() {
+    trace.clear();
+    VulProcessScheduler sched;
+    sched.spawn(spawner(sched));
+    while (sched.resume_all()) {
+    }
+    const std::vector<std::string> expect = {"parent@0", "child@0", "parent@1", "child@1"};
+    assert(trace == expect);
+}
+
+struct Alive {
+    int *count;
+    explicit Alive(int *count) : count(count) {
+        ++*count;
+    }
+    ~Alive() {
+        --*count;
+    }
+};
+
+VulProcess holder(int *count) {
+    Alive alive(count);
+    for (;;) {
+        co_await vul_next_cycle();
+    }
+}
+
+VulProcess outer_holder(int *count) {
+    Alive alive(count);
+    co_await holder(count);
+}
+
+void test_frames_destroyed() {
+    int count = 0;
+    {
+        VulProcess idle = holder(&count);
+        // 未启动的协程还没有执行函数体
+        assert(count == 0);
+    }
+    {
+        VulProcessScheduler sched;
+        sched.spawn(outer_holder(&count));
+        sched.resume_all();
+        sched.resume_all();
+        assert(count == 2);
+    }
+    // 调度器析构时销毁仍在等待的进程及其子过程
+    assert(count == 0);
+}
+
+VulProcess counter_agent(uint64_t period, uint64_t *total) {
+    for (int i = 0; i < 8; ++i) {
+        co_await vul_wait_cycles(period);
+        ++*total;
+    }
+}
+
+void test_many_agents() {
+    VulProcessScheduler sched;
+    uint64_t total = 0;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        sched.spawn(counter_agent(1 + i % 7, &total));
+    }
+    uint64_t cycles = 0;
+    while (sched.resume_all()) {
+        ++cycles;
+    }
+    assert(total == 8000);
+    assert(cycles == 8 * 7);
+}
+
+} // namespace
+
+int main() {
+    test_resume_order_and_next_cycle();
+    test_wait_cycles();
+    test_until();
+    test_nested_subprocess();
+    test_spawn_from_process();
+    test_frames_destroyed();
+    test_many_agents();
+
+    std::cout << "VulProcess tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,306 @@
+#include "fixint.hpp"
+#include "queue.hpp"
+#include "ram.hpp"
+#include "storage.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace {
+
+template <typename Reg, typename Value>
+void force_reset(Reg &reg, const Value &value) {
+    reg._set_reset_value(value);
+    reg._reset();
+}
+
+struct Pair {
+    uint32_t a;
+    uint32_t b;
+};
+
+void test_register_quiescent() {
+    VulRegister<uint32_t> reg;
+    force_reset(reg, 7u);
+    assert(reg._quiescent());
+    reg.setnext(7);
+    assert(reg._quiescent());
+    reg.apply_next_tick();
+    reg.setnext(8);
+    assert(!reg._quiescent());
+    reg.apply_next_tick();
+    reg.holdnext();
+    assert(reg._quiescent());
+    reg.apply_next_tick();
+    reg.resetnext();
+    assert(!reg._quiescent());
+    reg.apply_next_tick();
+    assert(reg.get() == 7);
+    reg.resetnext();
+    assert(reg._quiescent());
+    reg.apply_next_tick();
+
+    VulRegister<uint32_t, 3> mul;
+    force_reset(mul, 1u);
+    assert(mul._quiescent());
+    mul.setnext<2>(5);
+    assert(!mul._quiescent());
+    mul.setnext<0>(1);
+    assert(mul._quiescent());
+    mul.apply_next_tick();
+    assert(mul.get() == 1);
+
+    // 没有 operator== 的类型写入即视为活动
+    VulRegister<Pair> pair;
+    force_reset(pair, Pair{1, 2});
+    assert(pair._quiescent());
+    pair.setnext(Pair{1, 2});
+    assert(!pair._quiescent());
+    pair.apply_next_tick();
+
+    VulRegister<Int<12>> wide;
+    force_reset(wide, Int<12>(9));
+    wide.setnext(Int<12>(9));
+    assert(wide._quiescent());
+    wide.apply_next_tick();
+}
+
+template <typename Timer>
+void check_timer(Timer &timer) {
+    force_reset(timer, 10u);
+    assert(!timer._timer_counting());
+    timer.setnext(9);
+    assert(timer._timer_counting());
+    assert(timer._timer_span() == 9);
+    timer._timer_skip(4);
+    timer.apply_next_tick();
+    assert(static_cast<uint64_t>(timer.get()) == 5);
+
+    timer.setnext(6);
+    assert(!timer._timer_counting());
+    assert(!timer._quiescent());
+    timer.apply_next_tick();
+
+    force_reset(timer, 1u);
+    timer.setnext(0);
+    assert(timer._timer_counting());
+    assert(timer._timer_span() == 0);
+    timer.apply_next_tick();
+
+    // 已经为 0 时没有写入即静默，写入任何值都不是倒计数
+    assert(!timer._timer_counting());
+    assert(timer._quiescent());
+    timer.setnext(0);
+    assert(!timer._timer_counting());
+    timer.apply_next_tick();
+
+    force_reset(timer, 3u);
+    timer.setnext(2);
+    timer.holdnext();
+    assert(!timer._timer_counting());
+    assert(timer._quiescent());
+    timer.apply_next_tick();
+}
+
+void test_timer() {
+    VulRegister<uint16_t> t1;
+    check_timer(t1);
+    VulRegister<uint64_t, 2> t2;
+    check_timer(t2);
+
+    VulRegister<Int<20>> t3;
+    force_reset(t3, Int<20>(100));
+    t3.setnext(Int<20>(99));
+    assert(t3._timer_counting());
+    assert(t3._timer_span() == 99);
+    t3._timer_skip(99);
+    t3.apply_next_tick();
+    assert(t3.get().to<uint64_t>() == 0);
+}
+
+template <uint32_t Size>
+void check_array() {
+    auto holder = std::make_unique<VulRegisterArray<uint32_t, Size>>();
+    auto &arr = *holder;
+    force_reset(arr, 0u);
+    assert(arr._quiescent());
+    arr.setnext(Size - 1, 3);
+    assert(!arr._quiescent());
+    arr.apply_next_tick();
+    assert(arr._quiescent());
+    arr.holdnext(0);
+    assert(!arr._quiescent());
+    arr.apply_next_tick();
+    assert(arr._quiescent());
+    std::vector<uint32_t> values(Size);
+    arr.setnext_range(0, 0, values.data());
+    assert(arr._quiescent());
+    arr.setnext_range(0, Size, values.data());
+    assert(!arr._quiescent());
+    arr.apply_next_tick();
+    assert(arr._quiescent());
+}
+
+void test_register_array() {
+    check_array<8>();      // 整体拷贝
+    check_array<1024>();   // 自适应
+    check_array<1 << 19>(); // 位图
+}
+
+void test_queue_and_ram() {
+    VulQueue<uint32_t, 4> q;
+    assert(q._quiescent());
+    q.enqnext(1);
+    assert(!q._quiescent());
+    q.apply_next_tick();
+    assert(q._quiescent());
+    q.deqnext();
+    assert(!q._quiescent());
+    q.apply_next_tick();
+    q.clrnext();
+    assert(!q._quiescent());
+    q.apply_next_tick();
+
+    VulQueueMP<uint32_t, 8, 2, 2> mp;
+    assert(mp._quiescent());
+    mp.enqnext({1, 2}, 2);
+    assert(!mp._quiescent());
+    mp.apply_next_tick();
+    assert(mp._quiescent());
+
+    VulBRAM1RW<uint32_t, 16> ram1;
+    assert(ram1._quiescent());
+    ram1.req(Int<4>(3), 0, false);
+    assert(!ram1._quiescent());
+    ram1.apply_next_tick();
+    // 读数据有效的这个周期提交后会失效，状态仍在变化
+    assert(!ram1._quiescent());
+    ram1.apply_next_tick();
+    assert(ram1._quiescent());
+
+    VulBRAM<uint32_t, 16, 1, 1> ram;
+    assert(ram._quiescent());
+    ram.write<0>(Int<4>(2), 5);
+    assert(!ram._quiescent());
+    ram.apply_next_tick();
+    assert(ram._quiescent());
+    ram.readreq<0>(Int<4>(2));
+    ram.apply_next_tick();
+    assert(!ram._quiescent());
+    ram.apply_next_tick();
+    assert(ram._quiescent());
+}
+
+// 按生成代码的方式手写的小模块：队列中的请求依次等待 LATENCY 个周期后完成
+struct LatencyModel {
+    static constexpr uint32_t LATENCY = 1000;
+
+    VulQueue<uint32_t, 4> pending;
+    VulRegister<uint32_t> wait;
+    VulRegister<uint32_t> busy;
+    VulRegister<uint32_t> done;
+    VulRegister<uint32_t> sum;
+
+    LatencyModel() {
+        force_reset(wait, 0u);
+        force_reset(busy, 0u);
+        force_reset(done, 0u);
+        force_reset(sum, 0u);
+    }
+
+    void tick() {
+        if (wait.get() != 0) {
+            wait.setnext(wait.get() - 1);
+        } else if (busy.get() != 0) {
+            busy.setnext(0);
+            done.setnext(done.get() + 1);
+        } else if (pending.deqvalid()) {
+            sum.setnext(sum.get() + pending.front());
+            pending.deqnext();
+            wait.setnext(LATENCY);
+            busy.setnext(1);
+        }
+    }
+
+    void apply_next_tick() {
+        pending.apply_next_tick();
+        wait.apply_next_tick();
+        busy.apply_next_tick();
+        done.apply_next_tick();
+        sum.apply_next_tick();
+    }
+
+    uint64_t quiescent_span(uint64_t limit) const {
+        if (!pending._quiescent()) return 0;
+        if (wait._timer_counting()) {
+            limit = std::min(limit, wait._timer_span());
+            if (limit == 0) return 0;
+        } else if (!wait._quiescent()) {
+            return 0;
+        }
+        if (!busy._quiescent()) return 0;
+        if (!done._quiescent()) return 0;
+        if (!sum._quiescent()) return 0;
+        return limit;
+    }
+
+    void quiescent_skip(uint64_t cycles) {
+        if (wait._timer_counting()) wait._timer_skip(cycles);
+    }
+};
+
+uint64_t run(LatencyModel &model, uint64_t cycles, bool skip_idle) {
+    uint64_t skipped = 0;
+    for (uint64_t i = 0; i < cycles; ++i) {
+        if (i % 1500 == 0 && model.pending.enqready()) {
+            model.pending.enqnext(static_cast<uint32_t>(i));
+        }
+        const bool active = i % 1500 == 0;
+        model.tick();
+        if (skip_idle && !active) {
+            // 下一次入队之前的周期必须逐个执行
+            const uint64_t next_event = (i / 1500 + 1) * 1500;
+            const uint64_t span = model.quiescent_span(std::min(cycles - i - 1, next_event - i - 1));
+            if (span > 0) {
+                model.quiescent_skip(span);
+                i += span;
+                skipped += span;
+            }
+        }
+        model.apply_next_tick();
+    }
+    return skipped;
+}
+
+void test_skip_matches_cycle_by_cycle() {
+    for (uint64_t cycles : {1ull, 999ull, 1001ull, 1002ull, 20000ull, 20001ull}) {
+        LatencyModel ref;
+        LatencyModel fast;
+        assert(run(ref, cycles, false) == 0);
+        const uint64_t skipped = run(fast, cycles, true);
+        assert(ref.wait.get() == fast.wait.get());
+        assert(ref.busy.get() == fast.busy.get());
+        assert(ref.done.get() == fast.done.get());
+        assert(ref.sum.get() == fast.sum.get());
+        assert(ref.pending.deqvalid() == fast.pending.deqvalid());
+        if (cycles >= 20000) {
+            assert(skipped > cycles / 2);
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    test_register_quiescent();
+    test_timer();
+    test_register_array();
+    test_queue_and_ram();
+    test_skip_matches_cycle_by_cycle();
+    std::cout << "quiescent tests passed" << std::endl;
+    return 0;
+}
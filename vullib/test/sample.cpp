@@ -0,0 +1,89 @@
+#include "sample.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+// 按周期推进一个采样器，窗口子进程中到达 fail_cycle 时以失败结束
+void run(VulSampler &sampler, uint64_t &counter, uint64_t cycles, uint64_t fail_cycle) {
+    uint64_t next = sampler.first_event();
+    for (uint64_t cycle = 1; cycle <= cycles; cycle++) {
+        counter += 2;
+        if (sampler.in_window_process() && cycle == fail_cycle) {
+            sampler.fail_window_process();
+        }
+        if (cycle == next) {
+            next = sampler.on_event(cycle);
+        }
+    }
+    sampler.abandon_window_process();
+}
+
+void test_inline_windows() {
+    uint64_t counter = 0;
+    std::vector<VulSampleCounter> counters{{"counter", &counter}};
+    VulSampler sampler;
+    VulSampleConfig config;
+    config.period = 100;
+    config.warmup = 10;
+    config.window = 20;
+    assert(sampler.configure(config, &counters));
+    run(sampler, counter, 1000, 0);
+    assert(sampler.collect());
+    assert(sampler.windows().size() == 9);
+    for (const double rate : sampler.rates(0)) {
+        assert(rate == 2.0);
+    }
+}
+
+void test_forked_windows() {
+    uint64_t counter = 0;
+    std::vector<VulSampleCounter> counters{{"counter", &counter}};
+    VulSampler sampler;
+    VulSampleConfig config;
+    config.period = 100;
+    config.warmup = 10;
+    config.window = 20;
+    config.jobs = 2;
+    assert(sampler.configure(config, &counters));
+    // 最后一个窗口在仿真结束时未完成，计为作废而不是失败
+    run(sampler, counter, 915, 0);
+    assert(sampler.collect());
+    assert(sampler.windows().size() == 8);
+    assert(sampler.dropped_windows() == 1);
+    assert(sampler.failed_windows().empty());
+}
+
+void test_failed_window() {
+    uint64_t counter = 0;
+    std::vector<VulSampleCounter> counters{{"counter", &counter}};
+    VulSampler sampler;
+    VulSampleConfig config;
+    config.period = 100;
+    config.warmup = 10;
+    config.window = 20;
+    config.jobs = 2;
+    assert(sampler.configure(config, &counters));
+    // 第 3 个窗口（序号 2，起始周期 300）的子进程在测量中失败
+    run(sampler, counter, 1000, 325);
+    assert(!sampler.collect());
+    assert(sampler.failed_windows().size() == 1);
+    assert(sampler.failed_windows()[0] == 2);
+    assert(sampler.windows().size() == 8);
+    for (const auto &w : sampler.windows()) {
+        assert(w.index != 2);
+    }
+}
+
+} // namespace
+
+int main() {
+    test_inline_windows();
+    test_forked_windows();
+    test_failed_window();
+    std::cout << "sample tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,241 @@
+#include "sparsemem.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::string temp_path(const char *name) {
+    return std::string("/tmp/vul_sparsemem_") + std::to_string(getpid()) + "_" + name;
+}
+
+void write_file(const std::string &path, const std::vector<uint8_t> &bytes) {
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+void test_unmapped_reads_zero_without_allocation() {
+    VulSparseMemory mem;
+    assert(mem.load<uint64_t>(0x123456789000ULL) == 0);
+    assert(mem.load_le(0xfff, 8) == 0);
+    assert(mem.page_count() == 0);
+
+    mem.store_le(0x1000, 0x1122334455667788ULL, 8);
+    assert(mem.page_count() == 1);
+    assert(mem.load_le(0x1000, 8) == 0x1122334455667788ULL);
+    assert(mem.load_le(0x1000, 4) == 0x55667788ULL);
+    assert(mem.load_le(0x1002, 2) == 0x5566ULL);
+    assert(mem.load_le(0x1007, 1) == 0x11ULL);
+    assert(mem.load_le(0x1001, 3) == 0x556677ULL);
+
+    mem.clear();
+    assert(mem.page_count() == 0);
+    assert(mem.load_le(0x1000, 8) == 0);
+}
+
+// 与逐字节的平坦数组参考模型比较，覆盖跨页的非对齐访问
+void test_matches_flat_reference() {
+    constexpr uint64_t kBase = 0x80000000ULL;
+    constexpr uint64_t kSize = 5 * VulSparseMemory::PageSize;
+    std::vector<uint8_t> ref(kSize, 0);
+    VulSparseMemory mem;
+    std::mt19937_64 rng(7);
+    const uint32_t widths[] = {1, 2, 3, 4, 5, 8};
+
+    for (int i = 0; i < 200000; i++) {
+        const uint32_t width = widths[rng() % 6];
+        uint64_t offset = rng() % (kSize - 8);
+        if (rng() % 4 == 0) {
+            // 集中在页边界附近
+            offset = (rng() % 4 + 1) * VulSparseMemory::PageSize - (rng() % 8);
+        }
+        if (rng() % 2) {
+            const uint64_t value = rng();
+            mem.store_le(kBase + offset, value, width);
+            for (uint32_t b = 0; b < width; b++) {
+                ref[offset + b] = static_cast<uint8_t>(value >> (8 * b));
+            }
+        } else {
+            uint64_t expected = 0;
+            for (uint32_t b = 0; b < width; b++) {
+                expected |= static_cast<uint64_t>(ref[offset + b]) << (8 * b);
+            }
+            assert(mem.load_le(kBase + offset, width) == expected);
+        }
+    }
+
+    std::vector<uint8_t> bulk(kSize);
+    mem.read(kBase, bulk.data(), kSize);
+    assert(bulk == ref);
+
+    mem.zero(kBase + 100, 2 * VulSparseMemory::PageSize);
+    std::fill(ref.begin() + 100, ref.begin() + 100 + 2 * VulSparseMemory::PageSize, 0);
+    mem.read(kBase, bulk.data(), kSize);
+    assert(bulk == ref);
+    assert(mem.page_count() == 4);
+}
+
+void test_copy_on_write() {
+    VulSparseMemory base;
+    for (uint64_t page = 0; page < 8; page++) {
+        base.store<uint64_t>(page * VulSparseMemory::PageSize, page + 1);
+    }
+    // 先把页面放进 base 的 TLB，拷贝之后 base 自己的写入也必须触发复制
+    assert(base.load<uint64_t>(0) == 1);
+
+    VulSparseMemory inst0(base);
+    VulSparseMemory inst1 = base;
+    assert(base.private_page_count() == 0);
+    assert(inst0.load<uint64_t>(3 * VulSparseMemory::PageSize) == 4);
+
+    inst0.store<uint64_t>(0, 100);
+    inst1.store<uint64_t>(0, 200);
+    base.store<uint64_t>(0, 300);
+    assert(inst0.load<uint64_t>(0) == 100);
+    assert(inst1.load<uint64_t>(0) == 200);
+    assert(base.load<uint64_t>(0) == 300);
+    assert(inst0.private_page_count() == 1);
+    assert(inst1.private_page_count() == 1);
+    assert(inst0.load<uint64_t>(VulSparseMemory::PageSize) == 2);
+
+    {
+        VulSparseMemory tmp(inst0);
+        tmp.store<uint64_t>(8, 1);
+        assert(inst0.load<uint64_t>(8) == 0);
+    }
+    // tmp 析构后 inst0 重新独占该页，写入不再复制
+    inst0.store<uint64_t>(8, 5);
+    assert(inst0.load<uint64_t>(8) == 5);
+}
+
+void test_load_binary() {
+    std::vector<uint8_t> bytes(3 * VulSparseMemory::PageSize + 123);
+    for (size_t i = 0; i < bytes.size(); i++) {
+        bytes[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    const std::string path = temp_path("flat.bin");
+    write_file(path, bytes);
+
+    for (uint64_t base : {0x10000ULL, 0x10005ULL}) {
+        VulSparseMemory mem;
+        uint64_t size = 0;
+        assert(mem.load_binary(path, base, &size));
+        assert(size == bytes.size());
+        std::vector<uint8_t> got(bytes.size());
+        mem.read(base, got.data(), got.size());
+        assert(got == bytes);
+        // 引用文件映射的页在写入时复制，文件内容不变
+        mem.store<uint32_t>(base + VulSparseMemory::PageSize, 0xdeadbeefU);
+        assert(mem.load<uint32_t>(base + VulSparseMemory::PageSize) == 0xdeadbeefU);
+        if (base == 0x10000ULL) {
+            assert(mem.private_page_count() == 2);
+        }
+    }
+
+    std::ifstream in(path, std::ios::binary);
+    std::vector<uint8_t> reread((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    assert(reread == bytes);
+    std::remove(path.c_str());
+
+    VulSparseMemory mem;
+    assert(!mem.load_binary(temp_path("missing.bin"), 0));
+    assert(!mem.error().empty());
+}
+
+// 手工构造一个 ELF32：一个非页对齐的数据段，memsz 大于 filesz 的部分必须为 0
+void test_load_elf32() {
+    std::vector<uint8_t> file(0x200, 0);
+    Elf32_Ehdr ehdr{};
+    std::memcpy(ehdr.e_ident, ELFMAG, SELFMAG);
+    ehdr.e_ident[EI_CLASS] = ELFCLASS32;
+    ehdr.e_ident[EI_DATA] = ELFDATA2LSB;
+    ehdr.e_ident[EI_VERSION] = EV_CURRENT;
+    ehdr.e_type = ET_EXEC;
+    ehdr.e_machine = EM_RISCV;
+    ehdr.e_version = EV_CURRENT;
+    ehdr.e_entry = 0x80000010;
+    ehdr.e_phoff = sizeof(Elf32_Ehdr);
+    ehdr.e_ehsize = sizeof(Elf32_Ehdr);
+    ehdr.e_phentsize = sizeof(Elf32_Phdr);
+    ehdr.e_phnum = 2;
+    std::memcpy(file.data(), &ehdr, sizeof(ehdr));
+
+    Elf32_Phdr phdr[2]{};
+    phdr[0].p_type = PT_LOAD;
+    phdr[0].p_offset = 0x100;
+    phdr[0].p_vaddr = 0x80000ff0;
+    phdr[0].p_filesz = 0x40;
+    phdr[0].p_memsz = 0x2000;
+    phdr[1].p_type = PT_NOTE;
+    std::memcpy(file.data() + sizeof(ehdr), phdr, sizeof(phdr));
+    for (int i = 0; i < 0x40; i++) {
+        file[0x100 + i] = static_cast<uint8_t>(0xa0 + i);
+    }
+    const std::string path = temp_path("img.elf");
+    write_file(path, file);
+
+    VulSparseMemory mem;
+    mem.store<uint64_t>(0x80001100, ~0ULL); // 落在 bss 中的旧内容必须被清零
+    VulElfImage image;
+    assert(mem.load_elf(path, &image));
+    std::remove(path.c_str());
+    assert(image.entry == 0x80000010);
+    assert(image.low == 0x80000ff0);
+    assert(image.high == 0x80002ff0);
+    assert(image.segments == 1);
+    for (int i = 0; i < 0x40; i++) {
+        assert(mem.load<uint8_t>(0x80000ff0 + i) == 0xa0 + i);
+    }
+    assert(mem.load<uint64_t>(0x80001100) == 0);
+    assert(mem.load<uint32_t>(0x80000ffe) == 0xb1b0afaeU);
+    assert(mem.load<uint16_t>(0x80000ffe) == 0xafae);
+
+    write_file(path, std::vector<uint8_t>(64, 0x7f));
+    assert(!mem.load_elf(path));
+    std::remove(path.c_str());
+}
+
+// 用测试程序自身（ELF64）验证页对齐段的直接映射
+void test_load_elf64_self() {
+    VulSparseMemory mem;
+    VulElfImage image;
+    assert(mem.load_elf("/proc/self/exe", &image));
+    assert(image.segments > 0);
+
+    std::ifstream in("/proc/self/exe", std::ios::binary);
+    std::vector<uint8_t> file((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    Elf64_Ehdr ehdr;
+    std::memcpy(&ehdr, file.data(), sizeof(ehdr));
+    for (uint32_t i = 0; i < ehdr.e_phnum; i++) {
+        Elf64_Phdr phdr;
+        std::memcpy(&phdr, file.data() + ehdr.e_phoff + i * sizeof(phdr), sizeof(phdr));
+        if (phdr.p_type != PT_LOAD) {
+            continue;
+        }
+        std::vector<uint8_t> got(phdr.p_filesz);
+        mem.read(phdr.p_vaddr, got.data(), got.size());
+        assert(std::equal(got.begin(), got.end(), file.begin() + phdr.p_offset));
+        if (phdr.p_memsz > phdr.p_filesz) {
+            assert(mem.load<uint8_t>(phdr.p_vaddr + phdr.p_memsz - 1) == 0);
+        }
+    }
+    assert(mem.private_page_count() < mem.page_count());
+}
+
+} // namespace
+
+int main() {
+    test_unmapped_reads_zero_without_allocation();
+    test_matches_flat_reference();
+    test_copy_on_write();
+    test_load_binary();
+    test_load_elf32();
+    test_load_elf64_self();
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,260 @@
+#include "stimulus.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+enum class Color : uint8_t { Red = 1, Green = 7 };
+
+std::string temp_path(const char *name) {
+    return std::string("/tmp/vul_stimulus_") + std::to_string(getpid()) + "_" + name;
+}
+
+constexpr uint64_t kSignature = 0x1234abcd5678ef00ULL;
+constexpr uint64_t kPortA = VulStimulusStream::TagPortBase;
+constexpr uint64_t kPortB = VulStimulusStream::TagPortBase + 1;
+
+// 两个端口：A 为数组端口，B 为普通端口；中间穿插空周期与复位
+void record_sample(const std::string &path) {
+    VulStimulusStream out;
+    assert(out.open_record(path, kSignature, {"request a", "service b"}));
+    assert(out.recording());
+
+    Int<100> wide;
+    wide.set_data({0x0123456789abcdefULL, 0xfedcba98ULL});
+    out.event(VulStimulusStream::TagReset);
+    out.event(kPortA, 3);
+    out.put(static_cast<int32_t>(-2));
+    out.put(wide);
+    out.event(VulStimulusStream::TagResult);
+    out.put(true);
+    out.cycle();
+    out.cycle();
+    out.cycle();
+    out.event(kPortB);
+    out.put(Color::Green);
+    out.put(static_cast<uint8_t>(200));
+    out.cycle();
+    assert(out.close());
+    assert(!out.recording());
+    assert(out.cycles() == 4);
+    assert(out.events() == 4);
+}
+
+void test_roundtrip() {
+    const std::string path = temp_path("roundtrip.bin");
+    record_sample(path);
+
+    VulStimulusStream in;
+    assert(in.open_replay(path, kSignature, {"request a", "service b"}));
+    assert(in.replaying());
+    assert(in.peek() == VulStimulusStream::TagReset);
+    in.take();
+
+    assert(in.peek() == kPortA);
+    in.take();
+    assert(in.index() == 3);
+    int32_t narrow = 0;
+    in.get(narrow);
+    assert(narrow == -2);
+    Int<100> wide;
+    in.get(wide);
+    assert(wide.get_data()[0] == 0x0123456789abcdefULL);
+    assert(wide.get_data()[1] == 0xfedcba98ULL);
+    assert(in.peek() == VulStimulusStream::TagResult);
+    in.take();
+    in.check("__ret", true);
+    assert(!in.failed());
+
+    // 三个空周期合并为一个周期计数，逐个消费
+    for (int i = 0; i < 3; i++) {
+        assert(in.peek() == VulStimulusStream::TagCycles);
+        in.take_cycle();
+    }
+    assert(in.expect(kPortB, -1));
+    in.check("color", Color::Green);
+    in.check("value", static_cast<uint8_t>(200));
+    assert(!in.failed());
+    assert(in.peek() == VulStimulusStream::TagCycles);
+    in.take_cycle();
+    assert(in.peek() == VulStimulusStream::TagEnd);
+    assert(in.close());
+    assert(in.cycles() == 4);
+    std::remove(path.c_str());
+}
+
+void test_mismatch_detection() {
+    const std::string path = temp_path("mismatch.bin");
+    record_sample(path);
+
+    {
+        // 设计一侧的值不同
+        VulStimulusStream in;
+        assert(in.open_replay(path, kSignature, {"request a", "service b"}));
+        assert(in.peek() == VulStimulusStream::TagReset);
+        in.take();
+        assert(in.expect(kPortA, 3));
+        in.check("narrow", static_cast<int32_t>(-3));
+        assert(in.failed());
+        assert(!in.close());
+    }
+    {
+        // 设计在周期结束前调用了录制中没有的服务
+        VulStimulusStream in;
+        assert(in.open_replay(path, kSignature, {"request a", "service b"}));
+        in.peek();
+        in.take();
+        assert(!in.expect(kPortB, -1));
+        assert(in.failed());
+    }
+    {
+        // 数组端口的下标不同
+        VulStimulusStream in;
+        assert(in.open_replay(path, kSignature, {"request a", "service b"}));
+        in.peek();
+        in.take();
+        assert(!in.expect(kPortA, 2));
+    }
+    {
+        // 不同接口录制的流被拒绝
+        VulStimulusStream in;
+        assert(!in.open_replay(path, kSignature + 1, {}));
+        assert(!in.error().empty());
+        assert(!in.replaying());
+    }
+
+    // 截断的流在结束时报告
+    FILE *file = std::fopen(path.c_str(), "rb+");
+    assert(file != nullptr);
+    std::fseek(file, 0, SEEK_END);
+    const long size = std::ftell(file);
+    std::fclose(file);
+    assert(truncate(path.c_str(), size - 2) == 0);
+    {
+        VulStimulusStream in;
+        assert(in.open_replay(path, kSignature, {"request a", "service b"}));
+        uint64_t tag;
+        while ((tag = in.peek()) != VulStimulusStream::TagEnd) {
+            if (tag == VulStimulusStream::TagCycles) {
+                in.take_cycle();
+                continue;
+            }
+            in.take();
+            if (tag == kPortA) {
+                int32_t narrow;
+                Int<100> wide;
+                in.index();
+                in.get(narrow);
+                in.get(wide);
+            } else if (tag == VulStimulusStream::TagResult) {
+                bool ret;
+                in.get(ret);
+            } else if (tag == kPortB) {
+                Color color;
+                uint8_t value;
+                in.get(color);
+                in.get(value);
+            }
+        }
+        assert(!in.close());
+    }
+    std::remove(path.c_str());
+
+    VulStimulusStream in;
+    assert(!in.open_replay(temp_path("missing.bin"), kSignature, {}));
+}
+
+// 大数值与长的空周期序列的编码长度
+void test_compact_encoding() {
+    const std::string path = temp_path("compact.bin");
+    VulStimulusStream out;
+    assert(out.open_record(path, kSignature, {"query q"}));
+    for (int i = 0; i < 100000; i++) {
+        out.cycle();
+    }
+    out.event(kPortA);
+    out.put(~0ULL);
+    out.put(static_cast<__uint128_t>(1) << 100);
+    assert(out.close());
+
+    FILE *file = std::fopen(path.c_str(), "rb");
+    std::fseek(file, 0, SEEK_END);
+    // 16 字节头 + 周期计数 1+3 字节 + 端口 1 字节 + 全 1 的 64 位字 10 字节 + 128 位值的两个字 1+6 字节 + 结束标记 1 字节
+    assert(std::ftell(file) == 16 + 4 + 1 + 10 + 7 + 1);
+    std::fclose(file);
+
+    VulStimulusStream in;
+    assert(in.open_replay(path, kSignature, {"query q"}));
+    for (int i = 0; i < 100000; i++) {
+        assert(in.peek() == VulStimulusStream::TagCycles);
+        in.take_cycle();
+    }
+    assert(in.expect(kPortA, -1));
+    in.check("all_ones", ~0ULL);
+    in.check("wide", static_cast<__uint128_t>(1) << 100);
+    assert(!in.failed());
+    assert(in.peek() == VulStimulusStream::TagEnd);
+    assert(in.close());
+    std::remove(path.c_str());
+}
+
+// fork 出的子进程 detach() 后继承来的缓冲不会写进父进程的流
+void test_fork_detach() {
+    const std::string path = temp_path("fork.bin");
+    VulStimulusStream out;
+    assert(out.open_record(path, kSignature, {"request a", "service b"}));
+    out.event(kPortA, 1);
+    out.put(static_cast<uint8_t>(5));
+    out.cycle();
+
+    const pid_t pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        out.detach();
+        const bool ok = !out.recording() && out.close();
+        _exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    assert(waitpid(pid, &status, 0) == pid);
+    assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    out.event(kPortB);
+    out.put(static_cast<uint8_t>(9));
+    out.cycle();
+    assert(out.close());
+
+    VulStimulusStream in;
+    assert(in.open_replay(path, kSignature, {"request a", "service b"}));
+    assert(in.peek() == kPortA);
+    in.take();
+    assert(in.index() == 1);
+    uint8_t value = 0;
+    in.get(value);
+    assert(value == 5);
+    assert(in.peek() == VulStimulusStream::TagCycles);
+    in.take_cycle();
+    assert(in.expect(kPortB, -1));
+    in.check("value", static_cast<uint8_t>(9));
+    assert(in.peek() == VulStimulusStream::TagCycles);
+    in.take_cycle();
+    assert(in.peek() == VulStimulusStream::TagEnd);
+    assert(in.close());
+    std::remove(path.c_str());
+}
+
+} // namespace
+
+int main() {
+    test_roundtrip();
+    test_mismatch_detection();
+    test_compact_encoding();
+    test_fork_detach();
+
+    std::cout << "All tests passed!" << std::endl;
+    return 0;
+}
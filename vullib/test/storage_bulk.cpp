@@ -0,0 +1,234 @@
+#include "storage.hpp"
+#include "../bench/storage_dirty.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace {
+
+template <typename Reg, typename Value>
+void force_reset(Reg &reg, const Value &value) {
+    reg._set_reset_value(value);
+    reg._reset();
+}
+
+uint32_t random_below(std::mt19937 &rng, uint32_t limit) {
+    assert(limit > 0);
+    return static_cast<uint32_t>(rng() % static_cast<std::mt19937::result_type>(limit));
+}
+
+// 逐项语义的参考模型：整段写入等价于对区间内每一项调用 setnext<P>
+template <uint32_t Size, uint32_t WRPortNum>
+struct BulkOracle {
+    std::array<uint64_t, Size> curr{};
+    std::array<uint64_t, Size> next{};
+    std::array<uint64_t, Size> reset_values{};
+    std::array<uint32_t, Size> best_prio{};
+    std::array<uint8_t, Size> hold{};
+    std::array<uint8_t, Size> reset{};
+
+    BulkOracle() {
+        best_prio.fill(WRPortNum);
+    }
+
+    void force_reset(uint64_t value) {
+        curr.fill(value);
+        next.fill(value);
+        reset_values.fill(value);
+    }
+
+    void setnext(uint32_t port, uint32_t index, uint64_t value) {
+        if (hold[index] || reset[index]) {
+            return;
+        }
+        if (port < best_prio[index]) {
+            next[index] = value;
+            best_prio[index] = port;
+        }
+    }
+
+    void holdnext(uint32_t index) {
+        if (!reset[index]) {
+            hold[index] = 1;
+        }
+    }
+
+    void resetnext(uint32_t index) {
+        reset[index] = 1;
+        hold[index] = 0;
+    }
+
+    void apply_next_tick() {
+        for (uint32_t i = 0; i < Size; i++) {
+            if (reset[i]) {
+                curr[i] = reset_values[i];
+            } else if (hold[i]) {
+                // keep
+            } else if (best_prio[i] < WRPortNum) {
+                curr[i] = next[i];
+            }
+            next[i] = curr[i];
+        }
+        best_prio.fill(WRPortNum);
+        hold.fill(0);
+        reset.fill(0);
+    }
+};
+
+template <typename Impl, uint32_t Size, uint32_t WRPortNum>
+void run_bulk_script(uint32_t seed) {
+    static_assert(WRPortNum <= 2);
+    Impl impl;
+    BulkOracle<Size, WRPortNum> oracle;
+    force_reset(impl, uint64_t(7));
+    oracle.force_reset(7);
+
+    std::mt19937 rng(seed + Size * 31u + WRPortNum);
+    uint64_t seq = 100;
+
+    for (uint32_t cycle = 0; cycle < 2000; ++cycle) {
+        // 每个端口每周期对每一项至多写一次
+        std::array<std::array<uint8_t, Size>, WRPortNum> used{};
+
+        auto bulk_writes = [&]() {
+            for (uint32_t port = 0; port < WRPortNum; ++port) {
+                const uint32_t mode = random_below(rng, 4u);
+                if (mode == 0u) {
+                    continue;
+                }
+                uint32_t lo = 0;
+                uint32_t hi = Size;
+                if (mode == 2u) {
+                    lo = random_below(rng, Size);
+                    hi = lo + random_below(rng, Size - lo + 1u);
+                }
+                bool overlap = false;
+                for (uint32_t i = lo; i < hi; i++) {
+                    overlap = overlap || used[port][i];
+                }
+                if (overlap) {
+                    continue;
+                }
+                std::vector<uint64_t> src(hi - lo);
+                for (auto &value : src) {
+                    value = seq++;
+                }
+                for (uint32_t i = lo; i < hi; i++) {
+                    used[port][i] = 1;
+                    oracle.setnext(port, i, src[i - lo]);
+                }
+                if (mode == 1u && port == 0u) {
+                    std::array<uint64_t, Size> all{};
+                    std::copy(src.begin(), src.end(), all.begin());
+                    if constexpr (requires { impl.template setnext_all<0>(all); }) {
+                        impl.template setnext_all<0>(all);
+                    } else {
+                        impl.template setnext_range<0>(0, Size, all.data());
+                    }
+                } else if (port == 0u) {
+                    impl.template setnext_range<0>(lo, hi, src.data());
+                } else {
+                    impl.template setnext_range<WRPortNum - 1>(lo, hi, src.data());
+                }
+            }
+        };
+        auto single_writes = [&]() {
+            const uint32_t write_count = random_below(rng, Size / 2u + 1u);
+            for (uint32_t w = 0; w < write_count; ++w) {
+                const uint32_t port = random_below(rng, WRPortNum);
+                const uint32_t index = random_below(rng, Size);
+                if (used[port][index]) {
+                    continue;
+                }
+                used[port][index] = 1;
+                const uint64_t value = seq++;
+                oracle.setnext(port, index, value);
+                if (port == 0u) {
+                    impl.template setnext<0>(index, value);
+                } else {
+                    impl.template setnext<WRPortNum - 1>(index, value);
+                }
+            }
+        };
+        // 交替覆盖“先整段后逐项”和“先逐项后整段”两种顺序
+        if (cycle % 2u == 0u) {
+            bulk_writes();
+            single_writes();
+        } else {
+            single_writes();
+            bulk_writes();
+        }
+
+        const uint32_t controls = random_below(rng, 3u);
+        for (uint32_t c = 0; c < controls; ++c) {
+            const uint32_t index = random_below(rng, Size);
+            if (random_below(rng, 2u) == 0u) {
+                impl.holdnext(index);
+                oracle.holdnext(index);
+            } else {
+                impl.resetnext(index);
+                oracle.resetnext(index);
+            }
+        }
+
+        impl.apply_next_tick();
+        oracle.apply_next_tick();
+
+        const auto view = impl.view();
+        assert(view.size() == Size);
+        for (uint32_t i = 0; i < Size; i++) {
+            assert(impl[i] == oracle.curr[i]);
+            assert(view[i] == oracle.curr[i]);
+        }
+    }
+}
+
+void test_view_tracks_commit() {
+    VulRegisterArray<uint32_t, 40> reg_array;
+    force_reset(reg_array, 0u);
+    std::array<uint32_t, 40> values{};
+    for (uint32_t i = 0; i < 40; i++) {
+        values[i] = i * 3u;
+    }
+    reg_array.setnext_all(values);
+    assert(reg_array.view()[39] == 0u);
+    reg_array.apply_next_tick();
+    for (uint32_t i = 0; i < 40; i++) {
+        assert(reg_array.view()[i] == i * 3u);
+    }
+
+    // 移位寄存器写法：整体左移一项
+    uint32_t shifted[39];
+    std::copy(reg_array.view().begin() + 1, reg_array.view().end(), shifted);
+    reg_array.setnext_range(0, 39, shifted);
+    reg_array.apply_next_tick();
+    for (uint32_t i = 0; i < 39; i++) {
+        assert(reg_array[i] == (i + 1u) * 3u);
+    }
+    assert(reg_array[39] == 39u * 3u);
+}
+
+} // namespace
+
+int main() {
+    test_view_tracks_commit();
+    run_bulk_script<VulRegisterArray<uint64_t, 4, 1>, 4, 1>(1u);
+    run_bulk_script<VulRegisterArray<uint64_t, 16, 1>, 16, 1>(2u);
+    run_bulk_script<VulRegisterArray<uint64_t, 16, 2>, 16, 2>(3u);
+    run_bulk_script<VulRegisterArray<uint64_t, 17, 1>, 17, 1>(4u);
+    run_bulk_script<VulRegisterArray<uint64_t, 17, 2>, 17, 2>(5u);
+    run_bulk_script<VulRegisterArray<uint64_t, 96, 2>, 96, 2>(6u);
+    run_bulk_script<vulstorage::VulRegisterArrayDirtyImpl<uint64_t, 96, 2>, 96, 2>(7u);
+    run_bulk_script<vulstorage::VulRegisterArrayDirtyImpl<uint64_t, 96, 1>, 96, 1>(8u);
+    run_bulk_script<vulstorage::VulRegisterArrayAdaptiveImpl<uint64_t, 200, 1>, 200, 1>(9u);
+    run_bulk_script<vulstorage::VulRegisterArrayBitmapImpl<uint64_t, 200, 2>, 200, 2>(10u);
+    run_bulk_script<vulstorage::VulRegisterArrayBitmapImpl<uint64_t, 200, 1>, 200, 1>(11u);
+
+    std::cout << "storage bulk tests passed!" << std::endl;
+    return 0;
+}
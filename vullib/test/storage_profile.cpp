@@ -0,0 +1,84 @@
+#include "storage.hpp"
+#include "../bench/storage_dirty.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+
+// 以 checked（默认）与 unchecked（-DVULSIM_UNCHECKED）两种档位各编译一次，
+// 检查 unchecked 档位去掉了各寄存器数组实现中每周期写端口检查的状态，且写入优先级不变
+
+namespace {
+
+template <typename T, uint32_t Size, uint32_t WRPortNum>
+struct BitmapProbe : vulstorage::VulRegisterArrayBitmapImpl<T, Size, WRPortNum> {
+    static constexpr size_t entry_bytes =
+        sizeof(typename vulstorage::VulRegisterArrayBitmapImpl<T, Size, WRPortNum>::PendingEntry);
+};
+
+template <typename T, uint32_t Size, uint32_t WRPortNum>
+struct DirtyProbe : vulstorage::VulRegisterArrayDirtyImpl<T, Size, WRPortNum> {
+    static constexpr size_t slot_bytes =
+        sizeof(typename vulstorage::VulRegisterArrayDirtyImpl<T, Size, WRPortNum>::PendingSlot);
+};
+
+// 超过 VulRegisterArrayAdaptiveMaxBytes 的数组默认使用 Bitmap 实现
+constexpr uint32_t LargeSize = static_cast<uint32_t>(vulstorage::VulRegisterArrayAdaptiveMaxBytes / sizeof(uint32_t)) + 1;
+using LargeArray = VulRegisterArray<uint32_t, LargeSize, 2>;
+static_assert(sizeof(LargeArray) == sizeof(vulstorage::VulRegisterArrayBitmapImpl<uint32_t, LargeSize, 2>));
+
+#ifdef VULSIM_UNCHECKED
+static_assert(BitmapProbe<uint32_t, LargeSize, 2>::entry_bytes == 8);
+static_assert(DirtyProbe<uint32_t, 64, 2>::slot_bytes == 12);
+static_assert(sizeof(VulRegisterArray<uint32_t, 16, 2>) == 292);
+static_assert(sizeof(VulRegister<uint32_t, 2>) == 20);
+#else
+static_assert(BitmapProbe<uint32_t, LargeSize, 2>::entry_bytes == 16);
+static_assert(DirtyProbe<uint32_t, 64, 2>::slot_bytes == 24);
+static_assert(sizeof(VulRegisterArray<uint32_t, 16, 2>) == 424);
+static_assert(sizeof(VulRegister<uint32_t, 2>) == 32);
+#endif
+
+template <typename Array>
+void check_port_priority(Array &arr, uint32_t size) {
+    for (uint32_t cycle = 0; cycle < 4; cycle++) {
+        const uint32_t index = (cycle * 7919u) % size;
+        arr.template setnext<1>(index, 100 + cycle);
+        arr.template setnext<0>(index, 200 + cycle);
+        arr.template setnext<1>(size - 1 - index, 300 + cycle);
+        arr.apply_next_tick();
+        assert(arr[index] == 200 + cycle);
+        assert(arr[size - 1 - index] == 300 + cycle);
+        assert(arr._quiescent());
+    }
+}
+
+void test_large_array() {
+    auto arr = std::make_unique<LargeArray>(0u);
+    check_port_priority(*arr, LargeSize);
+}
+
+void test_dirty_impl() {
+    auto arr = std::make_unique<vulstorage::VulRegisterArrayDirtyImpl<uint32_t, 64, 2>>(0u);
+    check_port_priority(*arr, 64);
+}
+
+void test_small_array() {
+    VulRegisterArray<uint32_t, 16, 2> arr(0u);
+    check_port_priority(arr, 16);
+}
+
+} // namespace
+
+int main() {
+    test_large_array();
+    test_dirty_impl();
+    test_small_array();
+#ifdef VULSIM_UNCHECKED
+    std::cout << "storage profile tests passed (unchecked)" << std::endl;
+#else
+    std::cout << "storage profile tests passed (checked)" << std::endl;
+#endif
+    return 0;
+}
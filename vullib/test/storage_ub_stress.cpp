@@ -1,4 +1,5 @@
 #include "storage.hpp"
+#include "../bench/storage_dirty.hpp"
 
 #include <array>
 #include <cassert>
@@ -309,6 +310,26 @@ void test_array_dirty_impl_payload() {
     run_array_script<decltype(impl), Payload, 17, 4>(impl, oracle);
 }
 
+void test_array_adaptive_impl_payload() {
+    vulstorage::VulRegisterArrayAdaptiveImpl<Payload, 17, 4> impl;
+    RegisterArrayOracle<Payload, 17, 4> oracle;
+    run_array_script<decltype(impl), Payload, 17, 4>(impl, oracle);
+
+    vulstorage::VulRegisterArrayAdaptiveImpl<Payload, 130, 1> impl1;
+    RegisterArrayOracle<Payload, 130, 1> oracle1;
+    run_array_script<decltype(impl1), Payload, 130, 1>(impl1, oracle1);
+}
+
+void test_array_bitmap_impl_payload() {
+    vulstorage::VulRegisterArrayBitmapImpl<Payload, 17, 4> impl;
+    RegisterArrayOracle<Payload, 17, 4> oracle;
+    run_array_script<decltype(impl), Payload, 17, 4>(impl, oracle);
+
+    vulstorage::VulRegisterArrayBitmapImpl<Payload, 130, 1> impl1;
+    RegisterArrayOracle<Payload, 130, 1> oracle1;
+    run_array_script<decltype(impl1), Payload, 130, 1>(impl1, oracle1);
+}
+
 void test_array_wrapper_threshold_paths() {
     VulRegisterArray<Payload, 1> size1;
     RegisterArrayOracle<Payload, 1, 1> oracle1;
@@ -349,6 +370,8 @@ int main() {
     test_register_wrapper_paths();
     test_array_full_impl_payload();
     test_array_dirty_impl_payload();
+    test_array_adaptive_impl_payload();
+    test_array_bitmap_impl_payload();
     test_array_wrapper_threshold_paths();
 
     std::cout << "storage UB stress tests passed!" << std::endl;
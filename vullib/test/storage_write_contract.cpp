@@ -1,4 +1,5 @@
 #include "storage.hpp"
+#include "../bench/storage_dirty.hpp"
 
 #include <cassert>
 #include <cstdint>
@@ -122,12 +122,55 @@ void test_width_gt64_vector_record() {
     assert(content.find("b" + bits + " !\n") != std::string::npos);
 }
 
+void test_disable_and_reenable() {
+    const std::filesystem::path path = "/tmp/vulsim_vcd_enable.vcd";
+    const std::filesystem::path path2 = "/tmp/vulsim_vcd_enable_redirect.vcd";
+    std::filesystem::remove(path);
+    std::filesystem::remove(path2);
+
+    GlobalVCDRecord rec;
+    const uint32_t clk_id = rec.registe("clk", 1);
+    const uint32_t data_id = rec.registe("data", 8);
+    rec.init(path.string(), 1, 0);
+
+    rec.record(clk_id, 1);
+    rec.record(data_id, 7);
+    rec.commit(); // cycle 1
+
+    rec.set_enabled(false);
+    rec.record(clk_id, 0);
+    rec.record(data_id, 9);
+    rec.commit(); // cycle 2, 不记录
+
+    rec.set_enabled(true);
+    rec.record(clk_id, 0);
+    rec.record(data_id, 7);
+    rec.commit(); // cycle 3，data 与关闭前相同也要输出
+
+    rec.redirect(path2.string());
+    rec.record(clk_id, 0);
+    rec.record(data_id, 7);
+    rec.commit(); // cycle 4，新文件中输出完整取值
+    rec.close();
+
+    const std::string content = read_all(path);
+    assert(content.find("#1\n") != std::string::npos);
+    assert(content.find("#2\n") == std::string::npos);
+    assert(content.find("#3\n0!\nb00000111 \"\n") != std::string::npos);
+    assert(content.find("#4\n") == std::string::npos);
+
+    const std::string redirected = read_all(path2);
+    assert(redirected.find("$enddefinitions $end") != std::string::npos);
+    assert(redirected.find("#4\n0!\nb00000111 \"\n") != std::string::npos);
+}
+
 } // namespace
 
 int main() {
     test_width1_manual_close_flush();
     test_width64_auto_interval_and_close_tail_flush();
     test_width_gt64_vector_record();
+    test_disable_and_reenable();
 
     std::cout << "GlobalVCDRecord tests passed!" << std::endl;
     return 0;
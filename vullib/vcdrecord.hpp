@@ -29,6 +29,7 @@
 #include <ctime>
 #include <deque>
 #include <fstream>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -86,6 +87,17 @@ public:
         break_history_cycles_ = cycle_count;
     }
 
+    // 设置后断点菜单提供 (r)ewind 选项，参数为当前周期；处理函数成功回退时不返回
+    void set_rewind_handler(std::function<void(uint64_t)> handler) {
+        rewind_handler_ = std::move(handler);
+    }
+
+    // 从快照恢复后调用：断点历史在配置深度之外再保留 cycle_count 个周期，
+    // 使再次命中断点时可导出从快照到断点的完整波形，同时历史仍然有界
+    void extend_break_history(uint64_t cycle_count) {
+        rewind_history_cycles_ = cycle_count;
+    }
+
     void add_break_point(const std::vector<TraceBreakConditionSpec> &conditions, const std::string &expr_text) {
         ensure_state(State::Registering, "add_break_point");
         if (conditions.empty()) {
@@ -151,6 +163,9 @@ public:
 
     void record(uint32_t signal_id, uint64_t signal_value) {
         ensure_state(State::Recording, "record");
+        if (!enabled_) {
+            return;
+        }
         SignalInfo &sig = get_signal(signal_id);
         if (sig.width > 64) {
             throw std::runtime_error("Signal width > 64 requires vector<uint64_t> overload");
@@ -169,6 +184,9 @@ public:
 
     void record(uint32_t signal_id, const std::vector<uint64_t> &signal_value) {
         ensure_state(State::Recording, "record");
+        if (!enabled_) {
+            return;
+        }
         SignalInfo &sig = get_signal(signal_id);
         const uint32_t words = (sig.width + 63U) / 64U;
         if (signal_value.size() < words) {
@@ -188,6 +206,9 @@ public:
     void commit() {
         ensure_state(State::Recording, "commit");
         ++cycle_count_;
+        if (!enabled_) {
+            return;
+        }
 
         std::vector<std::optional<std::string>> snapshot_before;
         if (breakpoint_mode_) {
@@ -219,7 +240,7 @@ public:
 
         if (breakpoint_mode_) {
             history_.push_back(CycleFrame{cycle_count_, std::move(snapshot_before), cycle_changes});
-            while (history_.size() > break_history_cycles_) {
+            while (history_.size() > break_history_cycles_ + rewind_history_cycles_) {
                 history_.pop_front();
             }
             handle_breakpoints_if_hit();
@@ -228,6 +249,51 @@ public:
         }
     }
 
+    // 关闭后 record() 被忽略，commit() 只推进周期计数；重新开启后的第一次提交输出所有信号的完整取值
+    // 断点模式需要逐周期求值，不受影响
+    void set_enabled(bool enabled) {
+        if (state_ != State::Recording || breakpoint_mode_ || enabled == enabled_) {
+            return;
+        }
+        if (enabled) {
+            for (auto &sig : signals_) {
+                sig.last_bits.reset();
+            }
+        } else {
+            flush_buffer();
+            ofs_.flush();
+        }
+        enabled_ = enabled;
+    }
+
+    // 此后的波形写入新文件，文件头中初值未知，下一次提交输出所有信号的完整取值；断点模式下无效
+    void redirect(const std::string &filename) {
+        ensure_state(State::Recording, "redirect");
+        if (breakpoint_mode_) {
+            return;
+        }
+        flush_buffer();
+        ofs_.close();
+        ofs_.open(filename, std::ios::out | std::ios::trunc);
+        if (!ofs_.is_open()) {
+            throw std::runtime_error("Failed to open VCD file: " + filename);
+        }
+        trace_filename_ = filename;
+        write_header(ofs_, std::vector<std::optional<std::string>>(signals_.size(), std::nullopt));
+        for (auto &sig : signals_) {
+            sig.last_bits.reset();
+        }
+    }
+
+    const std::string &filename() const {
+        return trace_filename_;
+    }
+
+    // 已写入波形文件的数值变化字节数（不含文件头）
+    uint64_t bytes_written() const {
+        return bytes_written_;
+    }
+
     void close() {
         if (state_ == State::Closed) {
             return;
@@ -249,7 +315,9 @@ public:
         write_interval_ = 0;
         cycle_count_ = 0;
         break_history_cycles_ = 64;
+        rewind_history_cycles_ = 0;
         breakpoint_mode_ = false;
+        enabled_ = true;
         trace_filename_.clear();
         history_.clear();
         break_points_.clear();
@@ -312,6 +380,7 @@ private:
         }
         if (!buffer_.empty()) {
             ofs_ << buffer_;
+            bytes_written_ += buffer_.size();
             buffer_.clear();
         }
     }
@@ -420,7 +489,11 @@ private:
         }
 
         while (true) {
-            std::cout << "[Breakpoint] Choose action: (d)ump buffered waveform, (c)ontinue, (q)uit: ";
+            std::cout << "[Breakpoint] Choose action: (d)ump buffered waveform, ";
+            if (rewind_handler_) {
+                std::cout << "(r)ewind to snapshot, ";
+            }
+            std::cout << "(c)ontinue, (q)uit: ";
             std::string choice;
             if (!std::getline(std::cin, choice)) {
                 choice = "q";
@@ -440,6 +513,10 @@ private:
                 std::cout << "[Breakpoint] Waveform written to " << outpath << "\n";
                 continue;
             }
+            if ((ch == 'r' || ch == 'R') && rewind_handler_) {
+                rewind_handler_(cycle_count_);
+                continue;
+            }
             if (ch == 'c' || ch == 'C') {
                 suppress_currently_true_breakpoints();
                 return;
@@ -594,9 +671,13 @@ private:
     uint64_t write_interval_ = 0;
     uint64_t cycle_count_ = 0;
     uint64_t break_history_cycles_ = 64;
+    uint64_t rewind_history_cycles_ = 0;
     bool breakpoint_mode_ = false;
+    bool enabled_ = true;
     std::string trace_filename_;
     std::string buffer_;
+    uint64_t bytes_written_ = 0;
     std::deque<CycleFrame> history_;
     std::vector<BreakPoint> break_points_;
+    std::function<void(uint64_t)> rewind_handler_;
 };
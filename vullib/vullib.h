@@ -26,6 +26,13 @@
 #include "storage.hpp"
 #include "ram.hpp"
 #include "queue.hpp"
+#include "delayline.hpp"
+#include "cam.hpp"
+#include "alloctrack.hpp"
+#include "sparsemem.hpp"
+#include "stimulus.hpp"
+#include "process.hpp"
+#include "runresult.hpp"
 
 #include <string>
 #include <vector>
@@ -55,3 +62,49 @@ void trace_record(uint32_t signal_id, const std::vector<uint64_t> &signal_value)
 void trace_commit();
 
 void sim_exit();
+
+// 仿真周期上限，0 表示不限制；由 main.cpp 从环境变量 VULSIM_MAX_CYCLES 读取
+extern uint64_t sim_max_cycles;
+
+void sim_cycle_limit_reached(uint64_t cycles);
+
+// 共享内存遥测：sim_telemetry_next 为下一次更新的周期数，0 表示未开启
+extern uint64_t sim_telemetry_next;
+
+void sim_telemetry_update(uint64_t cycles);
+
+// fork 快照：sim_snapshot_next 为下一次快照的周期数，0 表示未开启
+extern uint64_t sim_snapshot_next;
+
+void sim_snapshot_take(uint64_t cycles);
+
+// 采样仿真：sim_sample_next 为下一个采样事件的周期数，0 表示未开启
+extern uint64_t sim_sample_next;
+
+void sim_sample_event(uint64_t cycles);
+
+// 当前周期是否处于测量窗口 / 预热或测量窗口内；未开启采样时始终为 true
+bool sim_sample_measuring();
+
+bool sim_sample_detailed();
+
+void sim_register_counter(const std::string &name, const uint64_t *value);
+
+// 与 Verilator 模型锁步联合仿真：以 -DVULSIM_COSIM 构建时展开为对影子模型 vul_cosim 的调用，否则为空
+#ifdef VULSIM_COSIM
+#define VUL_COSIM(...) __VA_ARGS__
+#else
+#define VUL_COSIM(...) ((void)0)
+#endif
+
+// 联合仿真发现不一致时由影子模型调用，不返回
+[[noreturn]] void sim_cosim_failed(uint64_t cycles);
+
+// 激励录制与回放：由 main.cpp 根据环境变量 VULSIM_RECORD / VULSIM_REPLAY 打开，见 stimulus.hpp
+extern VulStimulusStream vul_stimulus;
+
+// 实例边界捕获：由 main.cpp 根据环境变量 VULSIM_CAPTURE 打开，只在 vulsimgen --capture 选中的实例中写入
+extern VulStimulusStream vul_capture;
+
+// 回放发现不一致时调用，不返回
+[[noreturn]] void sim_replay_failed(uint64_t cycles);